@@ -0,0 +1,113 @@
+// File: bench_sidebar.c
+// Description: Sidebar rebuild cost on a synthetic tree
+// License: MIT License
+//
+// Measures the work the GUI does after every refresh: collecting the
+// expanded state, destroying the sidebar tree and rebuilding it from the
+// file tree (rebuildSidebar). No window is opened; only the data side of
+// the sidebar is exercised. Output follows bench_fileops (JSON lines on
+// stdout, table on stderr) and accepts the same tree options.
+//
+//   bench_sidebar [--depth N] [--fanout N] [--files N] [--seed N] [--rounds N] [--label TEXT]
+
+#define RAYGUI_IMPLEMENTATION
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "file_manager.h"
+#include "raygui.h"
+#include "sidebar.h"
+#include "treegen.h"
+
+#define ROOT ".dir/root"
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+static void report(FILE* out, const char* label, const char* op, long long items, double ms,
+  const TreeGenConfig* tree) {
+  fprintf(out,
+    "{\"suite\":\"sidebar\",\"label\":\"%s\",\"op\":\"%s\",\"items\":%lld,\"ms\":%.3f,\"ns_per_item\":%.1f,"
+    "\"entries\":%lld,\"depth\":%d,\"fanout\":%d,\"files\":%d,\"seed\":%llu}\n",
+    label, op, items, ms, items > 0 ? ms * 1e6 / (double)items : 0.0,
+    treegen_entry_count(tree), tree->depth, tree->fanout, tree->files, (unsigned long long)tree->seed);
+  fflush(out);
+  fprintf(stderr, "%-22s %10lld items %12.3f ms %10.1f ns/item\n",
+    op, items, ms, items > 0 ? ms * 1e6 / (double)items : 0.0);
+}
+
+int main(int argc, char** argv) {
+  TreeGenConfig tree = treegen_default_config();
+  tree.sparse = true;
+  const char* label = "default";
+  int rounds = 20;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--depth") == 0) tree.depth = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--fanout") == 0) tree.fanout = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--files") == 0) tree.files = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--seed") == 0) tree.seed = strtoull(argv[i + 1], NULL, 10);
+    else if (strcmp(argv[i], "--rounds") == 0) rounds = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--label") == 0) label = argv[i + 1];
+    // Opsi bench_fileops lain diabaikan agar BENCH_ARGS bisa dipakai bersama
+  }
+  if (rounds < 1) {
+    rounds = 1;
+  }
+
+  FILE* results = fdopen(dup(STDOUT_FILENO), "w");
+  if (results == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+    perror("bench_sidebar");
+    return 1;
+  }
+
+  char scratch[1024];
+  snprintf(scratch, sizeof(scratch), "%s/alpenli-sidebar-%d", treegen_scratch_dir(), (int)getpid());
+  treegen_remove(scratch);
+  if (mkdir(scratch, 0755) != 0 || chdir(scratch) != 0) {
+    perror(scratch);
+    return 1;
+  }
+
+  TreeGenStats stats;
+  if (!treegen_generate(ROOT, &tree, &stats)) {
+    return 1;
+  }
+
+  FileManager fm;
+  createFileManager(&fm);
+  initFileManager(&fm);
+  long long folders = stats.folders + 1;
+
+  Sidebar sidebar;
+  memset(&sidebar, 0, sizeof(sidebar));
+
+  double start = now_ms();
+  sidebar.sidebarRoot = createSidebarItemWithState(fm.root, NULL);
+  report(results, label, "sidebar_build", folders, now_ms() - start, &tree);
+
+  start = now_ms();
+  for (int i = 0; i < rounds; i++) {
+    rebuildSidebar(&sidebar, fm.root);
+  }
+  report(results, label, "sidebar_rebuild", folders, (now_ms() - start) / rounds, &tree);
+
+  destroySidebarItem(&sidebar.sidebarRoot);
+  stopTrashPurger(&fm.trashPurger);
+  closeTrashJournal(&fm.trashJournal);
+  closeOpJournal(&fm.opJournal);
+
+  if (chdir("/") == 0) {
+    treegen_remove(scratch);
+  }
+  fclose(results);
+  return 0;
+}
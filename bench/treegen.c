@@ -0,0 +1,217 @@
+// File: treegen.c
+// Description: Deterministic synthetic directory trees for benchmarks
+// License: MIT License
+
+#define _XOPEN_SOURCE 700
+
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "treegen.h"
+
+#define TREEGEN_PATH_MAX 4096
+#define TREEGEN_CHUNK 65536
+
+static const char* file_exts[] = { "txt", "jpg", "pdf", "c", "md", "png", "zip", "csv" };
+#define FILE_EXT_COUNT (int)(sizeof(file_exts) / sizeof(file_exts[0]))
+
+static char fill_buffer[TREEGEN_CHUNK];
+
+// splitmix64: small, fast and identical on every platform
+static uint64_t next_random(uint64_t* state) {
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static double next_unit(uint64_t* state) {
+  return (double)(next_random(state) >> 11) / (double)(1ULL << 53);
+}
+
+static long pick_size(const TreeGenConfig* config, uint64_t* state) {
+  long span = config->max_size - config->min_size;
+  if (span <= 0) {
+    return config->max_size;
+  }
+  switch (config->size_dist) {
+  case TREEGEN_SIZE_FIXED:
+    return config->max_size;
+  case TREEGEN_SIZE_UNIFORM:
+    return config->min_size + (long)(next_random(state) % (uint64_t)(span + 1));
+  case TREEGEN_SIZE_PARETO:
+  default: {
+    // Pareto alpha 1.2 over [1, inf), scaled so 1 KiB is the typical file
+    double u = next_unit(state);
+    double x = pow(1.0 - u, -1.0 / 1.2) - 1.0;
+    long size = config->min_size + (long)(x * 1024.0);
+    return size > config->max_size || size < config->min_size ? config->max_size : size;
+  }
+  }
+}
+
+static bool write_file(const char* path, long size, bool sparse, TreeGenStats* stats) {
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    fprintf(stderr, "treegen: gagal membuat %s: %s\n", path, strerror(errno));
+    return false;
+  }
+
+  bool ok = true;
+  if (sparse) {
+    ok = ftruncate(fd, size) == 0;
+  }
+  else {
+    long left = size;
+    while (ok && left > 0) {
+      long chunk = left < TREEGEN_CHUNK ? left : TREEGEN_CHUNK;
+      ok = write(fd, fill_buffer, (size_t)chunk) == chunk;
+      left -= chunk;
+    }
+  }
+  close(fd);
+
+  if (ok) {
+    stats->files++;
+    stats->bytes += size;
+  }
+  return ok;
+}
+
+// Recursion depth is bounded by config->depth, not by the entry count
+static bool generate_level(char* path, size_t length, int level, const TreeGenConfig* config,
+  uint64_t* state, TreeGenStats* stats) {
+  for (int i = 0; i < config->files; i++) {
+    int ext = (int)(next_random(state) % FILE_EXT_COUNT);
+    long size = pick_size(config, state);
+    snprintf(path + length, TREEGEN_PATH_MAX - length, "/file_%d.%s", i, file_exts[ext]);
+    if (!write_file(path, size, config->sparse, stats)) {
+      return false;
+    }
+  }
+
+  if (level >= config->depth) {
+    path[length] = '\0';
+    return true;
+  }
+
+  for (int i = 0; i < config->fanout; i++) {
+    int written = snprintf(path + length, TREEGEN_PATH_MAX - length, "/dir_%d_%d", level, i);
+    if (written <= 0 || length + (size_t)written >= TREEGEN_PATH_MAX) {
+      return false;
+    }
+    if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+      fprintf(stderr, "treegen: gagal membuat folder %s: %s\n", path, strerror(errno));
+      return false;
+    }
+    stats->folders++;
+    if (!generate_level(path, length + (size_t)written, level + 1, config, state, stats)) {
+      return false;
+    }
+  }
+  path[length] = '\0';
+  return true;
+}
+
+TreeGenConfig treegen_default_config(void) {
+  TreeGenConfig config;
+  config.depth = 4;
+  config.fanout = 6;
+  config.files = 8;
+  config.size_dist = TREEGEN_SIZE_PARETO;
+  config.min_size = 0;
+  config.max_size = 64 * 1024;
+  config.seed = 42;
+  config.sparse = false;
+  return config;
+}
+
+long long treegen_entry_count(const TreeGenConfig* config) {
+  long long folders = 0;
+  long long level = 1;
+  for (int i = 0; i < config->depth; i++) {
+    level *= config->fanout;
+    folders += level;
+  }
+  return folders + (folders + 1) * config->files;
+}
+
+bool treegen_parse_size(const char* name, TreeGenSize* out) {
+  if (strcmp(name, "fixed") == 0) {
+    *out = TREEGEN_SIZE_FIXED;
+  }
+  else if (strcmp(name, "uniform") == 0) {
+    *out = TREEGEN_SIZE_UNIFORM;
+  }
+  else if (strcmp(name, "pareto") == 0) {
+    *out = TREEGEN_SIZE_PARETO;
+  }
+  else {
+    return false;
+  }
+  return true;
+}
+
+bool treegen_generate(const char* root, const TreeGenConfig* config, TreeGenStats* stats) {
+  char path[TREEGEN_PATH_MAX];
+  size_t length = strlen(root);
+  if (length >= sizeof(path)) {
+    return false;
+  }
+  memcpy(path, root, length + 1);
+
+  // mkdir -p untuk root
+  for (size_t i = 1; i <= length; i++) {
+    if (path[i] == '/' || path[i] == '\0') {
+      char saved = path[i];
+      path[i] = '\0';
+      if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "treegen: gagal membuat folder %s: %s\n", path, strerror(errno));
+        return false;
+      }
+      path[i] = saved;
+    }
+  }
+
+  for (int i = 0; i < TREEGEN_CHUNK; i++) {
+    fill_buffer[i] = (char)('a' + i % 26);
+  }
+
+  uint64_t state = config->seed;
+  memset(stats, 0, sizeof(*stats));
+  return generate_level(path, length, 0, config, &state, stats);
+}
+
+static int remove_entry(const char* path, const struct stat* sb, int flag, struct FTW* ftw) {
+  (void)sb;
+  (void)flag;
+  (void)ftw;
+  return remove(path);
+}
+
+bool treegen_remove(const char* path) {
+  struct stat st;
+  if (lstat(path, &st) != 0) {
+    return true;
+  }
+  return nftw(path, remove_entry, 64, FTW_DEPTH | FTW_PHYS) == 0;
+}
+
+const char* treegen_scratch_dir(void) {
+  const char* dir = getenv("ALPENLI_BENCH_DIR");
+  if (dir != NULL && dir[0] != '\0') {
+    return dir;
+  }
+  struct stat st;
+  if (stat("/dev/shm", &st) == 0 && S_ISDIR(st.st_mode) && access("/dev/shm", W_OK) == 0) {
+    return "/dev/shm";
+  }
+  return "/tmp";
+}
@@ -0,0 +1,56 @@
+// File: treegen.h
+// Description: Deterministic synthetic directory trees for benchmarks
+// License: MIT License
+//
+// A tree is described by depth, folders per folder, files per folder and a
+// file-size distribution. The same config and seed always produce the same
+// names and sizes, so results from different runs are comparable.
+
+#ifndef TREEGEN_H
+#define TREEGEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum TreeGenSize {
+  TREEGEN_SIZE_FIXED,    // Every file is max_size bytes
+  TREEGEN_SIZE_UNIFORM,  // Uniform in [min_size, max_size]
+  TREEGEN_SIZE_PARETO    // Heavy tail: mostly near min_size, few near max_size
+} TreeGenSize;
+
+typedef struct TreeGenConfig {
+  int depth;             // Folder levels below the root (0 = files only)
+  int fanout;            // Subfolders per folder
+  int files;             // Files per folder
+  TreeGenSize size_dist;
+  long min_size;
+  long max_size;
+  uint64_t seed;
+  bool sparse;           // ftruncate instead of writing data
+} TreeGenConfig;
+
+typedef struct TreeGenStats {
+  long long folders;     // Folders created, not counting the root
+  long long files;
+  long long bytes;       // Logical bytes of all files
+} TreeGenStats;
+
+// Defaults: depth 4, fanout 6, 8 files, pareto 0..64 KiB, seed 42
+TreeGenConfig treegen_default_config(void);
+
+// Number of entries (folders + files) the config produces
+long long treegen_entry_count(const TreeGenConfig* config);
+
+// Parse "fixed", "uniform" or "pareto"; false if unknown
+bool treegen_parse_size(const char* name, TreeGenSize* out);
+
+// Create the tree under root (created if missing)
+bool treegen_generate(const char* root, const TreeGenConfig* config, TreeGenStats* stats);
+
+// Remove path recursively; true if nothing is left
+bool treegen_remove(const char* path);
+
+// Scratch directory for benchmarks: $ALPENLI_BENCH_DIR, else /dev/shm (tmpfs), else /tmp
+const char* treegen_scratch_dir(void);
+
+#endif
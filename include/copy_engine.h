@@ -0,0 +1,125 @@
+#ifndef COPY_ENGINE_H
+#define COPY_ENGINE_H
+
+#include <stdbool.h>
+
+/**
+ * @file copy_engine.h
+ * @brief Low-level file copy backend used by paste and import operations
+ * @author AlpenliCloud Development Team
+ * @date 2025
+**/
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Statistics collected while copying files
+ *
+ * Accumulates counters across one or more copy calls so callers can
+ * report a summary once a whole paste/import operation has finished.
+ * Logical size is the apparent size of the files (st_size), allocated
+ * size is what the destination filesystem actually reserved on disk.
+ * Sparse bytes sum, per file, how much of the logical size was kept as
+ * holes instead of being allocated.
+ */
+typedef struct CopyStats {
+    long long filesCopied;     ///< Number of regular files copied
+    long long logicalBytes;    ///< Sum of apparent file sizes (st_size)
+    long long allocatedBytes;  ///< Sum of bytes allocated at destination (st_blocks * 512)
+    long long dataBytes;       ///< Bytes actually read and written (holes are skipped)
+    long long sparseBytes;     ///< Logical bytes left as holes at destination (per file logical - allocated)
+} CopyStats;
+
+/*
+====================================================================
+    COPY OPERATIONS
+====================================================================
+*/
+
+/**
+ * @brief Resets all counters in a CopyStats structure
+ *
+ * @param[out] stats Statistics structure to reset
+ *
+ * @pre stats must point to valid memory
+ * @post All counters set to zero
+ */
+void resetCopyStats(CopyStats* stats);
+
+/**
+ * @brief Copies the process-wide totals of every copy so far
+ *
+ * Unlike the per-call CopyStats, these counters are always kept and
+ * dataBytes advances per chunk, so sampling it during a long copy gives
+ * the current throughput. Safe to call from any thread.
+ *
+ * @param[out] totals Filled with the running totals
+ */
+void getCopyTotals(CopyStats* totals);
+
+/**
+ * @brief Copies a regular file while preserving sparse regions
+ *
+ * On platforms that support SEEK_DATA/SEEK_HOLE, only the data extents of
+ * the source are read and written at their original offsets; holes are
+ * skipped and the destination is extended with ftruncate() so it ends up
+ * with the same logical size and the same holes. On other platforms (or
+ * filesystems that reject SEEK_DATA) a plain buffered copy is performed.
+ *
+ * @param[in] srcPath Path of the source file
+ * @param[in] destPath Path of the destination file (created or truncated)
+ * @param[in,out] stats Optional statistics accumulator, may be NULL
+ *
+ * @return bool Status of the copy
+ * @retval true File fully copied
+ * @retval false Source could not be read or destination could not be written
+ *
+ * @pre srcPath refers to a readable regular file
+ * @post destPath contains the same bytes as srcPath, with holes recreated
+ *
+ * @note Sparse VM images or database files keep their on-disk footprint
+ */
+bool copyFileSparse(const char* srcPath, const char* destPath, CopyStats* stats);
+
+/**
+ * @brief Moves a file or folder to another filesystem by copy + delete
+ *
+ * Fallback for rename() failing with EXDEV. Files are streamed through
+ * copyFileSparse(), verified against the source size and only then is the
+ * source unlinked, one file at a time. Folders are walked depth-first and
+ * each source directory is removed once it is empty.
+ *
+ * Each destination file is synced to disk before its source is unlinked.
+ * The move is resumable: a destination file whose contents already match the
+ * source (left behind by an interrupted move) is not copied again, only its
+ * source is removed. Memory use is bounded by directory depth, not by size.
+ *
+ * @param[in] srcPath Source file or folder path
+ * @param[in] destPath Destination path (must not be inside srcPath)
+ * @param[in,out] stats Optional statistics accumulator, may be NULL
+ *
+ * @return bool Status of the move
+ * @retval true Everything moved and source removed
+ * @retval false At least one entry failed; already moved entries stay moved
+ *
+ * @pre srcPath exists, parent of destPath exists
+ * @post Content lives at destPath and srcPath no longer exists on success
+ */
+bool moveAcrossFilesystems(const char* srcPath, const char* destPath, CopyStats* stats);
+
+/**
+ * @brief Formats a byte count as a human readable string
+ *
+ * @param[in] bytes Byte count to format
+ * @param[out] buffer Output buffer
+ * @param[in] bufferSize Size of output buffer
+ *
+ * @return char* Pointer to buffer for convenience
+ */
+char* formatCopySize(long long bytes, char* buffer, int bufferSize);
+
+#endif
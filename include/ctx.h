@@ -23,6 +23,10 @@ typedef struct Sidebar Sidebar;
 typedef struct TitleBar TitleBar;
 typedef struct Toolbar Toolbar;
 typedef struct Footer Footer;
+typedef struct Hud Hud;
+typedef struct ThumbnailCache ThumbnailCache;
+typedef struct PreviewPane PreviewPane;
+typedef struct DuplicateView DuplicateView;
 
 /*
 ====================================================================
@@ -45,6 +49,10 @@ typedef struct Context {
     TitleBar* titleBar;             /**< Title bar component */
     Toolbar* toolbar;               /**< Toolbar component with action buttons */
     Footer* footer;                 /**< Footer component for status information */
+    Hud* hud;                       /**< Performance overlay (F3) */
+    ThumbnailCache* thumbnails;     /**< Image thumbnails shown in the body */
+    PreviewPane* preview;           /**< Preview of the selected file (F4) */
+    DuplicateView* duplicates;      /**< Duplicate scan shown as search results (Ctrl+D) */
 
     Rectangle* currentZeroPosition; /**< Current zero position rectangle for layout */
 
@@ -105,7 +113,7 @@ void createContext(Context* ctx, FileManager* fileManager, int screenWidth, int
  * @post currentZeroPosition is updated based on current screen dimensions and titleBar height
  * @post Context width and height are updated to current screen dimensions
  * @post fileManager reference is updated
- * @post All GUI components are updated in sequence: titleBar → navbar → toolbar → sidebar → body
+ * @post All GUI components are updated in sequence: titleBar → navbar → toolbar → sidebar → body → preview
  *
  * @note Uses GetScreenWidth() and GetScreenHeight() to get current dimensions
  * @note Component update order is important for proper layout calculation
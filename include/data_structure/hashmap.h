@@ -0,0 +1,181 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @file hashmap.h
+ * @brief Separate-chaining hash map with generic keys and values
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ * @license MIT License
+ *
+ * Keys are not copied: the caller keeps ownership of key memory and must
+ * keep it alive while the entry is in the map. Several entries may share
+ * the same key (multimap semantics); hashmap_get() returns the most
+ * recently inserted one.
+ */
+
+ /*
+ ====================================================================
+     DATA STRUCTURES
+ ====================================================================
+ */
+
+ /**
+  * @brief Hash function signature
+  */
+typedef unsigned long (*HashFunction)(const void* key);
+
+/**
+ * @brief Key equality function signature
+ */
+typedef bool (*KeyEquals)(const void* a, const void* b);
+
+/**
+ * @brief Single entry in a hash bucket chain
+ */
+typedef struct HashEntry {
+    const void* key;          /**< Key (not owned) */
+    void* value;              /**< Stored value */
+    unsigned long hash;       /**< Cached hash of key */
+    struct HashEntry* next;   /**< Next entry in the same bucket */
+} HashEntry;
+
+/**
+ * @brief Hash map container
+ */
+typedef struct HashMap {
+    HashEntry** buckets;      /**< Bucket array */
+    size_t capacity;          /**< Number of buckets (power of two) */
+    size_t size;              /**< Number of stored entries */
+    HashFunction hash;        /**< Hash function for keys */
+    KeyEquals equals;         /**< Equality function for keys */
+} HashMap;
+
+/*
+====================================================================
+    UTILITY FUNCTIONS
+====================================================================
+*/
+
+/**
+ * @brief Initializes an empty hash map with custom key functions
+ *
+ * @param[out] map Map to initialize
+ * @param[in] hash Hash function for keys
+ * @param[in] equals Equality function for keys
+ *
+ * @post map is empty, buckets are allocated lazily on first insert
+ */
+void create_hashmap(HashMap* map, HashFunction hash, KeyEquals equals);
+
+/**
+ * @brief Initializes an empty hash map keyed by NUL-terminated strings
+ *
+ * @param[out] map Map to initialize
+ */
+void create_string_hashmap(HashMap* map);
+
+/**
+ * @brief Initializes an empty hash map keyed by pointer identity
+ *
+ * @param[out] map Map to initialize
+ */
+void create_pointer_hashmap(HashMap* map);
+
+/**
+ * @brief Releases all entries and buckets (keys and values are not freed)
+ *
+ * @param[in,out] map Map to destroy, left empty and reusable
+ */
+void destroy_hashmap(HashMap* map);
+
+/**
+ * @brief Removes all entries but keeps the bucket array allocated
+ *
+ * @param[in,out] map Map to clear
+ */
+void clear_hashmap(HashMap* map);
+
+/*
+====================================================================
+    OPERATIONS
+====================================================================
+*/
+
+/**
+ * @brief Inserts a key/value pair in amortized O(1)
+ *
+ * Does not replace existing entries with an equal key; the new entry
+ * shadows them for hashmap_get() until it is removed.
+ *
+ * @param[in,out] map Target map
+ * @param[in] key Key (must outlive the entry)
+ * @param[in] value Value to store
+ *
+ * @return bool false if memory allocation failed
+ */
+bool hashmap_put(HashMap* map, const void* key, void* value);
+
+/**
+ * @brief Looks up the most recent value stored for key in O(1)
+ *
+ * @param[in] map Map to search
+ * @param[in] key Key to look up
+ *
+ * @return void* Stored value, or NULL if key not present
+ */
+void* hashmap_get(const HashMap* map, const void* key);
+
+/**
+ * @brief Checks whether a key is present
+ *
+ * @param[in] map Map to search
+ * @param[in] key Key to look up
+ *
+ * @return bool true if at least one entry uses key
+ */
+bool hashmap_contains(const HashMap* map, const void* key);
+
+/**
+ * @brief Removes the most recent entry for key in O(1)
+ *
+ * @param[in,out] map Target map
+ * @param[in] key Key to remove
+ *
+ * @return void* Removed value, or NULL if key not present
+ */
+void* hashmap_remove(HashMap* map, const void* key);
+
+/**
+ * @brief Removes the exact key/value pair in O(1)
+ *
+ * Used by multimap users that store several values under the same key.
+ *
+ * @param[in,out] map Target map
+ * @param[in] key Key of the entry
+ * @param[in] value Value of the entry
+ *
+ * @return bool true if the pair was found and removed
+ */
+bool hashmap_remove_entry(HashMap* map, const void* key, void* value);
+
+/**
+ * @brief String hash (FNV-1a) usable with create_hashmap()
+ *
+ * @param[in] key NUL-terminated string
+ * @return unsigned long Hash value
+ */
+unsigned long hash_string(const void* key);
+
+/**
+ * @brief Pointer hash usable with create_hashmap()
+ *
+ * @param[in] key Any pointer
+ * @return unsigned long Hash value
+ */
+unsigned long hash_pointer(const void* key);
+
+#endif
@@ -33,11 +33,13 @@ typedef struct Node {
 /**
  * @brief Linked list structure
  *
- * Container structure for managing linked list with head pointer
- * to track the beginning of the list.
+ * Container structure for managing linked list. Tail and length are
+ * maintained by every operation so appending and counting are O(1).
  */
 typedef struct LinkedList {
     Node* head;           /**< Pointer to the first node in the list */
+    Node* tail;           /**< Pointer to the last node in the list */
+    int length;           /**< Number of nodes in the list */
 } LinkedList;
 
 /*
@@ -83,8 +85,9 @@ void create_list(LinkedList* list);
  * @post New node is created with data stored and next set to NULL
  * @post Memory is allocated for the new node
  *
- * @note Memory allocation is performed using malloc
- * @note Caller is responsible for freeing the node when no longer needed
+ * @note Nodes come from a per-thread pool refilled in blocks of
+ *       NODE_POOL_BLOCK, so most calls do not reach malloc
+ * @note Release the node with free_node(), never with free()
  * @warning Check return value for NULL before using the node
  *
  * @see insert_first() for adding node to list
@@ -94,6 +97,19 @@ void create_list(LinkedList* list);
  */
 Node* create_node(infotype data);
 
+/**
+ * @brief Returns a node to the node pool
+ *
+ * @param[in] node Node obtained from create_node() (NULL is ignored)
+ *
+ * @post node is on the calling thread's free list and must not be used
+ *
+ * @note Pool blocks are kept for the lifetime of the process
+ *
+ * @author Maulana Ishak
+ */
+void free_node(Node* node);
+
 /**
  * @brief Checks if the linked list is empty
  *
@@ -160,7 +176,7 @@ bool is_exist(LinkedList list, infotype data);
  * @pre list can be empty or contain valid nodes
  * @post No modification to list state
  *
- * @note Traverses entire list for counting
+ * @note O(1), reads the maintained length
  * @note Returns 0 for empty list
  *
  * @see is_list_empty() for quick emptiness check
@@ -255,7 +271,7 @@ void insert_first(LinkedList* list, infotype data);
  * @brief Inserts a new node at the end of the list
  *
  * Creates a new node with the given data and appends it to the
- * end of the linked list. Traverses to find the last node.
+ * end of the linked list using the tail pointer.
  *
  * @param[in,out] list Pointer to linked list to insert into
  * @param[in] data Data to be inserted at the end
@@ -267,8 +283,7 @@ void insert_first(LinkedList* list, infotype data);
  * @post New node becomes the last element
  * @post If list was empty, new node becomes head
  *
- * @note Requires traversal to find end of list
- * @note O(n) time complexity operation
+ * @note O(1) time complexity operation
  * @warning Ensure sufficient memory is available for new node
  *
  * @see insert_first() for inserting at beginning
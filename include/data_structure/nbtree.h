@@ -1,6 +1,10 @@
 #ifndef NBTREE_H
 #define NBTREE_H
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
 #include "item.h"
 
 /**
@@ -31,19 +35,101 @@ typedef Item treeInfotype;
  */
 typedef struct TreeNode* Tree;
 
+/**
+ * @brief Stable reference to a tree node
+ *
+ * A handle names a slot in the node table plus the slot's generation.
+ * Freeing a node bumps the generation, so resolving an old handle returns
+ * NULL in O(1) instead of a dangling pointer. Holders that outlive the
+ * node (sidebar items, clipboard, saved cursor) keep handles, not Trees.
+ */
+typedef struct NodeHandle {
+  uint32_t index;        /**< Slot in the node table (0 = null handle) */
+  uint32_t generation;   /**< Slot generation when the handle was taken */
+} NodeHandle;
+
+#define NULL_NODE_HANDLE ((NodeHandle){ 0, 0 })  /**< Handle that never resolves */
+
 /**
  * @brief N-ary tree node structure
  *
  * Represents a node in an N-ary tree with support for multiple children
  * and parent relationships. Used for hierarchical file system representation.
+ *
+ * Children are reachable both through the first_son/next_brother chain and
+ * through the contiguous children array, which holds the same nodes in the
+ * same order. The array gives O(1) indexed access, O(1) append and a
+ * cache-friendly loop; the chain is kept for existing traversals. Code that
+ * relinks the chain directly must call reindex_children() afterwards.
  */
 typedef struct TreeNode {
   treeInfotype item;     /**< Data stored in this node (file/directory information) */
   Tree next_brother;     /**< Pointer to next sibling node at same level */
   Tree first_son;        /**< Pointer to first child node */
   Tree parent;           /**< Pointer to parent node */
+  Tree* children;        /**< Children in sibling order (NULL until the first child) */
+  int child_count;       /**< Number of entries in children */
+  int child_capacity;    /**< Allocated entries in children */
+  NodeHandle handle;     /**< This node's entry in the node table */
 } TreeNode;
 
+/**
+ * @brief Visiting order of a traversal
+ */
+typedef enum TreeOrder {
+  TREE_PRE_ORDER,   /**< Parent before its children */
+  TREE_POST_ORDER   /**< Children before their parent */
+} TreeOrder;
+
+/**
+ * @brief Ancestor entry on a traversal stack
+ */
+typedef struct TreeIterFrame {
+  Tree node;         /**< Ancestor of the current position */
+  int next_child;    /**< Index of the next child of node to visit */
+} TreeIterFrame;
+
+/**
+ * @brief Iterative depth-first traversal over a subtree
+ *
+ * The stack lives on the heap and holds one frame per ancestor, so memory
+ * is O(depth) however wide a folder is, and deep trees cannot overflow the
+ * call stack. The tree must not be modified while an iterator is open.
+ */
+typedef struct TreeIterator {
+  TreeIterFrame* stack;  /**< Ancestors of the current position */
+  int top;               /**< Frames in use */
+  int capacity;          /**< Allocated frames */
+  TreeOrder order;       /**< Visiting order */
+  Tree pending;          /**< Pre-order: root, not yet returned */
+  Tree last;             /**< Pre-order: node to descend into on the next call */
+  int depth;             /**< Depth of the node last returned (root = 0) */
+  bool failed;           /**< Stack could not grow; traversal ended early */
+} TreeIterator;
+
+/**
+ * @brief Callback for tree_walk()
+ *
+ * @return bool false to stop the walk
+ */
+typedef bool (*TreeVisitor)(Tree node, int depth, void* context);
+
+/**
+ * @brief Running totals of every live tree node
+ *
+ * Kept up to date by create_node_tree(), free_node_tree() and the child
+ * array growth, so reading them never walks a tree. Item strings are
+ * owned by the file manager and are not counted.
+ */
+typedef struct TreeStats {
+  long live_nodes;        /**< Nodes created and not yet freed */
+  size_t node_bytes;      /**< sizeof(TreeNode) for every live node */
+  size_t children_bytes;  /**< Allocated child array capacity */
+  size_t slot_bytes;      /**< Handle table and its free lists */
+  uint32_t slots_used;    /**< Handle slots ever handed out */
+  uint32_t slots_free;    /**< Slots waiting for reuse (free + deferred) */
+} TreeStats;
+
 /*
 ====================================================================
     TREE OPERATIONS
@@ -88,7 +174,8 @@ void create_tree(Tree* tree);
  * @post Memory is allocated for the new node
  *
  * @note Memory allocation is performed using malloc
- * @note Caller is responsible for freeing the node when no longer needed
+ * @note The node is registered in the node table and gets a handle
+ * @note Free the node with free_node_tree(), which also frees the child array
  * @warning Check return value for NULL before using the node
  *
  * @see insert_node() for adding node to existing tree
@@ -117,8 +204,9 @@ Tree create_node_tree(treeInfotype data);
  * @post If parent has children, new node is added at end of sibling list
  * @post New node's parent pointer is set to parent
  *
- * @note If parent is NULL, creates standalone node without parent relationship
- * @note New node is always added at the end of existing children
+ * @note Returns NULL without allocating if parent is NULL
+ * @note New node is always added at the end of existing children in O(1)
+ *       (amortized), using the child array instead of walking siblings
  * @warning Ensure parent node remains valid if not NULL
  *
  * @see create_node_tree() for creating standalone nodes
@@ -127,11 +215,176 @@ Tree create_node_tree(treeInfotype data);
  */
 Tree insert_node(Tree parent, treeInfotype data);
 
+/*
+====================================================================
+    CHILD ARRAY OPERATIONS
+====================================================================
+*/
+
+/**
+ * @brief Appends an existing node as the last child of parent
+ *
+ * @param[in,out] parent Parent node
+ * @param[in,out] child Detached node (its parent and next_brother are overwritten)
+ *
+ * @return bool false if the child array could not grow (tree unchanged)
+ */
+bool append_child(Tree parent, Tree child);
+
+/**
+ * @brief Unlinks child from parent's sibling chain and child array
+ *
+ * @param[in,out] parent Parent node
+ * @param[in] child Child of parent; the node itself is not freed
+ *
+ * @note O(children) because the array is compacted to keep order
+ */
+void remove_child(Tree parent, Tree child);
+
+/**
+ * @brief Returns the child at index, or NULL if out of range
+ *
+ * @note O(1)
+ */
+Tree get_child(Tree parent, int index);
+
+/**
+ * @brief Returns the number of children of parent (0 for NULL)
+ *
+ * @note O(1)
+ */
+int get_child_count(Tree parent);
+
+/**
+ * @brief Rebuilds the child array from the sibling chain
+ *
+ * Call after relinking first_son/next_brother directly, e.g. after
+ * sorting or filtering a child list.
+ */
+void reindex_children(Tree parent);
+
+/**
+ * @brief Frees a node and its child array
+ *
+ * Item strings and child nodes are not freed. The node's handle stops
+ * resolving.
+ */
+void free_node_tree(Tree node);
+
+/*
+====================================================================
+    NODE HANDLES
+====================================================================
+*/
+
+/**
+ * @brief Returns the handle of a live node (NULL_NODE_HANDLE for NULL)
+ */
+NodeHandle get_node_handle(Tree node);
+
+/**
+ * @brief Returns the node a handle refers to, or NULL if it was freed
+ *
+ * @note O(1); never dereferences the node
+ */
+Tree resolve_node_handle(NodeHandle handle);
+
+/**
+ * @brief Compares two handles
+ */
+bool node_handle_equals(NodeHandle a, NodeHandle b);
+
+/**
+ * @brief Moves a freed node's handle onto its replacement
+ *
+ * Used when a subtree is reloaded from disk: the new node for the same
+ * path takes over the old handle, so holders keep resolving without a
+ * search by path. The new node's own handle is released.
+ *
+ * @param[in,out] node Newly created node
+ * @param[in] previous Handle of the freed node it replaces
+ *
+ * @return bool false if the old slot was already reused (node keeps its handle)
+ *
+ * @see defer_node_slot_reuse() to keep the old slots free during a reload
+ */
+bool adopt_node_handle(Tree node, NodeHandle previous);
+
+/**
+ * @brief Keeps freed slots out of reuse while a subtree is reloaded
+ *
+ * Between defer_node_slot_reuse(true) and defer_node_slot_reuse(false),
+ * slots released by freed nodes are not handed to new nodes, so
+ * adopt_node_handle() can move each old handle onto the node that
+ * replaces it. Turning deferral off makes the remaining slots reusable.
+ */
+void defer_node_slot_reuse(bool defer);
+
+/**
+ * @brief Copies the running node and memory totals
+ *
+ * @note O(1); meant for the performance overlay and benchmarks
+ */
+void get_tree_stats(TreeStats* stats);
+
+/**
+ * @brief Returns the node that embeds item
+ *
+ * @pre item is the item field of a TreeNode (not a TrashItem)
+ */
+Tree node_from_item(Item* item);
+
+/*
+====================================================================
+    TRAVERSAL
+====================================================================
+*/
+
+/**
+ * @brief Starts a traversal of root and its descendants
+ *
+ * Siblings of root are not visited.
+ *
+ * @param[out] it Iterator to initialize
+ * @param[in] root Subtree root (NULL gives an empty traversal)
+ * @param[in] order Pre-order or post-order
+ */
+void tree_iter_init(TreeIterator* it, Tree root, TreeOrder order);
+
+/**
+ * @brief Returns the next node, or NULL when the traversal is done
+ *
+ * it->depth holds the depth of the returned node relative to root.
+ */
+Tree tree_iter_next(TreeIterator* it);
+
+/**
+ * @brief Does not descend into the node last returned (pre-order only)
+ */
+void tree_iter_skip_children(TreeIterator* it);
+
+/**
+ * @brief Frees the iterator stack
+ */
+void tree_iter_destroy(TreeIterator* it);
+
+/**
+ * @brief Calls visit for root and every descendant without recursion
+ *
+ * @param[in] root Subtree root
+ * @param[in] order Pre-order or post-order
+ * @param[in] visit Callback; returning false stops the walk
+ * @param[in] context Passed through to visit
+ *
+ * @return bool false if the walk was stopped by visit or ran out of memory
+ */
+bool tree_walk(Tree root, TreeOrder order, TreeVisitor visit, void* context);
+
 /**
  * @brief Searches for a node with matching data in the tree
  *
- * Performs recursive search through the tree to find a node containing
- * data that matches the specified criteria. Uses depth-first search approach.
+ * Walks root and its descendants in pre-order, without recursion, to find
+ * a node whose name and path match.
  *
  * @param[in] root Root node to start search from
  * @param[in] data Data to search for in the tree
@@ -145,7 +398,7 @@ Tree insert_node(Tree parent, treeInfotype data);
  * @post No modification to tree structure
  * @post Returns first node found with matching data
  *
- * @note Uses depth-first search algorithm
+ * @note Uses tree_iter_next(); siblings of root are not searched
  * @note Comparison depends on treeInfotype comparison implementation
  * @note Returns first match found during traversal
  *
@@ -177,7 +430,7 @@ void printIndent(int depth);
 /**
  * @brief Prints tree structure with hierarchical formatting
  *
- * Recursively prints the entire tree structure with proper indentation
+ * Prints node and its descendants in pre-order with proper indentation
  * to visualize the hierarchical relationships between nodes.
  *
  * @param[in] node Root node to start printing from
@@ -187,9 +440,9 @@ void printIndent(int depth);
  * @pre depth must be non-negative integer
  * @post Tree structure is printed to standard output with indentation
  * @post Each level is properly indented based on depth
- * @post All children and siblings are printed recursively
+ * @post All descendants are printed; siblings of node are not
  *
- * @note Uses depth-first traversal for printing
+ * @note Uses tree_iter_next(), so deep trees cannot overflow the stack
  * @note Safe to call with NULL node (no output)
  * @note Indentation helps visualize tree structure
  *
@@ -23,10 +23,12 @@
   *
   * Queue implementation using linked list with front and rear pointers.
   * Follows First-In-First-Out (FIFO) principle for data storage and retrieval.
+  * Enqueue, dequeue and length are O(1).
   */
 typedef struct Queue {
   Node* front;  /**< Pointer to front node of the queue */
   Node* rear;   /**< Pointer to rear node of the queue */
+  int length;   /**< Number of elements in the queue */
 } Queue;
 
 /*
@@ -206,4 +208,15 @@ void print_queue(Queue queue);
  */
 void clear_queue(Queue* q);
 
+/**
+ * @brief Returns the number of elements in the queue
+ *
+ * @param[in] queue Queue to count
+ *
+ * @return int Number of elements, O(1)
+ *
+ * @author Maulana Ishak
+ */
+int get_queue_length(Queue queue);
+
 #endif // QUEUE_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef DELETE_ENGINE_H
+#define DELETE_ENGINE_H
+
+#include <stdbool.h>
+
+/**
+ * @file delete_engine.h
+ * @brief Parallel recursive delete backend (POSIX)
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Directories are opened relative to their parent's descriptor and
+ * entries are removed with unlinkat(), so no full path is ever built and
+ * path length does not matter. Pending directories live on an explicit
+ * work stack instead of the C call stack, and a small pool of threads
+ * pops independent subtrees from it. A directory is removed as soon as
+ * the last of its subdirectories is gone.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define DELETE_MAX_THREADS 8   ///< Upper bound for the worker pool
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Statistics collected by one recursive delete
+ */
+typedef struct DeleteStats {
+    long long filesRemoved;   ///< Non-directory entries unlinked
+    long long dirsRemoved;    ///< Directories removed (including the root)
+    long long errors;         ///< Entries that could not be removed
+    double seconds;           ///< Wall-clock duration
+    int threads;              ///< Threads that took part (including the caller)
+} DeleteStats;
+
+/*
+====================================================================
+    DELETE OPERATIONS
+====================================================================
+*/
+
+/**
+ * @brief Recursively deletes a directory tree using a thread pool
+ *
+ * @param[in] path Directory to delete (a non-directory is simply unlinked)
+ * @param[out] stats Optional statistics, may be NULL
+ *
+ * @return bool true if path no longer exists afterwards
+ *
+ * @note Symlinks are unlinked, never followed
+ * @note Not available on Windows; RemoveItemsRecurse keeps its Win32 path there
+ */
+bool removeTreeParallel(const char* path, DeleteStats* stats);
+
+/**
+ * @brief Items removed per second for a finished delete
+ *
+ * @param[in] stats Statistics filled by removeTreeParallel()
+ *
+ * @return double Items per second (0 if nothing was timed)
+ */
+double deleteItemsPerSecond(const DeleteStats* stats);
+
+#endif
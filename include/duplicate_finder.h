@@ -0,0 +1,182 @@
+#ifndef DUPLICATE_FINDER_H
+#define DUPLICATE_FINDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "nbtree.h"
+
+/**
+ * @file duplicate_finder.h
+ * @brief Duplicate file finder with a staged, parallel hashing pipeline
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Files below a folder are narrowed down in three stages, each cheaper
+ * than the next and run only on what the previous one left:
+ *
+ *   1. size: grouped by the in-memory Item::size, no I/O at all;
+ *   2. edges: a 64-bit hash of the first and last DUP_EDGE_BYTES, which
+ *      separates most same-size files after two small reads;
+ *   3. contents: a hash of the whole file, only for edge collisions.
+ *
+ * Files of at most 2 * DUP_EDGE_BYTES are fully covered by stage 2.
+ * Hashing runs on a pool of worker threads. A group is published as soon
+ * as all of its candidates are hashed, so results stream in while larger
+ * files are still being read; largest sizes are queued first.
+ *
+ * Matching hashes (XXH64) are treated as identical contents; the files
+ * are not compared byte by byte.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define DUP_EDGE_BYTES 4096                ///< Bytes hashed at each end in stage 2
+#define DUP_READ_CHUNK (256 * 1024)        ///< Read size of stage 3 (multiple of 32)
+#define DUP_DEFAULT_WORKERS 4              ///< Hashing threads when 0 is requested
+#define DUP_MAX_WORKERS 16                 ///< Upper bound on hashing threads
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief One candidate file
+ */
+typedef struct DuplicateFile {
+    char* path;                ///< Path at scan time (owned)
+    NodeHandle node;           ///< Tree node; resolve before use, it may be gone
+    long long size;            ///< Item::size at scan time
+    uint64_t edgeHash;         ///< Stage 2 hash (whole contents for small files)
+    uint64_t fullHash;         ///< Stage 3 hash
+    bool readable;             ///< false if reading failed or the size changed
+    int run;                   ///< Run the file is being hashed for
+} DuplicateFile;
+
+/**
+ * @brief Files with identical contents
+ */
+typedef struct DuplicateGroup {
+    long long size;            ///< Size of each file
+    uint64_t hash;             ///< Contents hash shared by the group
+    DuplicateFile** files;     ///< Members sorted by path; the first is the suggested keeper
+    int count;                 ///< Members (at least 2)
+    long long reclaimableBytes; ///< size * (count - 1)
+} DuplicateGroup;
+
+/**
+ * @brief Progress and totals of a scan
+ */
+typedef struct DuplicateStats {
+    long long files;           ///< Files walked below the folder
+    long long sizeCandidates;  ///< Files sharing their size with another file
+    long long edgeCandidates;  ///< Files still colliding after stage 2 (queued for stage 3)
+    long long hashed;          ///< Stage 2 and 3 hashes finished
+    long long bytesRead;       ///< Bytes read by all stages
+    int groups;                ///< Groups published
+    long long duplicateFiles;  ///< Files beyond the keeper of each group
+    long long reclaimableBytes; ///< Sum of DuplicateGroup::reclaimableBytes
+    bool done;                 ///< Every candidate hashed (or the scan was cancelled)
+} DuplicateStats;
+
+/**
+ * @brief A contiguous range of files that collide so far
+ */
+typedef struct DuplicateRun {
+    long long start;           ///< First file index
+    long long end;             ///< One past the last file index
+    long long remaining;       ///< Members not hashed yet in the current stage
+    bool full;                 ///< Stage 3 run
+} DuplicateRun;
+
+/**
+ * @brief Scan state shared by the hashing workers
+ */
+typedef struct DuplicateFinder {
+    DuplicateFile* files;      ///< Candidates; each run is a contiguous range
+    long long fileCount;
+
+    pthread_t workers[DUP_MAX_WORKERS];
+    int workerCount;           ///< Threads started
+    pthread_mutex_t lock;      ///< Guards everything below
+    pthread_cond_t changed;    ///< Signalled on new jobs, new groups and completion
+    long long* jobs;           ///< Ring of file indices to hash (fileCount slots)
+    long long jobHead;         ///< Jobs taken so far
+    long long jobTail;         ///< Jobs queued so far
+    int active;                ///< Workers hashing right now
+    DuplicateRun* runs;
+    int runCount;
+    int runCapacity;
+    DuplicateGroup** groups;   ///< Published groups, in publication order
+    int groupCapacity;
+    DuplicateStats stats;
+    bool cancel;               ///< Set by destroyDuplicateFinder()
+} DuplicateFinder;
+
+/*
+====================================================================
+    LIFECYCLE
+====================================================================
+*/
+
+/**
+ * @brief Collects the size candidates below a folder and starts hashing them
+ *
+ * The tree is only read here, on the calling thread; workers see copies
+ * of the paths and never touch the tree.
+ *
+ * @param[out] finder Scan state to initialize
+ * @param[in] folder Folder to scan recursively
+ * @param[in] workers Hashing threads (0 = DUP_DEFAULT_WORKERS)
+ *
+ * @return bool false if memory ran out; finder is then unusable
+ *
+ * @post On success finder must be released with destroyDuplicateFinder()
+ */
+bool startDuplicateFinder(DuplicateFinder* finder, Tree folder, int workers);
+
+/**
+ * @brief Cancels the remaining work, joins the workers and frees all results
+ *
+ * Groups returned by getDuplicateGroup() are invalid afterwards.
+ */
+void destroyDuplicateFinder(DuplicateFinder* finder);
+
+/*
+====================================================================
+    RESULTS
+====================================================================
+*/
+
+/**
+ * @brief Number of groups published so far
+ */
+int duplicateGroupCount(DuplicateFinder* finder);
+
+/**
+ * @brief Blocks until more than known groups are published or the scan is done
+ *
+ * @return int Groups published now
+ */
+int waitForDuplicateGroups(DuplicateFinder* finder, int known);
+
+/**
+ * @brief Returns a published group; it stays valid until destroyDuplicateFinder()
+ *
+ * @return const DuplicateGroup* Group, or NULL if index is not published
+ */
+const DuplicateGroup* getDuplicateGroup(DuplicateFinder* finder, int index);
+
+/**
+ * @brief Copies the current progress and totals
+ */
+void getDuplicateStats(DuplicateFinder* finder, DuplicateStats* stats);
+
+#endif
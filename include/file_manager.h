@@ -8,10 +8,33 @@
 #include "queue.h"
 #include "stack.h"
 #include "operation.h"
+#include "copy_engine.h"
+#include "trash_store.h"
+#include "trash_journal.h"
+#include "trash_purger.h"
+#include "undo_history.h"
+#include "op_journal.h"
+#include "selection_set.h"
+#include "mem_stats.h"
+#include "duplicate_finder.h"
 
 #define alloc(T) (T *)malloc(sizeof(T))
 
-typedef struct Context Context;
+typedef struct FileManager FileManager;
+
+/**
+ * @brief Callbacks through which the core notifies its front-end
+ *
+ * The core never calls GUI code directly: the GUI installs these hooks
+ * (see ctx.c), headless clients such as the CLI may leave any of them NULL.
+ */
+typedef struct FileManagerHooks {
+    void* userData;                                                   ///< Passed back to every hook
+    void (*treeChanged)(FileManager* fm, void* userData);             ///< Tree changed; rebuild derived views
+    void (*navigated)(FileManager* fm, void* userData);               ///< treeCursor/currentPath changed
+    bool (*progress)(int current, int total, const char* name, void* userData); ///< Paste step; false cancels
+    void (*progressReset)(void* userData);                            ///< Long operation starts or ends
+} FileManagerHooks;
 
 /**
  * @brief Main structure for managing file system in the application
@@ -27,7 +50,11 @@ typedef struct Context Context;
 
 typedef struct FileManager {
     Tree root;                ///< Root directory tree
-    LinkedList trash;         ///< Root trash container for deleted files
+    TrashStore trash;         ///< Trash items indexed by UID/original path, newest first
+    TrashJournal trashJournal; ///< Append-only log persisting the trash store
+    TrashRetention trashRetention; ///< Max age/size/count limits for the trash
+    TrashPurger trashPurger;  ///< Background worker deleting expired trash items
+    time_t lastRetentionCheck; ///< Time of the last retention check
     bool isRootTrash;         ///< Flag indicating if trash is the root trash
 
     LinkedList searchingList; ///< Linked list storing search results
@@ -35,16 +62,21 @@ typedef struct FileManager {
 
     char* currentPath;        ///< Current path string representation
     Tree treeCursor;          ///< Current tree cursor position
+    HashMap racyFolders;      ///< Folders scanned in the second of their mtime; re-read on refresh
 
-    Stack undo;               ///< Stack for undo operations
-    Stack redo;               ///< Stack for redo operations
+    UndoHistory undo;         ///< Byte-bounded history for undo operations
+    UndoHistory redo;         ///< Byte-bounded history for redo operations
+    OpJournal opJournal;      ///< Write-ahead log of operations and the undo history
+    long long activeOperation; ///< Journal sequence of the running delete, 0 when idle
     bool isCopy;
     Queue copied;             ///< Queue for copied items
     Queue clipboard;          ///< Temporary queue for operations
-    LinkedList selectedItem;  ///< Linked list for selected items
+    SelectionSet selectedItem; ///< Selected items, O(1) membership with running count/size
+
+    CopyStats lastPasteStats; ///< Logical vs allocated bytes of the last paste
 
     bool needsRefresh;        ///< Flag indicating if refresh is needed
-    Context* ctx;             ///< Context for accessing sidebar and other components
+    FileManagerHooks hooks;   ///< Front-end callbacks (all NULL when headless)
 } FileManager;
 
 /*
@@ -84,15 +116,14 @@ void createFileManager(FileManager* fileManager);
 void initFileManager(FileManager* fileManager);
 
 /**
- * @brief Refreshes file manager with current filesystem state
+ * @brief Tells the front-end that the tree changed
  *
- * Reloads tree structure from current directory by clearing children and reloading.
- * This function synchronizes in-memory tree with actual filesystem state.
+ * Calls the treeChanged hook so the GUI can rebuild views derived from the
+ * tree (the sidebar). Does not read the filesystem; see syncFileManager().
  *
  * @param[in,out] fileManager Pointer to FileManager to refresh
  *
- * @pre Tree structure may be out of sync with filesystem
- * @post Child nodes cleared, tree reloaded from treeCursor path, tree structure synchronized with filesystem
+ * @post treeChanged hook called if installed
  *
  * @author Arief
  * @editor Farras
@@ -100,15 +131,31 @@ void initFileManager(FileManager* fileManager);
 void refreshFileManager(FileManager* fileManager);
 
 /**
- * @brief Saves trash data to file
+ * @brief Merges filesystem changes below the current folder into the tree
+ *
+ * Reconciles the existing nodes by name instead of rebuilding them, so
+ * selection, sidebar expansion and node handles survive. Folders whose
+ * mtime is unchanged are not read again. If the current folder was removed
+ * from disk, the cursor moves to the nearest folder that still exists.
+ * Used by the F5 / CTRL+R shortcut.
+ *
+ * @param[in,out] fm Pointer to FileManager to synchronize
+ *
+ * @post Tree below treeCursor matches the filesystem, sidebar refreshed
+ */
+void syncFileManager(FileManager* fm);
+
+/**
+ * @brief Checkpoints trash data to disk
  *
- * Persists all items in LinkedList trash to trash_dump.txt file.
- * This function ensures trash state survives application restarts.
+ * Trash changes are appended to the trash journal as they happen; this
+ * flushes the pending batch and compacts the journal if it is mostly
+ * dead records. Called on shutdown and after batch trash operations.
  *
  * @param[in] fileManager Pointer to FileManager containing trash data
  *
- * @pre LinkedList trash contains deleted items
- * @post trash_dump.txt file updated with trash data, each item saved in "name,originalPath,deletedTime" format
+ * @pre trash journal is open (initFileManager)
+ * @post every trash change so far is fsynced to .dir/.trash.journal
  *
  * @author Farras
  */
@@ -117,16 +164,16 @@ void saveTrashToFile(FileManager* fileManager);
 /**
  * @brief Prints trash contents to console
  *
- * Displays all items in LinkedList trash to console for debugging/monitoring.
+ * Displays all items in the trash store to console for debugging/monitoring.
  *
- * @param[in] trash LinkedList containing trash items
+ * @param[in] trash Trash store containing trash items
  *
- * @pre LinkedList trash contains deleted items
+ * @pre trash store is initialized
  * @post Each item printed to console with name, original path, deletion time, and trash path
  *
  * @author Farras
  */
-void printTrash(LinkedList trash);
+void printTrash(const TrashStore* trash);
 
 /*
 ================================================================================
@@ -151,7 +198,7 @@ void printTrash(LinkedList trash);
  *
  * @author Maulana
  */
-void createFile(FileManager* fileManager, ItemType type, char* dirPath, char* name, bool isOperation);
+void createFile(FileManager* fileManager, ItemType type, const char* dirPath, char* name, bool isOperation);
 
 /**
  * @brief Deletes files/folders to trash
@@ -169,6 +216,24 @@ void createFile(FileManager* fileManager, ItemType type, char* dirPath, char* na
  */
 void deleteFile(FileManager* fileManager, bool isOperation);
 
+/**
+ * @brief Moves a batch of items to trash as one transaction
+ *
+ * Resolves all tree nodes in a single traversal, moves the items on disk,
+ * then removes the nodes and refreshes the view once. The whole batch is
+ * recorded as one undo Operation.
+ *
+ * @param[in,out] fileManager Pointer to FileManager instance
+ * @param[in] items Items to delete (matched by path and name)
+ * @param[in] count Number of items
+ * @param[in] isOperation Flag indicating if operation should be saved for undo
+ *
+ * @return int Number of items moved to trash
+ *
+ * @post The selection is cleared before any node is freed
+ */
+int deleteItems(FileManager* fileManager, Item** items, int count, bool isOperation);
+
 /**
  * @brief Permanently deletes files/folders
  *
@@ -217,6 +282,23 @@ void renameFile(FileManager* fileManager, char* filePath, char* newName, bool is
  */
 void recoverFile(FileManager* fileManager);
 
+/**
+ * @brief Enforces the trash retention policy
+ *
+ * Called every frame; runs at most once per TRASH_RETENTION_CHECK_INTERVAL.
+ * While the trash exceeds any retention limit, the oldest item is detached
+ * from the trash store and handed to the background purge worker.
+ *
+ * @param[in,out] fileManager Pointer to FileManager instance
+ *
+ * @pre initFileManager() has started the purge worker
+ * @post at most TRASH_RETENTION_BATCH oldest items queued for deletion
+ *
+ * @note Selected items and trash search results are never purged from
+ *       under the UI; the check is retried on the next interval
+ */
+void enforceTrashRetention(FileManager* fileManager);
+
 /**
  * @brief Searches for a file by path
  *
@@ -296,12 +378,14 @@ void cutFile(FileManager* fileManager);
  * @param[in,out] fileManager Pointer to FileManager instance
  * @param[in] isOperation Flag indicating if operation should be saved for undo
  *
+ * @return int Number of items pasted; less than the clipboard size if some failed
+ *
  * @pre temp queue contains files/folders from copy/cut operation
  * @post Files/folders pasted to treeCursor with copy content or move, progress bar shown if >10 items, temp queue cleared for cut
  *
  * @author Arief
  */
-void pasteFile(FileManager* fileManager, bool isOperation);
+int pasteFile(FileManager* fileManager, bool isOperation);
 
 /*
 ================================================================================
@@ -312,8 +396,8 @@ void pasteFile(FileManager* fileManager, bool isOperation);
 /**
  * @brief Selects a file/folder
  *
- * Adds item to LinkedList selectedItem if not already present.
- * This function manages item selection state.
+ * Adds item to the selectedItem set if not already present.
+ * Membership is by item identity and costs O(1).
  *
  * @param[in,out] fileManager Pointer to FileManager instance
  * @param[in,out] item Pointer to item to select
@@ -326,22 +410,20 @@ void selectFile(FileManager* fileManager, Item* item);
 /**
  * @brief Deselects a file/folder
  *
- * Removes item from LinkedList selectedItem and sets selected=false.
- * This function manages item deselection state.
+ * Removes item from the selectedItem set in O(1) and sets selected=false.
  *
  * @param[in,out] fileManager Pointer to FileManager instance
  * @param[in,out] item Pointer to item to deselect
  *
  * @pre item may exist in selectedItem
- * @post item removed from selectedItem if found, item.selected set to false, LinkedList reset if empty
+ * @post item removed from selectedItem if found, item.selected set to false
  */
 void deselectFile(FileManager* fileManager, Item* item);
 
 /**
  * @brief Clears all selected files
  *
- * Removes all items from LinkedList selectedItem by calling deselectFile for each item.
- * This function provides bulk deselection capability.
+ * Clears the selected flag of every selected item and empties selectedItem.
  *
  * @param[in,out] fileManager Pointer to FileManager instance
  *
@@ -354,7 +436,7 @@ void clearSelectedFile(FileManager* fileManager);
  * @brief Selects all files in current directory
  *
  * Selects all child nodes from current treeCursor.
- * This function provides bulk selection capability.
+ * Each child costs one O(1) set insert, so large directories stay linear.
  *
  * @param[in,out] fileManager Pointer to FileManager instance
  *
@@ -386,21 +468,38 @@ void selectAll(FileManager* fileManager);
 void searchingTreeItem(FileManager* fileManager, char* keyword);
 
 /**
- * @brief Searches items in linked list
+ * @brief Searches items in trash
  *
- * Searches items in LinkedList based on keyword by comparing item names.
- * This function enables search within list-based data structures.
+ * Searches trash items based on keyword by comparing item names, walking
+ * the trash store in deletion-time order.
  *
  * @param[in,out] FileManager Pointer to FileManager instance
- * @param[in] node Node to search from
  * @param[in] keyword Search keyword string
  *
- * @pre FileManager, node, and keyword are valid
- * @post LinkedList populated with matching items, each containing name, path, size, type, and time
+ * @pre FileManager and keyword are valid
+ * @post LinkedList searchingList populated with matching trash items
  *
  * @author Farras
  */
-void searchingLinkedListItem(FileManager* FileManager, Node* node, char* keyword);
+void searchingTrashItem(FileManager* FileManager, char* keyword);
+
+/**
+ * @brief Shows duplicate groups as search results, appending the groups found since the last call
+ *
+ * Groups are added in publication order, each with its keeper first, so
+ * the results can be reviewed and the copies selected and deleted like
+ * any other search result. Members whose tree node no longer exists are
+ * skipped. Passing from = 0 replaces the current results.
+ *
+ * @param[in,out] fileManager Pointer to FileManager instance
+ * @param[in] finder Running or finished duplicate scan
+ * @param[in] from Groups already shown
+ *
+ * @return int Groups shown after the call
+ *
+ * @post isSearching is true and searchingList holds the nodes of the shown groups
+ */
+int appendDuplicateResults(FileManager* fileManager, DuplicateFinder* finder, int from);
 
 /**
  * @brief Prints search results to console
@@ -441,13 +540,27 @@ void goBack(FileManager* fileManager);
  * @param[in,out] FileManager Pointer to FileManager instance
  * @param[in] tree Target tree to navigate to
  *
- * @pre tree target is valid and accessible
+ * @pre tree is a live node of the current tree (not freed by a refresh);
+ *      holders that outlive a frame should keep a NodeHandle and use goToHandle()
  * @post treeCursor moved to tree target, currentPath updated with complete path, filesystem refreshed
  *
  * @author Farras
  */
 void goTo(FileManager* FileManager, Tree tree);
 
+/**
+ * @brief Navigates to the directory referenced by a node handle
+ *
+ * Resolves the handle in O(1) and calls goTo(). Does nothing if the node
+ * was removed since the handle was taken.
+ *
+ * @param[in,out] fm Pointer to FileManager instance
+ * @param[in] handle Handle of the target tree node
+ *
+ * @return bool false if the handle is stale
+ */
+bool goToHandle(FileManager* fm, NodeHandle handle);
+
 /**
  * @brief Gets current root directory
  *
@@ -526,8 +639,9 @@ char* getNameFromPath(char* path);
 /**
  * @brief Sorts child nodes by type
  *
- * Sorts child nodes by type using insertion sort (folders first, then files).
- * This function provides organized directory display.
+ * Stable partition of the child array by type (folders first, then files),
+ * O(n). Returns after one O(n) check when the children are already sorted,
+ * which is the common case since this runs every frame.
  *
  * @param[in,out] parent Pointer to parent node to sort children
  *
@@ -538,6 +652,52 @@ char* getNameFromPath(char* path);
  */
 void sort_children(Tree* parent);
 
+/**
+ * @brief Returns the number of directory entries read so far
+ *
+ * Counts every entry returned by readdir while loading, reloading or
+ * syncing the tree. The counter only grows; the performance overlay
+ * turns its delta into a scan rate.
+ *
+ * @return long long Entries read since startup
+ */
+long long getScannedEntryCount(void);
+
+/**
+ * @brief Per-category accounting snapshot with a reachability check
+ *
+ * reachableBytes/reachableBlocks hold what a walk of the live structures
+ * found for the categories the file manager owns (tree, strings, search);
+ * the others are -1. Live minus reachable is memory that was counted as
+ * allocated but is no longer referenced, i.e. a leak.
+ */
+typedef struct MemoryReport {
+    MemCategoryStats categories[MEM_CATEGORY_COUNT];  ///< Counters at collection time
+    long long reachableBytes[MEM_CATEGORY_COUNT];     ///< Bytes found by the walk, -1 if not checked
+    long long reachableBlocks[MEM_CATEGORY_COUNT];    ///< Blocks found by the walk, -1 if not checked
+} MemoryReport;
+
+/**
+ * @brief Collects the accounting counters and walks what is still reachable
+ *
+ * Walks the whole tree (nodes, child arrays, item strings), the trash
+ * store item strings and the search result list. O(n) in the tree size,
+ * meant for the exit report and the CLI, not for every frame.
+ *
+ * @param[in] fm Pointer to FileManager structure
+ * @param[out] report Filled snapshot
+ *
+ * @pre No background operation is modifying the tree
+ */
+void collectMemoryReport(FileManager* fm, MemoryReport* report);
+
+/**
+ * @brief Logs a report, one line per category, warning on leaked bytes
+ *
+ * @param[in] report Snapshot from collectMemoryReport()
+ */
+void logMemoryReport(const MemoryReport* report);
+
 /**
  * @brief Opens file with Windows "Open With" dialog
  *
@@ -0,0 +1,136 @@
+#ifndef FILE_PREVIEW_H
+#define FILE_PREVIEW_H
+
+#include <stdbool.h>
+#include <pthread.h>
+
+/**
+ * @file file_preview.h
+ * @brief Memory-mapped file preview with a lazily built sparse line index
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * The file is mapped read-only, never read into memory, so opening a
+ * multi-GB log costs the same as opening a small one. Text files get a
+ * background thread that scans the mapping for newlines and remembers
+ * the offset of every PREVIEW_INDEX_STRIDE-th line; any line already
+ * covered by the index is then found by scanning at most one stride
+ * forward from its checkpoint. Files that look binary are shown as hex
+ * rows of PREVIEW_HEX_BYTES bytes, which need no index at all.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define PREVIEW_INDEX_STRIDE 1024          ///< Lines between two index checkpoints
+#define PREVIEW_HEX_BYTES 16               ///< Bytes per hex row
+#define PREVIEW_SNIFF_BYTES 8192           ///< Bytes inspected to decide text or binary
+#define PREVIEW_PUBLISH_BYTES (8LL << 20)  ///< Indexer publishes progress after this many bytes
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief An open preview: the mapping and its line index
+ */
+typedef struct FilePreview {
+    char* path;                        ///< Previewed file
+    const unsigned char* data;         ///< Read-only mapping (NULL for an empty file)
+    long long size;                    ///< File size in bytes
+    bool binary;                       ///< Shown as hex rows instead of lines
+#ifdef _WIN32
+    void* fileHandle;                  ///< HANDLE of the file
+    void* mappingHandle;               ///< HANDLE of the file mapping
+#endif
+
+    pthread_t indexer;                 ///< Background newline scanner
+    bool indexerRunning;               ///< True if the thread was started
+    pthread_mutex_t lock;              ///< Guards everything below
+    pthread_cond_t progress;           ///< Signalled whenever the index grows
+    long long* checkpoints;            ///< Byte offset of line i * PREVIEW_INDEX_STRIDE
+    int checkpointCount;
+    int checkpointCapacity;
+    long long lineCount;               ///< Lines indexed so far (all lines once complete)
+    long long indexedBytes;            ///< Bytes scanned so far
+    bool complete;                     ///< Whole file indexed
+    bool cancel;                       ///< Set by closeFilePreview() to stop the scanner
+
+    long long cursorLine;              ///< Last line looked up by the reader (-1 if none)
+    long long cursorOffset;            ///< Its byte offset, so the next line needs no checkpoint scan
+} FilePreview;
+
+/*
+====================================================================
+    LIFECYCLE
+====================================================================
+*/
+
+/**
+ * @brief Maps a file and starts indexing it in the background
+ *
+ * @param[out] preview Preview to initialize
+ * @param[in] path File to open
+ * @return bool false if the file cannot be opened or mapped
+ *
+ * @post On success preview must be released with closeFilePreview()
+ */
+bool openFilePreview(FilePreview* preview, const char* path);
+
+/**
+ * @brief Stops the indexer, unmaps the file and frees the index
+ */
+void closeFilePreview(FilePreview* preview);
+
+/*
+====================================================================
+    ACCESS
+====================================================================
+*/
+
+/**
+ * @brief Rows available right now: indexed lines, or hex rows for binary files
+ *
+ * @param[out] complete Optional; true once the count is final
+ */
+long long previewRowCount(FilePreview* preview, bool* complete);
+
+/**
+ * @brief Fraction of the file scanned by the indexer (1.0 when complete)
+ */
+double previewIndexProgress(FilePreview* preview);
+
+/**
+ * @brief Blocks until a line is indexed or the index is complete
+ *
+ * @return bool true if line exists
+ */
+bool previewWaitForLine(FilePreview* preview, long long line);
+
+/**
+ * @brief Copies one text line, without its line break, for display
+ *
+ * Tabs become a space, other control bytes '.'; the copy is cut at
+ * size - 1 bytes. Costs one checkpoint lookup and a scan of less than
+ * PREVIEW_INDEX_STRIDE lines; reading the lines after the previous call
+ * in order scans only those lines. Call from one thread only.
+ *
+ * @param[out] out NUL-terminated line
+ * @return int Bytes written, or -1 if line is not indexed (yet)
+ */
+int previewTextLine(FilePreview* preview, long long line, char* out, int size);
+
+/**
+ * @brief Formats one hex row: offset, PREVIEW_HEX_BYTES hex bytes and their ASCII
+ *
+ * @param[out] out NUL-terminated row (at least 80 bytes for a full row)
+ * @return int Bytes written, or -1 if row is past the end of the file
+ */
+int previewHexRow(FilePreview* preview, long long row, char* out, int size);
+
+#endif
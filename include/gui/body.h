@@ -12,6 +12,15 @@
 
 typedef struct Context Context;
 
+#define GRID_TILE_WIDTH 96    // Lebar satu tile pada grid view
+#define GRID_TILE_HEIGHT 96   // Tinggi satu tile (thumbnail + nama)
+
+// Mode tampilan isi folder
+typedef enum BodyViewMode {
+    BODY_VIEW_DETAILS,  // Tabel detail (default)
+    BODY_VIEW_GRID      // Grid thumbnail
+} BodyViewMode;
+
 typedef struct Body {
     Rectangle panelRec;
     Rectangle panelContentRec;
@@ -20,6 +29,7 @@ typedef struct Body {
     Rectangle currentZeroPosition;
 
     bool showCheckbox;
+    BodyViewMode viewMode;
 
     bool selectedAll;
     bool previousSelectedAll;
@@ -70,6 +80,27 @@ void drawBody(Context* ctx, Body* body);
 // Created by: Farras
 void drawTableItem(Context* ctx, Body* body, Tree subTree, int index, float startX, float startY, float rowHeight, float colWidths[5]);
 
+// Prosedur draw grid view
+// Menggambar isi folder sebagai grid tile thumbnail; hanya tile di dalam panelView yang digambar dan meminta thumbnail
+// IS: Context dan Body valid, viewMode BODY_VIEW_GRID, panelRec sudah dihitung oleh updateBody
+// FS: Jumlah kolom mengikuti lebar panel, panelContentRec disesuaikan dengan jumlah baris, tile terlihat digambar dengan drawGridItem; item folder diambil lewat get_child sehingga biaya per frame sebanding dengan tile yang terlihat
+// Created by: AlpenliCloud Development Team
+void drawGridView(Context* ctx, Body* body);
+
+// Prosedur draw grid tile
+// Menggambar satu tile (thumbnail atau ikon besar, nama, checkbox) dengan handling mouse yang sama seperti baris tabel
+// IS: Tree subTree valid, tile berada (sebagian) di dalam panelView
+// FS: Background tile digambar berdasarkan status selected/focused, thumbnail diminta untuk file gambar, klik/double klik/Ctrl+klik dihandle
+// Created by: AlpenliCloud Development Team
+void drawGridItem(Context* ctx, Body* body, Tree subTree, int index, Rectangle tile);
+
+// Prosedur toggle view mode
+// Berganti antara tabel detail dan grid thumbnail
+// IS: Body valid
+// FS: viewMode berganti, panelScroll direset ke atas
+// Created by: AlpenliCloud Development Team
+void toggleBodyViewMode(Body* body);
+
 // Prosedur draw table header
 // Menggambar header table dengan checkbox select all dan label kolom
 // IS: Posisi header dan lebar kolom ditentukan oleh parameter
@@ -50,7 +50,7 @@ bool GuiTextBoxCustom(Rectangle bounds, char *icon, char *placeholder, char *inp
 
 // Prosedur show paste progress bar
 // Menampilkan modal progress bar untuk operasi paste dengan informasi progress dan item saat ini
-// IS: currentProgress, totalItems, dan currentItemName diketahui
+// IS: currentProgress, totalItems, dan currentItemName diketahui, dipanggil di antara BeginDrawing dan EndDrawing
 // FS: Modal progress ditampilkan di tengah layar dengan overlay, progress bar dengan persentase, informasi item yang sedang diproses, tombol Cancel untuk membatalkan operasi
 // Created by: Arief
 void showPasteProgressBar(int currentProgress, int totalItems, const char *currentItemName);
@@ -0,0 +1,68 @@
+#ifndef DUPLICATES_H
+#define DUPLICATES_H
+
+#include <stdbool.h>
+
+#include "duplicate_finder.h"
+
+/**
+ * @file duplicates.h
+ * @brief Duplicate scan of the current folder, reviewed in the search view (Ctrl+D)
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * The scan runs on the finder's worker threads; every frame the groups
+ * published since the last frame are appended to the search results, so
+ * the body fills in while large files are still being hashed. Copies are
+ * selected and deleted with the normal selection and trash operations.
+ * Leaving the search view (navigating or starting a search) cancels the
+ * scan.
+ */
+
+typedef struct Context Context;
+
+/**
+ * @brief Duplicate scan shown in the body
+ */
+typedef struct DuplicateView {
+    Context *ctx;
+    DuplicateFinder finder;      /**< Valid while active */
+    bool active;                 /**< A scan owns the search results */
+    int shownGroups;             /**< Groups already appended to the search results */
+} DuplicateView;
+
+/**
+ * @brief Initializes the view (no scan)
+ */
+void createDuplicateView(DuplicateView *view, Context *ctx);
+
+/**
+ * @brief Cancels any previous scan and starts one below folder
+ */
+void startDuplicateView(DuplicateView *view, Tree folder);
+
+/**
+ * @brief Appends newly found groups; cancels the scan once the search view is left
+ *
+ * Call once per frame on the main thread.
+ */
+void updateDuplicateView(DuplicateView *view);
+
+/**
+ * @brief Cancels the scan and frees its results
+ */
+void closeDuplicateView(DuplicateView *view);
+
+/**
+ * @brief Formats the progress and reclaimable total for the footer
+ *
+ * @return bool false if no scan is active (out untouched)
+ */
+bool duplicateViewStatus(DuplicateView *view, char *out, int size);
+
+/**
+ * @brief Whether a scan is active and still hashing
+ */
+bool duplicateViewScanning(DuplicateView *view);
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include "raylib.h"
+
+/**
+ * @file hud.h
+ * @brief Performance overlay drawn on top of the GUI (toggle with F3)
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Frame timings are sampled every frame, whether the overlay is shown or
+ * not. Everything else comes from counters the subsystems already keep
+ * (tree stats, index sizes, memory accounting, copy and scan totals,
+ * job queues); the overlay reads them a few times per second and never
+ * walks the tree.
+ */
+
+#define HUD_FRAME_SAMPLES 240      /**< Frames kept for the percentiles */
+#define HUD_MAX_LINES 12           /**< Text lines of the overlay */
+#define HUD_LINE_LENGTH 96         /**< Characters per line */
+
+typedef struct Context Context;
+
+/**
+ * @brief Performance overlay state
+ */
+typedef struct Hud {
+    Context *ctx;
+    bool visible;                          /**< Drawn when true */
+
+    double frameStart;                     /**< GetTime() at hudBeginFrame() */
+    double drawStart;                      /**< GetTime() at hudBeginDraw() */
+    float frameMs[HUD_FRAME_SAMPLES];      /**< Frame to frame interval */
+    float updateMs[HUD_FRAME_SAMPLES];     /**< Update phase of the frame */
+    float drawMs[HUD_FRAME_SAMPLES];       /**< Draw phase, until EndDrawing */
+    int sampleCount;                       /**< Valid samples (<= HUD_FRAME_SAMPLES) */
+    int sampleNext;                        /**< Ring position of the next sample */
+    float pendingUpdateMs;                 /**< Update time of the frame in progress */
+    float pendingDrawMs;                   /**< Draw time of the frame in progress */
+
+    double lastRefresh;                    /**< GetTime() of the last snapshot */
+    long long lastCopyBytes;               /**< Copy data bytes at the last snapshot */
+    long long lastScanned;                 /**< Scanned entries at the last snapshot */
+
+    char lines[HUD_MAX_LINES][HUD_LINE_LENGTH];  /**< Text of the last snapshot */
+    int lineCount;
+} Hud;
+
+/**
+ * @brief Initializes the overlay (hidden)
+ */
+void createHud(Hud *hud, Context *ctx);
+
+/**
+ * @brief Marks the start of a frame, before the update phase
+ *
+ * Closes the previous frame's sample with the frame interval.
+ */
+void hudBeginFrame(Hud *hud);
+
+/**
+ * @brief Marks the switch from update to draw, before BeginDrawing()
+ */
+void hudBeginDraw(Hud *hud);
+
+/**
+ * @brief Marks the end of the draw phase, right before EndDrawing()
+ */
+void hudEndDraw(Hud *hud);
+
+/**
+ * @brief Shows or hides the overlay
+ */
+void toggleHud(Hud *hud);
+
+/**
+ * @brief Draws the overlay in the top right corner if visible
+ *
+ * Refreshes the text from the subsystem counters at most four times
+ * per second. Must be called between BeginDrawing() and EndDrawing().
+ */
+void drawHud(Hud *hud);
+
+#endif
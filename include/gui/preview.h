@@ -0,0 +1,76 @@
+#ifndef PREVIEW_H
+#define PREVIEW_H
+
+#include <stdbool.h>
+#include <time.h>
+
+#include "file_preview.h"
+#include "raylib.h"
+
+/**
+ * @file preview.h
+ * @brief Preview pane for the selected file (toggle with F4)
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * The pane sits to the right of the body and shows the single selected
+ * file through a FilePreview: text files as numbered lines, binary files
+ * as hex rows. Only the rows inside the pane are read each frame, so the
+ * cost of a frame does not depend on the file size. While the line index
+ * is still being built the scrollbar covers the lines indexed so far and
+ * the header shows the progress.
+ */
+
+#define PREVIEW_PANE_RATIO 0.4f        /**< Share of the body width given to the pane */
+#define PREVIEW_PANE_LINE_LENGTH 512   /**< Bytes of a line copied for drawing */
+
+typedef struct Context Context;
+
+/**
+ * @brief Preview pane state
+ */
+typedef struct PreviewPane {
+    Context *ctx;
+    bool visible;                          /**< Drawn and given space when true */
+    Rectangle bounds;                      /**< Set by updatePreviewPane() */
+
+    FilePreview file;                      /**< Open preview, valid when fileOpen */
+    bool fileOpen;
+    char *shownPath;                       /**< File shown (or that failed to open), NULL if none */
+    time_t shownMtime;                     /**< Its modification time, a change reopens it */
+
+    long long firstRow;                    /**< Top visible row */
+    bool draggingScrollbar;                /**< Scrollbar thumb held with the mouse */
+} PreviewPane;
+
+/**
+ * @brief Initializes the pane (hidden, no file)
+ */
+void createPreviewPane(PreviewPane *pane, Context *ctx);
+
+/**
+ * @brief Shows or hides the pane; hiding it closes the file
+ */
+void togglePreviewPane(PreviewPane *pane);
+
+/**
+ * @brief Lays the pane out next to the body, follows the selection and handles scrolling
+ *
+ * Call after updateBody(), which leaves PREVIEW_PANE_RATIO of its width
+ * free while the pane is visible. Mouse wheel, PageUp/PageDown and
+ * Home/End scroll while the mouse is over the pane; dragging or clicking
+ * the scrollbar jumps directly to any indexed row.
+ */
+void updatePreviewPane(PreviewPane *pane, Context *ctx);
+
+/**
+ * @brief Draws the header and the visible rows
+ */
+void drawPreviewPane(PreviewPane *pane);
+
+/**
+ * @brief Closes the previewed file and stops its indexer
+ */
+void closePreviewPane(PreviewPane *pane);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef SHORTCUT_H
+#define SHORTCUT_H
+
+/**
+ * @file shortcut.h
+ * @brief Keyboard shortcuts of the GUI client
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ */
+
+typedef struct Context Context;
+
+/**
+ * @brief Handles keyboard shortcuts for file manager operations
+ *
+ * Processes all keyboard shortcuts for file manager operations and UI navigation
+ * using raylib input handling. Supports common operations like copy, paste, cut,
+ * refresh, and arrow key navigation.
+ *
+ * @param[in,out] ctx Context containing application state and UI components
+ *
+ * @pre Context contains valid application state and UI components
+ * @post Keyboard shortcuts are processed (Ctrl+C/V/X for copy/paste/cut, F5 for refresh,
+ *       arrow keys for navigation, F3 to toggle the performance overlay, Ctrl+G to switch
+ *       between details and grid view, F4 to show/hide the preview pane, Ctrl+D to find
+ *       duplicate files below the current folder, F9 to start/stop a profiler capture in
+ *       PROFILE=1 builds, etc.), UI state and file manager updated accordingly
+ *
+ * @note Requires raylib for input handling
+ * @warning Context parameter must be a valid pointer to initialized Context structure
+ *
+ * @author Arief
+ */
+void ShortcutKeys(Context* ctx);
+
+#endif
@@ -29,7 +29,7 @@ typedef struct Context Context;
  */
 typedef struct SidebarItem SidebarItem;
 typedef struct SidebarItem {
-    Tree tree;                  /**< Associated tree node from file manager */
+    NodeHandle handle;          /**< Handle of the associated tree node */
     bool isExpanded;           /**< Flag indicating if folder is expanded */
     SidebarItem* first_son;    /**< Pointer to first child item */
     SidebarItem* next_brother; /**< Pointer to next sibling item */
@@ -42,7 +42,7 @@ typedef struct SidebarItem {
  * and updates to preserve user interface state.
  */
 typedef struct SidebarState {
-    Tree treeNode;              /**< Associated tree node */
+    NodeHandle handle;          /**< Handle of the associated tree node */
     bool isExpanded;           /**< Expansion state to preserve */
     struct SidebarState* next; /**< Next state in linked list */
 } SidebarState;
@@ -133,9 +133,9 @@ void updateSidebar(Sidebar* sidebar, Context* ctx);
 */
 
 /**
- * @brief Creates sidebar item recursively from tree structure
+ * @brief Creates sidebar items from tree structure
  *
- * Creates SidebarItem recursively from Tree using malloc and initializes
+ * Creates SidebarItem for tree and its descendants using malloc and initializes
  * expansion state to false. Builds complete hierarchical structure.
  *
  * @param[in] tree Tree node to create sidebar item from (can be NULL)
@@ -148,10 +148,11 @@ void updateSidebar(Sidebar* sidebar, Context* ctx);
  * @post SidebarItem is created with malloc
  * @post tree is referenced in created item
  * @post isExpanded is set to false
- * @post first_son and next_brother are created recursively
+ * @post first_son and next_brother mirror the tree's children
  *
  * @note Memory is allocated using malloc for each item
- * @note Recursively processes entire tree structure
+ * @note Walks the tree with tree_iter_next(), so wide or deep trees cannot
+ *       overflow the call stack; siblings of tree are not included
  * @warning Caller is responsible for freeing allocated memory
  *
  * @see createSidebarItemWithState() for creating with preserved state
@@ -178,6 +179,7 @@ SidebarItem* crateSidebarItem(Tree tree);
  * @post Items not in stateList default to collapsed state
  *
  * @note Preserves user's expanded/collapsed preferences during rebuilds
+ * @note Built iteratively in pre-order, like crateSidebarItem()
  * @see crateSidebarItem() for basic item creation
  * @see collectSidebarState() for collecting current states
  *
@@ -198,7 +200,8 @@ SidebarItem* createSidebarItemWithState(Tree root, SidebarState* stateList);
  * @post All allocated memory is freed
  * @post item pointer is set to NULL
  *
- * @note Recursively frees entire tree structure
+ * @note Frees entire tree structure; siblings are freed in a loop, so
+ *       recursion depth is bounded by folder depth
  * @warning Ensure no references to destroyed items remain
  *
  * @see crateSidebarItem() for item creation
@@ -233,7 +236,8 @@ void collectSidebarState(SidebarItem* item, SidebarState** stateList);
  * @brief Gets expansion state for specific tree from state list
  *
  * Searches state list for expansion state of specific tree node.
- * Returns false if tree not found in state list.
+ * States are matched by node handle, so they survive subtree reloads
+ * that adopt the old handles. Returns false if tree not found in state list.
  *
  * @param[in] tree Tree node to find state for
  * @param[in] stateList List of sidebar states to search
@@ -270,6 +274,17 @@ bool getExpandedForTree(Tree tree, SidebarState* stateList);
  */
 void destroySidebarState(SidebarState* stateList);
 
+/**
+ * @brief Rebuilds sidebar items from the tree, keeping expansion states
+ *
+ * Collects the current expansion states, destroys the items and builds
+ * them again from root. Installed as the file manager's treeChanged hook.
+ *
+ * @param[in,out] sidebar Sidebar to rebuild
+ * @param[in] root Root of the file manager tree
+ */
+void rebuildSidebar(Sidebar* sidebar, Tree root);
+
 /*
 ====================================================================
     RENDERING AND DRAWING
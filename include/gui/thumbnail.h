@@ -0,0 +1,128 @@
+#ifndef THUMBNAIL_H
+#define THUMBNAIL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "hashmap.h"
+#include "item.h"
+#include "queue.h"
+#include "raylib.h"
+
+/**
+ * @file thumbnail.h
+ * @brief Background image thumbnails with an LRU texture cache
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Rows ask for a thumbnail every frame they are visible. A miss queues the
+ * file for a small pool of decoder threads, which load and downscale the
+ * image (raylib LoadImage/ImageResize) and keep the result as a PNG under
+ * .dir/thumbs, so a reopened folder decodes only the small copy. Textures
+ * can only be created on the main thread: uploadThumbnails() turns a
+ * bounded number of decoded images into textures per frame, and the
+ * cache unloads the least recently drawn ones beyond its capacity.
+ *
+ * Entries are keyed by path and modification time, so an edited image
+ * gets a new thumbnail instead of a stale one.
+ */
+
+#define THUMB_SIZE 64                  /**< Longest side of a thumbnail in pixels */
+#define THUMB_WORKERS 2                /**< Decoder threads */
+#define THUMB_CACHE_CAPACITY 256       /**< Textures kept on the GPU */
+#define THUMB_MAX_PENDING 64           /**< Queued decodes; the oldest are dropped first */
+#define THUMB_UPLOADS_PER_FRAME 4      /**< Texture uploads per frame */
+#define THUMB_MAX_SOURCE_BYTES (64L << 20)  /**< Larger images keep the generic icon */
+#define THUMB_DISK_DIR ".dir/thumbs"   /**< On-disk thumbnail cache */
+
+/**
+ * @brief Life cycle of a cache entry, changed only on the main thread
+ */
+typedef enum ThumbState {
+    THUMB_QUEUED,      /**< In the job or done queue, not drawable yet */
+    THUMB_READY,       /**< Texture on the GPU */
+    THUMB_FAILED       /**< Not decodable; the generic icon is drawn */
+} ThumbState;
+
+/**
+ * @brief One cached thumbnail
+ *
+ * Queued entries belong to the job and done queues (a decoder fills in
+ * image between the two); only ready and failed entries are on the LRU
+ * list and can be evicted.
+ */
+typedef struct ThumbEntry {
+    char *key;                   /**< "mtime:path", also the map key */
+    char *path;                  /**< Source image */
+    ThumbState state;
+    Image image;                 /**< Decoded pixels until uploaded */
+    Texture2D texture;           /**< Valid when state is THUMB_READY */
+    struct ThumbEntry *prev;     /**< More recently drawn entry */
+    struct ThumbEntry *next;     /**< Less recently drawn entry */
+} ThumbEntry;
+
+/**
+ * @brief Decoder pool and texture cache
+ */
+typedef struct ThumbnailCache {
+    HashMap byKey;               /**< key -> ThumbEntry*, main thread only */
+    ThumbEntry *mostRecent;      /**< Head of the LRU list */
+    ThumbEntry *leastRecent;     /**< Tail of the LRU list, evicted first */
+    int cached;                  /**< Entries on the LRU list */
+    int capacity;                /**< Max entries on the LRU list */
+
+    pthread_t workers[THUMB_WORKERS];
+    int workerCount;             /**< Threads started (0 = one decode per uploadThumbnails()) */
+    pthread_mutex_t lock;        /**< Guards jobs, done and stopping */
+    pthread_cond_t wake;         /**< Signalled on new jobs and on stop */
+    Queue jobs;                  /**< ThumbEntry* waiting for a decoder */
+    Queue done;                  /**< ThumbEntry* decoded, waiting for upload */
+    bool stopping;
+
+    long long uploaded;          /**< Textures created since start */
+    long long evicted;           /**< Textures unloaded by the LRU */
+} ThumbnailCache;
+
+/**
+ * @brief Initializes the cache and starts the decoder threads
+ *
+ * Needs no window; textures are only created in uploadThumbnails().
+ */
+void createThumbnailCache(ThumbnailCache *cache, int capacity);
+
+/**
+ * @brief Stops the decoders and unloads every texture
+ *
+ * Must be called before CloseWindow().
+ */
+void destroyThumbnailCache(ThumbnailCache *cache);
+
+/**
+ * @brief Whether an item should get a thumbnail (image file of sane size)
+ */
+bool isThumbnailCandidate(const Item *item);
+
+/**
+ * @brief Returns the thumbnail texture of an image, queueing it on a miss
+ *
+ * O(1). Call it only for rows that are actually on screen, so scrolling
+ * past a large folder does not queue every image in it.
+ *
+ * @return const Texture2D* Texture, or NULL while it is not ready (draw the generic icon)
+ */
+const Texture2D *requestThumbnail(ThumbnailCache *cache, const char *path, time_t mtime);
+
+/**
+ * @brief Uploads up to budget decoded thumbnails and trims the LRU
+ *
+ * Call once per frame on the main thread, outside BeginDrawing().
+ */
+void uploadThumbnails(ThumbnailCache *cache, int budget);
+
+/**
+ * @brief Decodes waiting to run or to be uploaded
+ */
+int thumbnailPending(ThumbnailCache *cache);
+
+#endif
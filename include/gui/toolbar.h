@@ -45,6 +45,7 @@ typedef struct Toolbar {
     bool isButtonPermanentDeleteClicked; /**< Flag indicating if permanent delete button was clicked */
     bool isButtonImportClicked;         /**< Flag indicating if import button was clicked */
     bool isButtonCreateItemClicked;     /**< Flag indicating if create item button was clicked */
+    bool isButtonViewClicked;           /**< Flag indicating if details/grid view toggle was clicked */
 
     // Import modal properties
     bool importClicked;        /**< Flag indicating if import operation was initiated */
@@ -113,7 +113,7 @@ typedef struct PasteItem {
  *
  * @author Maulana
  */
-Item createItem(char* name, char* path, long size, ItemType type, time_t created_at, time_t updated_at, time_t deleted_at);
+Item createItem(const char* name, const char* path, long size, ItemType type, time_t created_at, time_t updated_at, time_t deleted_at);
 
 /**
  * @brief Creates a new paste item
@@ -140,38 +140,49 @@ Item createItem(char* name, char* path, long size, ItemType type, time_t created
  */
 PasteItem createPasteItem(Item item, char* originalPath);
 
+/**
+ * @brief Creates a lookup key for searchTree() without copying strings
+ *
+ * The key borrows name and path, so it must not outlive them and must
+ * never be passed to destroyItem().
+ *
+ * @param[in] name Name to match
+ * @param[in] path Path to match
+ * @param[in] type Type of item (file or folder)
+ *
+ * @return Item Key item; only name, path and type are set
+ */
+Item createItemKey(char* name, char* path, ItemType type);
+
 /*
 ====================================================================
-    TRASH ITEM OPERATIONS
+    ITEM STRINGS
 ====================================================================
 */
 
 /**
- * @brief Searches for a trash item by original path
- *
- * Searches through the trash LinkedList to find a TrashItem with matching
- * original path using string comparison.
- *
- * @param[in] trash LinkedList containing TrashItem structures
- * @param[in] originalPath Original path to search for
+ * @brief Duplicates a string for an Item name or path
  *
- * @return TrashItem Found trash item or empty TrashItem if not found
- * @retval TrashItem Matching trash item if found
- * @retval Empty TrashItem All fields set to 0/NULL if not found or trash is empty
+ * Like strdup(), but the copy is counted in the MEM_STRINGS category.
+ * Every string stored in Item::name or Item::path must come from here
+ * (createItem() uses it) and be released with freeItemString().
  *
- * @pre trash must be a valid LinkedList
- * @pre originalPath must be a valid null-terminated string
- * @post No modification to the trash list
- *
- * @note Uses strcmp() for path comparison
- * @note Returns empty TrashItem structure if item not found
- * @warning Check returned TrashItem fields before use
+ * @param[in] text String to copy (NULL gives an empty string)
  *
- * @see LinkedList for list structure
- * @see TrashItem for trash item structure
+ * @return char* Heap copy, NULL if allocation fails
+ */
+char* itemStrdup(const char* text);
+
+/**
+ * @brief Frees a string made by itemStrdup() (NULL is ignored)
+ */
+void freeItemString(char* text);
+
+/**
+ * @brief Frees the name and path of an item and sets them to NULL
  *
- * @author Maulana
+ * @param[in,out] item Item whose strings are released (the struct itself is not freed)
  */
-TrashItem searchTrashItem(LinkedList trash, char* originalPath);
+void destroyItem(Item* item);
 
 #endif // ITEM_H
\ No newline at end of file
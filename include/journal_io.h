@@ -0,0 +1,195 @@
+#ifndef JOURNAL_IO_H
+#define JOURNAL_IO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file journal_io.h
+ * @brief Record framing shared by the append-only journals
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * A journal file starts with an 8-byte magic string followed by records.
+ * Each record is a u32 payload length, a u32 FNV-1a checksum of the
+ * payload and the payload itself. Strings inside a payload are stored as
+ * a u32 length followed by the bytes (0xFFFFFFFF encodes NULL). Integers
+ * use host byte order; the journals never leave the machine.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define JOURNAL_MAGIC_LEN 8        ///< Length of the file magic
+#define JOURNAL_RECORD_HEADER 8    ///< u32 payload length + u32 checksum
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Growable byte buffer used to encode records
+ */
+typedef struct JournalBuffer {
+    unsigned char* data;   ///< Encoded bytes
+    size_t length;         ///< Used bytes
+    size_t capacity;       ///< Allocated bytes
+} JournalBuffer;
+
+/**
+ * @brief Bounds-checked cursor over one record payload
+ *
+ * Reads past the end set ok to false and return zero/NULL, so a decoder
+ * can read every field and check ok once at the end.
+ */
+typedef struct JournalReader {
+    const unsigned char* cursor;  ///< Next unread byte
+    const unsigned char* end;     ///< End of payload
+    bool ok;                      ///< False once a read ran past the end
+} JournalReader;
+
+/**
+ * @brief Applies the records of a journal during journalOpen()
+ *
+ * @param[in] records Record area (after the magic)
+ * @param[in] length Length of the record area
+ * @param[in,out] context Caller state
+ *
+ * @return size_t Number of bytes forming complete, valid records
+ */
+typedef size_t (*JournalReplayFunction)(const unsigned char* records, size_t length, void* context);
+
+/*
+====================================================================
+    ENCODING
+====================================================================
+*/
+
+/**
+ * @brief Appends raw bytes, growing the buffer as needed
+ */
+void journalPut(JournalBuffer* buffer, const void* data, size_t length);
+
+/**
+ * @brief Appends one byte
+ */
+void journalPutU8(JournalBuffer* buffer, uint8_t value);
+
+/**
+ * @brief Appends a 64-bit integer
+ */
+void journalPutI64(JournalBuffer* buffer, int64_t value);
+
+/**
+ * @brief Appends a length-prefixed string (NULL allowed)
+ */
+void journalPutString(JournalBuffer* buffer, const char* str);
+
+/**
+ * @brief Reserves a record header; pair with journalEndRecord()
+ *
+ * @param[in,out] buffer Target buffer
+ * @param[out] headerOffset Offset of the reserved header
+ */
+void journalBeginRecord(JournalBuffer* buffer, size_t* headerOffset);
+
+/**
+ * @brief Fills in length and checksum of the record started at headerOffset
+ */
+void journalEndRecord(JournalBuffer* buffer, size_t headerOffset);
+
+/**
+ * @brief Frees buffer memory and resets it to empty
+ */
+void journalBufferFree(JournalBuffer* buffer);
+
+/*
+====================================================================
+    DECODING
+====================================================================
+*/
+
+/**
+ * @brief Reads one byte
+ */
+uint8_t journalReadU8(JournalReader* reader);
+
+/**
+ * @brief Reads a 64-bit integer
+ */
+int64_t journalReadI64(JournalReader* reader);
+
+/**
+ * @brief Reads a string into newly allocated memory
+ *
+ * @return char* Allocated string, or NULL for a stored NULL or on error
+ */
+char* journalReadString(JournalReader* reader);
+
+/**
+ * @brief Validates the record at *offset and positions a reader on its payload
+ *
+ * @param[in] records Record area
+ * @param[in] length Length of the record area
+ * @param[in,out] offset Offset of the record; advanced past it on success
+ * @param[out] payload Reader over the payload
+ *
+ * @return bool false at the end of the area or on a torn/corrupt record
+ */
+bool journalNextRecord(const unsigned char* records, size_t length, size_t* offset, JournalReader* payload);
+
+/*
+====================================================================
+    FILE OPERATIONS
+====================================================================
+*/
+
+/**
+ * @brief Opens a journal, replays it and returns an append descriptor
+ *
+ * The file is mapped read-only (read into memory on Windows) and handed to
+ * replay. A torn final record left by a crash during append is truncated.
+ * Any other damage (foreign magic, a bad record followed by more data) is
+ * never cut off: the file is renamed to path.corrupt and a new journal
+ * holding the records replayed so far takes its place.
+ *
+ * @param[in] path Journal path (created if missing)
+ * @param[in] magic 8-byte file magic
+ * @param[in] replay Record callback
+ * @param[in,out] context Passed to replay
+ *
+ * @return int O_APPEND descriptor, or -1 on failure (e.g. the file cannot be mapped)
+ */
+int journalOpen(const char* path, const char* magic, JournalReplayFunction replay, void* context);
+
+/**
+ * @brief Writes magic plus data to a new file, for compaction
+ *
+ * @return int O_APPEND descriptor of the new file (not yet synced), or -1
+ */
+int journalCreateFile(const char* path, const char* magic, const unsigned char* data, size_t length);
+
+/**
+ * @brief Writes a whole buffer, retrying on partial writes and EINTR
+ */
+bool journalWriteAll(int fd, const void* data, size_t length);
+
+/**
+ * @brief Flushes a journal descriptor to stable storage
+ */
+bool journalFlush(int fd);
+
+/**
+ * @brief Atomically replaces path with tmpPath (after tmpPath is flushed)
+ *
+ * @param[in,out] oldFd Descriptor of the file being replaced; closed on Windows before the swap
+ */
+bool journalReplaceFile(const char* tmpPath, const char* path, int* oldFd);
+
+#endif
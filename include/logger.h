@@ -0,0 +1,148 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdbool.h>
+
+/**
+ * @file logger.h
+ * @brief Leveled logging with a lock-free ring buffer and a writer thread
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Call sites format their message into a fixed-size slot of a bounded
+ * multi-producer ring and return; a single background thread drains the
+ * ring to a rotating log file under .dir. A full ring drops the message
+ * (and counts it) instead of blocking the caller.
+ *
+ * Levels below LOG_COMPILE_LEVEL are removed by the preprocessor, including
+ * their arguments, so per-entry trace logging in hot loops costs nothing
+ * in a normal build (`make LOG_LEVEL=0` keeps it). Levels below the runtime
+ * level (ALPENLI_LOG_LEVEL=trace|debug|info|warn|error|off, default info)
+ * are rejected before formatting. Warnings and errors are also echoed to
+ * stderr by the writer thread; ALPENLI_LOG_CONSOLE=1 echoes every level.
+ *
+ * Before logInit() (or after logShutdown()) messages are printed directly
+ * to stdout with the old "[LOG]" prefix.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define LOG_LEVEL_TRACE 0                    ///< Per-entry detail inside loops
+#define LOG_LEVEL_DEBUG 1                    ///< Per-operation detail
+#define LOG_LEVEL_INFO 2                     ///< Operation results
+#define LOG_LEVEL_WARN 3                     ///< Recoverable problems
+#define LOG_LEVEL_ERROR 4                    ///< Failed operations
+#define LOG_LEVEL_OFF 5                      ///< Nothing is logged
+
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG    ///< Calls below this level are compiled out
+#endif
+
+#define LOG_DEFAULT_PATH ".dir/alpenli.log"  ///< Log file used by the front-ends
+#define LOG_RING_CAPACITY 4096               ///< Slots in the ring (power of two)
+#define LOG_MESSAGE_LENGTH 240               ///< Max formatted message length per slot
+#define LOG_ROTATE_BYTES (4L << 20)          ///< Log file size that triggers rotation
+#define LOG_ROTATE_KEEP 3                    ///< Rotated files kept (.1 is the newest)
+
+/*
+=====================================================================
+    MACROS
+=====================================================================
+*/
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_TRACE
+#define logTrace(...) logWrite(LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#define logTrace(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define logDebug(...) logWrite(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define logDebug(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define logInfo(...) logWrite(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define logInfo(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#define logWarn(...) logWrite(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define logWarn(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define logError(...) logWrite(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define logError(...) ((void)0)
+#endif
+
+/*
+====================================================================
+    LIFECYCLE
+====================================================================
+*/
+
+/**
+ * @brief Opens the log file and starts the writer thread
+ *
+ * Reads ALPENLI_LOG_LEVEL and ALPENLI_LOG_CONSOLE. Calling it again while
+ * running does nothing.
+ *
+ * @param[in] path Log file; missing parent folders are created
+ *
+ * @return bool false if the file or thread could not be created (logging
+ *              then stays on stdout)
+ */
+bool logInit(const char* path);
+
+/**
+ * @brief Drains the ring, stops the writer thread and closes the file
+ */
+void logShutdown(void);
+
+/*
+====================================================================
+    LOGGING
+====================================================================
+*/
+
+/**
+ * @brief Sets the runtime level; messages below it are discarded
+ */
+void logSetLevel(int level);
+
+/**
+ * @brief Checks whether a message of this level would be recorded
+ *
+ * For call sites that do extra work only to build a log message.
+ */
+bool logEnabled(int level);
+
+/**
+ * @brief Formats a message and queues it for the writer thread
+ *
+ * Use the logTrace()..logError() macros instead so the compile-time level
+ * applies. A trailing newline in the format is optional. Safe to call from
+ * any thread.
+ */
+void logWrite(int level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Number of messages dropped because the ring was full
+ */
+long long logDroppedCount(void);
+
+/**
+ * @brief Number of messages queued and not yet written (approximate)
+ */
+int logPendingCount(void);
+
+#endif
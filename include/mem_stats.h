@@ -0,0 +1,105 @@
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <stddef.h>
+
+/**
+ * @file mem_stats.h
+ * @brief Allocation accounting by category
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Subsystems report what they allocate and free, and the totals are kept
+ * per category with atomic counters, so any thread may report and the
+ * HUD, the CLI and benchmarks can read them in O(1).
+ *
+ * Heap blocks are counted with their usable size from the allocator
+ * (malloc_usable_size, _msize or malloc_size), so a block reported with
+ * memTrackAlloc() and later memTrackFree() always balances, whatever
+ * size the caller asked for. Owners that keep their own byte count (undo
+ * history, trash store) report it with memAccount() instead.
+**/
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Accounting categories
+ */
+typedef enum MemCategory {
+    MEM_TREE,        ///< TreeNode structs and child arrays
+    MEM_STRINGS,     ///< Item name and path strings
+    MEM_SIDEBAR,     ///< SidebarItem mirror and saved expansion states
+    MEM_SEARCH,      ///< Search result list nodes
+    MEM_UNDO,        ///< Undo and redo history payloads
+    MEM_TRASH,       ///< Trash store nodes, TrashItem structs and their paths
+    MEM_CATEGORY_COUNT
+} MemCategory;
+
+/**
+ * @brief Snapshot of one category
+ */
+typedef struct MemCategoryStats {
+    long long bytes;        ///< Live bytes
+    long long blocks;       ///< Live allocations
+    long long peakBytes;    ///< Highest live bytes seen
+    long long allocations;  ///< Allocations reported since startup
+} MemCategoryStats;
+
+/*
+====================================================================
+    REPORTING
+====================================================================
+*/
+
+/**
+ * @brief Counts a freshly allocated heap block (NULL is ignored)
+ */
+void memTrackAlloc(MemCategory category, const void* block);
+
+/**
+ * @brief Uncounts a heap block; call before free() (NULL is ignored)
+ */
+void memTrackFree(MemCategory category, const void* block);
+
+/**
+ * @brief Adds a byte and block delta computed by the owner
+ *
+ * @param[in] category Category to change
+ * @param[in] bytes Bytes added (negative when released)
+ * @param[in] blocks Blocks added (negative when released)
+ */
+void memAccount(MemCategory category, long long bytes, long long blocks);
+
+/**
+ * @brief Usable size of a heap block as counted by memTrackAlloc()
+ *
+ * @return size_t 0 for NULL
+ */
+size_t memBlockSize(const void* block);
+
+/*
+====================================================================
+    QUERIES
+====================================================================
+*/
+
+/**
+ * @brief Copies the counters of one category
+ */
+void getMemStats(MemCategory category, MemCategoryStats* stats);
+
+/**
+ * @brief Sum of live bytes over all categories
+ */
+long long memTotalBytes(void);
+
+/**
+ * @brief Short lowercase name of a category ("tree", "strings", ...)
+ */
+const char* memCategoryName(MemCategory category);
+
+#endif
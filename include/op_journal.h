@@ -0,0 +1,175 @@
+#ifndef OP_JOURNAL_H
+#define OP_JOURNAL_H
+
+#include <stdbool.h>
+
+#include "item.h"
+#include "operation.h"
+#include "undo_history.h"
+
+/**
+ * @file op_journal.h
+ * @brief Write-ahead journal for file operations and the undo history
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Multi-item operations (paste, delete to trash, recover) are logged
+ * before they touch the filesystem. BEGIN opens an operation, and each item
+ * gets a STEP record naming its source and destination, flushed to disk
+ * before the item is moved or copied. STEP_DONE marks the item finished
+ * and END closes the operation. An operation without END at startup was
+ * interrupted; its unfinished steps are handed to the file manager to roll
+ * back or finish.
+ *
+ * The undo stack is persisted with PUSH (full Operation snapshot) and
+ * POP records, so replaying the journal restores the undo history.
+**/
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Record types stored in the operation journal
+ */
+typedef enum OpJournalRecord {
+    OP_JOURNAL_BEGIN = 1,      ///< Operation started
+    OP_JOURNAL_STEP = 2,       ///< Item about to be processed (intent)
+    OP_JOURNAL_STEP_DONE = 3,  ///< Last logged item finished
+    OP_JOURNAL_END = 4,        ///< Operation finished or resolved after a crash
+    OP_JOURNAL_PUSH = 5,       ///< Operation pushed on the undo stack
+    OP_JOURNAL_POP = 6         ///< Top of the undo stack popped
+} OpJournalRecord;
+
+/**
+ * @brief One logged item of an operation
+ */
+typedef struct OpJournalStep {
+    ItemType type;   ///< File or folder
+    char* src;       ///< Source path (trash path for recover)
+    char* dest;      ///< Final destination path (trash path for delete)
+    char* uid;       ///< Trash UID for delete/recover, NULL for paste
+    bool done;       ///< STEP_DONE seen
+} OpJournalStep;
+
+/**
+ * @brief Operation found without END when the journal was replayed
+ */
+typedef struct OpJournalIncomplete {
+    long long seq;            ///< Sequence number from BEGIN
+    ActionType type;          ///< ACTION_PASTE, ACTION_DELETE or ACTION_RECOVER
+    bool isCopy;              ///< Paste mode
+    OpJournalStep* steps;     ///< Logged items in order
+    int stepCount;            ///< Number of steps
+    int stepCapacity;         ///< Allocated steps
+} OpJournalIncomplete;
+
+/**
+ * @brief Open operation journal
+ */
+typedef struct OpJournal {
+    char* path;                        ///< Journal file path
+    int fd;                            ///< Append descriptor, -1 when closed
+    long long nextSeq;                 ///< Sequence number for the next BEGIN
+    long records;                      ///< Records currently in the file
+
+    OpJournalIncomplete* incomplete;   ///< Interrupted operations found on open
+    int incompleteCount;               ///< Number of interrupted operations
+} OpJournal;
+
+/*
+====================================================================
+    LIFECYCLE
+====================================================================
+*/
+
+/**
+ * @brief Opens the journal, restores the undo history and collects interrupted operations
+ *
+ * @param[out] journal Journal state to initialize
+ * @param[in] path Journal file path (created if missing)
+ * @param[in,out] undoHistory Empty undo history; receives the persisted entries
+ *
+ * @return bool false if the journal could not be opened for writing
+ *
+ * @post journal->incomplete lists operations that were interrupted
+ */
+bool openOpJournal(OpJournal* journal, const char* path, UndoHistory* undoHistory);
+
+/**
+ * @brief Flushes and closes the journal
+ */
+void closeOpJournal(OpJournal* journal);
+
+/**
+ * @brief Frees the interrupted-operation list once recovery has handled it
+ */
+void freeOpJournalIncomplete(OpJournal* journal);
+
+/**
+ * @brief Rewrites the journal with only the current undo history
+ *
+ * @param[in,out] journal Open journal with no operation in progress
+ * @param[in] undoHistory Current undo history (entries evicted by its budget are dropped)
+ *
+ * @return bool true on success
+ */
+bool opJournalCheckpoint(OpJournal* journal, const UndoHistory* undoHistory);
+
+/*
+====================================================================
+    WRITE-AHEAD RECORDS
+====================================================================
+*/
+
+/**
+ * @brief Logs the start of a multi-item operation
+ *
+ * @return long long Sequence number to pass to the other calls
+ */
+long long opJournalBegin(OpJournal* journal, ActionType type, bool isCopy);
+
+/**
+ * @brief Logs an item before it is processed and flushes the journal
+ *
+ * @param[in,out] journal Open journal
+ * @param[in] seq Operation sequence number
+ * @param[in] type Item type
+ * @param[in] src Source path
+ * @param[in] dest Final destination path
+ * @param[in] uid Trash UID or NULL
+ */
+void opJournalStep(OpJournal* journal, long long seq, ItemType type, const char* src, const char* dest, const char* uid);
+
+/**
+ * @brief Marks the last logged item of seq as finished
+ */
+void opJournalStepDone(OpJournal* journal, long long seq);
+
+/**
+ * @brief Marks operation seq as finished and flushes the journal
+ */
+void opJournalEnd(OpJournal* journal, long long seq);
+
+/*
+====================================================================
+    UNDO HISTORY
+====================================================================
+*/
+
+/**
+ * @brief Logs an operation pushed on the undo stack
+ *
+ * @param[in,out] journal Open journal
+ * @param[in] operation Operation with its PasteItem/TrashItem payload
+ */
+void opJournalPushUndo(OpJournal* journal, const Operation* operation);
+
+/**
+ * @brief Logs that the top of the undo stack was popped
+ */
+void opJournalPopUndo(OpJournal* journal);
+
+#endif
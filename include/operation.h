@@ -81,6 +81,25 @@ typedef struct Operation {
  *
  * @author Maulana
  */
-Operation createOperation(char* from, char* to, ActionType type, bool isDir, Queue* itemTemp);
+Operation createOperation(const char* from, const char* to, ActionType type, bool isDir, Queue* itemTemp);
+
+/*
+====================================================================
+    OPERATION DESTRUCTORS
+====================================================================
+*/
+
+/**
+ * @brief Frees a heap-allocated operation together with its item payload
+ *
+ * DELETE and RECOVER operations carry TrashItem*, PASTE carries PasteItem*.
+ * Every string reachable from the operation is freed, so the payload must
+ * own its strings (not share them with tree nodes or the trash store).
+ *
+ * @param[in] operation Operation to free (NULL allowed)
+ *
+ * @post operation, its paths, its queue and all queued items are freed
+ */
+void destroyOperation(Operation* operation);
 
 #endif // OPERATION_H
\ No newline at end of file
@@ -0,0 +1,124 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+
+/**
+ * @file profiler.h
+ * @brief Scoped timing zones exported as Chrome trace events
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * PROFILE_ZONE("name") at the top of a block records one complete event
+ * covering the rest of that block; PROFILE_BEGIN/PROFILE_END mark a zone
+ * that does not follow a block. Each thread appends to its own buffer, so
+ * recording takes no lock. A capture runs from profilerStart() to
+ * profilerStop() and is written with profilerExport() as trace-event JSON
+ * that chrome://tracing and Perfetto open directly.
+ *
+ * Zones exist only in builds with ALPENLI_PROFILE (`make PROFILE=1`); in
+ * other builds the macros expand to nothing and the control functions
+ * report that profiling is unavailable. Between captures a zone costs
+ * one relaxed atomic load.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define PROFILE_EVENTS_PER_THREAD (1 << 16)   ///< Events kept per thread and capture; later ones are dropped
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Open zone, lives on the caller's stack
+ */
+typedef struct ProfileZone {
+    const char* name;          ///< Static string, stored by pointer
+    long long start;           ///< Monotonic ns, 0 if not recording
+    unsigned session;          ///< Capture the zone started in
+} ProfileZone;
+
+/*
+=====================================================================
+    MACROS
+=====================================================================
+*/
+
+#ifdef ALPENLI_PROFILE
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(name) \
+    ProfileZone PROFILE_CONCAT(_profileZone, __LINE__) __attribute__((cleanup(profileZoneEnd))) = profileZoneBegin(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#define PROFILE_BEGIN(var, name) ProfileZone var = profileZoneBegin(name)
+#define PROFILE_END(var) profileZoneEnd(&(var))
+#define PROFILE_THREAD_NAME(name) profilerSetThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_BEGIN(var, name) ((void)0)
+#define PROFILE_END(var) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+/*
+====================================================================
+    CAPTURE CONTROL
+====================================================================
+*/
+
+/**
+ * @brief Checks whether zones are compiled into this build
+ */
+bool profilerAvailable(void);
+
+/**
+ * @brief Checks whether a capture is running
+ */
+bool profilerRecording(void);
+
+/**
+ * @brief Discards the previous capture and starts recording
+ *
+ * @return bool false if profiling is not compiled in
+ */
+bool profilerStart(void);
+
+/**
+ * @brief Stops recording; the capture stays available for export
+ */
+void profilerStop(void);
+
+/**
+ * @brief Writes the last capture as Chrome trace-event JSON
+ *
+ * Call after profilerStop(). Each thread appears as its own track.
+ *
+ * @param[in] path Output file
+ *
+ * @return bool false if profiling is not compiled in or the file could not be written
+ */
+bool profilerExport(const char* path);
+
+/**
+ * @brief Names the calling thread in exported traces
+ */
+void profilerSetThreadName(const char* name);
+
+/*
+====================================================================
+    ZONES (use the macros)
+====================================================================
+*/
+
+ProfileZone profileZoneBegin(const char* name);
+void profileZoneEnd(ProfileZone* zone);
+
+#endif
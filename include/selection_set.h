@@ -0,0 +1,113 @@
+#ifndef SELECTION_SET_H
+#define SELECTION_SET_H
+
+#include <stdbool.h>
+
+#include "hashmap.h"
+#include "item.h"
+
+/**
+ * @file selection_set.h
+ * @brief Selected items with O(1) membership and running totals
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Items are keyed by identity (the Item* stored in the tree, search list
+ * or trash store), so add, remove and contains never compare strings.
+ * The set keeps an ordered list for iteration, newest first, and
+ * updates count and total bytes on every change. Callers read the
+ * totals without walking the list.
+**/
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Entry of the selection list
+ */
+typedef struct SelectionNode {
+    Item* data;                   ///< Selected item (not owned)
+    long size;                    ///< Item size counted in totalBytes
+    struct SelectionNode* next;   ///< Older selection
+    struct SelectionNode* prev;   ///< Newer selection
+} SelectionNode;
+
+/**
+ * @brief Selection set
+ */
+typedef struct SelectionSet {
+    SelectionNode* head;   ///< Most recently selected item
+    HashMap index;         ///< Item* -> SelectionNode*
+    int count;             ///< Number of selected items
+    long long totalBytes;  ///< Sum of Item::size at selection time
+} SelectionSet;
+
+/*
+====================================================================
+    LIFECYCLE
+====================================================================
+*/
+
+/**
+ * @brief Initializes an empty selection
+ */
+void createSelectionSet(SelectionSet* set);
+
+/**
+ * @brief Frees all entries and the index
+ */
+void destroySelectionSet(SelectionSet* set);
+
+/*
+====================================================================
+    OPERATIONS
+====================================================================
+*/
+
+/**
+ * @brief Adds an item and sets its selected flag
+ *
+ * @return bool false if the item was already selected
+ */
+bool selectionSetAdd(SelectionSet* set, Item* item);
+
+/**
+ * @brief Removes an item and clears its selected flag
+ *
+ * @return bool false if the item was not selected
+ */
+bool selectionSetRemove(SelectionSet* set, Item* item);
+
+/**
+ * @brief Removes an item without touching it
+ *
+ * For items whose memory may already be freed.
+ *
+ * @return bool false if the item was not selected
+ */
+bool selectionSetForget(SelectionSet* set, const Item* item);
+
+/**
+ * @brief Checks whether an item is selected
+ */
+bool selectionSetContains(const SelectionSet* set, const Item* item);
+
+/**
+ * @brief Clears the selected flag of every item and empties the set
+ */
+void selectionSetClear(SelectionSet* set);
+
+/**
+ * @brief Copies the selected items into an array, newest first
+ *
+ * @param[in] set Selection
+ * @param[out] items Newly allocated array (caller frees), NULL if empty
+ *
+ * @return int Number of items in the array
+ */
+int selectionSetToArray(const SelectionSet* set, Item*** items);
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef TRASH_JOURNAL_H
+#define TRASH_JOURNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "trash_store.h"
+
+/**
+ * @file trash_journal.h
+ * @brief Append-only binary journal persisting the trash store
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Every delete-to-trash, recover and purge appends one length-prefixed,
+ * checksummed record. Records are fsynced in batches, so a crash loses at
+ * most the last unsynced batch instead of the whole trash index. At
+ * startup the journal is replayed in a single pass over an mmap of the
+ * file; a torn record at the tail is detected by its checksum and cut off.
+ *
+ * When most records are dead (ADD followed by REMOVE) the journal is
+ * rewritten in the background with only the live items.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define TRASH_JOURNAL_SYNC_BATCH 64        ///< Records appended before a forced fsync
+#define TRASH_JOURNAL_COMPACT_MIN 1024     ///< Minimum record count before compaction is considered
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Record types stored in the journal
+ */
+typedef enum TrashJournalOp {
+    TRASH_JOURNAL_ADD = 1,     ///< Item moved to trash
+    TRASH_JOURNAL_REMOVE = 2   ///< Item recovered or purged (by UID)
+} TrashJournalOp;
+
+/**
+ * @brief Open trash journal state
+ */
+typedef struct TrashJournal {
+    char* path;                 ///< Journal file path
+    int fd;                     ///< Append file descriptor, -1 when closed
+    int pendingSync;            ///< Records written since last fsync
+    long totalRecords;          ///< Records currently in the file
+    long liveRecords;           ///< Records describing items still in trash
+
+    pthread_mutex_t lock;       ///< Guards fd swap and tail buffer during compaction
+    pthread_t compactor;        ///< Background compaction thread
+    bool compacting;            ///< True while compactor runs
+    bool compactorJoinable;     ///< True if compactor must be joined
+
+    unsigned char* snapshot;    ///< Live records serialized for the compactor
+    size_t snapshotLength;      ///< Length of snapshot
+    long snapshotRecords;       ///< Number of records in snapshot
+
+    unsigned char* tail;        ///< Records appended while compaction runs
+    size_t tailLength;          ///< Used bytes in tail
+    size_t tailCapacity;        ///< Allocated bytes in tail
+    long tailRecords;           ///< Number of records in tail
+} TrashJournal;
+
+/*
+====================================================================
+    LIFECYCLE
+====================================================================
+*/
+
+/**
+ * @brief Opens the journal, replays it into store and prepares for appends
+ *
+ * @param[out] journal Journal state to initialize
+ * @param[in] path Journal file path (created if missing)
+ * @param[in,out] store Trash store receiving replayed items
+ *
+ * @return bool false if the journal file could not be opened for writing
+ *
+ * @post store contains every item whose last record is ADD
+ * @post a torn tail record (crash during append) is truncated away
+ */
+bool openTrashJournal(TrashJournal* journal, const char* path, TrashStore* store);
+
+/**
+ * @brief Syncs pending records, waits for compaction and closes the file
+ *
+ * @param[in,out] journal Journal to close
+ */
+void closeTrashJournal(TrashJournal* journal);
+
+/*
+====================================================================
+    RECORDING
+====================================================================
+*/
+
+/**
+ * @brief Appends an ADD record for an item moved to trash
+ *
+ * @param[in,out] journal Open journal
+ * @param[in] trashItem Item now in trash
+ */
+void trashJournalAppendAdd(TrashJournal* journal, const TrashItem* trashItem);
+
+/**
+ * @brief Appends a REMOVE record for an item leaving the trash
+ *
+ * @param[in,out] journal Open journal
+ * @param[in] uid UID of the item recovered or purged
+ */
+void trashJournalAppendRemove(TrashJournal* journal, const char* uid);
+
+/**
+ * @brief Fsyncs records appended since the last sync (end of a batch)
+ *
+ * @param[in,out] journal Open journal
+ */
+void trashJournalSync(TrashJournal* journal);
+
+/**
+ * @brief Rewrites the journal in the background if it is fragmented
+ *
+ * Starts compaction when the journal holds at least
+ * TRASH_JOURNAL_COMPACT_MIN records and more than half of them are dead.
+ * Live items are serialized on the calling thread; the writing, fsync and
+ * atomic rename happen on a background thread.
+ *
+ * @param[in,out] journal Open journal
+ * @param[in] store Current trash store (source of live items)
+ */
+void trashJournalMaybeCompact(TrashJournal* journal, const TrashStore* store);
+
+/**
+ * @brief Checks whether a background compaction is running
+ */
+bool trashJournalCompacting(TrashJournal* journal);
+
+/**
+ * @brief Writes a compact journal containing exactly the items in store
+ *
+ * Used for migration from the legacy CSV format. Runs synchronously.
+ *
+ * @param[in,out] journal Open journal
+ * @param[in] store Trash store to persist
+ *
+ * @return bool true on success
+ */
+bool trashJournalRewrite(TrashJournal* journal, const TrashStore* store);
+
+#endif
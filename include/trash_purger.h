@@ -0,0 +1,157 @@
+#ifndef TRASH_PURGER_H
+#define TRASH_PURGER_H
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "queue.h"
+#include "trash_store.h"
+#include "trash_journal.h"
+
+/**
+ * @file trash_purger.h
+ * @brief Trash retention policy and low-priority background purge worker
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * The UI thread decides which items exceed the retention policy (oldest
+ * first, straight from the tail of the trash store) and hands them to a
+ * single worker thread. The worker runs at idle CPU and I/O priority where
+ * the platform allows it, deletes one item at a time and sleeps between
+ * items so foreground copies and the UI keep the disk.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define TRASH_RETENTION_MAX_AGE_DAYS 30            ///< Default max age of a trash item (0 = unlimited)
+#define TRASH_RETENTION_MAX_BYTES (10LL << 30)     ///< Default max total trash size (0 = unlimited)
+#define TRASH_RETENTION_MAX_ITEMS 10000            ///< Default max number of trash items (0 = unlimited)
+#define TRASH_RETENTION_CHECK_INTERVAL 60          ///< Seconds between retention checks
+#define TRASH_RETENTION_BATCH 256                  ///< Max items handed to the worker per check
+
+#define TRASH_PURGE_BYTES_PER_SEC (32LL << 20)     ///< Worker delete throughput budget
+#define TRASH_PURGE_ITEM_DELAY_MS 20               ///< Minimum pause between purged items
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Retention limits; a limit of 0 disables that rule
+ *
+ * Defaults come from the TRASH_RETENTION_* constants and can be
+ * overridden with ALPENLI_TRASH_MAX_AGE_DAYS, ALPENLI_TRASH_MAX_MB and
+ * ALPENLI_TRASH_MAX_ITEMS.
+ */
+typedef struct TrashRetention {
+    long maxAgeSeconds;        ///< Items deleted longer ago than this are purged
+    long long maxBytes;        ///< Oldest items are purged while total size exceeds this
+    int maxItems;              ///< Oldest items are purged while count exceeds this
+} TrashRetention;
+
+/**
+ * @brief Background purge worker state
+ */
+typedef struct TrashPurger {
+    pthread_t thread;          ///< Worker thread
+    pthread_mutex_t lock;      ///< Guards jobs, failed and stopping
+    pthread_cond_t wake;       ///< Signalled when jobs arrive or on stop
+    Queue jobs;                ///< Detached TrashItem* waiting for deletion
+    Queue failed;              ///< TrashItem* whose deletion failed, waiting to go back to the store
+    TrashJournal* journal;     ///< Journal receiving REMOVE records after deletion
+    bool running;              ///< True if thread was started
+    bool stopping;             ///< Set on shutdown; worker drains without throttling
+
+    long long purgedItems;     ///< Items deleted since start
+    long long purgedBytes;     ///< Recorded bytes of items deleted since start
+} TrashPurger;
+
+/*
+====================================================================
+    RETENTION POLICY
+====================================================================
+*/
+
+/**
+ * @brief Fills retention limits from defaults and environment overrides
+ *
+ * @param[out] retention Limits to fill
+ */
+void loadTrashRetention(TrashRetention* retention);
+
+/**
+ * @brief Checks whether the trash currently violates any retention limit
+ *
+ * @param[in] retention Limits
+ * @param[in] store Trash store (oldest item is store->tail)
+ * @param[in] now Current time
+ *
+ * @return bool true if the oldest item should be purged
+ */
+bool isTrashOverRetention(const TrashRetention* retention, const TrashStore* store, time_t now);
+
+/*
+====================================================================
+    PURGE WORKER
+====================================================================
+*/
+
+/**
+ * @brief Starts the background purge worker
+ *
+ * @param[out] purger Worker state to initialize
+ * @param[in] journal Journal that receives a REMOVE record once an item is gone from disk
+ *
+ * @return bool false if the thread could not be created (purge then runs inline)
+ */
+bool startTrashPurger(TrashPurger* purger, TrashJournal* journal);
+
+/**
+ * @brief Queues a detached trash item for deletion
+ *
+ * The purger takes ownership of trashItem and frees it once its file or
+ * folder is deleted. The REMOVE journal record is written only after the
+ * deletion, so a crash before that leaves the item in trash to be purged
+ * again on the next run. If the deletion fails the item is kept and handed
+ * back by trashPurgerReclaim().
+ *
+ * @param[in,out] purger Running worker
+ * @param[in] trashItem Item already removed from the trash store
+ */
+void trashPurgerSubmit(TrashPurger* purger, TrashItem* trashItem);
+
+/**
+ * @brief Puts items whose deletion failed back into the trash store
+ *
+ * Must be called from the thread that owns the store. Reclaimed items are
+ * the oldest in trash, so the next retention check submits them again.
+ *
+ * @param[in,out] purger Worker (running or not)
+ * @param[in,out] store Trash store that takes the items back
+ *
+ * @return int Number of items put back
+ */
+int trashPurgerReclaim(TrashPurger* purger, TrashStore* store);
+
+/**
+ * @brief Number of items queued and not yet deleted
+ *
+ * @param[in] purger Worker (running or not)
+ */
+int trashPurgerPending(TrashPurger* purger);
+
+/**
+ * @brief Stops the worker after deleting the remaining queued items
+ *
+ * @param[in,out] purger Worker to stop
+ */
+void stopTrashPurger(TrashPurger* purger);
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef TRASH_STORE_H
+#define TRASH_STORE_H
+
+#include <stdbool.h>
+
+#include "item.h"
+#include "hashmap.h"
+
+/**
+ * @file trash_store.h
+ * @brief Indexed container for trash items
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Keeps every TrashItem in a doubly linked list ordered by deletion time
+ * (newest first, the order shown in the trash view) and indexes the same
+ * nodes by UID, by original path and by item address. Insert, remove and
+ * all lookups are O(1) on average.
+**/
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Node of the deletion-time ordered trash list
+ *
+ * Field names mirror Node (data/next) so list walks read the same way.
+ */
+typedef struct TrashNode {
+    TrashItem* data;          ///< Trash item stored in this node
+    struct TrashNode* next;   ///< Next (older) item
+    struct TrashNode* prev;   ///< Previous (newer) item
+    struct TrashNode* samePathNext;  ///< Older item deleted from the same original path
+    struct TrashNode* samePathPrev;  ///< Newer item deleted from the same original path
+} TrashNode;
+
+/**
+ * @brief Trash container with hash indexes
+ */
+typedef struct TrashStore {
+    TrashNode* head;          ///< Newest deleted item
+    TrashNode* tail;          ///< Oldest deleted item
+    int count;                ///< Number of items in trash
+    long long totalBytes;     ///< Sum of item sizes in trash
+    HashMap byUid;            ///< uid -> TrashNode*
+    HashMap byOriginalPath;   ///< originalPath -> newest TrashNode* (older ones chained via samePath links)
+    HashMap byItem;           ///< &trashItem->item -> TrashNode*
+} TrashStore;
+
+/*
+====================================================================
+    LIFECYCLE
+====================================================================
+*/
+
+/**
+ * @brief Initializes an empty trash store
+ *
+ * @param[out] store Store to initialize
+ */
+void createTrashStore(TrashStore* store);
+
+/**
+ * @brief Frees every node, index and TrashItem held by the store
+ *
+ * @param[in,out] store Store to destroy, left empty and reusable
+ */
+void destroyTrashStore(TrashStore* store);
+
+/**
+ * @brief Frees a TrashItem and all strings it owns
+ *
+ * @param[in] trashItem Item to free, may be NULL
+ */
+void freeTrashItem(TrashItem* trashItem);
+
+/*
+====================================================================
+    OPERATIONS
+====================================================================
+*/
+
+/**
+ * @brief Inserts a trash item keeping deletion-time order
+ *
+ * New deletions are the newest item, so the common case is a head insert.
+ * Items loaded oldest-first or newest-first are appended/prepended in O(1).
+ *
+ * @param[in,out] store Target store
+ * @param[in] trashItem Item to insert (store takes ownership); uid,
+ *                      originalPath must be set
+ *
+ * @return bool false if memory allocation failed
+ */
+bool trashStoreInsert(TrashStore* store, TrashItem* trashItem);
+
+/**
+ * @brief Detaches a trash item from the list and all indexes in O(1)
+ *
+ * The item itself is not freed; ownership goes back to the caller, which
+ * either frees it with freeTrashItem() or keeps it (e.g. in an undo record).
+ *
+ * @param[in,out] store Target store
+ * @param[in] trashItem Item to detach
+ *
+ * @return bool true if the item was in the store
+ */
+bool trashStoreRemove(TrashStore* store, TrashItem* trashItem);
+
+/**
+ * @brief Finds a trash item by UID in O(1)
+ *
+ * @return TrashItem* Item or NULL
+ */
+TrashItem* trashStoreFindByUID(const TrashStore* store, const char* uid);
+
+/**
+ * @brief Finds the most recently deleted item with the given original path in O(1)
+ *
+ * @return TrashItem* Item or NULL
+ */
+TrashItem* trashStoreFindByOriginalPath(const TrashStore* store, const char* originalPath);
+
+/**
+ * @brief Resolves an Item pointer shown in the trash view to its TrashItem in O(1)
+ *
+ * @return TrashItem* Item or NULL if item does not belong to the trash
+ */
+TrashItem* trashStoreFindByItem(const TrashStore* store, const Item* item);
+
+/**
+ * @brief Checks whether the trash is empty
+ */
+bool isTrashStoreEmpty(const TrashStore* store);
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef UNDO_HISTORY_H
+#define UNDO_HISTORY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "dll.h"
+#include "hashmap.h"
+#include "item.h"
+#include "operation.h"
+
+/**
+ * @file undo_history.h
+ * @brief Byte-bounded undo/redo history with compact, path-interned payloads
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Operations are not kept as pushed. Each one is compacted into an
+ * UndoEntry holding a flat array of UndoItem records whose strings are
+ * interned in a reference-counted pool, so the same path shared by
+ * several entries (or by path and originalPath) is stored once.
+ * Popping an entry expands it back into a regular Operation with
+ * PasteItem/TrashItem payload for the existing undo/redo handlers.
+ *
+ * When the history exceeds its byte budget the oldest entries are
+ * evicted. The newest entry is always kept.
+**/
+
+/*
+=====================================================================
+    CONSTANTS
+=====================================================================
+*/
+
+#define UNDO_HISTORY_BUDGET_BYTES (4L * 1024 * 1024)  ///< Default budget per history (4 MB)
+
+#define UNDO_FLAG_DIR 0x01      ///< Operation::isDir
+#define UNDO_FLAG_COPY 0x02     ///< Operation::isCopy
+#define UNDO_ITEM_FOLDER 0x01   ///< Item is a folder
+
+/*
+=====================================================================
+    STRUCTURES
+=====================================================================
+*/
+
+/**
+ * @brief Reference-counted string intern pool
+ */
+typedef struct PathPool {
+    HashMap map;      ///< String -> InternedPath
+    size_t bytes;     ///< Heap bytes held by interned strings
+} PathPool;
+
+/**
+ * @brief One affected item of an operation, stored compactly
+ *
+ * All strings are interned. name is NULL when it equals the last
+ * component of path.
+ */
+typedef struct UndoItem {
+    const char* path;           ///< Item path
+    const char* name;           ///< Display name, NULL if derivable from path
+    const char* originalPath;   ///< Paste source / trash original path
+    const char* trashPath;      ///< Physical trash path (DELETE/RECOVER), NULL for paste
+    const char* uid;            ///< Trash UID (DELETE/RECOVER), NULL for paste
+    long size;                  ///< Item size in bytes
+    time_t time;                ///< created_at for paste, deletedTime for trash items
+    uint8_t flags;              ///< UNDO_ITEM_* flags
+} UndoItem;
+
+/**
+ * @brief Compacted Operation
+ */
+typedef struct UndoEntry {
+    const char* from;    ///< Interned Operation::from
+    const char* to;      ///< Interned Operation::to
+    UndoItem* items;     ///< Item records, queue order
+    int itemCount;       ///< Number of items
+    uint8_t type;        ///< ActionType
+    uint8_t flags;       ///< UNDO_FLAG_* flags
+} UndoEntry;
+
+/**
+ * @brief Bounded stack of compacted operations
+ */
+typedef struct UndoHistory {
+    DoublyLinkedList entries;   ///< UndoEntry*, head is the newest
+    PathPool paths;             ///< Strings referenced by the entries
+    size_t entryBytes;          ///< Bytes of entry structs and item arrays
+    size_t budget;              ///< Max entryBytes + paths.bytes
+    long evicted;               ///< Entries dropped because of the budget
+} UndoHistory;
+
+/*
+====================================================================
+    LIFECYCLE
+====================================================================
+*/
+
+/**
+ * @brief Reads the byte budget, overridable with ALPENLI_UNDO_BUDGET_KB
+ *
+ * @return size_t Budget in bytes
+ */
+size_t loadUndoBudget(void);
+
+/**
+ * @brief Initializes an empty history
+ *
+ * @param[out] history History to initialize
+ * @param[in] budget Byte budget (0 = unbounded)
+ */
+void createUndoHistory(UndoHistory* history, size_t budget);
+
+/**
+ * @brief Frees all entries and interned strings
+ */
+void destroyUndoHistory(UndoHistory* history);
+
+/*
+====================================================================
+    STACK OPERATIONS
+====================================================================
+*/
+
+/**
+ * @brief Compacts an operation onto the top of the history
+ *
+ * The operation is copied; the caller keeps ownership. Oldest entries
+ * are evicted while the history is over budget.
+ *
+ * @param[in,out] history Target history
+ * @param[in] operation Operation with its PasteItem/TrashItem payload
+ *
+ * @return int Number of entries evicted
+ */
+int undoHistoryPush(UndoHistory* history, const Operation* operation);
+
+/**
+ * @brief Removes the newest entry and expands it into an Operation
+ *
+ * @return Operation* Newly allocated operation (free with destroyOperation()), NULL if empty
+ */
+Operation* undoHistoryPop(UndoHistory* history);
+
+/**
+ * @brief Expands an entry without removing it
+ *
+ * @return Operation* Newly allocated operation (free with destroyOperation())
+ */
+Operation* undoHistoryExpand(const UndoEntry* entry);
+
+/**
+ * @brief Checks whether the history has no entries
+ */
+bool isUndoHistoryEmpty(const UndoHistory* history);
+
+/**
+ * @brief Drops every entry
+ */
+void clearUndoHistory(UndoHistory* history);
+
+/**
+ * @brief Bytes currently used by entries and interned strings
+ */
+size_t undoHistoryBytes(const UndoHistory* history);
+
+#endif
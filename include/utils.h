@@ -3,18 +3,15 @@
 
 /**
  * @file utils.h
- * @brief Utility functions for string processing, input handling, and keyboard shortcuts
+ * @brief Utility functions for string processing, input handling and filesystem checks
  * @author AlpenliCloud Development Team
  * @date 2025
+ *
+ * Part of the core library: nothing here depends on raylib, so the CLI and
+ * other headless clients can link it. Keyboard shortcuts live in gui/shortcut.h.
  */
 
- /*
- ====================================================================
-     FORWARD DECLARATIONS
- ====================================================================
- */
-
-typedef struct Context Context;
+#include <stdbool.h>
 
 /*
 ====================================================================
@@ -79,28 +76,50 @@ void toLowerStr(char* str);
 
 /*
 ====================================================================
-    KEYBOARD SHORTCUTS AND NAVIGATION
+    FILESYSTEM AND FORMATTING
 ====================================================================
 */
 
 /**
- * @brief Handles keyboard shortcuts for file manager operations
+ * @brief Formats text into a rotating static buffer
+ *
+ * Replacement for raylib's TextFormat() in the core library. Results live
+ * in one of four static buffers, so a returned string stays valid for the
+ * next three calls only; strdup() it to keep it longer.
+ *
+ * @param[in] format printf-style format string
  *
- * Processes all keyboard shortcuts for file manager operations and UI navigation
- * using raylib input handling. Supports common operations like copy, paste, cut,
- * refresh, and arrow key navigation.
+ * @return const char* Formatted text (truncated at 4095 bytes)
+ *
+ * @warning Not thread-safe; call from the UI/CLI thread only
+ */
+const char* formatText(const char* format, ...);
+
+/**
+ * @brief Checks whether a file or directory exists
  *
- * @param[in,out] ctx Context containing application state and UI components
+ * @param[in] path Path to check
  *
- * @pre Context contains valid application state and UI components
- * @post Keyboard shortcuts are processed (Ctrl+C/V/X for copy/paste/cut, F5 for refresh,
- *       arrow keys for navigation, etc.), UI state and file manager updated accordingly
+ * @return bool true if path exists (file or directory)
+ */
+bool fileExists(const char* path);
+
+/**
+ * @brief Checks whether path exists and is a directory
+ *
+ * @param[in] path Path to check
+ *
+ * @return bool true if path is a directory
+ */
+bool directoryExists(const char* path);
+
+/**
+ * @brief Creates a directory and any missing parents
  *
- * @note Requires raylib for input handling
- * @warning Context parameter must be a valid pointer to initialized Context structure
+ * @param[in] path Directory to create
  *
- * @author Arief
+ * @return int 0 if the directory exists afterwards, -1 otherwise
  */
-void ShortcutKeys(Context* ctx);
+int makeDirectory(const char* path);
 
-#endif
\ No newline at end of file
+#endif
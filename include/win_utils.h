@@ -39,14 +39,15 @@ typedef enum {
  * @brief Recursively removes directory and all its contents
  *
  * Performs recursive deletion of a directory including all subdirectories
- * and files contained within. Uses Windows-specific APIs for efficient
- * file system operations.
+ * and files contained within. Uses Windows-specific APIs on Windows; on
+ * other platforms delegates to removeTreeParallel() (fd-relative, thread
+ * pool) and logs the items/second achieved.
  *
  * @param[in] folderPath Path to the folder to be removed
  *
  * @return int Status code
- * @retval 0 Success - folder and all contents removed
- * @retval -1 Failure - operation failed (insufficient permissions, folder in use, etc.)
+ * @retval 1 Success - folder and all contents removed
+ * @retval 0 Failure - operation failed (insufficient permissions, folder in use, etc.)
  *
  * @pre folderPath must be a valid directory path
  * @post Directory and all contents are permanently deleted from file system
@@ -0,0 +1,623 @@
+/**
+ * @file alpenli.c
+ * @brief Headless command-line front-end of AlpenliCloud
+ * @author AlpenliCloud Development Team
+ * @date 2025
+ *
+ * Drives the same core library as the GUI (libalpenli) without a window,
+ * so file operations can be scripted, benchmarked and profiled. Paths are
+ * relative to the virtual root (".dir/root"); "root/" prefixes are
+ * accepted. Operations go through the normal journal, so undo works
+ * across invocations and with the GUI. The redo stack is not journaled:
+ * redo only sees operations undone in the same process (e.g. one batch).
+ *
+ * `alpenli --trace out.json <command>` records the run (tree load
+ * included) as a Chrome trace in PROFILE=1 builds.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "duplicate_finder.h"
+#include "file_manager.h"
+#include "file_preview.h"
+#include "logger.h"
+#include "nbtree.h"
+#include "profiler.h"
+#include "utils.h"
+
+#define ROOT ".dir/root"
+#define CLI_LINE_LENGTH 4096
+#define CLI_MAX_ARGS 64
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+/**
+ * @brief Totals collected by the scan command
+ */
+typedef struct ScanStats {
+    long long files;
+    long long folders;
+    long long bytes;
+    int maxDepth;
+} ScanStats;
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static int _run(FileManager* fm, int argc, char** argv);                 // Dispatch satu command
+static int _runBatch(FileManager* fm, const char* path);                  // Jalankan command per baris
+static Tree _resolve(FileManager* fm, const char* path);                  // Path CLI -> node tree
+static bool _selectPaths(FileManager* fm, int count, char** paths);       // Pilih node untuk operasi
+static bool _countNode(Tree node, int depth, void* context);              // Visitor scan
+static int _cmdScan(FileManager* fm, int argc, char** argv);              // scan [path]
+static int _cmdSearch(FileManager* fm, int argc, char** argv);            // search <keyword> [path]
+static int _cmdTransfer(FileManager* fm, int argc, char** argv, bool isCopy); // copy/move
+static int _cmdTrash(FileManager* fm, int argc, char** argv);             // trash <path>...
+static int _cmdRestore(FileManager* fm, int argc, char** argv);           // restore <path>...
+static int _cmdHistory(FileManager* fm, int argc, char** argv, bool isUndo); // undo/redo [n]
+static int _cmdMem(FileManager* fm);                                      // mem
+static int _cmdPreview(FileManager* fm, int argc, char** argv);           // preview <path> [line] [count]
+static int _cmdDupes(FileManager* fm, int argc, char** argv);             // dupes [path] [workers]
+static void _usage(void);                                                 // Cetak bantuan
+
+/*
+================================================================================
+    ENTRY POINT
+================================================================================
+*/
+
+int main(int argc, char** argv) {
+    const char* tracePath = NULL;
+    if (argc > 2 && strcmp(argv[1], "--trace") == 0) {
+        tracePath = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc < 2) {
+        _usage();
+        return 2;
+    }
+
+    logInit(LOG_DEFAULT_PATH);
+    PROFILE_THREAD_NAME("main");
+    if (tracePath != NULL) {
+        profilerStart();
+    }
+    FileManager fileManager;
+    createFileManager(&fileManager);
+    initFileManager(&fileManager);
+
+    int status = _run(&fileManager, argc - 1, argv + 1);
+
+    stopTrashPurger(&fileManager.trashPurger);
+    trashPurgerReclaim(&fileManager.trashPurger, &fileManager.trash);
+    saveTrashToFile(&fileManager);
+    closeTrashJournal(&fileManager.trashJournal);
+    opJournalCheckpoint(&fileManager.opJournal, &fileManager.undo);
+    closeOpJournal(&fileManager.opJournal);
+
+    MemoryReport report;
+    collectMemoryReport(&fileManager, &report);
+    logMemoryReport(&report);
+
+    if (tracePath != NULL && profilerRecording()) {
+        profilerStop();
+        profilerExport(tracePath);
+    }
+    logShutdown();
+    return status;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Dispatches one command
+ *
+ * @return int 0 on success, 1 on failure, 2 on usage error
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _run(FileManager* fm, int argc, char** argv) {
+    const char* cmd = argv[0];
+
+    if (strcmp(cmd, "scan") == 0) return _cmdScan(fm, argc, argv);
+    if (strcmp(cmd, "search") == 0) return _cmdSearch(fm, argc, argv);
+    if (strcmp(cmd, "copy") == 0) return _cmdTransfer(fm, argc, argv, true);
+    if (strcmp(cmd, "move") == 0) return _cmdTransfer(fm, argc, argv, false);
+    if (strcmp(cmd, "trash") == 0) return _cmdTrash(fm, argc, argv);
+    if (strcmp(cmd, "restore") == 0) return _cmdRestore(fm, argc, argv);
+    if (strcmp(cmd, "undo") == 0) return _cmdHistory(fm, argc, argv, true);
+    if (strcmp(cmd, "redo") == 0) return _cmdHistory(fm, argc, argv, false);
+    if (strcmp(cmd, "mem") == 0) return _cmdMem(fm);
+    if (strcmp(cmd, "preview") == 0) return _cmdPreview(fm, argc, argv);
+    if (strcmp(cmd, "dupes") == 0) return _cmdDupes(fm, argc, argv);
+    if (strcmp(cmd, "trash-list") == 0) {
+        printTrash(&fm->trash);
+        return 0;
+    }
+    if (strcmp(cmd, "batch") == 0) {
+        if (argc != 2) {
+            _usage();
+            return 2;
+        }
+        return _runBatch(fm, argv[1]);
+    }
+
+    fprintf(stderr, "alpenli: command tidak dikenal: %s\n", cmd);
+    _usage();
+    return 2;
+}
+
+/**
+ * @brief Runs one command per line from a file ("-" for stdin)
+ *
+ * Lines are split on whitespace; empty lines and lines starting with '#'
+ * are skipped. The file manager is loaded once for the whole batch.
+ *
+ * @return int Number of failed commands (0 if all succeeded)
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _runBatch(FileManager* fm, const char* path) {
+    FILE* file = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "alpenli: gagal membuka %s\n", path);
+        return 1;
+    }
+
+    char line[CLI_LINE_LENGTH];
+    int failed = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char* args[CLI_MAX_ARGS];
+        int count = 0;
+        for (char* tok = strtok(line, " \t\r\n"); tok != NULL && count < CLI_MAX_ARGS; tok = strtok(NULL, " \t\r\n")) {
+            args[count++] = tok;
+        }
+        if (count == 0 || args[0][0] == '#') {
+            continue;
+        }
+        // Batch bersarang tidak diizinkan
+        if (strcmp(args[0], "batch") == 0) {
+            fprintf(stderr, "alpenli: batch bersarang diabaikan\n");
+            failed++;
+            continue;
+        }
+        if (_run(fm, count, args) != 0) {
+            failed++;
+        }
+    }
+
+    if (file != stdin) {
+        fclose(file);
+    }
+    return failed > 0 ? 1 : 0;
+}
+
+/**
+ * @brief Resolves a CLI path ("docs/a.txt", "root/docs", "." for root) to its tree node
+ *
+ * @internal
+ * @since 1.0
+ */
+static Tree _resolve(FileManager* fm, const char* path) {
+    if (path == NULL || strcmp(path, ".") == 0 || strcmp(path, "root") == 0 || strcmp(path, "/") == 0) {
+        return fm->root;
+    }
+    while (*path == '/') {
+        path++;
+    }
+    if (strncmp(path, "root/", 5) == 0) {
+        path += 5;
+    }
+
+    char* fullPath = strdup(formatText("%s/%s", ROOT, path));
+    trimTrailingSlash(fullPath);
+    Tree node = searchTree(fm->root,
+        createItemKey(getNameFromPath(fullPath), fullPath, ITEM_FILE));
+    free(fullPath);
+
+    if (node == NULL) {
+        fprintf(stderr, "alpenli: tidak ditemukan: %s\n", path);
+    }
+    return node;
+}
+
+/**
+ * @brief Replaces the selection with the nodes named by paths
+ *
+ * @return bool false if any path does not resolve
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _selectPaths(FileManager* fm, int count, char** paths) {
+    clearSelectedFile(fm);
+    for (int i = 0; i < count; i++) {
+        Tree node = _resolve(fm, paths[i]);
+        if (node == NULL || node == fm->root) {
+            clearSelectedFile(fm);
+            return false;
+        }
+        selectFile(fm, &node->item);
+    }
+    return true;
+}
+
+/**
+ * @brief tree_walk visitor accumulating ScanStats
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _countNode(Tree node, int depth, void* context) {
+    ScanStats* stats = context;
+    if (node->item.type == ITEM_FOLDER) {
+        stats->folders++;
+    }
+    else {
+        stats->files++;
+        stats->bytes += node->item.size;
+    }
+    if (depth > stats->maxDepth) {
+        stats->maxDepth = depth;
+    }
+    return true;
+}
+
+/**
+ * @brief scan [path]: counts files, folders and bytes below a folder
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdScan(FileManager* fm, int argc, char** argv) {
+    Tree node = _resolve(fm, argc > 1 ? argv[1] : NULL);
+    if (node == NULL) {
+        return 1;
+    }
+
+    ScanStats stats = { 0 };
+    if (!tree_walk(node, TREE_PRE_ORDER, _countNode, &stats)) {
+        fprintf(stderr, "alpenli: scan gagal (memori)\n");
+        return 1;
+    }
+    printf("%s: %lld folder, %lld file, %lld byte, kedalaman %d\n",
+        node->item.path, stats.folders, stats.files, stats.bytes, stats.maxDepth);
+    return 0;
+}
+
+/**
+ * @brief search <keyword> [path]: prints matching items below a folder
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdSearch(FileManager* fm, int argc, char** argv) {
+    if (argc < 2) {
+        _usage();
+        return 2;
+    }
+    Tree node = _resolve(fm, argc > 2 ? argv[2] : NULL);
+    if (node == NULL) {
+        return 1;
+    }
+
+    goTo(fm, node);
+    searchingTreeItem(fm, argv[1]);
+
+    int found = 0;
+    for (Node* curr = fm->searchingList.head; curr != NULL; curr = curr->next) {
+        Item* item = curr->data;
+        printf("%s\n", item->path);
+        found++;
+    }
+    printf("%d item ditemukan\n", found);
+    return 0;
+}
+
+/**
+ * @brief copy|move <source>... <destFolder>
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdTransfer(FileManager* fm, int argc, char** argv, bool isCopy) {
+    if (argc < 3) {
+        _usage();
+        return 2;
+    }
+    Tree dest = _resolve(fm, argv[argc - 1]);
+    if (dest == NULL || dest->item.type != ITEM_FOLDER) {
+        fprintf(stderr, "alpenli: tujuan harus folder: %s\n", argv[argc - 1]);
+        return 1;
+    }
+    if (!_selectPaths(fm, argc - 2, argv + 1)) {
+        return 1;
+    }
+
+    if (isCopy) {
+        copyFile(fm);
+    }
+    else {
+        cutFile(fm);
+    }
+    goTo(fm, dest);
+    int pasted = pasteFile(fm, true);
+    clearSelectedFile(fm);
+    const CopyStats* stats = &fm->lastPasteStats;
+    if (stats->filesCopied > 0) {
+        // Move dalam satu filesystem cukup rename, tidak ada data yang disalin
+        printf("%lld file, %lld byte logis, %lld byte teralokasi, %lld byte hole dipertahankan\n",
+            stats->filesCopied, stats->logicalBytes, stats->allocatedBytes, stats->sparseBytes);
+    }
+    if (pasted < argc - 2) {
+        fprintf(stderr, "alpenli: %d dari %d item gagal di%s\n", argc - 2 - pasted, argc - 2, isCopy ? "salin" : "pindahkan");
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief trash <path>...: moves items to the trash
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdTrash(FileManager* fm, int argc, char** argv) {
+    if (argc < 2) {
+        _usage();
+        return 2;
+    }
+    Item** items = malloc(sizeof(Item*) * (argc - 1));
+    if (items == NULL) {
+        return 1;
+    }
+
+    int count = 0;
+    for (int i = 1; i < argc; i++) {
+        Tree node = _resolve(fm, argv[i]);
+        if (node == NULL || node == fm->root) {
+            free(items);
+            return 1;
+        }
+        items[count++] = &node->item;
+    }
+
+    int deleted = deleteItems(fm, items, count, true);
+    free(items);
+    printf("%d item dipindahkan ke trash\n", deleted);
+    return deleted == count ? 0 : 1;
+}
+
+/**
+ * @brief restore <originalPath>...: recovers the newest trash entry of each path
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdRestore(FileManager* fm, int argc, char** argv) {
+    if (argc < 2) {
+        _usage();
+        return 2;
+    }
+
+    clearSelectedFile(fm);
+    for (int i = 1; i < argc; i++) {
+        const char* path = argv[i];
+        while (*path == '/') {
+            path++;
+        }
+        if (strncmp(path, "root/", 5) == 0) {
+            path += 5;
+        }
+        TrashItem* trashItem = trashStoreFindByOriginalPath(&fm->trash, formatText("%s/%s", ROOT, path));
+        if (trashItem == NULL) {
+            fprintf(stderr, "alpenli: tidak ada di trash: %s\n", argv[i]);
+            clearSelectedFile(fm);
+            return 1;
+        }
+        selectFile(fm, &trashItem->item);
+    }
+
+    recoverFile(fm);
+    clearSelectedFile(fm);
+    return 0;
+}
+
+/**
+ * @brief undo|redo [n]: replays the history n times (default 1)
+ *
+ * Redo fails once the redo stack is empty; it is not persisted, so an undo
+ * from an earlier invocation cannot be redone.
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdHistory(FileManager* fm, int argc, char** argv, bool isUndo) {
+    int times = argc > 1 ? atoi(argv[1]) : 1;
+    if (times < 1) {
+        _usage();
+        return 2;
+    }
+    for (int i = 0; i < times; i++) {
+        if (isUndo) {
+            undo(fm);
+        }
+        else {
+            if (isUndoHistoryEmpty(&fm->redo)) {
+                fprintf(stderr, "alpenli: tidak ada yang bisa di-redo; redo hanya berlaku dalam satu sesi (gunakan batch)\n");
+                return 1;
+            }
+            redo(fm);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief mem: prints the memory accounting table with the leak check
+ *
+ * In a batch the table reflects every command run so far, so repeating
+ * a cycle of commands and calling mem in between shows the growth.
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdMem(FileManager* fm) {
+    MemoryReport report;
+    collectMemoryReport(fm, &report);
+
+    printf("%-8s %12s %8s %12s %12s %12s\n", "kategori", "bytes", "blok", "peak", "terjangkau", "leak");
+    for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+        const MemCategoryStats* stats = &report.categories[i];
+        printf("%-8s %12lld %8lld %12lld", memCategoryName((MemCategory)i),
+            stats->bytes, stats->blocks, stats->peakBytes);
+        if (report.reachableBytes[i] < 0) {
+            printf(" %12s %12s\n", "-", "-");
+        }
+        else {
+            printf(" %12lld %12lld\n", report.reachableBytes[i], stats->bytes - report.reachableBytes[i]);
+        }
+    }
+    printf("total    %12lld\n", memTotalBytes());
+    return 0;
+}
+
+/**
+ * @brief preview <path> [line] [count]: prints count rows starting at a 1-based row
+ *
+ * Uses the same mapped, lazily indexed preview as the GUI pane, so only
+ * the file up to the requested line is scanned before it is printed.
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdPreview(FileManager* fm, int argc, char** argv) {
+    if (argc < 2) {
+        _usage();
+        return 2;
+    }
+    Tree node = _resolve(fm, argv[1]);
+    if (node == NULL) {
+        return 1;
+    }
+    if (node->item.type != ITEM_FILE) {
+        fprintf(stderr, "alpenli: %s bukan file\n", node->item.path);
+        return 1;
+    }
+    long long first = argc > 2 ? atoll(argv[2]) - 1 : 0;
+    long long count = argc > 3 ? atoll(argv[3]) : 20;
+    if (first < 0 || count < 0) {
+        _usage();
+        return 2;
+    }
+
+    FilePreview preview;
+    if (!openFilePreview(&preview, node->item.path)) {
+        fprintf(stderr, "alpenli: preview gagal: %s\n", node->item.path);
+        return 1;
+    }
+
+    char line[CLI_LINE_LENGTH];
+    for (long long row = first; row < first + count; row++) {
+        if (!previewWaitForLine(&preview, row)) {
+            break;
+        }
+        int length = preview.binary ? previewHexRow(&preview, row, line, sizeof(line))
+                                    : previewTextLine(&preview, row, line, sizeof(line));
+        if (length < 0) {
+            break;
+        }
+        if (preview.binary) {
+            printf("%s\n", line);
+        }
+        else {
+            printf("%8lld  %s\n", row + 1, line);
+        }
+    }
+    closeFilePreview(&preview);
+    return 0;
+}
+
+/**
+ * @brief dupes [path] [workers]: prints groups of identical files as they are found
+ *
+ * Each group lists the suggested keeper first, then the copies marked
+ * with '-'. The totals at the end come from the finder's counters.
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _cmdDupes(FileManager* fm, int argc, char** argv) {
+    Tree node = _resolve(fm, argc > 1 ? argv[1] : NULL);
+    if (node == NULL) {
+        return 1;
+    }
+    DuplicateFinder finder;
+    if (!startDuplicateFinder(&finder, node, argc > 2 ? atoi(argv[2]) : 0)) {
+        fprintf(stderr, "alpenli: pencarian duplikat gagal (memori)\n");
+        return 1;
+    }
+
+    int shown = 0;
+    while (true) {
+        int available = waitForDuplicateGroups(&finder, shown);
+        for (; shown < available; shown++) {
+            const DuplicateGroup* group = getDuplicateGroup(&finder, shown);
+            printf("%d x %lld byte, %lld byte bisa dihemat\n", group->count, group->size, group->reclaimableBytes);
+            for (int i = 0; i < group->count; i++) {
+                printf("  %c %s\n", i == 0 ? '+' : '-', group->files[i]->path);
+            }
+        }
+        DuplicateStats stats;
+        getDuplicateStats(&finder, &stats);
+        if (stats.done && shown == stats.groups) {
+            printf("%d grup, %lld file duplikat, %lld byte bisa dihemat\n",
+                stats.groups, stats.duplicateFiles, stats.reclaimableBytes);
+            printf("%lld file, %lld kandidat ukuran, %lld kandidat isi, %lld byte dibaca\n",
+                stats.files, stats.sizeCandidates, stats.edgeCandidates, stats.bytesRead);
+            break;
+        }
+    }
+    destroyDuplicateFinder(&finder);
+    return 0;
+}
+
+/**
+ * @brief Prints the command summary to stderr
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _usage(void) {
+    fprintf(stderr,
+        "Usage: alpenli [--trace out.json] <command> [args]\n"
+        "  scan [path]                   Hitung folder, file dan ukuran\n"
+        "  search <keyword> [path]       Cari item di bawah folder\n"
+        "  copy <src>... <destFolder>    Salin item\n"
+        "  move <src>... <destFolder>    Pindahkan item\n"
+        "  trash <path>...               Pindahkan item ke trash\n"
+        "  trash-list                    Tampilkan isi trash\n"
+        "  restore <originalPath>...     Kembalikan item dari trash\n"
+        "  undo [n] | redo [n]           Batalkan / ulangi operasi (redo: sesi yang sama)\n"
+        "  mem                           Tampilkan pemakaian memori per kategori\n"
+        "  preview <path> [line] [count] Tampilkan baris (atau hex) mulai dari line\n"
+        "  dupes [path] [workers]        Cari file duplikat di bawah folder\n"
+        "  batch <file|->                Jalankan command per baris\n"
+        "Path relatif terhadap root (" ROOT "), contoh: docs/a.txt\n");
+}
@@ -0,0 +1,559 @@
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#endif
+
+#include "copy_engine.h"
+#include "logger.h"
+#include "profiler.h"
+
+#define COPY_BUFFER_SIZE (256 * 1024)
+
+#ifndef PATH_MAX
+#define PATH_MAX 4096
+#endif
+
+#ifdef _WIN32
+#define lstat stat
+#endif
+
+// Total seluruh proses, dibaca oleh HUD untuk throughput
+static atomic_llong totalFiles = 0;
+static atomic_llong totalLogicalBytes = 0;
+static atomic_llong totalAllocatedBytes = 0;
+static atomic_llong totalDataBytes = 0;
+static atomic_llong totalSparseBytes = 0;
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static bool _moveFileAcross(const char* srcPath, const char* destPath, CopyStats* stats);  // Copy, verify, unlink one file
+static bool _moveFolderAcross(const char* srcPath, const char* destPath, CopyStats* stats);  // Depth-first folder move
+static int _makeDir(const char* path);  // Portable mkdir
+static bool _syncFile(const char* path);  // Flush file data to disk
+static bool _sameContents(const char* pathA, const char* pathB);  // Byte-wise file comparison
+static void _countFile(long long logicalBytes, long long allocatedBytes);  // Add one file to the totals
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+static bool _copyRange(int srcFd, int destFd, off_t offset, off_t length, char* buffer, long long* copied);  // Copy one data extent
+#else
+static bool _copyBuffered(const char* srcPath, const char* destPath, CopyStats* stats);  // Portable stdio copy
+#endif
+
+/*
+================================================================================
+    PUBLIC FUNCTIONS
+================================================================================
+*/
+
+void resetCopyStats(CopyStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(CopyStats));
+}
+
+void getCopyTotals(CopyStats* totals) {
+    totals->filesCopied = atomic_load_explicit(&totalFiles, memory_order_relaxed);
+    totals->logicalBytes = atomic_load_explicit(&totalLogicalBytes, memory_order_relaxed);
+    totals->allocatedBytes = atomic_load_explicit(&totalAllocatedBytes, memory_order_relaxed);
+    totals->dataBytes = atomic_load_explicit(&totalDataBytes, memory_order_relaxed);
+    totals->sparseBytes = atomic_load_explicit(&totalSparseBytes, memory_order_relaxed);
+}
+
+bool copyFileSparse(const char* srcPath, const char* destPath, CopyStats* stats) {
+    PROFILE_FUNCTION();
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    int srcFd = open(srcPath, O_RDONLY);
+    if (srcFd < 0) {
+        logError("Gagal membuka file source: %s (Error: %d)\n", srcPath, errno);
+        return false;
+    }
+
+    struct stat srcStat;
+    if (fstat(srcFd, &srcStat) != 0) {
+        close(srcFd);
+        return false;
+    }
+
+    int destFd = open(destPath, O_WRONLY | O_CREAT | O_TRUNC, srcStat.st_mode & 0777);
+    if (destFd < 0) {
+        logError("Gagal membuat file tujuan: %s (Error: %d)\n", destPath, errno);
+        close(srcFd);
+        return false;
+    }
+
+    char* buffer = malloc(COPY_BUFFER_SIZE);
+    if (buffer == NULL) {
+        close(srcFd);
+        close(destFd);
+        return false;
+    }
+
+    off_t logicalSize = srcStat.st_size;
+    off_t position = 0;
+    long long copied = 0;
+    bool ok = true;
+
+    while (position < logicalSize) {
+        off_t dataStart = lseek(srcFd, position, SEEK_DATA);
+        if (dataStart < 0) {
+            if (errno == ENXIO) {
+                // Sisa file adalah hole, cukup di-extend dengan ftruncate
+                break;
+            }
+            // Filesystem tidak mendukung SEEK_DATA, salin sisanya sebagai data
+            dataStart = position;
+        }
+
+        off_t holeStart = lseek(srcFd, dataStart, SEEK_HOLE);
+        if (holeStart < 0 || holeStart > logicalSize) {
+            holeStart = logicalSize;
+        }
+
+        if (!_copyRange(srcFd, destFd, dataStart, holeStart - dataStart, buffer, &copied)) {
+            logError("Gagal menyalin data %s (Error: %d)\n", srcPath, errno);
+            ok = false;
+            break;
+        }
+        position = holeStart;
+    }
+
+    // Recreate trailing hole (dan pastikan ukuran logis sama persis)
+    if (ok && ftruncate(destFd, logicalSize) != 0) {
+        logError("Gagal mengatur ukuran file tujuan: %s (Error: %d)\n", destPath, errno);
+        ok = false;
+    }
+
+    struct stat destStat;
+    if (ok && fstat(destFd, &destStat) == 0) {
+        long long allocatedBytes = (long long)destStat.st_blocks * 512LL;
+        _countFile((long long)logicalSize, allocatedBytes);
+        if (stats != NULL) {
+            stats->filesCopied++;
+            stats->logicalBytes += (long long)logicalSize;
+            stats->allocatedBytes += allocatedBytes;
+            stats->dataBytes += copied;
+            // Pembulatan blok bisa membuat allocated > logical pada file kecil
+            if ((long long)logicalSize > allocatedBytes) {
+                stats->sparseBytes += (long long)logicalSize - allocatedBytes;
+            }
+        }
+    }
+
+    free(buffer);
+    close(srcFd);
+    if (close(destFd) != 0) {
+        ok = false;
+    }
+    return ok;
+#else
+    return _copyBuffered(srcPath, destPath, stats);
+#endif
+}
+
+bool moveAcrossFilesystems(const char* srcPath, const char* destPath, CopyStats* stats) {
+    PROFILE_FUNCTION();
+    struct stat st;
+    if (stat(srcPath, &st) != 0) {
+        logWarn("Source tidak ditemukan untuk move: %s\n", srcPath);
+        return false;
+    }
+
+    logDebug("Move lintas filesystem: %s -> %s\n", srcPath, destPath);
+    if (S_ISDIR(st.st_mode)) {
+        return _moveFolderAcross(srcPath, destPath, stats);
+    }
+    return _moveFileAcross(srcPath, destPath, stats);
+}
+
+char* formatCopySize(long long bytes, char* buffer, int bufferSize) {
+    if (bytes >= 1024LL * 1024 * 1024) {
+        snprintf(buffer, bufferSize, "%.2f GB", bytes / (1024.0 * 1024.0 * 1024.0));
+    }
+    else if (bytes >= 1024LL * 1024) {
+        snprintf(buffer, bufferSize, "%.2f MB", bytes / (1024.0 * 1024.0));
+    }
+    else if (bytes >= 1024LL) {
+        snprintf(buffer, bufferSize, "%.2f KB", bytes / 1024.0);
+    }
+    else {
+        snprintf(buffer, bufferSize, "%lld B", bytes);
+    }
+    return buffer;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Moves a single file: copy, verify, sync, then unlink the source
+ *
+ * A destination left behind by an interrupted move is only reused if its
+ * contents match the source byte for byte; otherwise it is copied again.
+ * The destination is synced to disk before the source is unlinked, so a
+ * crash can never leave the data in neither place.
+ *
+ * @param[in] srcPath Source file path
+ * @param[in] destPath Destination file path
+ * @param[in,out] stats Optional statistics accumulator
+ * @return true if the file now only exists at destPath
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _moveFileAcross(const char* srcPath, const char* destPath, CopyStats* stats) {
+    struct stat srcStat;
+    struct stat destStat;
+
+    if (lstat(srcPath, &srcStat) != 0) {
+        return false;
+    }
+
+#ifndef _WIN32
+    if (S_ISLNK(srcStat.st_mode)) {
+        char target[PATH_MAX];
+        ssize_t len = readlink(srcPath, target, sizeof(target) - 1);
+        if (len < 0) {
+            return false;
+        }
+        target[len] = '\0';
+        if (symlink(target, destPath) != 0) {
+            // Hanya symlink identik dari move yang terputus yang boleh dipakai ulang
+            char existing[PATH_MAX];
+            ssize_t existingLen = errno == EEXIST ? readlink(destPath, existing, sizeof(existing) - 1) : -1;
+            if (existingLen != len || memcmp(existing, target, (size_t)len) != 0) {
+                logError("Gagal membuat symlink, source dipertahankan: %s (Error: %d)\n", destPath, errno);
+                return false;
+            }
+        }
+        return unlink(srcPath) == 0;
+    }
+#endif
+
+    bool alreadyCopied = stat(destPath, &destStat) == 0 &&
+        S_ISREG(destStat.st_mode) && destStat.st_size == srcStat.st_size &&
+        _sameContents(srcPath, destPath);
+
+    if (!alreadyCopied) {
+        if (!copyFileSparse(srcPath, destPath, stats)) {
+            return false;
+        }
+        if (stat(destPath, &destStat) != 0 || destStat.st_size != srcStat.st_size) {
+            logError("Verifikasi gagal, source dipertahankan: %s\n", srcPath);
+            return false;
+        }
+    }
+    else {
+        logInfo("Melanjutkan move, isi tujuan sudah sama: %s\n", destPath);
+    }
+
+    if (!_syncFile(destPath)) {
+        logError("Gagal sync file tujuan, source dipertahankan: %s (Error: %d)\n", destPath, errno);
+        return false;
+    }
+
+    if (unlink(srcPath) != 0) {
+        logError("Gagal menghapus source: %s (Error: %d)\n", srcPath, errno);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Moves a folder tree depth-first, removing sources as it goes
+ *
+ * @param[in] srcPath Source folder path
+ * @param[in] destPath Destination folder path (created if missing)
+ * @param[in,out] stats Optional statistics accumulator
+ * @return true if the whole folder moved and the source was removed
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _moveFolderAcross(const char* srcPath, const char* destPath, CopyStats* stats) {
+    if (_makeDir(destPath) != 0 && errno != EEXIST) {
+        logError("Gagal membuat folder tujuan: %s (Error: %d)\n", destPath, errno);
+        return false;
+    }
+
+    DIR* dir = opendir(srcPath);
+    if (dir == NULL) {
+        logError("Gagal membuka folder source: %s (Error: %d)\n", srcPath, errno);
+        return false;
+    }
+
+    bool ok = true;
+    struct dirent* entry;
+    char srcItem[PATH_MAX];
+    char destItem[PATH_MAX];
+
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        snprintf(srcItem, sizeof(srcItem), "%s/%s", srcPath, entry->d_name);
+        snprintf(destItem, sizeof(destItem), "%s/%s", destPath, entry->d_name);
+
+        struct stat st;
+        if (lstat(srcItem, &st) != 0) {
+            ok = false;
+            continue;
+        }
+
+        bool moved = S_ISDIR(st.st_mode)
+            ? _moveFolderAcross(srcItem, destItem, stats)
+            : _moveFileAcross(srcItem, destItem, stats);
+        if (!moved) {
+            logError("Gagal memindahkan: %s\n", srcItem);
+            ok = false;
+        }
+    }
+    closedir(dir);
+
+    if (ok && rmdir(srcPath) != 0) {
+        logError("Gagal menghapus folder source: %s (Error: %d)\n", srcPath, errno);
+        ok = false;
+    }
+    return ok;
+}
+
+/**
+ * @brief Creates a directory with default permissions
+ *
+ * @param[in] path Directory path
+ * @return 0 on success, -1 on failure with errno set
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _makeDir(const char* path) {
+#ifdef _WIN32
+    return _mkdir(path);
+#else
+    return mkdir(path, 0755);
+#endif
+}
+
+/**
+ * @brief Flushes a file's data to stable storage
+ *
+ * @param[in] path File path
+ * @return true if the data reached the disk
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _syncFile(const char* path) {
+#ifdef _WIN32
+    int fd = _open(path, _O_RDWR);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = _commit(fd) == 0;
+    _close(fd);
+    return ok;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+#endif
+}
+
+/**
+ * @brief Compares two files byte for byte
+ *
+ * @param[in] pathA First file path
+ * @param[in] pathB Second file path
+ * @return true if both files could be read and have identical contents
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _sameContents(const char* pathA, const char* pathB) {
+    FILE* a = fopen(pathA, "rb");
+    FILE* b = fopen(pathB, "rb");
+    char* buffer = malloc(2 * COPY_BUFFER_SIZE);
+    bool same = a != NULL && b != NULL && buffer != NULL;
+
+    while (same) {
+        size_t readA = fread(buffer, 1, COPY_BUFFER_SIZE, a);
+        size_t readB = fread(buffer + COPY_BUFFER_SIZE, 1, COPY_BUFFER_SIZE, b);
+        if (readA != readB || memcmp(buffer, buffer + COPY_BUFFER_SIZE, readA) != 0) {
+            same = false;
+        }
+        else if (readA < COPY_BUFFER_SIZE) {
+            same = !ferror(a) && !ferror(b);
+            break;
+        }
+    }
+
+    free(buffer);
+    if (a)
+        fclose(a);
+    if (b)
+        fclose(b);
+    return same;
+}
+
+#if !defined(SEEK_DATA) || !defined(SEEK_HOLE)
+/**
+ * @brief Copies a file with a plain buffered read/write loop
+ *
+ * Fallback used on platforms without SEEK_DATA/SEEK_HOLE. Holes in the
+ * source are materialized as zeroes, so allocated size equals logical size.
+ *
+ * @param[in] srcPath Source file path
+ * @param[in] destPath Destination file path
+ * @param[in,out] stats Optional statistics accumulator
+ * @return true if the whole file was copied
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _copyBuffered(const char* srcPath, const char* destPath, CopyStats* stats) {
+    FILE* src = fopen(srcPath, "rb");
+    FILE* dest = fopen(destPath, "wb");
+
+    if (!src || !dest) {
+        if (src)
+            fclose(src);
+        if (dest)
+            fclose(dest);
+        return false;
+    }
+
+    char* buffer = malloc(COPY_BUFFER_SIZE);
+    if (buffer == NULL) {
+        fclose(src);
+        fclose(dest);
+        return false;
+    }
+
+    bool ok = true;
+    long long copied = 0;
+    size_t bytes;
+    while ((bytes = fread(buffer, 1, COPY_BUFFER_SIZE, src)) > 0) {
+        if (fwrite(buffer, 1, bytes, dest) != bytes) {
+            ok = false;
+            break;
+        }
+        copied += (long long)bytes;
+        atomic_fetch_add_explicit(&totalDataBytes, (long long)bytes, memory_order_relaxed);
+    }
+    if (ferror(src)) {
+        ok = false;
+    }
+
+    free(buffer);
+    fclose(src);
+    if (fclose(dest) != 0) {
+        ok = false;
+    }
+
+    if (ok) {
+        _countFile(copied, copied);
+    }
+    if (ok && stats != NULL) {
+        stats->filesCopied++;
+        stats->logicalBytes += copied;
+        stats->allocatedBytes += copied;
+        stats->dataBytes += copied;
+    }
+    return ok;
+}
+#endif
+
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+/**
+ * @brief Copies one data extent at the same offset in the destination
+ *
+ * @param[in] srcFd Source file descriptor
+ * @param[in] destFd Destination file descriptor
+ * @param[in] offset Start offset of the extent
+ * @param[in] length Length of the extent in bytes
+ * @param[in] buffer Scratch buffer of COPY_BUFFER_SIZE bytes
+ * @param[in,out] copied Running count of bytes copied
+ * @return true if the extent was copied completely
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _copyRange(int srcFd, int destFd, off_t offset, off_t length, char* buffer, long long* copied) {
+    while (length > 0) {
+        size_t chunk = length > COPY_BUFFER_SIZE ? COPY_BUFFER_SIZE : (size_t)length;
+        ssize_t readBytes = pread(srcFd, buffer, chunk, offset);
+        if (readBytes < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        if (readBytes == 0) {
+            // File menyusut saat disalin, sisanya diisi oleh ftruncate
+            return true;
+        }
+
+        ssize_t written = 0;
+        while (written < readBytes) {
+            ssize_t w = pwrite(destFd, buffer + written, (size_t)(readBytes - written), offset + written);
+            if (w < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            written += w;
+        }
+
+        offset += readBytes;
+        length -= readBytes;
+        *copied += readBytes;
+        atomic_fetch_add_explicit(&totalDataBytes, (long long)readBytes, memory_order_relaxed);
+    }
+    return true;
+}
+#endif
+
+/**
+ * @brief Adds one completed file to the process-wide totals
+ *
+ * Data bytes are counted per chunk by the copy loops.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _countFile(long long logicalBytes, long long allocatedBytes) {
+    atomic_fetch_add_explicit(&totalFiles, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&totalLogicalBytes, logicalBytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&totalAllocatedBytes, allocatedBytes, memory_order_relaxed);
+    if (logicalBytes > allocatedBytes) {
+        atomic_fetch_add_explicit(&totalSparseBytes, logicalBytes - allocatedBytes, memory_order_relaxed);
+    }
+}
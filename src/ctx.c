@@ -1,14 +1,33 @@
 #include "ctx.h"
 #include "file_manager.h"
 #include "gui/body.h"
+#include "gui/component.h"
+#include "gui/duplicates.h"
 #include "gui/footer.h"
+#include "gui/hud.h"
 #include "gui/navbar.h"
+#include "gui/preview.h"
 #include "gui/sidebar.h"
+#include "gui/thumbnail.h"
 #include "gui/titlebar.h"
 #include "gui/toolbar.h"
 #include "macro.h"
+#include "profiler.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+// File manager hooks
+static void _onTreeChanged(FileManager *fm, void *userData);                          // Rebuild sidebar
+static void _onNavigated(FileManager *fm, void *userData);                            // Reset navbar text boxes
+static bool _onProgress(int current, int total, const char *name, void *userData);  // Draw paste progress
+static void _onProgressReset(void *userData);                                        // Reset progress bar
 
 void createContext(Context *ctx, FileManager *fileManager, int screenWidth, int screenHeight) {
     if (!ctx)
@@ -31,7 +50,8 @@ void createContext(Context *ctx, FileManager *fileManager, int screenWidth, int
     ctx->fileManager = (FileManager *)malloc(sizeof(FileManager));
     if (ctx->fileManager) {
         ctx->fileManager = fileManager;
-        fileManager->ctx = ctx;
+        // GUI adalah salah satu klien core; core memanggil GUI hanya lewat hook
+        fileManager->hooks = (FileManagerHooks){ctx, _onTreeChanged, _onNavigated, _onProgress, _onProgressReset};
     }
 
     // Alokasi dan inisialisasi komponen GUI
@@ -41,6 +61,10 @@ void createContext(Context *ctx, FileManager *fileManager, int screenWidth, int
     ctx->sidebar = (Sidebar *)malloc(sizeof(Sidebar));
     ctx->body = (Body *)malloc(sizeof(Body));
     ctx->footer = (Footer *)malloc(sizeof(Footer));
+    ctx->hud = (Hud *)malloc(sizeof(Hud));
+    ctx->thumbnails = (ThumbnailCache *)malloc(sizeof(ThumbnailCache));
+    ctx->preview = (PreviewPane *)malloc(sizeof(PreviewPane));
+    ctx->duplicates = (DuplicateView *)malloc(sizeof(DuplicateView));
 
     if (ctx->titleBar)
         createTitleBar(ctx->titleBar, ctx);
@@ -54,9 +78,18 @@ void createContext(Context *ctx, FileManager *fileManager, int screenWidth, int
         createBody(ctx, ctx->body);
     if (ctx->footer)
         createFooter(ctx->footer, ctx);
+    if (ctx->hud)
+        createHud(ctx->hud, ctx);
+    if (ctx->thumbnails)
+        createThumbnailCache(ctx->thumbnails, THUMB_CACHE_CAPACITY);
+    if (ctx->preview)
+        createPreviewPane(ctx->preview, ctx);
+    if (ctx->duplicates)
+        createDuplicateView(ctx->duplicates, ctx);
 }
 
 void updateContext(Context *ctx, FileManager *fileManager) {
+    PROFILE_FUNCTION();
     if (!ctx || !ctx->currentZeroPosition || !ctx->titleBar)
         return;
 
@@ -81,12 +114,55 @@ void updateContext(Context *ctx, FileManager *fileManager) {
     ctx->width = screenWidth;
     ctx->height = screenHeight;
     ctx->fileManager = fileManager;
-    fileManager->ctx = ctx;
+    fileManager->hooks.userData = ctx;
 
     updateTitleBar(ctx->titleBar, ctx);
     updateNavbar(ctx->navbar, ctx);
     updateToolbar(ctx->toolbar, ctx);
     updateSidebar(ctx->sidebar, ctx);
+    updateDuplicateView(ctx->duplicates);
     updateBody(ctx, ctx->body);
+    updatePreviewPane(ctx->preview, ctx);
     updateFooter(ctx->footer, ctx);
 }
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - FILE MANAGER HOOKS
+================================================================================
+*/
+
+static void _onTreeChanged(FileManager *fm, void *userData) {
+    Context *ctx = (Context *)userData;
+    if (ctx->sidebar)
+        rebuildSidebar(ctx->sidebar, fm->root);
+}
+
+static void _onNavigated(FileManager *fm, void *userData) {
+    Context *ctx = (Context *)userData;
+    if (!ctx->navbar)
+        return;
+
+    memset(ctx->navbar->textboxSearch, 0, MAX_STRING_LENGTH);
+    if (fm->isRootTrash) {
+        strncpy(ctx->navbar->textboxPath, "root", MAX_STRING_LENGTH - 1);
+        ctx->navbar->textboxPath[MAX_STRING_LENGTH - 1] = '\0';
+    }
+}
+
+static bool _onProgress(int current, int total, const char *name, void *userData) {
+    Context *ctx = (Context *)userData;
+
+    // Paste memblok main loop, jadi HUD ikut digambar di sini
+    BeginDrawing();
+    ClearBackground(RAYWHITE);
+    showPasteProgressBar(current, total, name);
+    drawHud(ctx->hud);
+    EndDrawing();
+    return !shouldCancelPaste();
+}
+
+static void _onProgressReset(void *userData) {
+    (void)userData;
+    resetProgressBarState();
+}
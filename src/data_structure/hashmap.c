@@ -0,0 +1,184 @@
+// File: hashmap.c
+// Author: AlpenliCloud Development Team
+// Date: 2025
+// Description: Separate-chaining hash map with generic keys (multimap semantics)
+// License: MIT License
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hashmap.h"
+#include "logger.h"
+
+#define HASHMAP_INITIAL_CAPACITY 16
+
+static bool _string_equals(const void* a, const void* b) {
+  return strcmp((const char*)a, (const char*)b) == 0;
+}
+
+static bool _pointer_equals(const void* a, const void* b) {
+  return a == b;
+}
+
+unsigned long hash_string(const void* key) {
+  // FNV-1a
+  const unsigned char* str = (const unsigned char*)key;
+  uint64_t hash = 1469598103934665603ULL;
+  while (*str) {
+    hash ^= *str++;
+    hash *= 1099511628211ULL;
+  }
+  return (unsigned long)hash;
+}
+
+unsigned long hash_pointer(const void* key) {
+  // Mix bits so aligned pointers spread over buckets
+  uint64_t x = (uint64_t)(uintptr_t)key;
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  return (unsigned long)x;
+}
+
+void create_hashmap(HashMap* map, HashFunction hash, KeyEquals equals) {
+  map->buckets = NULL;
+  map->capacity = 0;
+  map->size = 0;
+  map->hash = hash;
+  map->equals = equals;
+}
+
+void create_string_hashmap(HashMap* map) {
+  create_hashmap(map, hash_string, _string_equals);
+}
+
+void create_pointer_hashmap(HashMap* map) {
+  create_hashmap(map, hash_pointer, _pointer_equals);
+}
+
+void clear_hashmap(HashMap* map) {
+  for (size_t i = 0; i < map->capacity; i++) {
+    HashEntry* entry = map->buckets[i];
+    while (entry != NULL) {
+      HashEntry* next = entry->next;
+      free(entry);
+      entry = next;
+    }
+    map->buckets[i] = NULL;
+  }
+  map->size = 0;
+}
+
+void destroy_hashmap(HashMap* map) {
+  clear_hashmap(map);
+  free(map->buckets);
+  map->buckets = NULL;
+  map->capacity = 0;
+}
+
+// Grow bucket array and rehash using cached hashes
+static bool _hashmap_resize(HashMap* map, size_t newCapacity) {
+  HashEntry** buckets = calloc(newCapacity, sizeof(HashEntry*));
+  if (buckets == NULL) {
+    logError("Overflow, Memory allocation failed\n");
+    return false;
+  }
+
+  for (size_t i = 0; i < map->capacity; i++) {
+    HashEntry* entry = map->buckets[i];
+    while (entry != NULL) {
+      HashEntry* next = entry->next;
+      size_t index = entry->hash & (newCapacity - 1);
+      entry->next = buckets[index];
+      buckets[index] = entry;
+      entry = next;
+    }
+  }
+
+  free(map->buckets);
+  map->buckets = buckets;
+  map->capacity = newCapacity;
+  return true;
+}
+
+bool hashmap_put(HashMap* map, const void* key, void* value) {
+  if (map->capacity == 0) {
+    if (!_hashmap_resize(map, HASHMAP_INITIAL_CAPACITY)) {
+      return false;
+    }
+  }
+  else if (map->size + 1 > map->capacity - map->capacity / 4) {
+    // Load factor 0.75
+    _hashmap_resize(map, map->capacity * 2);
+  }
+
+  HashEntry* entry = (HashEntry*)malloc(sizeof(HashEntry));
+  if (entry == NULL) {
+    logError("Overflow, Memory allocation failed\n");
+    return false;
+  }
+
+  entry->key = key;
+  entry->value = value;
+  entry->hash = map->hash(key);
+
+  size_t index = entry->hash & (map->capacity - 1);
+  entry->next = map->buckets[index];
+  map->buckets[index] = entry;
+  map->size++;
+  return true;
+}
+
+static HashEntry** _hashmap_find_slot(const HashMap* map, const void* key, const void* value, bool matchValue) {
+  if (map->capacity == 0) {
+    return NULL;
+  }
+
+  unsigned long hash = map->hash(key);
+  HashEntry** slot = &map->buckets[hash & (map->capacity - 1)];
+  while (*slot != NULL) {
+    HashEntry* entry = *slot;
+    if (entry->hash == hash && map->equals(entry->key, key) && (!matchValue || entry->value == value)) {
+      return slot;
+    }
+    slot = &entry->next;
+  }
+  return NULL;
+}
+
+void* hashmap_get(const HashMap* map, const void* key) {
+  HashEntry** slot = _hashmap_find_slot(map, key, NULL, false);
+  return slot ? (*slot)->value : NULL;
+}
+
+bool hashmap_contains(const HashMap* map, const void* key) {
+  return _hashmap_find_slot(map, key, NULL, false) != NULL;
+}
+
+void* hashmap_remove(HashMap* map, const void* key) {
+  HashEntry** slot = _hashmap_find_slot(map, key, NULL, false);
+  if (slot == NULL) {
+    return NULL;
+  }
+
+  HashEntry* entry = *slot;
+  void* value = entry->value;
+  *slot = entry->next;
+  free(entry);
+  map->size--;
+  return value;
+}
+
+bool hashmap_remove_entry(HashMap* map, const void* key, void* value) {
+  HashEntry** slot = _hashmap_find_slot(map, key, value, true);
+  if (slot == NULL) {
+    return false;
+  }
+
+  HashEntry* entry = *slot;
+  *slot = entry->next;
+  free(entry);
+  map->size--;
+  return true;
+}
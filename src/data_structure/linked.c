@@ -8,24 +8,57 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "linked.h"
+#include "logger.h"
+
+#define NODE_POOL_BLOCK 256  // Nodes allocated per malloc when the pool is empty
+
+// Free list per thread: queues are filled and drained from different
+// threads (trash purger), so each thread recycles into its own list.
+static _Thread_local Node* node_pool = NULL;
+
+// Refill the pool with one block of nodes
+static bool refill_node_pool(void) {
+  Node* block = (Node*)malloc(sizeof(Node) * NODE_POOL_BLOCK);
+  if (block == NULL) {
+    return false;
+  }
+  for (int i = 0; i < NODE_POOL_BLOCK - 1; i++) {
+    block[i].next = &block[i + 1];
+  }
+  block[NODE_POOL_BLOCK - 1].next = node_pool;
+  node_pool = block;
+  return true;
+}
 
 // Initialize the linked list
 void create_list(LinkedList* list) {
   list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
 }
 
 // Create a new node with the given data
 Node* create_node(void* data) {
-  Node* new_node = (Node*)malloc(sizeof(Node));
-  if (new_node == NULL) {
-    printf("[LOG] Overflow, Memory allocation failed\n");
+  if (node_pool == NULL && !refill_node_pool()) {
+    logError("Overflow, Memory allocation failed\n");
     return NULL;
   }
+  Node* new_node = node_pool;
+  node_pool = new_node->next;
+
   new_node->data = data;
   new_node->next = NULL;
   return new_node;
 }
 
+// Return a node to the pool
+void free_node(Node* node) {
+  if (node == NULL) return;
+  node->data = NULL;
+  node->next = node_pool;
+  node_pool = node;
+}
+
 // Check if the list is empty
 bool is_list_empty(LinkedList list) {
   if (list.head == NULL) {
@@ -56,15 +89,15 @@ bool is_exist(LinkedList list, infotype data) {
 void print_list(LinkedList list) {
   Node* curr;
   if (is_list_empty(list)) {
-    printf("[LOG] list empty\n");
+    printf("list empty\n");
   }
   else {
     curr = list.head;
     while (curr->next != NULL) {
-      printf("[LOG] [%c]->", curr->data);
+      printf("[%p]->", curr->data);
       curr = curr->next;
     }
-    printf("[LOG] [%c]\n", curr->data);
+    printf("[%p]\n", curr->data);
   }
 }
 
@@ -76,28 +109,14 @@ void destroy_list(LinkedList* list) {
   while (curr != NULL) {
     temp = curr;
     curr = curr->next;
-
-    temp->next = NULL;
-    free(temp);
+    free_node(temp);
   }
-  list->head = NULL;
+  create_list(list);
 }
 
 // Get the length of the linked list
 int get_length(LinkedList list) {
-  Node* curr;
-  int count;
-
-  curr = list.head;
-  count = 0;
-
-  while (curr != NULL) {
-    count++;
-    curr = curr->next;
-  }
-
-  return count;
-
+  return list.length;
 }
 
 
@@ -106,76 +125,77 @@ void insert_first(LinkedList* list, infotype data) {
   new_node = create_node(data);
   if (new_node == NULL) return;
 
-  if (is_list_empty(*list)) {
-    list->head = new_node;
-  }
-  else {
-    new_node->next = list->head;
-    list->head = new_node;
+  new_node->next = list->head;
+  list->head = new_node;
+  if (list->tail == NULL) {
+    list->tail = new_node;
   }
+  list->length++;
 }
 
 void insert_last(LinkedList* list, infotype data) {
-  Node *new_node, *curr;
+  Node* new_node;
   new_node = create_node(data);
   if (new_node == NULL) return;
 
-  curr = list->head;
-  if (curr == NULL) {
-    insert_first(list, data);
+  if (list->tail == NULL) {
+    list->head = new_node;
   }
   else {
-    while (curr->next != NULL) {
-      curr = curr->next;
-    }
-    curr->next = new_node;
+    list->tail->next = new_node;
   }
+  list->tail = new_node;
+  list->length++;
 }
 
 void insert_at(LinkedList* list, int position, infotype data) {
   Node* new_node, * curr;
-  new_node = create_node(data);
-  if (new_node == NULL) return;
 
-  if (position < 1 || position > get_length(*list)) {
-    printf("[LOG] Invalid position\n");
+  if (position < 1 || position > list->length) {
+    logWarn("Invalid position\n");
     return;
   }
 
   if (position == 1) {
     insert_first(list, data);
+    return;
   }
-  else {
-    curr = list->head;
-    for (int i = 1; i < position - 1; i++) {
-      curr = curr->next;
-    }
-    new_node->next = curr->next;
-    curr->next = new_node;
+
+  new_node = create_node(data);
+  if (new_node == NULL) return;
+
+  curr = list->head;
+  for (int i = 1; i < position - 1; i++) {
+    curr = curr->next;
   }
+  new_node->next = curr->next;
+  curr->next = new_node;
+  list->length++;
 }
 
 void delete_first(LinkedList* list, infotype* temp) {
   Node* curr;
   if (is_list_empty(*list)) {
-    printf("[LOG] List is empty\n");
+    logDebug("List is empty\n");
     return;
   }
   else {
     curr = list->head;
     list->head = curr->next;
-    curr->next = NULL;
+    if (list->head == NULL) {
+      list->tail = NULL;
+    }
+    list->length--;
 
     *temp = curr->data;
-    free(curr);
-    curr = NULL;
+    free_node(curr);
   }
 }
 
 void delete_last(LinkedList* list, infotype* temp) {
   Node* curr, * prev;
   if (is_list_empty(*list)) {
-    printf("[LOG] List is empty\n");
+    logDebug("List is empty\n");
     return;
   }
   else {
@@ -187,13 +207,14 @@ void delete_last(LinkedList* list, infotype* temp) {
     }
     *temp = curr->data;
     if (prev == NULL) {
-      free(curr);
       list->head = NULL;
     }
     else {
-      free(curr);
       prev->next = NULL;
     }
+    list->tail = prev;
+    list->length--;
+    free_node(curr);
   }
 }
 
@@ -202,7 +223,7 @@ void delete_last(LinkedList* list, infotype* temp) {
 void delete_val(LinkedList* list, infotype data, infotype* temp) {
   Node* curr, * prev;
   if (is_list_empty(*list)) {
-    printf("[LOG] List is empty\n");
+    logDebug("List is empty\n");
     return;
   }
   else {
@@ -213,7 +234,7 @@ void delete_val(LinkedList* list, infotype data, infotype* temp) {
       curr = curr->next;
     }
     if (curr == NULL) {
-      printf("[LOG] Node with data %d not found\n", data);
+      logDebug("Node with data %p not found\n", data);
       return;
     }
     else {
@@ -223,8 +244,12 @@ void delete_val(LinkedList* list, infotype data, infotype* temp) {
       else {
         prev->next = curr->next;
       }
+      if (list->tail == curr) {
+        list->tail = prev;
+      }
+      list->length--;
       *temp = curr->data;
-      free(curr);
+      free_node(curr);
     }
   }
 }
@@ -232,14 +257,14 @@ void delete_val(LinkedList* list, infotype data, infotype* temp) {
 void delete_at(LinkedList* list, int position, infotype* temp) {
   Node* curr, * prev;
   if (is_list_empty(*list)) {
-    printf("[LOG] List is empty\n");
+    logDebug("List is empty\n");
     return;
   }
   else {
     curr = list->head;
     prev = NULL;
-    if (position < 1 || position > get_length(*list)) {
-      printf("[LOG] Invalid position\n");
+    if (position < 1 || position > list->length) {
+      logWarn("Invalid position\n");
       return;
     }
     for (int i = 1; i < position; i++) {
@@ -252,7 +277,11 @@ void delete_at(LinkedList* list, int position, infotype* temp) {
     else {
       prev->next = curr->next;
     }
+    if (list->tail == curr) {
+      list->tail = prev;
+    }
+    list->length--;
     *temp = curr->data;
-    free(curr);
+    free_node(curr);
   }
 }
@@ -1,14 +1,47 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include "logger.h"
+#include "mem_stats.h"
 #include "nbtree.h"
 #include <string.h>
 
+// Tabel node untuk handle. Hanya dipakai dari thread UI (tree tidak
+// pernah dibuat atau dibebaskan dari worker).
+typedef struct NodeSlot {
+  Tree node;             // NULL jika slot kosong
+  uint32_t generation;   // Naik setiap node di slot ini dibebaskan
+} NodeSlot;
+
+typedef struct SlotList {
+  uint32_t* items;
+  uint32_t count;
+  uint32_t capacity;
+} SlotList;
+
+static NodeSlot* node_slots = NULL;
+static uint32_t node_slot_count = 1;   // slot 0 = handle null
+static uint32_t node_slot_capacity = 0;
+static SlotList free_slots = { NULL, 0, 0 };     // Siap dipakai ulang
+static SlotList pending_slots = { NULL, 0, 0 };  // Dibebaskan saat reuse ditunda
+static bool defer_reuse = false;
+
+// Total semua node hidup, dibaca oleh HUD tanpa menelusuri tree
+static long live_nodes = 0;
+static size_t children_bytes = 0;
+
+static void register_node(Tree node);
+static void release_slot(NodeHandle handle);
+static bool push_slot(SlotList* list, uint32_t index);
+static bool push_frame(TreeIterator* it, Tree node);
+
 void create_tree(Tree* tree) {
   *tree = NULL;
 }
 
 Tree create_node_tree(treeInfotype data) {
-  TreeNode* newNode = (TreeNode*)malloc(sizeof(TreeNode));
+  TreeNode* newNode = NULL;
+  newNode = (TreeNode*)malloc(sizeof(TreeNode));
   if (newNode == NULL)
     return NULL;
 
@@ -16,51 +49,250 @@ Tree create_node_tree(treeInfotype data) {
   newNode->next_brother = NULL;
   newNode->first_son = NULL;
   newNode->parent = NULL;
+  newNode->children = NULL;
+  newNode->child_count = 0;
+  newNode->child_capacity = 0;
+  memTrackAlloc(MEM_TREE, newNode);
+  register_node(newNode);
+  live_nodes++;
   return newNode;
 }
 
 Tree insert_node(Tree parent, treeInfotype data) {
+  // kembalikan jika dia root
+  if (parent == NULL) return NULL;
+
   Tree child = create_node_tree(data);
+  if (child == NULL) return NULL;
 
-  // kembalikan jika dia root dan gagal alokasi
-  if (parent == NULL || child == NULL) return NULL;
+  if (!append_child(parent, child)) {
+    free_node_tree(child);
+    return NULL;
+  }
+  return child;
+}
 
-  child->parent = parent;
+// Pastikan array anak muat minimal `needed` elemen
+static bool reserve_children(Tree parent, int needed) {
+  if (needed <= parent->child_capacity) return true;
+
+  int capacity = parent->child_capacity ? parent->child_capacity : 4;
+  while (capacity < needed)
+    capacity *= 2;
+
+  size_t old_size = memBlockSize(parent->children);
+  Tree* children = (Tree*)realloc(parent->children, sizeof(Tree) * capacity);
+  if (children == NULL) {
+    logError("Overflow, Memory allocation failed\n");
+    return false;
+  }
+  memAccount(MEM_TREE, (long long)memBlockSize(children) - (long long)old_size, parent->children == NULL ? 1 : 0);
+  children_bytes += sizeof(Tree) * (size_t)(capacity - parent->child_capacity);
+  parent->children = children;
+  parent->child_capacity = capacity;
+  return true;
+}
 
-  if (parent->first_son == NULL) {
+bool append_child(Tree parent, Tree child) {
+  if (!reserve_children(parent, parent->child_count + 1)) return false;
+
+  child->parent = parent;
+  child->next_brother = NULL;
+  if (parent->child_count == 0) {
     parent->first_son = child;
   }
   else {
-    Tree sibling = parent->first_son;
-    while (sibling->next_brother != NULL)
-      sibling = sibling->next_brother;
-    sibling->next_brother = child;
+    parent->children[parent->child_count - 1]->next_brother = child;
   }
+  parent->children[parent->child_count++] = child;
+  return true;
+}
 
-  return child;
+void remove_child(Tree parent, Tree child) {
+  if (parent == NULL || child == NULL) return;
+
+  int index = 0;
+  while (index < parent->child_count && parent->children[index] != child)
+    index++;
+  if (index == parent->child_count) return;
+
+  if (index == 0) {
+    parent->first_son = child->next_brother;
+  }
+  else {
+    parent->children[index - 1]->next_brother = child->next_brother;
+  }
+  memmove(&parent->children[index], &parent->children[index + 1],
+    sizeof(Tree) * (parent->child_count - index - 1));
+  parent->child_count--;
+  child->next_brother = NULL;
+}
+
+Tree get_child(Tree parent, int index) {
+  if (parent == NULL || index < 0 || index >= parent->child_count) return NULL;
+  return parent->children[index];
+}
+
+int get_child_count(Tree parent) {
+  return parent ? parent->child_count : 0;
+}
+
+void reindex_children(Tree parent) {
+  if (parent == NULL) return;
+
+  int count = 0;
+  for (Tree child = parent->first_son; child != NULL; child = child->next_brother)
+    count++;
+
+  parent->child_count = 0;
+  if (!reserve_children(parent, count)) {
+    // Tanpa array, relasi tetap utuh lewat first_son/next_brother
+    return;
+  }
+  for (Tree child = parent->first_son; child != NULL; child = child->next_brother)
+    parent->children[parent->child_count++] = child;
+}
+
+void free_node_tree(Tree node) {
+  if (node == NULL) return;
+  release_slot(node->handle);
+  children_bytes -= sizeof(Tree) * (size_t)node->child_capacity;
+  live_nodes--;
+  memTrackFree(MEM_TREE, node->children);
+  memTrackFree(MEM_TREE, node);
+  free(node->children);
+  free(node);
+}
+
+void tree_iter_init(TreeIterator* it, Tree root, TreeOrder order) {
+  it->stack = NULL;
+  it->top = 0;
+  it->capacity = 0;
+  it->order = order;
+  it->pending = NULL;
+  it->last = NULL;
+  it->depth = 0;
+  it->failed = false;
+  if (root == NULL) return;
+
+  if (order == TREE_PRE_ORDER) {
+    it->pending = root;
+  }
+  else {
+    push_frame(it, root);
+  }
+}
+
+Tree tree_iter_next(TreeIterator* it) {
+  if (it->order == TREE_PRE_ORDER) {
+    if (it->pending != NULL) {
+      it->last = it->pending;
+      it->pending = NULL;
+      it->depth = 0;
+      return it->last;
+    }
+    // Turunkan ke anak node terakhir kecuali dilewati
+    if (it->last != NULL && get_child_count(it->last) > 0) {
+      push_frame(it, it->last);
+    }
+    it->last = NULL;
+
+    while (it->top > 0) {
+      TreeIterFrame* frame = &it->stack[it->top - 1];
+      if (frame->next_child < get_child_count(frame->node)) {
+        it->last = get_child(frame->node, frame->next_child++);
+        it->depth = it->top;
+        return it->last;
+      }
+      it->top--;
+    }
+    return NULL;
+  }
+
+  while (it->top > 0) {
+    TreeIterFrame* frame = &it->stack[it->top - 1];
+    if (frame->next_child < get_child_count(frame->node)) {
+      Tree child = get_child(frame->node, frame->next_child++);
+      if (!push_frame(it, child)) return NULL;
+      continue;
+    }
+    it->top--;
+    it->depth = it->top;
+    return frame->node;
+  }
+  return NULL;
+}
+
+void tree_iter_skip_children(TreeIterator* it) {
+  if (it->order == TREE_PRE_ORDER) {
+    it->last = NULL;
+  }
+}
+
+void tree_iter_destroy(TreeIterator* it) {
+  free(it->stack);
+  it->stack = NULL;
+  it->top = 0;
+  it->capacity = 0;
+  it->pending = NULL;
+  it->last = NULL;
+}
+
+bool tree_walk(Tree root, TreeOrder order, TreeVisitor visit, void* context) {
+  TreeIterator it;
+  tree_iter_init(&it, root, order);
+
+  bool completed = true;
+  Tree node;
+  while ((node = tree_iter_next(&it)) != NULL) {
+    if (!visit(node, it.depth, context)) {
+      completed = false;
+      break;
+    }
+  }
+  if (it.failed) completed = false;
+
+  tree_iter_destroy(&it);
+  return completed;
+}
+
+// Tambah frame di atas stack; jika gagal traversal dihentikan
+static bool push_frame(TreeIterator* it, Tree node) {
+  if (it->top == it->capacity) {
+    int capacity = it->capacity ? it->capacity * 2 : 32;
+    TreeIterFrame* stack = (TreeIterFrame*)realloc(it->stack, sizeof(TreeIterFrame) * capacity);
+    if (stack == NULL) {
+      logError("Overflow, Memory allocation failed\n");
+      it->failed = true;
+      it->top = 0;
+      it->pending = NULL;
+      it->last = NULL;
+      return false;
+    }
+    it->stack = stack;
+    it->capacity = capacity;
+  }
+  it->stack[it->top].node = node;
+  it->stack[it->top].next_child = 0;
+  it->top++;
+  return true;
 }
 
 Tree searchTree(Tree root, treeInfotype item) {
-  if (root == NULL) return NULL;
-  Tree current = root;
+  TreeIterator it;
+  tree_iter_init(&it, root, TREE_PRE_ORDER);
 
-  while (current != NULL) {
+  Tree current;
+  while ((current = tree_iter_next(&it)) != NULL) {
     if (
       strcmp(current->item.name, item.name) == 0 &&
       strcmp(current->item.path, item.path) == 0) {
-      return current;
+      break;
     }
-    current = current->next_brother;
   }
 
-  current = root;
-  while (current != NULL) {
-    Tree found = searchTree(current->first_son, item);
-    if (found != NULL) return found;
-    current = current->next_brother;
-  }
-
-  return NULL;
+  tree_iter_destroy(&it);
+  return current;
 }
 
 // Fungsi bantu untuk mencetak indentasi
@@ -70,44 +302,153 @@ void printIndent(int depth) {
   }
 }
 
-// Fungsi rekursif untuk mencetak pohon
+// Cetak pohon secara pre-order tanpa rekursi
 void printTree(Tree node, int depth) {
-  if (node == NULL)
-    return;
+  TreeIterator it;
+  tree_iter_init(&it, node, TREE_PRE_ORDER);
+
+  Tree current;
+  while ((current = tree_iter_next(&it)) != NULL) {
+    int level = depth + it.depth;
+    char* typeStr = current->item.type == ITEM_FOLDER ? "(folder)" : "(file)";
 
-  // Cetak node saat ini
+    // Format waktu
+    char updated_at_str[20];
+    strftime(updated_at_str, sizeof(updated_at_str), "%Y-%m-%d", localtime(&current->item.updated_at));
 
-  char* typeStr = node->item.type == ITEM_FOLDER ? "(folder)" : "(file)";
+    printIndent(level);
+    printf("==================================\n");
+    printIndent(level);
+    printf("item name: %s\n", current->item.name);
+    printIndent(level);
+    printf("first son name: %s\n", current->first_son == NULL ? "NULL" : current->first_son->item.name);
+    printIndent(level);
+    printf("brother name: %s\n", current->next_brother == NULL ? "NULL" : current->next_brother->item.name);
+    printIndent(level);
+    printf("parent name: %s\n", current->parent == NULL ? "NULL" : current->parent->item.name);
+    printIndent(level);
+    printf("size: %d\n", current->item.size);
+    printIndent(level);
+    printf("path: %s\n", current->item.path);
 
-  // Format waktu
-  char updated_at_str[20];
-  strftime(updated_at_str, sizeof(updated_at_str), "%Y-%m-%d", localtime(&node->item.updated_at));
+    printIndent(level);
+    printf("==================================\n");
+  }
 
-  printIndent(depth);
-  printf("==================================\n");
-  printIndent(depth);
-  printf("item name: %s\n", node->item.name);
-  printIndent(depth);
-  printf("first son name: %s\n", node->first_son == NULL ? "NULL" : node->first_son->item.name);
-  printIndent(depth);
-  printf("brother name: %s\n", node->next_brother == NULL ? "NULL" : node->next_brother->item.name);
-  printIndent(depth);
-  printf("parent name: %s\n", node->parent == NULL ? "NULL" : node->parent->item.name);
-  printIndent(depth);
-  printf("size: %d\n", node->item.size);
-  printIndent(depth);
-  printf("path: %s\n", node->item.path);
+  tree_iter_destroy(&it);
+}
 
-  printIndent(depth);
-  printf("==================================\n");
+NodeHandle get_node_handle(Tree node) {
+  return node ? node->handle : NULL_NODE_HANDLE;
+}
 
-  // Cetak saudara (next_brother)
-  if (node->next_brother != NULL) {
-    printTree(node->next_brother, depth);
+Tree resolve_node_handle(NodeHandle handle) {
+  if (handle.index == 0 || handle.index >= node_slot_count) return NULL;
+  NodeSlot* slot = &node_slots[handle.index];
+  return (slot->generation == handle.generation) ? slot->node : NULL;
+}
+
+bool node_handle_equals(NodeHandle a, NodeHandle b) {
+  return a.index == b.index && a.generation == b.generation;
+}
+
+bool adopt_node_handle(Tree node, NodeHandle previous) {
+  if (node == NULL || previous.index == 0 || previous.index >= node_slot_count) return false;
+
+  // Slot lama harus masih kosong sejak node sebelumnya dibebaskan
+  NodeSlot* slot = &node_slots[previous.index];
+  if (slot->node != NULL || slot->generation != previous.generation + 1) return false;
+
+  release_slot(node->handle);
+  slot->node = node;
+  slot->generation = previous.generation;
+  node->handle = previous;
+  return true;
+}
+
+void get_tree_stats(TreeStats* stats) {
+  stats->live_nodes = live_nodes;
+  stats->node_bytes = sizeof(TreeNode) * (size_t)live_nodes;
+  stats->children_bytes = children_bytes;
+  stats->slot_bytes = sizeof(NodeSlot) * node_slot_capacity
+    + sizeof(uint32_t) * (free_slots.capacity + pending_slots.capacity);
+  stats->slots_used = node_slot_count - 1;
+  stats->slots_free = free_slots.count + pending_slots.count;
+}
+
+Tree node_from_item(Item* item) {
+  return item ? (Tree)((char*)item - offsetof(TreeNode, item)) : NULL;
+}
+
+void defer_node_slot_reuse(bool defer) {
+  defer_reuse = defer;
+  if (defer) return;
+
+  // Slot yang tidak diadopsi boleh dipakai ulang sekarang
+  for (uint32_t i = 0; i < pending_slots.count; i++)
+    push_slot(&free_slots, pending_slots.items[i]);
+  pending_slots.count = 0;
+}
+
+// Daftarkan node ke slot kosong atau slot baru
+static void register_node(Tree node) {
+  node->handle = NULL_NODE_HANDLE;
+
+  uint32_t index = 0;
+  while (free_slots.count > 0) {
+    uint32_t candidate = free_slots.items[--free_slots.count];
+    // Slot bisa sudah dipakai lagi lewat adopt_node_handle
+    if (node_slots[candidate].node == NULL) {
+      index = candidate;
+      break;
+    }
+  }
+
+  if (index == 0) {
+    if (node_slot_count >= node_slot_capacity) {
+      uint32_t capacity = node_slot_capacity ? node_slot_capacity * 2 : 1024;
+      NodeSlot* slots = (NodeSlot*)realloc(node_slots, sizeof(NodeSlot) * capacity);
+      if (slots == NULL) {
+        // Node tetap bisa dipakai, hanya tanpa handle
+        logError("Overflow, Memory allocation failed\n");
+        return;
+      }
+      if (node_slot_capacity == 0) {
+        slots[0].node = NULL;
+        slots[0].generation = 0;
+      }
+      node_slots = slots;
+      node_slot_capacity = capacity;
+    }
+    index = node_slot_count++;
+    node_slots[index].generation = 1;
   }
 
-  // Cetak anak (first_son)
-  if (node->first_son != NULL) {
-    printTree(node->first_son, depth + 1);
+  node_slots[index].node = node;
+  node->handle.index = index;
+  node->handle.generation = node_slots[index].generation;
+}
+
+// Kosongkan slot dan naikkan generasinya sehingga handle lama tidak valid
+static void release_slot(NodeHandle handle) {
+  if (handle.index == 0 || handle.index >= node_slot_count) return;
+  NodeSlot* slot = &node_slots[handle.index];
+  if (slot->generation != handle.generation) return;
+
+  slot->node = NULL;
+  slot->generation++;
+  // Jika gagal, slot bocor tapi handle lama tetap tidak valid
+  push_slot(defer_reuse ? &pending_slots : &free_slots, handle.index);
+}
+
+static bool push_slot(SlotList* list, uint32_t index) {
+  if (list->count == list->capacity) {
+    uint32_t capacity = list->capacity ? list->capacity * 2 : 1024;
+    uint32_t* items = (uint32_t*)realloc(list->items, sizeof(uint32_t) * capacity);
+    if (items == NULL) return false;
+    list->items = items;
+    list->capacity = capacity;
   }
-}
\ No newline at end of file
+  list->items[list->count++] = index;
+  return true;
+}
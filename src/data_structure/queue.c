@@ -6,12 +6,14 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "logger.h"
 #include "queue.h"
 #include "linked.h"
 
 void create_queue(Queue* queue) {
   queue->front = NULL;
   queue->rear = NULL;
+  queue->length = 0;
 }
 
 bool is_queue_empty(Queue queue) {
@@ -23,38 +25,54 @@ bool is_queue_empty(Queue queue) {
 
 
 void enqueue(Queue* queue, infotype data) {
-  LinkedList temp_list;
-
-  temp_list.head = queue->front;
-  insert_last(&temp_list, data);
+  Node* new_node = create_node(data);
+  if (new_node == NULL) return;
 
-  queue->front = temp_list.head;
   if (queue->rear == NULL) {
-    queue->rear = queue->front;
+    queue->front = new_node;
   }
   else {
-    queue->rear = queue->rear->next;
+    queue->rear->next = new_node;
   }
-
+  queue->rear = new_node;
+  queue->length++;
 }
 
 infotype dequeue(Queue* queue) {
-  LinkedList temp_list;
+  Node* node = queue->front;
   infotype data;
-  temp_list.head = queue->front;
-  delete_first(&temp_list, &data);
-  queue->front = temp_list.head;
+  if (node == NULL) {
+    logDebug("List is empty\n");
+    return NULL;
+  }
+
+  data = node->data;
+  queue->front = node->next;
   if (queue->front == NULL) {
     queue->rear = NULL;
   }
+  queue->length--;
+  free_node(node);
   return data;
 }
 
+void destroy_queue(Queue* queue) {
+  Node* curr = queue->front;
+  while (curr != NULL) {
+    Node* next = curr->next;
+    free_node(curr);
+    curr = next;
+  }
+  create_queue(queue);
+}
+
 void print_queue(Queue queue) {
   LinkedList temp_list;
   temp_list.head = queue.front;
+  temp_list.tail = queue.rear;
+  temp_list.length = queue.length;
   if (is_queue_empty(queue)) {
-    printf("[LOG] Queue is empty\n");
+    printf("Queue is empty\n");
   }
   else {
     print_list(temp_list);
@@ -62,10 +80,13 @@ void print_queue(Queue queue) {
 }
 
 void clear_queue(Queue* q) {
-  infotype temp;
-  while (!is_queue_empty(*q)) {
-    temp = dequeue(q);
-    printf("[LOG] Dequeued item\n");
-    // free(temp);
+  int count = q->length;
+  destroy_queue(q);
+  if (count > 0) {
+    logDebug("%d item dikeluarkan dari queue\n", count);
   }
-}
\ No newline at end of file
+}
+
+int get_queue_length(Queue queue) {
+  return queue.length;
+}
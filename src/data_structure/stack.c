@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "logger.h"
 #include "stack.h"
 
 // Initialize the stack
@@ -18,37 +19,43 @@ bool is_stack_empty(Stack stack) {
 }
 // Push an element onto the stack
 void push(Stack* stack, infotype data) {
-    LinkedList temp_list;
-    temp_list.head = *stack;
-    insert_first(&temp_list, data);
-    *stack = temp_list.head;
+    Node* new_node = create_node(data);
+    if (new_node == NULL) return;
+    new_node->next = *stack;
+    *stack = new_node;
 }
 
 // Pop an element from the stack
 void* pop(Stack* stack) {
-    LinkedList temp_list;
+    Node* top = *stack;
     void* popped_data;
-    temp_list.head = *stack;
-    delete_first(&temp_list, &popped_data);
-    *stack = temp_list.head;
+    if (top == NULL) {
+        logDebug("List is empty\n");
+        return NULL;
+    }
+    popped_data = top->data;
+    *stack = top->next;
+    free_node(top);
     return popped_data;
 }
 
 void pop_print(Stack* stack, infotype* data) {
-    LinkedList temp_list;
-    temp_list.head = *stack;
-    delete_first(&temp_list, data);
-    *stack = temp_list.head;
-    printf("[LOG] %d ", *data);
+    *data = pop(stack);
+    printf("%p ", *data);
 }
 
 // Print the stack
 void print_stack(Stack stack) {
     LinkedList temp_list;
     if (is_stack_empty(stack)) {
-        printf("[LOG] Stack is empty\n");
+        printf("Stack is empty\n");
         return;
     }
+    create_list(&temp_list);
+    for (Node* node = stack; node != NULL; node = node->next) {
+        temp_list.tail = node;
+        temp_list.length++;
+    }
     temp_list.head = stack;
     print_list(temp_list);
 }
\ No newline at end of file
@@ -0,0 +1,469 @@
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "delete_engine.h"
+#include "logger.h"
+#include "profiler.h"
+
+#define DELETE_PUSH_BATCH 64      // Subdirectories collected before publishing to the stack
+#define DELETE_ERROR_LOG_LIMIT 10 // Errors printed per delete before going quiet
+
+double deleteItemsPerSecond(const DeleteStats* stats) {
+    if (stats == NULL || stats->seconds <= 0.0) {
+        return 0.0;
+    }
+    return (double)(stats->filesRemoved + stats->dirsRemoved) / stats->seconds;
+}
+
+#ifndef _WIN32
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+/**
+ * @brief Directory waiting to be scanned or removed
+ *
+ * pending counts the outstanding work that keeps the directory alive: one
+ * for its own scan plus one per subdirectory not yet removed. The thread
+ * that drops it to zero removes the directory and releases its parent.
+ */
+typedef struct DeleteDir {
+    struct DeleteDir* parent;  // NULL for the root
+    char* name;                // Name relative to parent (full path for the root)
+    int fd;                    // Open while children still need it, -1 otherwise
+    bool rescanned;            // Already retried after ENOTEMPTY
+    atomic_int pending;
+} DeleteDir;
+
+/**
+ * @brief Shared state of one removeTreeParallel() call
+ */
+typedef struct DeleteJob {
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    DeleteDir** stack;         // Explicit work stack (LIFO keeps open fds near tree depth)
+    size_t count;
+    size_t capacity;
+    int active;                // Workers currently scanning a directory
+    bool rootRemoved;
+
+    atomic_llong files;
+    atomic_llong dirs;
+    atomic_llong errors;
+} DeleteJob;
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void* _deleteWorker(void* arg);                                           // Pop and scan until the tree is gone
+static void _scanDir(DeleteJob* job, DeleteDir* dir);                             // Unlink files, queue subdirectories
+static void _finishDir(DeleteJob* job, DeleteDir* dir);                           // Drop one pending ref, remove when zero
+static bool _pushDirs(DeleteJob* job, DeleteDir** dirs, size_t count);            // Publish subdirectories to the stack
+static DeleteDir* _newDir(DeleteDir* parent, const char* name);                   // Allocate pending directory
+static void _freeDir(DeleteDir* dir);                                             // Close and free directory
+static void _reportError(DeleteJob* job, const char* what, const char* name);     // Count and log an error
+static void _raiseFdLimit(void);                                                  // Allow one fd per tree level
+static double _now(void);                                                         // Monotonic seconds
+
+static pthread_once_t fdLimitOnce = PTHREAD_ONCE_INIT;
+
+/*
+================================================================================
+    DELETE OPERATIONS
+================================================================================
+*/
+
+bool removeTreeParallel(const char* path, DeleteStats* stats) {
+    PROFILE_FUNCTION();
+    double start = _now();
+    DeleteStats local = { 0 };
+    struct stat st;
+
+    if (lstat(path, &st) != 0) {
+        if (stats != NULL) {
+            *stats = local;
+        }
+        return errno == ENOENT;
+    }
+
+    if (!S_ISDIR(st.st_mode)) {
+        bool removed = unlink(path) == 0;
+        local.filesRemoved = removed ? 1 : 0;
+        local.errors = removed ? 0 : 1;
+        local.seconds = _now() - start;
+        local.threads = 1;
+        if (stats != NULL) {
+            *stats = local;
+        }
+        return removed;
+    }
+
+    pthread_once(&fdLimitOnce, _raiseFdLimit);
+
+    DeleteJob job;
+    memset(&job, 0, sizeof(job));
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.ready, NULL);
+    atomic_init(&job.files, 0);
+    atomic_init(&job.dirs, 0);
+    atomic_init(&job.errors, 0);
+
+    DeleteDir* root = _newDir(NULL, path);
+    if (root == NULL || !_pushDirs(&job, &root, 1)) {
+        _freeDir(root);
+        pthread_cond_destroy(&job.ready);
+        pthread_mutex_destroy(&job.lock);
+        return false;
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int workers = (int)(cpus < 1 ? 1 : (cpus > DELETE_MAX_THREADS ? DELETE_MAX_THREADS : cpus));
+    pthread_t threads[DELETE_MAX_THREADS];
+    int started = 0;
+
+    // Thread pemanggil ikut bekerja, jadi cukup buat workers - 1 thread
+    for (int i = 0; i < workers - 1; i++) {
+        if (pthread_create(&threads[started], NULL, _deleteWorker, &job) != 0) {
+            break;
+        }
+        started++;
+    }
+
+    _deleteWorker(&job);
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    local.filesRemoved = atomic_load(&job.files);
+    local.dirsRemoved = atomic_load(&job.dirs);
+    local.errors = atomic_load(&job.errors);
+    local.seconds = _now() - start;
+    local.threads = started + 1;
+    if (stats != NULL) {
+        *stats = local;
+    }
+
+    bool removed = job.rootRemoved;
+    free(job.stack);
+    pthread_cond_destroy(&job.ready);
+    pthread_mutex_destroy(&job.lock);
+    return removed;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Worker loop: pops directories until the stack is empty and idle
+ *
+ * @internal
+ * @since 1.0
+ */
+static void* _deleteWorker(void* arg) {
+    PROFILE_THREAD_NAME("delete worker");
+    PROFILE_FUNCTION();
+    DeleteJob* job = (DeleteJob*)arg;
+
+    pthread_mutex_lock(&job->lock);
+    while (true) {
+        while (job->count == 0 && job->active > 0) {
+            pthread_cond_wait(&job->ready, &job->lock);
+        }
+        if (job->count == 0) {
+            break;
+        }
+
+        DeleteDir* dir = job->stack[--job->count];
+        job->active++;
+        pthread_mutex_unlock(&job->lock);
+
+        _scanDir(job, dir);
+
+        pthread_mutex_lock(&job->lock);
+        job->active--;
+        if (job->count == 0 && job->active == 0) {
+            pthread_cond_broadcast(&job->ready);
+        }
+    }
+    pthread_mutex_unlock(&job->lock);
+    return NULL;
+}
+
+/**
+ * @brief Unlinks every non-directory entry and queues subdirectories
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _scanDir(DeleteJob* job, DeleteDir* dir) {
+    PROFILE_FUNCTION();
+    if (dir->fd < 0) {
+        int parentFd = dir->parent ? dir->parent->fd : AT_FDCWD;
+        dir->fd = openat(parentFd, dir->name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (dir->fd < 0) {
+            _reportError(job, "buka folder", dir->name);
+            _finishDir(job, dir);
+            return;
+        }
+    }
+
+    // fdopendir mengambil alih fd, jadi pakai salinan agar dir->fd tetap hidup
+    int iterFd = dup(dir->fd);
+    DIR* dp = iterFd >= 0 ? fdopendir(iterFd) : NULL;
+    if (dp == NULL) {
+        if (iterFd >= 0) {
+            close(iterFd);
+        }
+        _reportError(job, "baca folder", dir->name);
+        _finishDir(job, dir);
+        return;
+    }
+    rewinddir(dp);
+
+    DeleteDir* batch[DELETE_PUSH_BATCH];
+    size_t batchCount = 0;
+    struct dirent* entry;
+
+    while ((entry = readdir(dp)) != NULL) {
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+
+        bool isDir = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            isDir = fstatat(dir->fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+        }
+
+        if (!isDir) {
+            if (unlinkat(dir->fd, name, 0) == 0) {
+                atomic_fetch_add_explicit(&job->files, 1, memory_order_relaxed);
+                continue;
+            }
+            if (errno != EISDIR) {
+                _reportError(job, "hapus file", name);
+                continue;
+            }
+        }
+
+        DeleteDir* child = _newDir(dir, name);
+        if (child == NULL) {
+            _reportError(job, "alokasi", name);
+            continue;
+        }
+        atomic_fetch_add(&dir->pending, 1);
+        batch[batchCount++] = child;
+
+        if (batchCount == DELETE_PUSH_BATCH) {
+            _pushDirs(job, batch, batchCount);
+            batchCount = 0;
+        }
+    }
+    closedir(dp);
+
+    if (batchCount > 0) {
+        _pushDirs(job, batch, batchCount);
+    }
+
+    _finishDir(job, dir);
+}
+
+/**
+ * @brief Releases one pending reference and removes emptied directories
+ *
+ * Walks up the parent chain iteratively, so finishing the last leaf of a
+ * deep tree does not recurse.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _finishDir(DeleteJob* job, DeleteDir* dir) {
+    while (dir != NULL) {
+        if (atomic_fetch_sub(&dir->pending, 1) != 1) {
+            return;
+        }
+
+        DeleteDir* parent = dir->parent;
+        int parentFd = parent ? parent->fd : AT_FDCWD;
+
+        if (unlinkat(parentFd, dir->name, AT_REMOVEDIR) == 0) {
+            atomic_fetch_add_explicit(&job->dirs, 1, memory_order_relaxed);
+            if (parent == NULL) {
+                job->rootRemoved = true;
+            }
+        }
+        else if ((errno == ENOTEMPTY || errno == EEXIST) && !dir->rescanned && dir->fd >= 0) {
+            // Entry yang terlewat saat readdir bersamaan dengan unlink: pindai sekali lagi
+            dir->rescanned = true;
+            atomic_store(&dir->pending, 1);
+            if (_pushDirs(job, &dir, 1)) {
+                return;
+            }
+            _reportError(job, "hapus folder", dir->name);
+        }
+        else {
+            _reportError(job, "hapus folder", dir->name);
+        }
+
+        _freeDir(dir);
+        dir = parent;
+    }
+}
+
+/**
+ * @brief Pushes directories on the work stack and wakes idle workers
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _pushDirs(DeleteJob* job, DeleteDir** dirs, size_t count) {
+    pthread_mutex_lock(&job->lock);
+    if (job->count + count > job->capacity) {
+        size_t capacity = job->capacity ? job->capacity * 2 : 256;
+        while (capacity < job->count + count) {
+            capacity *= 2;
+        }
+        DeleteDir** stack = realloc(job->stack, capacity * sizeof(DeleteDir*));
+        if (stack == NULL) {
+            pthread_mutex_unlock(&job->lock);
+            // Tanpa memori tambahan: proses langsung di thread ini
+            for (size_t i = 0; i < count; i++) {
+                _scanDir(job, dirs[i]);
+            }
+            return true;
+        }
+        job->stack = stack;
+        job->capacity = capacity;
+    }
+
+    memcpy(job->stack + job->count, dirs, count * sizeof(DeleteDir*));
+    job->count += count;
+    pthread_cond_broadcast(&job->ready);
+    pthread_mutex_unlock(&job->lock);
+    return true;
+}
+
+/**
+ * @brief Allocates a pending directory holding one reference for its scan
+ *
+ * @internal
+ * @since 1.0
+ */
+static DeleteDir* _newDir(DeleteDir* parent, const char* name) {
+    DeleteDir* dir = malloc(sizeof(DeleteDir));
+    if (dir == NULL) {
+        return NULL;
+    }
+    dir->name = strdup(name);
+    if (dir->name == NULL) {
+        free(dir);
+        return NULL;
+    }
+    dir->parent = parent;
+    dir->fd = -1;
+    dir->rescanned = false;
+    atomic_init(&dir->pending, 1);
+    return dir;
+}
+
+/**
+ * @brief Closes descriptor and frees a directory node
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _freeDir(DeleteDir* dir) {
+    if (dir == NULL) {
+        return;
+    }
+    if (dir->fd >= 0) {
+        close(dir->fd);
+    }
+    free(dir->name);
+    free(dir);
+}
+
+/**
+ * @brief Counts an error and logs the first few
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _reportError(DeleteJob* job, const char* what, const char* name) {
+    int savedErrno = errno;
+    long long errors = atomic_fetch_add(&job->errors, 1);
+    if (errors < DELETE_ERROR_LOG_LIMIT) {
+        logError("Gagal %s: %s (Error: %d)\n", what, name, savedErrno);
+    }
+}
+
+/**
+ * @brief Raises the soft descriptor limit to the hard limit
+ *
+ * Each directory on the current path keeps its descriptor open until its
+ * subdirectories are gone, so very deep trees need more than the usual
+ * 1024 descriptors.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _raiseFdLimit(void) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+/**
+ * @brief Monotonic clock in seconds
+ *
+ * @internal
+ * @since 1.0
+ */
+static double _now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+#else
+
+bool removeTreeParallel(const char* path, DeleteStats* stats) {
+    PROFILE_FUNCTION();
+    (void)path;
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(DeleteStats));
+    }
+    return false;
+}
+
+#endif
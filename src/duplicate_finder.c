@@ -0,0 +1,717 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "duplicate_finder.h"
+#include "logger.h"
+#include "profiler.h"
+
+#ifdef _WIN32
+#define DUP_SEEK _fseeki64
+#define DUP_TELL _ftelli64
+#else
+#define DUP_SEEK fseeko
+#define DUP_TELL ftello
+#endif
+
+// XXH64 primes
+#define PRIME64_1 11400714785074694791ULL
+#define PRIME64_2 14029467366897019727ULL
+#define PRIME64_3 1609587929392839161ULL
+#define PRIME64_4 9650029242287828579ULL
+#define PRIME64_5 2870177450012600261ULL
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+/**
+ * @brief Files collected by the tree walk
+ */
+typedef struct CandidateList {
+    Tree* nodes;
+    long long count;
+    long long capacity;
+} CandidateList;
+
+/**
+ * @brief Streaming XXH64 state; every update but the last is a multiple of 32 bytes
+ */
+typedef struct HashState {
+    uint64_t v[4];
+    uint64_t total;
+} HashState;
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+// Pipeline
+static bool _collectFile(Tree node, int depth, void* context);                  // Visitor: gather files
+static void* _hashWorker(void* arg);                                            // Worker thread loop
+static long long _hashEdges(DuplicateFinder* finder, DuplicateFile* file, unsigned char* buffer);  // Stage 2
+static long long _hashContents(DuplicateFinder* finder, DuplicateFile* file,
+                               unsigned char* buffer, size_t bufferSize);       // Stage 3
+static FILE* _openCandidate(DuplicateFile* file);                               // Open and check the size
+static void _finishRun(DuplicateFinder* finder, DuplicateRun run);              // Split a hashed run
+static bool _queueRun(DuplicateFinder* finder, long long start, long long end, bool full);  // Add a run and its jobs
+static void _publishGroup(DuplicateFinder* finder, DuplicateFile* files, int count, uint64_t hash);  // Add a result
+static bool _cancelled(DuplicateFinder* finder);                                // Read the cancel flag
+
+// Comparators
+static int _compareSizeDesc(const void* a, const void* b);                      // Tree*, largest first
+static int _compareEdgeHash(const void* a, const void* b);                      // DuplicateFile by edge hash
+static int _compareFullHash(const void* a, const void* b);                      // DuplicateFile by full hash
+static int _comparePath(const void* a, const void* b);                          // DuplicateFile* by path
+
+// XXH64
+static void _hashInit(HashState* state);
+static void _hashUpdate(HashState* state, const unsigned char* data, size_t length);
+static uint64_t _hashFinal(HashState* state, const unsigned char* data, size_t length);
+
+/*
+================================================================================
+    LIFECYCLE
+================================================================================
+*/
+
+bool startDuplicateFinder(DuplicateFinder* finder, Tree folder, int workers) {
+    PROFILE_FUNCTION();
+    memset(finder, 0, sizeof(DuplicateFinder));
+    pthread_mutex_init(&finder->lock, NULL);
+    pthread_cond_init(&finder->changed, NULL);
+
+    // Tahap 1: kelompokkan berdasarkan ukuran di memori, tanpa I/O
+    CandidateList list = { 0 };
+    if (!tree_walk(folder, TREE_PRE_ORDER, _collectFile, &list)) {
+        logError("Pencarian duplikat kehabisan memori\n");
+        free(list.nodes);
+        destroyDuplicateFinder(finder);
+        return false;
+    }
+    finder->stats.files = list.count;
+    qsort(list.nodes, (size_t)list.count, sizeof(Tree), _compareSizeDesc);
+
+    long long candidates = 0;
+    for (long long i = 0, j; i < list.count; i = j) {
+        for (j = i + 1; j < list.count && list.nodes[j]->item.size == list.nodes[i]->item.size; j++) {
+        }
+        if (j - i >= 2) {
+            candidates += j - i;
+        }
+    }
+
+    if (candidates > 0) {
+        finder->files = calloc((size_t)candidates, sizeof(DuplicateFile));
+        finder->jobs = malloc(sizeof(long long) * (size_t)candidates);
+        if (finder->files == NULL || finder->jobs == NULL) {
+            logError("Pencarian duplikat kehabisan memori\n");
+            free(list.nodes);
+            destroyDuplicateFinder(finder);
+            return false;
+        }
+    }
+    finder->fileCount = candidates;
+
+    long long next = 0;
+    for (long long i = 0, j; i < list.count; i = j) {
+        for (j = i + 1; j < list.count && list.nodes[j]->item.size == list.nodes[i]->item.size; j++) {
+        }
+        if (j - i < 2) {
+            continue;
+        }
+        long long start = next;
+        for (long long k = i; k < j; k++, next++) {
+            DuplicateFile* file = &finder->files[next];
+            file->path = strdup(list.nodes[k]->item.path);
+            file->node = get_node_handle(list.nodes[k]);
+            file->size = list.nodes[k]->item.size;
+            file->readable = file->path != NULL;
+        }
+        _queueRun(finder, start, next, false);
+    }
+    free(list.nodes);
+    finder->stats.sizeCandidates = candidates;
+    logInfo("Duplikat: %lld file, %lld kandidat dengan ukuran sama\n", finder->stats.files, candidates);
+
+    if (candidates == 0) {
+        finder->stats.done = true;
+        return true;
+    }
+
+    if (workers <= 0) {
+        workers = DUP_DEFAULT_WORKERS;
+    }
+    if (workers > DUP_MAX_WORKERS) {
+        workers = DUP_MAX_WORKERS;
+    }
+    for (int i = 0; i < workers; i++) {
+        if (pthread_create(&finder->workers[i], NULL, _hashWorker, finder) != 0) {
+            logWarn("Gagal memulai worker duplikat ke-%d\n", i + 1);
+            break;
+        }
+        finder->workerCount++;
+    }
+    if (finder->workerCount == 0) {
+        logWarn("Worker duplikat tidak bisa dijalankan, hashing langsung\n");
+        _hashWorker(finder);
+    }
+    return true;
+}
+
+void destroyDuplicateFinder(DuplicateFinder* finder) {
+    pthread_mutex_lock(&finder->lock);
+    finder->cancel = true;
+    pthread_cond_broadcast(&finder->changed);
+    pthread_mutex_unlock(&finder->lock);
+    for (int i = 0; i < finder->workerCount; i++) {
+        pthread_join(finder->workers[i], NULL);
+    }
+
+    for (int i = 0; i < finder->stats.groups; i++) {
+        free(finder->groups[i]->files);
+        free(finder->groups[i]);
+    }
+    for (long long i = 0; i < finder->fileCount; i++) {
+        free(finder->files[i].path);
+    }
+    free(finder->groups);
+    free(finder->files);
+    free(finder->jobs);
+    free(finder->runs);
+    pthread_cond_destroy(&finder->changed);
+    pthread_mutex_destroy(&finder->lock);
+    memset(finder, 0, sizeof(DuplicateFinder));
+}
+
+/*
+================================================================================
+    RESULTS
+================================================================================
+*/
+
+int duplicateGroupCount(DuplicateFinder* finder) {
+    pthread_mutex_lock(&finder->lock);
+    int count = finder->stats.groups;
+    pthread_mutex_unlock(&finder->lock);
+    return count;
+}
+
+int waitForDuplicateGroups(DuplicateFinder* finder, int known) {
+    pthread_mutex_lock(&finder->lock);
+    while (finder->stats.groups <= known && !finder->stats.done) {
+        pthread_cond_wait(&finder->changed, &finder->lock);
+    }
+    int count = finder->stats.groups;
+    pthread_mutex_unlock(&finder->lock);
+    return count;
+}
+
+const DuplicateGroup* getDuplicateGroup(DuplicateFinder* finder, int index) {
+    pthread_mutex_lock(&finder->lock);
+    const DuplicateGroup* group = index >= 0 && index < finder->stats.groups ? finder->groups[index] : NULL;
+    pthread_mutex_unlock(&finder->lock);
+    return group;
+}
+
+void getDuplicateStats(DuplicateFinder* finder, DuplicateStats* stats) {
+    pthread_mutex_lock(&finder->lock);
+    *stats = finder->stats;
+    pthread_mutex_unlock(&finder->lock);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - PIPELINE
+================================================================================
+*/
+
+/**
+ * @brief Tree visitor that gathers every non-empty file
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _collectFile(Tree node, int depth, void* context) {
+    (void)depth;
+    CandidateList* list = context;
+    if (node->item.type != ITEM_FILE || node->item.size <= 0) {
+        return true;
+    }
+    if (list->count == list->capacity) {
+        long long capacity = list->capacity > 0 ? list->capacity * 2 : 256;
+        Tree* grown = realloc(list->nodes, sizeof(Tree) * (size_t)capacity);
+        if (grown == NULL) {
+            return false;
+        }
+        list->nodes = grown;
+        list->capacity = capacity;
+    }
+    list->nodes[list->count++] = node;
+    return true;
+}
+
+/**
+ * @brief Worker loop: hashes queued files and finishes the runs it completes
+ *
+ * A worker stays counted as active while it splits a finished run, so
+ * the others keep waiting for the stage 3 jobs that run may queue. The
+ * scan is done when the queue is empty and no worker is active.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void* _hashWorker(void* arg) {
+    DuplicateFinder* finder = (DuplicateFinder*)arg;
+    PROFILE_THREAD_NAME("duplicates");
+
+    // Tanpa buffer besar tetap bisa jalan dengan buffer stack yang cukup untuk tahap 2
+    unsigned char fallback[DUP_EDGE_BYTES * 2];
+    unsigned char* buffer = malloc(DUP_READ_CHUNK);
+    size_t bufferSize = buffer != NULL ? DUP_READ_CHUNK : sizeof(fallback);
+    if (buffer == NULL) {
+        buffer = fallback;
+    }
+
+    pthread_mutex_lock(&finder->lock);
+    while (true) {
+        while (finder->jobHead == finder->jobTail && finder->active > 0 && !finder->cancel) {
+            pthread_cond_wait(&finder->changed, &finder->lock);
+        }
+        if (finder->cancel || finder->jobHead == finder->jobTail) {
+            break;
+        }
+
+        long long index = finder->jobs[finder->jobHead++ % finder->fileCount];
+        DuplicateFile* file = &finder->files[index];
+        int runIndex = file->run;
+        bool full = finder->runs[runIndex].full;
+        finder->active++;
+        pthread_mutex_unlock(&finder->lock);
+
+        long long bytes = full ? _hashContents(finder, file, buffer, bufferSize) : _hashEdges(finder, file, buffer);
+
+        pthread_mutex_lock(&finder->lock);
+        finder->stats.hashed++;
+        finder->stats.bytesRead += bytes;
+        if (--finder->runs[runIndex].remaining == 0) {
+            DuplicateRun run = finder->runs[runIndex];
+            pthread_mutex_unlock(&finder->lock);
+            _finishRun(finder, run);
+            pthread_mutex_lock(&finder->lock);
+        }
+        finder->active--;
+        pthread_cond_broadcast(&finder->changed);
+    }
+
+    if (finder->active == 0 && !finder->stats.done) {
+        finder->stats.done = true;
+        logInfo("Duplikat: %d grup, %lld byte bisa dihemat, %lld byte dibaca\n",
+            finder->stats.groups, finder->stats.reclaimableBytes, finder->stats.bytesRead);
+        pthread_cond_broadcast(&finder->changed);
+    }
+    pthread_mutex_unlock(&finder->lock);
+
+    if (buffer != fallback) {
+        free(buffer);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Stage 2: hashes the first and last DUP_EDGE_BYTES (the whole file if smaller)
+ *
+ * @return long long Bytes read
+ *
+ * @internal
+ * @since 1.0
+ */
+static long long _hashEdges(DuplicateFinder* finder, DuplicateFile* file, unsigned char* buffer) {
+    (void)finder;
+    FILE* fp = _openCandidate(file);
+    if (fp == NULL) {
+        return 0;
+    }
+
+    HashState state;
+    _hashInit(&state);
+    long long bytes;
+    if (file->size <= 2 * DUP_EDGE_BYTES) {
+        size_t length = fread(buffer, 1, (size_t)file->size, fp);
+        bytes = (long long)length;
+        file->readable = bytes == file->size;
+        file->edgeHash = _hashFinal(&state, buffer, length);
+    }
+    else {
+        size_t head = fread(buffer, 1, DUP_EDGE_BYTES, fp);
+        _hashUpdate(&state, buffer, head);
+        bool ok = head == DUP_EDGE_BYTES && DUP_SEEK(fp, file->size - DUP_EDGE_BYTES, SEEK_SET) == 0;
+        size_t tail = ok ? fread(buffer, 1, DUP_EDGE_BYTES, fp) : 0;
+        bytes = (long long)(head + tail);
+        file->readable = ok && tail == DUP_EDGE_BYTES;
+        file->edgeHash = _hashFinal(&state, buffer, tail);
+    }
+    fclose(fp);
+    return bytes;
+}
+
+/**
+ * @brief Stage 3: hashes the whole file in DUP_READ_CHUNK reads
+ *
+ * @return long long Bytes read
+ *
+ * @internal
+ * @since 1.0
+ */
+static long long _hashContents(DuplicateFinder* finder, DuplicateFile* file,
+                               unsigned char* buffer, size_t bufferSize) {
+    PROFILE_FUNCTION();
+    FILE* fp = _openCandidate(file);
+    if (fp == NULL) {
+        return 0;
+    }
+
+    HashState state;
+    _hashInit(&state);
+    long long bytes = 0;
+    while (true) {
+        size_t length = fread(buffer, 1, bufferSize, fp);
+        bytes += (long long)length;
+        if (length < bufferSize) {
+            file->fullHash = _hashFinal(&state, buffer, length);
+            break;
+        }
+        _hashUpdate(&state, buffer, length);
+        if (_cancelled(finder)) {
+            file->readable = false;
+            break;
+        }
+    }
+    if (ferror(fp) || bytes != file->size) {
+        file->readable = false;
+    }
+    fclose(fp);
+    return bytes;
+}
+
+/**
+ * @brief Opens a candidate and checks that its size still matches the tree
+ *
+ * @return FILE* Stream at offset 0, or NULL (file marked unreadable)
+ *
+ * @internal
+ * @since 1.0
+ */
+static FILE* _openCandidate(DuplicateFile* file) {
+    FILE* fp = file->readable ? fopen(file->path, "rb") : NULL;
+    if (fp != NULL && (DUP_SEEK(fp, 0, SEEK_END) != 0 || DUP_TELL(fp) != file->size || DUP_SEEK(fp, 0, SEEK_SET) != 0)) {
+        logDebug("Duplikat: ukuran %s berubah sejak scan\n", file->path);
+        fclose(fp);
+        fp = NULL;
+    }
+    if (fp == NULL) {
+        file->readable = false;
+    }
+    return fp;
+}
+
+/**
+ * @brief Splits a fully hashed run by hash into groups or stage 3 runs
+ *
+ * Called without the lock; the finishing worker is the only one touching
+ * the run's files, so sorting them in place is safe.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _finishRun(DuplicateFinder* finder, DuplicateRun run) {
+    PROFILE_FUNCTION();
+    DuplicateFile* files = finder->files + run.start;
+    long long count = run.end - run.start;
+    qsort(files, (size_t)count, sizeof(DuplicateFile), run.full ? _compareFullHash : _compareEdgeHash);
+
+    for (long long i = 0, j; i < count; i = j) {
+        uint64_t hash = run.full ? files[i].fullHash : files[i].edgeHash;
+        for (j = i + 1; j < count && files[j].readable == files[i].readable &&
+                        (run.full ? files[j].fullHash : files[j].edgeHash) == hash; j++) {
+        }
+        if (j - i < 2 || !files[i].readable) {
+            continue;
+        }
+        // Hash tepi file kecil sudah mencakup seluruh isi
+        if (run.full || files[i].size <= 2 * DUP_EDGE_BYTES) {
+            _publishGroup(finder, files + i, (int)(j - i), hash);
+        }
+        else if (!_queueRun(finder, run.start + i, run.start + j, true)) {
+            logError("Duplikat: run tahap 3 gagal dibuat (memori)\n");
+        }
+    }
+}
+
+/**
+ * @brief Records a run and queues its files for hashing
+ *
+ * @return bool false if the run table could not grow
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _queueRun(DuplicateFinder* finder, long long start, long long end, bool full) {
+    pthread_mutex_lock(&finder->lock);
+    if (finder->runCount == finder->runCapacity) {
+        int capacity = finder->runCapacity > 0 ? finder->runCapacity * 2 : 64;
+        DuplicateRun* grown = realloc(finder->runs, sizeof(DuplicateRun) * (size_t)capacity);
+        if (grown == NULL) {
+            pthread_mutex_unlock(&finder->lock);
+            return false;
+        }
+        finder->runs = grown;
+        finder->runCapacity = capacity;
+    }
+
+    int index = finder->runCount++;
+    finder->runs[index] = (DuplicateRun){ start, end, end - start, full };
+    for (long long i = start; i < end; i++) {
+        finder->files[i].run = index;
+        // Satu file paling banyak punya satu job yang menunggu, ring cukup fileCount slot
+        finder->jobs[finder->jobTail++ % finder->fileCount] = i;
+    }
+    if (full) {
+        finder->stats.edgeCandidates += end - start;
+    }
+    pthread_cond_broadcast(&finder->changed);
+    pthread_mutex_unlock(&finder->lock);
+    return true;
+}
+
+/**
+ * @brief Publishes files with identical contents as one group, members sorted by path
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _publishGroup(DuplicateFinder* finder, DuplicateFile* files, int count, uint64_t hash) {
+    DuplicateGroup* group = malloc(sizeof(DuplicateGroup));
+    DuplicateFile** members = malloc(sizeof(DuplicateFile*) * (size_t)count);
+    if (group == NULL || members == NULL) {
+        logError("Duplikat: grup %s tidak disimpan (memori)\n", files[0].path);
+        free(group);
+        free(members);
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        members[i] = &files[i];
+    }
+    qsort(members, (size_t)count, sizeof(DuplicateFile*), _comparePath);
+    *group = (DuplicateGroup){ files[0].size, hash, members, count, files[0].size * (count - 1) };
+
+    pthread_mutex_lock(&finder->lock);
+    if (finder->stats.groups == finder->groupCapacity) {
+        int capacity = finder->groupCapacity > 0 ? finder->groupCapacity * 2 : 64;
+        DuplicateGroup** grown = realloc(finder->groups, sizeof(DuplicateGroup*) * (size_t)capacity);
+        if (grown == NULL) {
+            pthread_mutex_unlock(&finder->lock);
+            logError("Duplikat: grup %s tidak disimpan (memori)\n", files[0].path);
+            free(members);
+            free(group);
+            return;
+        }
+        finder->groups = grown;
+        finder->groupCapacity = capacity;
+    }
+    finder->groups[finder->stats.groups++] = group;
+    finder->stats.duplicateFiles += count - 1;
+    finder->stats.reclaimableBytes += group->reclaimableBytes;
+    pthread_cond_broadcast(&finder->changed);
+    pthread_mutex_unlock(&finder->lock);
+}
+
+/**
+ * @brief Reads the cancel flag under the lock
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _cancelled(DuplicateFinder* finder) {
+    pthread_mutex_lock(&finder->lock);
+    bool cancel = finder->cancel;
+    pthread_mutex_unlock(&finder->lock);
+    return cancel;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - COMPARATORS
+================================================================================
+*/
+
+/**
+ * @brief Orders tree nodes by size, largest first, so big reclaims are hashed first
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _compareSizeDesc(const void* a, const void* b) {
+    long sizeA = (*(const Tree*)a)->item.size;
+    long sizeB = (*(const Tree*)b)->item.size;
+    return (sizeA < sizeB) - (sizeA > sizeB);
+}
+
+/**
+ * @brief Orders files readable first, then by edge hash
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _compareEdgeHash(const void* a, const void* b) {
+    const DuplicateFile* fileA = a;
+    const DuplicateFile* fileB = b;
+    if (fileA->readable != fileB->readable) {
+        return fileA->readable ? -1 : 1;
+    }
+    return (fileA->edgeHash > fileB->edgeHash) - (fileA->edgeHash < fileB->edgeHash);
+}
+
+/**
+ * @brief Orders files readable first, then by full hash
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _compareFullHash(const void* a, const void* b) {
+    const DuplicateFile* fileA = a;
+    const DuplicateFile* fileB = b;
+    if (fileA->readable != fileB->readable) {
+        return fileA->readable ? -1 : 1;
+    }
+    return (fileA->fullHash > fileB->fullHash) - (fileA->fullHash < fileB->fullHash);
+}
+
+/**
+ * @brief Orders group members by path
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _comparePath(const void* a, const void* b) {
+    return strcmp((*(DuplicateFile* const*)a)->path, (*(DuplicateFile* const*)b)->path);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - XXH64
+================================================================================
+*/
+
+static inline uint64_t _rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t _read64(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t _read32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t _round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    acc = _rotl(acc, 31);
+    return acc * PRIME64_1;
+}
+
+static inline uint64_t _mergeRound(uint64_t acc, uint64_t value) {
+    acc ^= _round(0, value);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+/**
+ * @brief Starts an XXH64 hash with seed 0
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _hashInit(HashState* state) {
+    state->v[0] = PRIME64_1 + PRIME64_2;
+    state->v[1] = PRIME64_2;
+    state->v[2] = 0;
+    state->v[3] = 0 - PRIME64_1;
+    state->total = 0;
+}
+
+/**
+ * @brief Consumes the whole 32-byte stripes of data
+ *
+ * Callers pass multiples of 32 except in the final call; any remainder
+ * here is ignored, so it must go through _hashFinal() instead.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _hashUpdate(HashState* state, const unsigned char* data, size_t length) {
+    size_t stripes = length / 32;
+    for (size_t i = 0; i < stripes; i++, data += 32) {
+        state->v[0] = _round(state->v[0], _read64(data));
+        state->v[1] = _round(state->v[1], _read64(data + 8));
+        state->v[2] = _round(state->v[2], _read64(data + 16));
+        state->v[3] = _round(state->v[3], _read64(data + 24));
+    }
+    state->total += stripes * 32;
+}
+
+/**
+ * @brief Consumes the last bytes and returns the hash
+ *
+ * @internal
+ * @since 1.0
+ */
+static uint64_t _hashFinal(HashState* state, const unsigned char* data, size_t length) {
+    _hashUpdate(state, data, length);
+    size_t done = length - length % 32;
+    data += done;
+    length -= done;
+    uint64_t total = state->total + length;
+
+    uint64_t hash;
+    if (state->total >= 32) {
+        hash = _rotl(state->v[0], 1) + _rotl(state->v[1], 7) + _rotl(state->v[2], 12) + _rotl(state->v[3], 18);
+        for (int i = 0; i < 4; i++) {
+            hash = _mergeRound(hash, state->v[i]);
+        }
+    }
+    else {
+        hash = PRIME64_5;
+    }
+    hash += total;
+
+    for (; length >= 8; data += 8, length -= 8) {
+        hash ^= _round(0, _read64(data));
+        hash = _rotl(hash, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (length >= 4) {
+        hash ^= (uint64_t)_read32(data) * PRIME64_1;
+        hash = _rotl(hash, 23) * PRIME64_2 + PRIME64_3;
+        data += 4;
+        length -= 4;
+    }
+    for (; length > 0; data++, length--) {
+        hash ^= (*data) * PRIME64_5;
+        hash = _rotl(hash, 11) * PRIME64_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
@@ -2,32 +2,51 @@
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
+#include <stdint.h>
 #include <dirent.h>
 #include <errno.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 
+#include "hashmap.h"
 #include "nbtree.h"
 #include "queue.h"
 #include "stack.h"
 
-#include "raylib.h"
-
 #include "file_manager.h"
 #include "item.h"
+#include "logger.h"
+#include "mem_stats.h"
 #include "operation.h"
+#include "profiler.h"
 #include "utils.h"
 #include "win_utils.h"
-#include "ctx.h"
-
-#include "gui/component.h"
-#include "gui/navbar.h"
-#include "gui/sidebar.h"
+#include "copy_engine.h"
 
 #define _DIR ".dir/"
 #define ROOT ".dir/root"
 #define TRASH ".dir/trash"
 #define TRASH_DUMP ".dir/.trash"
+#define TRASH_JOURNAL ".dir/.trash.journal"
+#define OP_JOURNAL ".dir/.oplog"
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+typedef struct SyncStats {
+    time_t startedAt;  // Detik awal refresh, untuk deteksi mtime yang ambigu
+    int dirsRead;      // Folder yang isinya dibaca ulang
+    int dirsSkipped;   // Folder dengan mtime sama, tidak dibaca
+    int inserted;
+    int removed;
+    int updated;
+} SyncStats;
+
+// Entry direktori yang sudah dibaca (load, reload, sync), hanya dari thread UI
+static long long scannedEntries = 0;
 
 /*
 ================================================================================
@@ -36,30 +55,42 @@
 */
 
 // TRASH OPERATIONS
-static void _moveToTrash(FileManager* fm, Tree itemTree);                   // Move item to trash with UID
+static TrashItem* _moveToTrash(FileManager* fm, Tree itemTree);             // Move item to trash with UID
+static TrashItem* _trashNode(FileManager* fm, Tree itemTree);               // Move to trash, leave tree untouched
 static void _deletePermanently(char* fullPath, ItemType type, char* name);  // Delete from filesystem
 static void _deleteSingleItem(char* fullPath, ItemType type, char* name);   // Delete individual item
-static void _removeFromTrash(FileManager* fm, char* itemName);              // Remove from trash list
 static void _removeFromTrashByUID(FileManager* fm, char* uid);              // Remove by unique ID
+static char* _recoveryPath(TrashItem* trashItem);                          // Free restore location for item
+
+// JOURNAL OPERATIONS
+static void _pushUndo(FileManager* fm, Operation* operation);                                    // Push to undo stack and journal it
+static void _recoverIncompleteOperations(FileManager* fm);                                       // Resolve operations cut off by a crash
+static bool _recoverStep(FileManager* fm, OpJournalIncomplete* incomplete, OpJournalStep* step); // Roll one logged item back or forward
+
+// BATCH OPERATIONS
+static int _collectClipboard(FileManager* fm, Item*** items);                            // Clipboard handles -> live Item*
+static void _clearClipboard(FileManager* fm);                                           // Free clipboard handles
+static void _resolveNodes(Tree root, Item** items, int count, Tree* nodes);             // Find all nodes in one traversal
+static void _detachNodes(FileManager* fm, Tree* nodes, int count);                      // Unlink nodes, one pass per parent
 
 // FILE OPERATIONS
-static void _copyFileContent(char* srcPath, char* destPath);                // Copy file data
-static void _copyFolderRecursive(char* srcPath, char* destPath);            // Recursively copy folder
+static bool _copyFileContent(char* srcPath, char* destPath, CopyStats* stats);      // Copy file data (sparse aware)
+static void _copyFolderRecursive(char* srcPath, char* destPath, CopyStats* stats);  // Recursively copy folder
 static void _loadTree(Tree tree, char* path);                               // Load filesystem into tree
-static void _loadTrashFromFile(LinkedList* trash);                          // Load trash from persistent storage
+static void _loadTrashFromFile(TrashStore* trash);                          // Load legacy CSV trash (migration)
 static void _destroyTree(Tree* tree);                                       // Free tree memory recursively
 
 // TREE OPERATIONS
 static void _addBackToTree(FileManager* fm, TrashItem* trashItem, char* recoverPath);                               // Restore item to tree
-static void remove_node(Tree* root, Tree nodeToRemove);                                                             // Remove node from tree
+static void remove_node(FileManager* fm, Tree nodeToRemove);                                                        // Remove node and subtree
 static void _reconstructTreeStructure(FileManager* fm, Tree sourceTree, char* newBasePath, char* destinationPath);  // Rebuild tree after operation
-static void _loadTreeFromPath(Tree parentNode, char* basePath);                                                     // Populate tree from filesystem
+static void _loadTreeFromPath(Tree parentNode, const char* basePath);                                               // Populate tree from filesystem
 static void _addBackToTreeFromTrash(FileManager* fm, TrashItem* trashItem, char* recoverPath);                      // Restore from trash to tree
 static void _addTreeStructureRecursive(Tree parentNode, char* folderPath);                                          // Recursively build tree structure
 
 // PATH UTILITIES
-static char* _createDuplicatedFolderName(char* dirPath, char* suffix);      // Generate unique folder name
-static char* _createDuplicatedFileName(char* filePath, char* suffix);       // Generate unique file name
+static char* _createDuplicatedFolderName(const char* dirPath, const char* suffix);  // Generate unique folder name
+static char* _createDuplicatedFileName(const char* filePath, const char* suffix);   // Generate unique file name
 static bool _isDirectory(char* path);                                       // Check if path is directory
 static char* _getDirectoryFromPath(char* path);                             // Extract directory from path
 static char* _convertToUnixPath(char* path);                                // Convert Windows to Unix path
@@ -79,28 +110,26 @@ static void _redoPaste(FileManager* fm, Operation* op, Operation* opToUndo);
 static void _redoRecover(FileManager* fm, Operation* op, Operation* opToUndo);       // Redo recovery operation
 
 // PASTE OPERATIONS
-static int _calculateTotalPasteItems(FileManager* fm);                                                // Count clipboard items
-static bool _processSinglePasteItem(FileManager* fm, Item* itemToPaste, char** originPath);           // Validate paste item
+static bool _processSinglePasteItem(FileManager* fm, Item* itemToPaste, Tree sourceNode, char** originPath);  // Validate paste item
 static bool _pasteFolderItem(FileManager* fm, Item* itemToPaste, char* originPath, char* newPath);    // Handle folder paste
 static bool _pasteFileItem(FileManager* fm, Item* itemToPaste, char* originPath, char* newPath);      // Handle file paste
 static void _addItemToCurrentTree(FileManager* fm, Item* itemToPaste, char* newPath, ItemType type);  // Add pasted item to tree
-static void _handleCutCleanup(FileManager* fm, Item* itemToPaste);                                    // Clean up after cut operation
 static void _createPasteItemRecord(Item* itemToPaste, char* originPath);                              // Create operation record
 
 // SELECTION OPERATIONS
-static bool _isItemEqual(Item* item1, Item* item2);                         // Compare items for equality
-static void _freeSelectedNode(Node* node);                                  // Free selection node memory
 static void _cleanupInvalidSelections(FileManager* fm);                     // Remove invalid selections
 
 // REFRESH OPERATIONS
-static void _refreshTreeSafely(FileManager* fm, char* targetPath);          // Safely refresh tree structure
+static void _refreshTreeSafely(FileManager* fm, Tree targetNode);           // Merge filesystem changes into tree
+static void _syncFolder(FileManager* fm, Tree folder, SyncStats* stats);    // Reconcile one folder, recurse into subfolders
+static void _dropSyncedChild(FileManager* fm, Tree folder, Tree child);     // Free an unlinked child and its subtree
+static void _forgetSubtree(FileManager* fm, Tree node);                     // Drop selection/search refs into subtree
+static void _markRacyFolders(FileManager* fm, Tree folder, time_t scanStart); // Remember folders whose mtime can't prove freshness
 static Tree _findNodeByPath(Tree root, char* targetPath);                   // Find node by path string
-static void _refreshSidebarSafely(FileManager* fm);                         // Refresh sidebar with state preservation
-static bool _isValidTreeNode(Tree root, Tree target);                       // Validate tree node existence
 
 // SEARCH OPERATIONS
-static void _searchingTreeItemRecursive(LinkedList* linkedList, Tree tree, char* keyword);  // Recursive tree search
-static void _searchingLinkedListRecursive(FileManager* fm, Node* node, char* keyword);      // Recursive list search
+static void _searchingTreeItem(LinkedList* linkedList, Tree tree, char* keyword);          // Iterative subtree search
+static void _searchingTrashList(FileManager* fm, TrashNode* node, char* keyword);           // Trash list search
 static void _copyToClipboard(FileManager* fm);                                              // Copy selections to clipboard
 
 // UTILITY FUNCTIONS
@@ -125,20 +154,25 @@ static bool _isExternalPath(char* path);                                    // C
 
 void createFileManager(FileManager* fm) {
     create_tree(&(fm->root));
-    create_list(&(fm->trash));
-    create_stack(&(fm->undo));
-    create_stack(&(fm->redo));
+    createTrashStore(&(fm->trash));
+    createUndoHistory(&(fm->undo), loadUndoBudget());
+    createUndoHistory(&(fm->redo), loadUndoBudget());
     create_queue(&(fm->copied));
     create_queue(&(fm->clipboard));
-    create_list(&(fm->selectedItem));
+    createSelectionSet(&(fm->selectedItem));
     create_list(&(fm->searchingList));
+    create_pointer_hashmap(&(fm->racyFolders));
     fm->isRootTrash = false;
     fm->isSearching = false;
     fm->needsRefresh = false;
+    fm->lastRetentionCheck = 0;
+    fm->opJournal.fd = -1;
+    fm->activeOperation = 0;
+    resetCopyStats(&fm->lastPasteStats);
     fm->isCopy = false;
     fm->currentPath = NULL;
     fm->treeCursor = NULL;
-    fm->ctx = NULL;
+    fm->hooks = (FileManagerHooks){ NULL, NULL, NULL, NULL, NULL };
 }
 
 void initFileManager(FileManager* fm) {
@@ -150,52 +184,75 @@ void initFileManager(FileManager* fm) {
 
         fm->treeCursor = fm->root;
 
-        _loadTree(fm->treeCursor, ROOT);
+        bool hasJournal = fileExists(TRASH_JOURNAL);
+        openTrashJournal(&(fm->trashJournal), TRASH_JOURNAL, &(fm->trash));
+
+        // Migrasi satu kali dari format CSV lama
+        if (!hasJournal && fileExists(TRASH_DUMP)) {
+            _loadTrashFromFile(&(fm->trash));
+            if (trashJournalRewrite(&(fm->trashJournal), &(fm->trash))) {
+                remove(TRASH_DUMP);
+                logInfo("Trash CSV lama dimigrasikan ke %s\n", TRASH_JOURNAL);
+            }
+        }
 
-        _loadTrashFromFile(&(fm->trash));
+        // Operasi yang terputus diselesaikan sebelum tree dimuat dari disk
+        openOpJournal(&(fm->opJournal), OP_JOURNAL, &(fm->undo));
+        _recoverIncompleteOperations(fm);
+        opJournalCheckpoint(&(fm->opJournal), &(fm->undo));
+
+        time_t loadStart = time(NULL);
+        _loadTree(fm->treeCursor, ROOT);
+        _markRacyFolders(fm, fm->treeCursor, loadStart);
 
-        printf("\n\n");
+        loadTrashRetention(&(fm->trashRetention));
+        startTrashPurger(&(fm->trashPurger), &(fm->trashJournal));
     }
 }
 
 void refreshFileManager(FileManager* fm) {
-    // Refresh sidebar dengan cara yang aman
-    if (fm->ctx && fm->ctx->sidebar) {
-        printf("[LOG] Refreshing sidebar...\n");
-        _refreshSidebarSafely(fm);
-        printf("[LOG] Sidebar refreshed successfully\n");
+    // Front-end membangun ulang tampilan turunan (sidebar) dari tree
+    if (fm->hooks.treeChanged) {
+        logDebug("Refreshing sidebar...\n");
+        fm->hooks.treeChanged(fm, fm->hooks.userData);
+        logDebug("Sidebar refreshed successfully\n");
     }
 }
 
-void saveTrashToFile(FileManager* fm) {
-    FILE* trashFile = fopen(TRASH_DUMP, "w");
-    if (trashFile == NULL) {
-        perror("[ERROR] Gagal membuka file trash untuk menulis");
+void syncFileManager(FileManager* fm) {
+    PROFILE_FUNCTION();
+    if (!fm || !fm->treeCursor || fm->isRootTrash) {
+        refreshFileManager(fm);
         return;
     }
 
-    Node* current = fm->trash.head;
-    while (current != NULL) {
-        TrashItem* trashItem = (TrashItem*)current->data;
-        if (trashItem && trashItem->uid && trashItem->item.name && trashItem->originalPath) {
-            // Format: UID,originalName,originalPath,deletedTime
-            fprintf(trashFile, "%s,%s,%s,%ld\n",
-                trashItem->uid,
-                trashItem->item.name, // Nama asli untuk display
-                trashItem->originalPath,
-                trashItem->deletedTime); // Waktu dihapus
-        }
-        current = current->next;
+    // Folder aktif bisa sudah dihapus dari luar; naik ke induk yang masih ada
+    Tree target = fm->treeCursor;
+    while (target->parent != NULL && !directoryExists(target->item.path)) {
+        target = target->parent;
     }
+    Tree cursor = fm->treeCursor;
+    _refreshTreeSafely(fm, target);
 
-    fclose(trashFile);
-    printf("[LOG] Trash data saved with UID as primary key and deleted time\n");
+    if (fm->treeCursor != cursor) {
+        // Cursor ikut terhapus; goTo memperbarui path dan sidebar
+        goTo(fm, fm->treeCursor);
+    }
+    else {
+        refreshFileManager(fm);
+    }
 }
 
-void printTrash(LinkedList trash) {
-    Node* current = trash.head;
+void saveTrashToFile(FileManager* fm) {
+    // Perubahan trash sudah di-append ke journal; cukup flush batch dan kompaksi bila perlu
+    trashJournalSync(&fm->trashJournal);
+    trashJournalMaybeCompact(&fm->trashJournal, &fm->trash);
+}
+
+void printTrash(const TrashStore* trash) {
+    TrashNode* current = trash->head;
     if (current == NULL) {
-        printf("[LOG] Trash is empty\n");
+        logInfo("Trash is empty\n");
         return;
     }
 
@@ -206,7 +263,7 @@ void printTrash(LinkedList trash) {
         "----", "------------", "-------------", "------------", "----");
 
     while (current != NULL) {
-        TrashItem* trashItem = (TrashItem*)current->data;
+        TrashItem* trashItem = current->data;
         if (trashItem != NULL) {
             // Convert deleted time to readable format
             struct tm* timeinfo = localtime(&trashItem->deletedTime);
@@ -231,7 +288,7 @@ void printTrash(LinkedList trash) {
 ================================================================================
 */
 
-void createFile(FileManager* fm, ItemType type, char* dirPath, char* name, bool isOperation) {
+void createFile(FileManager* fm, ItemType type, const char* dirPath, char* name, bool isOperation) {
     Item newItem;
     char* path;
     char* currentFullPath;
@@ -241,7 +298,7 @@ void createFile(FileManager* fm, ItemType type, char* dirPath, char* name, bool
     Operation* newOperation;
 
     if (strlen(name) + 1 >= 255) {
-        printf("[LOG] nama file terlalu panjang, gagal membuat file\n");
+        logError("nama file terlalu panjang, gagal membuat file\n");
         return;
     }
 
@@ -251,29 +308,35 @@ void createFile(FileManager* fm, ItemType type, char* dirPath, char* name, bool
         currentNode = fm->treeCursor;
     } else {
         currentNode = searchTree(fm->root,
-            createItem(getNameFromPath(currentFullPath), currentFullPath, 0, ITEM_FOLDER, 0, 0, 0));
+            createItemKey(getNameFromPath(currentFullPath), currentFullPath, ITEM_FOLDER));
     }
-    // printf("[LOG] \ncurrent path: %s\n", currentFullPath);
-    // printf("[LOG] current name: %s\n", getNameFromPath(currentFullPath));
+    // logInfo("\ncurrent path: %s\n", currentFullPath);
+    // logInfo("current name: %s\n", getNameFromPath(currentFullPath));
     if (currentNode != NULL) {
-        path = TextFormat("%s/%s", currentFullPath, name);
+        path = strdup(formatText("%s/%s", currentFullPath, name));
         createdTime = time(NULL);
         if (type == ITEM_FOLDER) {
-            if (DirectoryExists(path)) {
-                path = _createDuplicatedFolderName(path, "(1)");
+            if (directoryExists(path)) {
+                char* uniquePath = _createDuplicatedFolderName(path, "(1)");
+                free(path);
+                path = uniquePath;
             }
-            if (MakeDirectory(path) != 0) {
-                printf("[LOG] Gagal membuat folder\n");
+            if (makeDirectory(path) != 0) {
+                logError("Gagal membuat folder\n");
+                free(path);
                 return;
             }
         }
         else if (type == ITEM_FILE) {
-            if (FileExists(path)) {
-                path = _createDuplicatedFileName(path, "(1)");
+            if (fileExists(path)) {
+                char* uniquePath = _createDuplicatedFileName(path, "(1)");
+                free(path);
+                path = uniquePath;
             }
             newFile = fopen(path, "w");
             if (newFile == NULL) {
-                printf("[LOG] Gagal membuat file %s\n", name);
+                logError("Gagal membuat file %s\n", name);
+                free(path);
                 return;
             }
             fclose(newFile);
@@ -282,93 +345,123 @@ void createFile(FileManager* fm, ItemType type, char* dirPath, char* name, bool
         if (isOperation) {
             newOperation = alloc(Operation);
             *newOperation = createOperation(path, NULL, ACTION_CREATE, false, NULL);
-            push(&fm->undo, newOperation);
+            _pushUndo(fm, newOperation);
         }
         newItem = createItem(getNameFromPath(path), path, 0, type, createdTime, createdTime, -1);
         insert_node(currentNode, newItem);
+        free(path);
 
         refreshFileManager(fm);
     }
     else {
-        printf("[LOG] Direktori parent tidak ditemukan : %s\n", dirPath);
+        logWarn("Direktori parent tidak ditemukan : %s\n", dirPath);
     }
 }
 
 void deleteFile(FileManager* fm, bool isOperation) {
-    Operation* deleteOperation;
     if (fm->selectedItem.head == NULL) {
-        printf("[LOG] Tidak ada file yang dipilih untuk dihapus\n");
+        logWarn("Tidak ada file yang dipilih untuk dihapus\n");
         return;
     }
 
-    Node* temp = fm->selectedItem.head;
+    Item** items = NULL;
+    int count = selectionSetToArray(&fm->selectedItem, &items);
+    deleteItems(fm, items, count, isOperation);
+    free(items);
+}
+
+int deleteItems(FileManager* fm, Item** items, int count, bool isOperation) {
+    PROFILE_FUNCTION();
+    Operation* deleteOperation = NULL;
+    int deleted = 0;
+    if (count <= 0) {
+        return 0;
+    }
+
+    // Satu kali telusur tree untuk semua item
+    Tree* nodes = calloc(count, sizeof(Tree));
+    if (nodes == NULL) {
+        logError("Overflow, Memory allocation failed\n");
+        return 0;
+    }
+    _resolveNodes(fm->root, items, count, nodes);
+
     if (isOperation) {
         deleteOperation = alloc(Operation);
         *deleteOperation = createOperation(NULL, NULL, ACTION_DELETE, false, NULL);
         deleteOperation->itemTemp = alloc(Queue);
         create_queue(&(*(deleteOperation->itemTemp)));
     }
-    while (temp != NULL) {
-        Item* itemToDelete = (Item*)temp->data;
-        Tree foundTree = searchTree(fm->root, *itemToDelete);
+
+    // Kerja filesystem; tree belum disentuh
+    fm->activeOperation = opJournalBegin(&fm->opJournal, ACTION_DELETE, false);
+    for (int i = 0; i < count; i++) {
+        Tree foundTree = nodes[i];
         if (foundTree == NULL) {
-            printf("[LOG] File %s tidak ditemukan\n", itemToDelete->name);
-            temp = temp->next;
+            logWarn("File %s tidak ditemukan\n", items[i]->name);
+            continue;
+        }
+
+        Item deletedItem = foundTree->item;
+        TrashItem* movedItem = _trashNode(fm, foundTree);
+        if (movedItem == NULL) {
+            nodes[i] = NULL;
             continue;
         }
+        deleted++;
 
-        // printf("[LOG] File berhasil dipindah ke trash\n");
-        // Tambahkan item ke queue dalam operasi
+        // Tambahkan item ke queue dalam operasi, lengkap dengan lokasi fisiknya di trash
         if (isOperation) {
             TrashItem* trashItem = alloc(TrashItem);
-            trashItem->item = foundTree->item;
-            trashItem->originalPath = strdup(foundTree->item.path);
-            trashItem->trashPath = strdup(TextFormat("%s/%s", TRASH, foundTree->item.name));
+            trashItem->item = createItem(deletedItem.name, deletedItem.path, deletedItem.size, deletedItem.type,
+                deletedItem.created_at, deletedItem.updated_at, movedItem->deletedTime);
+            trashItem->originalPath = strdup(deletedItem.path);
+            trashItem->trashPath = strdup(movedItem->trashPath);
+            trashItem->uid = strdup(movedItem->uid);
+            trashItem->deletedTime = movedItem->deletedTime;
             enqueue(deleteOperation->itemTemp, trashItem);
-            printf("[LOG] Operasi delete berhasil dibuat dengan origin path:%s\n", trashItem->originalPath);
         }
-
-        _moveToTrash(fm, foundTree);
-        temp = temp->next;
     }
+    opJournalEnd(&fm->opJournal, fm->activeOperation);
+    fm->activeOperation = 0;
 
-    push(&fm->undo, deleteOperation);
+    // Commit: seleksi dilepas sebelum node dibebaskan, lalu tree dan sidebar sekali jalan
     clearSelectedFile(fm);
-    printf("[LOG] File berhasil dipindah ke trash\n");
+    _detachNodes(fm, nodes, count);
+    free(nodes);
+
+    if (isOperation) {
+        _pushUndo(fm, deleteOperation);
+    }
+    saveTrashToFile(fm);
+    refreshFileManager(fm);
+    logInfo("%d dari %d item berhasil dipindah ke trash\n", deleted, count);
+    return deleted;
 }
 
 void deletePermanentFile(FileManager* fm) {
+    PROFILE_FUNCTION();
     if (fm->selectedItem.head == NULL) {
-        printf("[LOG] Tidak ada file yang dipilih untuk dihapus secara permanen\n");
+        logWarn("Tidak ada file yang dipilih untuk dihapus secara permanen\n");
         return;
     }
 
-    Node* temp = fm->selectedItem.head;
+    SelectionNode* temp = fm->selectedItem.head;
     while (temp != NULL) {
         Item* itemToDelete = (Item*)temp->data;
 
-        Node* trashNode = fm->trash.head;
-        TrashItem* foundTrashItem = NULL;
-
-        while (trashNode != NULL) {
-            TrashItem* trashItem = (TrashItem*)trashNode->data;
-            if (strcmp(trashItem->item.name, itemToDelete->name) == 0 &&
-                strcmp(trashItem->item.path, itemToDelete->path) == 0) {
-                foundTrashItem = trashItem;
-                break;
-            }
-            trashNode = trashNode->next;
-        }
+        // Item di trash view adalah &TrashItem->item, lookup O(1)
+        TrashItem* foundTrashItem = trashStoreFindByItem(&fm->trash, itemToDelete);
 
         if (foundTrashItem == NULL) {
-            printf("[LOG] Item %s tidak ditemukan di trash, dilewati\n", itemToDelete->name);
+            logWarn("Item %s tidak ditemukan di trash, dilewati\n", itemToDelete->name);
             temp = temp->next;
             continue;
         }
 
         if (foundTrashItem->item.type == ITEM_FILE) {
             if (remove(foundTrashItem->item.path) != 0) {
-                printf("[LOG] Gagal menghapus file %s (Error: %d)\n", foundTrashItem->item.name, errno);
+                logError("Gagal menghapus file %s (Error: %d)\n", foundTrashItem->item.name, errno);
                 temp = temp->next;
                 continue;
             }
@@ -376,13 +469,13 @@ void deletePermanentFile(FileManager* fm) {
         else if (foundTrashItem->item.type == ITEM_FOLDER) {
             char* fullPath = _getFullWindowsPath(foundTrashItem->item.path);
             if (fullPath == NULL) {
-                printf("[LOG] Gagal mendapatkan full path folder %s\n", foundTrashItem->item.name);
+                logError("Gagal mendapatkan full path folder %s\n", foundTrashItem->item.name);
                 temp = temp->next;
                 continue;
             }
 
             if (RemoveItemsRecurse(fullPath) != 1) {
-                printf("[LOG] Gagal menghapus folder %s\n", foundTrashItem->item.name);
+                logError("Gagal menghapus folder %s\n", foundTrashItem->item.name);
                 free(fullPath);
                 temp = temp->next;
                 continue;
@@ -396,7 +489,8 @@ void deletePermanentFile(FileManager* fm) {
     }
 
     clearSelectedFile(fm);
-    printf("[LOG] File berhasil dihapus secara permanen\n");
+    saveTrashToFile(fm);
+    logInfo("File berhasil dihapus secara permanen\n");
 }
 
 void renameFile(FileManager* fm, char* filePath, char* newName, bool isOperation) {
@@ -404,47 +498,56 @@ void renameFile(FileManager* fm, char* filePath, char* newName, bool isOperation
     Tree foundTree;
     char* newPath;
     Operation* operationToUndo;
-    if (isOperation) {
-        operationToUndo = alloc(Operation);
-    }
     // Cari item
-    item = createItem(getNameFromPath(filePath), filePath, 0, 0, 0, 0, 0);
+    item = createItemKey(getNameFromPath(filePath), filePath, ITEM_FOLDER);
     foundTree = searchTree(fm->treeCursor, item);
     if (foundTree == NULL) {
-        printf("[LOG] File tidak ditemukan\n");
+        logWarn("File tidak ditemukan\n");
         return;
     }
-    newPath = TextFormat("%s/%s", _getDirectoryFromPath(filePath), newName);
+    newPath = strdup(formatText("%s/%s", _getDirectoryFromPath(filePath), newName));
     // rename file
+    char* uniquePath = NULL;
     if (foundTree->item.type == ITEM_FILE) {
-        if (DirectoryExists(newPath)) {
-            newPath = _createDuplicatedFileName(newPath, "(1)");
+        if (directoryExists(newPath)) {
+            uniquePath = _createDuplicatedFileName(newPath, "(1)");
         }
     }
     else if (foundTree->item.type == ITEM_FILE) {
-        if (FileExists(newPath)) {
-            newPath = _createDuplicatedFolderName(newPath, "(1)");
+        if (fileExists(newPath)) {
+            uniquePath = _createDuplicatedFolderName(newPath, "(1)");
         }
     }
+    if (uniquePath != NULL) {
+        free(newPath);
+        newPath = uniquePath;
+    }
     if (isOperation) {
         // Simpan operasi untuk undo
+        operationToUndo = alloc(Operation);
         *operationToUndo = createOperation(filePath, newPath, ACTION_UPDATE, false, NULL);
         operationToUndo->isDir = (foundTree->item.type == ITEM_FOLDER);
         operationToUndo->itemTemp = NULL;
-        push(&fm->undo, operationToUndo);
+        _pushUndo(fm, operationToUndo);
     }
     rename(filePath, newPath);
 
-    // update item
-    foundTree->item.name = strdup(newName);
-    foundTree->item.path = strdup(newPath);
+    // update item, string lama dibebaskan setelah yang baru disalin
+    char* oldName = foundTree->item.name;
+    char* oldPath = foundTree->item.path;
+    foundTree->item.name = itemStrdup(newName);
+    foundTree->item.path = itemStrdup(newPath);
+    freeItemString(oldName);
+    freeItemString(oldPath);
+    free(newPath);
 
-    printf("[LOG] File berhasil diubah namanya menjadi %s\n", newName);
+    logInfo("File berhasil diubah namanya menjadi %s\n", newName);
 }
 
 void recoverFile(FileManager* fm) {
+    PROFILE_FUNCTION();
     if (fm->selectedItem.head == NULL) {
-        printf("[LOG] Tidak ada file yang dipilih untuk di-recover\n");
+        logWarn("Tidak ada file yang dipilih untuk di-recover\n");
         return;
     }
 
@@ -452,89 +555,105 @@ void recoverFile(FileManager* fm) {
     *recoverOperation = createOperation(NULL, NULL, ACTION_RECOVER, false, NULL);
     recoverOperation->itemTemp = alloc(Queue);
     create_queue(&(*(recoverOperation->itemTemp)));
-    Node* temp = fm->selectedItem.head;
+    long long seq = opJournalBegin(&fm->opJournal, ACTION_RECOVER, false);
+    SelectionNode* temp = fm->selectedItem.head;
     while (temp != NULL) {
         Item* itemToRecover = (Item*)temp->data;
 
-        // Cari di LinkedList trash berdasarkan UID atau nama display
-        Node* trashNode = fm->trash.head;
-        TrashItem* foundTrashItem = NULL;
-
-        while (trashNode != NULL) {
-            TrashItem* trashItem = (TrashItem*)trashNode->data;
-            // Match berdasarkan nama display dan path untuk identifikasi unik
-            if (strcmp(trashItem->item.name, itemToRecover->name) == 0 &&
-                strcmp(trashItem->item.path, itemToRecover->path) == 0) {
-                foundTrashItem = trashItem;
-                break;
-            }
-            trashNode = trashNode->next;
-        }
+        // Cari di trash store berdasarkan identitas item (O(1))
+        TrashItem* foundTrashItem = trashStoreFindByItem(&fm->trash, itemToRecover);
 
         if (foundTrashItem == NULL) {
-            printf("[LOG] File %s tidak ditemukan di trash\n", itemToRecover->name);
+            logWarn("File %s tidak ditemukan di trash\n", itemToRecover->name);
             temp = temp->next;
             continue;
         }
 
-        // Tentukan path recovery - ke original path
-        char* recoverPath = strdup(foundTrashItem->originalPath);
-
-        // Handle nama duplikat di lokasi recovery
-        if (FileExists(recoverPath) || DirectoryExists(recoverPath)) {
-            char* dirPath = _getDirectoryFromPath(recoverPath);
-            char* originalName = foundTrashItem->item.name;
-
-            if (foundTrashItem->item.type == ITEM_FOLDER) {
-                recoverPath = TextFormat("%s/%s(recovered)", dirPath, originalName);
-                if (DirectoryExists(recoverPath)) {
-                    recoverPath = _createDuplicatedFolderName(recoverPath, "(1)");
-                }
-            }
-            else {
-                recoverPath = _createDuplicatedFileName(recoverPath, "(recovered)");
-            }
-        }
-
-        // Simpan operasi untuk undo
-        enqueue(&(*recoverOperation->itemTemp), foundTrashItem);
+        // Tentukan path recovery - ke original path, atau nama "(recovered)" bila sudah terpakai
+        char* recoverPath = _recoveryPath(foundTrashItem);
 
         // Move dari trash ke lokasi recovery
+        opJournalStep(&fm->opJournal, seq, foundTrashItem->item.type, foundTrashItem->trashPath, recoverPath, foundTrashItem->uid);
         if (rename(foundTrashItem->trashPath, recoverPath) == 0) {
-            printf("[LOG] File '%s' berhasil di-recover ke %s (UID: %s)\n",
+            logInfo("File '%s' berhasil di-recover ke %s (UID: %s)\n",
                 foundTrashItem->item.name, recoverPath, foundTrashItem->uid);
 
-            // Hapus dari LinkedList trash
-            _removeFromTrashByUID(fm, foundTrashItem->uid);
+            // Lepas dari trash store; TrashItem sekarang dimiliki operasi recover
+            trashStoreRemove(&fm->trash, foundTrashItem);
+            enqueue(&(*recoverOperation->itemTemp), foundTrashItem);
+            trashJournalAppendRemove(&fm->trashJournal, foundTrashItem->uid);
+
+            opJournalStepDone(&fm->opJournal, seq);
 
             // Tambah kembali ke tree dengan path recovery
             _addBackToTreeFromTrash(fm, foundTrashItem, recoverPath);
         }
         else {
-            printf("[LOG] Gagal me-recover file %s (UID: %s)\n",
+            logError("Gagal me-recover file %s (UID: %s)\n",
                 foundTrashItem->item.name, foundTrashItem->uid);
         }
+        free(recoverPath);
 
         temp = temp->next;
     }
+    opJournalEnd(&fm->opJournal, seq);
 
     clearSelectedFile(fm);
+    // Recover tidak masuk riwayat undo; bebaskan item yang sudah lepas dari trash
+    destroyOperation(recoverOperation);
 
     // Save perubahan trash
     saveTrashToFile(fm);
 }
 
+void enforceTrashRetention(FileManager* fm) {
+    PROFILE_FUNCTION();
+    time_t now = time(NULL);
+    if (now - fm->lastRetentionCheck < TRASH_RETENTION_CHECK_INTERVAL) {
+        return;
+    }
+    fm->lastRetentionCheck = now;
+
+    // Hasil pencarian di trash menyimpan pointer ke item trash
+    if (fm->isSearching && fm->isRootTrash) {
+        return;
+    }
+
+    // Item yang gagal di-purge sebelumnya kembali ke trash dan dicoba lagi
+    trashPurgerReclaim(&fm->trashPurger, &fm->trash);
+
+    int queued = 0;
+    while (queued < TRASH_RETENTION_BATCH && isTrashOverRetention(&fm->trashRetention, &fm->trash, now)) {
+        TrashItem* oldest = fm->trash.tail->data;
+        if (selectionSetContains(&fm->selectedItem, &oldest->item)) {
+            break;
+        }
+
+        trashStoreRemove(&fm->trash, oldest);
+        trashPurgerSubmit(&fm->trashPurger, oldest);
+        queued++;
+    }
+
+    if (queued == TRASH_RETENTION_BATCH) {
+        // Masih ada sisa, lanjutkan di frame berikutnya
+        fm->lastRetentionCheck = 0;
+    }
+    if (queued > 0) {
+        logInfo("Retensi trash: %d item lama diantrikan untuk purge\n", queued);
+    }
+}
+
 Item searchFile(FileManager* fm, char* path) {
     Item item = { 0 };
     Item itemToSearch;
     Tree foundTree;
 
-    itemToSearch = createItem(getNameFromPath(path), path, 0, ITEM_FILE, 0, 0, 0);
+    itemToSearch = createItemKey(getNameFromPath(path), path, ITEM_FILE);
 
     foundTree = searchTree(fm->root, itemToSearch);
 
     if (foundTree == NULL) {
-        printf("[LOG] File tidak ditemukan\n");
+        logWarn("File tidak ditemukan\n");
         return item;
     }
     item = foundTree->item;
@@ -544,82 +663,79 @@ Item searchFile(FileManager* fm, char* path) {
 void importFile(FileManager* fm, char* sourcePath, bool isOperation) {
     sourcePath = _convertToUnixPath(sourcePath);
     if (!_validateImportPath(sourcePath)) {
-        printf("[LOG] Path tidak valid untuk import: %s\n", sourcePath);
+        logWarn("Path tidak valid untuk import: %s\n", sourcePath);
         return;
     }
 
     if (fm->treeCursor == NULL) {
-        printf("[LOG] Tidak ada direktori tujuan yang aktif\n");
+        logWarn("Tidak ada direktori tujuan yang aktif\n");
         return;
     }
 
-    printf("[LOG] Memulai import dari: %s\n", sourcePath);
-    printf("[LOG] Ke direktori: %s\n", fm->treeCursor->item.path);
+    logDebug("Memulai import dari: %s\n", sourcePath);
+    logDebug("Ke direktori: %s\n", fm->treeCursor->item.path);
 
     // Dapatkan nama file/folder dari path
     char* fileName = getNameFromPath(sourcePath);
     if (fileName == NULL || strlen(fileName) == 0) {
-        printf("[LOG] Tidak dapat mengekstrak nama file dari path\n");
+        logError("Tidak dapat mengekstrak nama file dari path\n");
         return;
     }
 
     // Buat path tujuan di direktori saat ini
-    char* destinationPath = TextFormat("%s/%s", fm->treeCursor->item.path, fileName);
+    char* destinationPath = strdup(formatText("%s/%s", fm->treeCursor->item.path, fileName));
 
     // Handle duplikasi nama dengan suffix yang lebih deskriptif
-    if (FileExists(destinationPath) || DirectoryExists(destinationPath)) {
-        char* timestamp = TextFormat("_imported_%ld", time(NULL) % 10000);
-        if (_isDirectory(sourcePath)) {
-            destinationPath = _createDuplicatedFolderName(destinationPath, timestamp);
-        }
-        else {
-            destinationPath = _createDuplicatedFileName(destinationPath, timestamp);
-        }
-        printf("[LOG] File exists, using new name: %s\n", getNameFromPath(destinationPath));
+    if (fileExists(destinationPath) || directoryExists(destinationPath)) {
+        char timestamp[32];
+        snprintf(timestamp, sizeof(timestamp), "_imported_%ld", (long)(time(NULL) % 10000));
+        char* uniquePath = _isDirectory(sourcePath) ? _createDuplicatedFolderName(destinationPath, timestamp)
+                                                    : _createDuplicatedFileName(destinationPath, timestamp);
+        free(destinationPath);
+        destinationPath = uniquePath;
+        logDebug("File exists, using new name: %s\n", getNameFromPath(destinationPath));
     }
 
     // Tentukan tipe item dan size untuk progress
     ItemType itemType = _isDirectory(sourcePath) ? ITEM_FOLDER : ITEM_FILE;
     bool success = false;
 
-    printf("[LOG] Tipe item: %s\n", itemType == ITEM_FOLDER ? "Folder" : "File");
+    logDebug("Tipe item: %s\n", itemType == ITEM_FOLDER ? "Folder" : "File");
 
     // Lakukan operasi copy dengan progress tracking
     if (itemType == ITEM_FOLDER) {
-        printf("[LOG] Mengimpor folder...\n");
+        logDebug("Mengimpor folder...\n");
 
         // Buat direktori tujuan
-        if (MakeDirectory(destinationPath) == 0) {
-            printf("[LOG] Direktori tujuan dibuat: %s\n", destinationPath);
+        if (makeDirectory(destinationPath) == 0) {
+            logDebug("Direktori tujuan dibuat: %s\n", destinationPath);
 
             // Copy semua isi folder secara rekursif dengan progress
-            printf("[LOG] Memulai copy rekursif...\n");
-            _copyFolderRecursive(sourcePath, destinationPath);
+            logDebug("Memulai copy rekursif...\n");
+            _copyFolderRecursive(sourcePath, destinationPath, NULL);
 
             success = true;
-            printf("[LOG] Folder berhasil diimpor: %s\n", fileName);
+            logInfo("Folder berhasil diimpor: %s\n", fileName);
         }
         else {
-            printf("[LOG] Gagal membuat direktori tujuan: %s\n", destinationPath);
+            logError("Gagal membuat direktori tujuan: %s\n", destinationPath);
         }
     }
     else {
-        printf("[LOG] Mengimpor file...\n");
+        logDebug("Mengimpor file...\n");
 
         // Copy file dengan progress feedback
-        _copyFileContent(sourcePath, destinationPath);
-
-        if (FileExists(destinationPath)) {
+        if (_copyFileContent(sourcePath, destinationPath, NULL) && fileExists(destinationPath)) {
             success = true;
-            printf("[LOG] File berhasil diimpor: %s\n", fileName);
+            logInfo("File berhasil diimpor: %s\n", fileName);
         }
         else {
-            printf("[LOG] Gagal mengimpor file: %s\n", fileName);
+            logError("Gagal mengimpor file: %s\n", fileName);
         }
     }
 
     if (success) {
-        printf("[LOG] Import berhasil, menambahkan ke tree...\n");
+        logDebug("Import berhasil, menambahkan ke tree...\n");
 
         // Tambahkan ke tree structure
         struct stat statbuf;
@@ -637,7 +753,7 @@ void importFile(FileManager* fm, char* sourcePath, bool isOperation) {
 
             // Jika folder, load strukturnya
             if (itemType == ITEM_FOLDER && newNode != NULL) {
-                printf("[LOG] Loading tree structure untuk folder...\n");
+                logDebug("Loading tree structure untuk folder...\n");
                 _loadTree(newNode, destinationPath);
             }
 
@@ -646,21 +762,22 @@ void importFile(FileManager* fm, char* sourcePath, bool isOperation) {
                 Operation* importOperation = alloc(Operation);
                 *importOperation = createOperation(destinationPath, sourcePath, ACTION_CREATE, (itemType == ITEM_FOLDER), NULL);
                 // push(&fm->undo, importOperation);
-                printf("[LOG] Operasi import disimpan untuk undo\n");
+                logDebug("Operasi import disimpan untuk undo\n");
             }
 
             // Refresh file manager untuk update UI
             refreshFileManager(fm);
 
-            printf("[LOG] Import selesai berhasil: %s -> %s\n", sourcePath, destinationPath);
+            logInfo("Import selesai berhasil: %s -> %s\n", sourcePath, destinationPath);
         }
         else {
-            printf("[LOG] Gagal mendapatkan stat untuk file yang diimpor\n");
+            logError("Gagal mendapatkan stat untuk file yang diimpor\n");
         }
     }
     else {
-        printf("[LOG] Import gagal untuk: %s\n", sourcePath);
+        logError("Import gagal untuk: %s\n", sourcePath);
     }
+    free(destinationPath);
 }
 
 /*
@@ -670,79 +787,80 @@ void importFile(FileManager* fm, char* sourcePath, bool isOperation) {
 */
 
 void copyFile(FileManager* fm) {
+    PROFILE_FUNCTION();
     _copyToClipboard(fm);
     fm->isCopy = true;
-    printf("[LOG] Mode: COPY\n");
+    logDebug("Mode: COPY\n");
 }
 
 void cutFile(FileManager* fm) {
+    PROFILE_FUNCTION();
     _copyToClipboard(fm);
     fm->isCopy = false;
-    printf("[LOG] Mode: CUT\n");
+    logDebug("Mode: CUT\n");
 }
 
-void pasteFile(FileManager* fm, bool isOperation) {
+int pasteFile(FileManager* fm, bool isOperation) {
+    PROFILE_FUNCTION();
     if (is_queue_empty(fm->clipboard)) {
-        printf("[LOG] Clipboard kosong\n");
-        return;
+        logWarn("Clipboard kosong\n");
+        return 0;
     }
-    Operation* pasteOperation;
+    Operation* pasteOperation = NULL;
     PasteItem* pasteItem;
     if (isOperation) {
         pasteOperation = alloc(Operation);
         *pasteOperation = createOperation(NULL, NULL, ACTION_PASTE, false, NULL);
+        pasteOperation->isCopy = fm->isCopy;
         pasteOperation->itemTemp = alloc(Queue);
         create_queue(&(*(pasteOperation->itemTemp)));
     }
+    long long seq = opJournalBegin(&fm->opJournal, ACTION_PASTE, fm->isCopy);
     // Reset progress state
-    resetProgressBarState();
+    if (fm->hooks.progressReset) {
+        fm->hooks.progressReset(fm->hooks.userData);
+    }
+    resetCopyStats(&fm->lastPasteStats);
 
-    // Hitung total item untuk progress bar
-    int totalItems = _calculateTotalPasteItems(fm);
+    // Salin isi clipboard sekali; clipboard bisa dikosongkan di tengah proses
+    Item** items = NULL;
+    int totalItems = _collectClipboard(fm, &items);
+    for (int i = 0; i < totalItems; i++) {
+        Item* container = items[i];
+        items[i] = alloc(Item);
+        *items[i] = createItem(container->name, container->path, container->size, container->type,
+            container->created_at, container->updated_at, 0);
+    }
     bool showProgress = _shouldShowProgressBar(totalItems);
     int currentProgress = 0;
     bool cancelled = false;
 
-    printf("[LOG] Total items to paste: %d, Show progress: %s\n",
+    logDebug("Total items to paste: %d, Show progress: %s\n",
         totalItems, showProgress ? "true" : "false");
 
-    // PERBAIKAN: Buat temporary queue untuk iterasi
-    Queue tempQueue;
-    create_queue(&tempQueue);
-    printf("[LOG] Temporary queue created for paste operation\n");
-    // Copy semua items ke temporary queue
-    Node* temp = fm->clipboard.front;
+    // Resolusi sekali jalan: node sumber semua item dan folder tujuan
+    Tree* sourceNodes = calloc(totalItems > 0 ? totalItems : 1, sizeof(Tree));
+    _resolveNodes(fm->root, items, totalItems, sourceNodes);
 
-    while (temp != NULL) {
-        Item* tempItem = alloc(Item);
-        Item* container = (Item*)temp->data;
-        tempItem->name = strdup(container->name);
-        tempItem->path = strdup(container->path);
-        tempItem->type = container->type;
-        tempItem->selected = container->type;
-        tempItem->created_at = container->created_at;
-        tempItem->size = container->size;
-        tempItem->updated_at = container->updated_at;
-        tempItem->deleted_at = 0;
-        printf("[LOG] Enqueueing item: %s to temporary queue\n", tempItem->name);
-        enqueue(&tempQueue, tempItem);
-        temp = temp->next;
+    char* destinationFullPath = strdup(formatText("%s%s", _DIR, fm->currentPath));
+    Tree parentDestinationTree = searchTree(fm->root,
+        createItemKey(getNameFromPath(destinationFullPath), destinationFullPath, ITEM_FOLDER));
+    if (parentDestinationTree == NULL) {
+        logError("ERROR: Parent destination tree tidak ditemukan: %s\n", destinationFullPath);
     }
 
-    // Iterasi menggunakan temporary queue
-    while (!is_queue_empty(tempQueue) && !cancelled) {
-        Item* itemToPaste = (Item*)dequeue(&tempQueue);
-        if (itemToPaste == NULL) {
-            printf("[LOG] Item to paste is NULL, skipping...\n");
-            continue;
-        }
+    // Node tree baru dikumpulkan dan dipasang setelah kerja filesystem selesai
+    Item* pastedItems = calloc(totalItems > 0 ? totalItems : 1, sizeof(Item));
+    int pastedCount = 0;
+
+    for (int i = 0; i < totalItems && !cancelled; i++) {
+        Item* itemToPaste = items[i];
 
-        printf("[LOG] Processing item: %s\n", itemToPaste->name);
+        logDebug("Processing item: %s\n", itemToPaste->name);
         // Update progress bar dan cek cancel
-        if (showProgress) {
-            showPasteProgressBar(currentProgress, totalItems, itemToPaste->name);
-            if (shouldCancelPaste()) {
-                printf("[LOG] Paste operation cancelled by user\n");
+        if (showProgress && fm->hooks.progress) {
+            if (!fm->hooks.progress(currentProgress, totalItems, itemToPaste->name, fm->hooks.userData)) {
+                logWarn("Paste operation cancelled by user\n");
                 cancelled = true;
                 break;
             }
@@ -750,21 +868,29 @@ void pasteFile(FileManager* fm, bool isOperation) {
 
         char* originPath;
         // Proses validasi dan setup untuk item ini
-        if (!_processSinglePasteItem(fm, itemToPaste, &originPath)) {
+        if (!_processSinglePasteItem(fm, itemToPaste, sourceNodes[i], &originPath)) {
+            sourceNodes[i] = NULL;
             currentProgress++;
             continue;
         }
 
         // Path untuk file/folder baru di lokasi tujuan
-        char* destinationFullPath = TextFormat("%s%s", _DIR, fm->currentPath);
-        char* newPath = TextFormat("%s/%s", destinationFullPath, itemToPaste->name);
+        // Buffer formatText dipakai ulang oleh helper lain, simpan salinan
+        char* newPath = strdup(formatText("%s/%s", destinationFullPath, itemToPaste->name));
+        if (itemToPaste->type == ITEM_FOLDER && directoryExists(newPath)) {
+            logDebug("Destination exists, creating duplicate name\n");
+            char* uniquePath = _createDuplicatedFolderName(newPath, "(1)");
+            free(newPath);
+            newPath = uniquePath;
+        }
+        else if (itemToPaste->type == ITEM_FILE && fileExists(newPath)) {
+            char* uniquePath = _createDuplicatedFileName(newPath, "(1)");
+            free(newPath);
+            newPath = uniquePath;
+        }
 
         bool success = false;
-        // Proses berdasarkan tipe item
-        if (isOperation) {
-            pasteOperation->isCopy = fm->isCopy;
-            printf("[LOG] Paste operation type: %s\n", fm->isCopy ? "COPY" : "CUT");
-        }
+        opJournalStep(&fm->opJournal, seq, itemToPaste->type, originPath, newPath, NULL);
         if (itemToPaste->type == ITEM_FOLDER) {
             success = _pasteFolderItem(fm, itemToPaste, originPath, newPath);
         }
@@ -772,74 +898,84 @@ void pasteFile(FileManager* fm, bool isOperation) {
             success = _pasteFileItem(fm, itemToPaste, originPath, newPath);
         }
 
-        // Di dalam pasteFile function, setelah success = true
         if (success) {
-            _handleCutCleanup(fm, itemToPaste);
-
-            // PERBAIKAN: Pastikan destinationFullPath benar
-            Tree parentDestinationTree = searchTree(fm->root,
-                createItem(getNameFromPath(destinationFullPath), destinationFullPath, 0, ITEM_FOLDER, 0, 0, 0));
-
-            if (parentDestinationTree != NULL) {
-                // Tambahkan item utama
-                Item newItem = createItem(
-                    strdup(getNameFromPath(newPath)), // PERBAIKAN: strdup untuk safety
-                    strdup(newPath),                   // PERBAIKAN: strdup untuk safety
-                    itemToPaste->size,
-                    itemToPaste->type,
-                    itemToPaste->created_at,
-                    time(NULL),
-                    0);
-
-                if (isOperation) {
-                    pasteItem = alloc(PasteItem);
-                    *pasteItem = createPasteItem(newItem, originPath);
-                    printf("[LOG] Adding PasteItem for %s with original path %s\n", pasteItem->item.path, pasteItem->originalPath);
-                    enqueue(&(*pasteOperation->itemTemp), pasteItem);
-                }
-                Tree newNode = insert_node(parentDestinationTree, newItem);
-                printf("[LOG] Main item added: %s at %s\n", newItem.name, newItem.path);
-
-                // Jika item yang di-paste adalah folder, tambahkan seluruh struktur dalamnya
-                if (itemToPaste->type == ITEM_FOLDER && newNode != NULL) {
-                    printf("[LOG] Starting recursive tree structure for folder: %s\n", newItem.name);
-                    _addTreeStructureRecursive(newNode, newPath);
-                    printf("[LOG] Completed recursive tree structure for folder: %s\n", newItem.name);
-                }
+            opJournalStepDone(&fm->opJournal, seq);
+            pastedItems[pastedCount++] = createItem(getNameFromPath(newPath), newPath, itemToPaste->size,
+                itemToPaste->type, itemToPaste->created_at, time(NULL), 0);
 
-                printf("[LOG] Item %s berhasil ditambahkan ke tree\n", newItem.name);
-            }
-            else {
-                printf("[LOG] ERROR: Parent destination tree tidak ditemukan: %s\n", destinationFullPath);
-                printf("[LOG] Searching for: name=%s, path=%s\n",
-                    getNameFromPath(destinationFullPath), destinationFullPath);
+            if (isOperation) {
+                pasteItem = alloc(PasteItem);
+                *pasteItem = createPasteItem(createItem(getNameFromPath(newPath), newPath, itemToPaste->size,
+                    itemToPaste->type, itemToPaste->created_at, time(NULL), 0), originPath);
+                enqueue(&(*pasteOperation->itemTemp), pasteItem);
             }
         }
+        if (!success || fm->isCopy) {
+            // Hanya sumber cut yang berhasil dilepas dari tree asal
+            sourceNodes[i] = NULL;
+        }
+        free(newPath);
         currentProgress++;
     }
+    opJournalEnd(&fm->opJournal, seq);
 
-    // Cleanup temporary queue
-    clear_queue(&tempQueue);
+    // Commit tree: lepas sumber cut, lalu pasang semua item baru sekali jalan
+    clearSelectedFile(fm);
+    _detachNodes(fm, sourceNodes, totalItems);
+    if (parentDestinationTree != NULL) {
+        for (int i = 0; i < pastedCount; i++) {
+            Tree newNode = insert_node(parentDestinationTree, pastedItems[i]);
+            if (newNode != NULL && pastedItems[i].type == ITEM_FOLDER) {
+                _addTreeStructureRecursive(newNode, pastedItems[i].path);
+            }
+        }
+    }
+    else {
+        for (int i = 0; i < pastedCount; i++) {
+            destroyItem(&pastedItems[i]);
+        }
+    }
+    logDebug("%d item ditambahkan ke tree\n", pastedCount);
+
+    for (int i = 0; i < totalItems; i++) {
+        destroyItem(items[i]);
+        free(items[i]);
+    }
+    free(items);
+    free(sourceNodes);
+    free(pastedItems);
+    free(destinationFullPath);
 
     // Reset progress state setelah selesai
-    resetProgressBarState();
+    if (fm->hooks.progressReset) {
+        fm->hooks.progressReset(fm->hooks.userData);
+    }
 
     // Clear clipboard setelah cut operation (hanya jika tidak di-cancel)
     if (!fm->isCopy && !cancelled) {
-        clear_queue(&fm->clipboard);
-        printf("[LOG] Clipboard cleared after cut operation\n");
+        _clearClipboard(fm);
+        logDebug("Clipboard cleared after cut operation\n");
     }
 
     if (cancelled) {
-        printf("[LOG] Paste operation was cancelled\n");
+        logWarn("Paste operation was cancelled\n");
     }
     else {
-        printf("[LOG] Paste berhasil!\n");
+        logInfo("Paste berhasil!\n");
+    }
+    if (fm->lastPasteStats.filesCopied > 0) {
+        char logicalText[32], allocatedText[32], sparseText[32];
+        logInfo("Ringkasan paste: %lld file, ukuran logis %s, teralokasi %s, hole dipertahankan %s\n",
+            fm->lastPasteStats.filesCopied,
+            formatCopySize(fm->lastPasteStats.logicalBytes, logicalText, sizeof(logicalText)),
+            formatCopySize(fm->lastPasteStats.allocatedBytes, allocatedText, sizeof(allocatedText)),
+            formatCopySize(fm->lastPasteStats.sparseBytes, sparseText, sizeof(sparseText)));
     }
     if (isOperation) {
-        push(&fm->undo, pasteOperation);
+        _pushUndo(fm, pasteOperation);
     }
     refreshFileManager(fm);
+    return pastedCount;
 }
 
 /*
@@ -849,100 +985,27 @@ void pasteFile(FileManager* fm, bool isOperation) {
 */
 
 void selectFile(FileManager* fm, Item* item) {
-    // Cek apakah item sudah ada dalam list
-    Node* temp = fm->selectedItem.head;
-    while (temp != NULL) {
-        Item* existingItem = (Item*)temp->data;
-        if (_isItemEqual(existingItem, item)) {
-            // Item sudah ada, tidak perlu ditambahkan lagi
-            item->selected = true; // Pastikan flag selected konsisten
-            return;
-        }
-        temp = temp->next;
-    }
-
-    // Item belum ada, tambahkan ke list
-    item->selected = true;
-
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    if (!newNode) {
-        printf("[LOG] Gagal mengalokasi memory untuk selected item\n");
+    if (!selectionSetAdd(&fm->selectedItem, item)) {
+        // Item sudah ada, flag selected sudah dipastikan true
         return;
     }
-
-    newNode->data = item; // Simpan pointer ke item, bukan copy
-    newNode->next = fm->selectedItem.head;
-    fm->selectedItem.head = newNode;
-
-    printf("[LOG] Item %s berhasil ditambahkan ke selection\n", item->name);
+    logDebug("Item %s berhasil ditambahkan ke selection\n", item->name);
 }
 
 void clearSelectedFile(FileManager* fm) {
-    Node* current = fm->selectedItem.head;
-
-    // First, unmark all items as unselected
-    while (current != NULL) {
-        Item* item = (Item*)current->data;
-        if (item) {
-            item->selected = false;
-        }
-        current = current->next;
-    }
-
-    Node* temp = fm->trash.head;
-    while (temp != NULL) {
-        TrashItem* trashItem = (TrashItem*)temp->data;
-        if (trashItem) {
-            trashItem->item.selected = false; // Unmark item in trash
-        }
-        temp = temp->next;
-    }
-
-    // Then free all nodes
-    current = fm->selectedItem.head;
-    while (current != NULL) {
-        Node* next = current->next;
-        // _freeSelectedNode(current);
-        current = next;
-    }
-
-    fm->selectedItem.head = NULL;
-    printf("[LOG] Semua item berhasil di-deselect\n");
+    selectionSetClear(&fm->selectedItem);
+    logInfo("Semua item berhasil di-deselect\n");
 }
 
 void deselectFile(FileManager* fm, Item* item) {
-    Node* current = fm->selectedItem.head;
-    Node* prev = NULL;
-
-    while (current != NULL) {
-        Item* data = (Item*)current->data;
-        if (_isItemEqual(data, item)) {
-            // Unmark item
-            item->selected = false;
-
-            // Remove from linked list
-            if (prev == NULL) {
-                fm->selectedItem.head = current->next;
-            }
-            else {
-                prev->next = current->next;
-            }
-
-            _freeSelectedNode(current);
-            printf("[LOG] Item %s berhasil di-deselect\n", item->name);
-            return;
-        }
-        prev = current;
-        current = current->next;
+    if (selectionSetRemove(&fm->selectedItem, item)) {
+        logDebug("Item %s berhasil di-deselect\n", item->name);
     }
-
-    // Item tidak ditemukan dalam list, tapi pastikan flag selected false
-    item->selected = false;
 }
 
 void selectAll(FileManager* fm) {
     if (fm->treeCursor == NULL) {
-        printf("[LOG] Tidak ada direktori yang dipilih\n");
+        logWarn("Tidak ada direktori yang dipilih\n");
         return;
     }
 
@@ -950,15 +1013,12 @@ void selectAll(FileManager* fm) {
     clearSelectedFile(fm);
 
     Tree currentNode = fm->treeCursor->first_son;
-    int selectedCount = 0;
-
     while (currentNode != NULL) {
-        selectFile(fm, &currentNode->item);
-        selectedCount++;
+        selectionSetAdd(&fm->selectedItem, &currentNode->item);
         currentNode = currentNode->next_brother;
     }
 
-    printf("[LOG] %d file di direktori saat ini telah dipilih\n", selectedCount);
+    logInfo("%d file di direktori saat ini telah dipilih\n", fm->selectedItem.count);
 }
 
 /*
@@ -968,60 +1028,87 @@ void selectAll(FileManager* fm) {
 */
 
 void searchingTreeItem(FileManager* fm, char* keyword) {
+    PROFILE_FUNCTION();
     if (fm->searchingList.head != NULL) {
+        memAccount(MEM_SEARCH, -(long long)sizeof(Node) * fm->searchingList.length, -fm->searchingList.length);
         destroy_list(&(fm->searchingList));
-        printf("[LOG] Hasil pencarian sebelumnya telah dihapus\n");
+        logDebug("Hasil pencarian sebelumnya telah dihapus\n");
     }
 
     if (keyword == NULL || strlen(keyword) == 0) {
-        printf("[LOG] Keyword pencarian tidak boleh kosong\n");
+        logWarn("Keyword pencarian tidak boleh kosong\n");
         return;
     }
 
-    _searchingTreeItemRecursive(&(fm->searchingList), fm->treeCursor, keyword);
+    _searchingTreeItem(&(fm->searchingList), fm->treeCursor, keyword);
 
     if (fm->searchingList.head == NULL) {
-        printf("[LOG] Tidak ada file yang cocok dengan keyword '%s'\n", keyword);
+        logInfo("Tidak ada file yang cocok dengan keyword '%s'\n", keyword);
     }
     else {
-        printf("[LOG] Pencarian selesai. Gunakan printSearchingList() untuk melihat hasil.\n");
+        logInfo("Pencarian selesai. Gunakan printSearchingList() untuk melihat hasil.\n");
     }
 }
 
-void searchingLinkedListItem(FileManager* fm, Node* node, char* keyword) {
+void searchingTrashItem(FileManager* fm, char* keyword) {
+    PROFILE_FUNCTION();
+    TrashNode* node = fm->trash.head;
     if (node == NULL)
         return;
 
     if (fm->searchingList.head != NULL) {
+        memAccount(MEM_SEARCH, -(long long)sizeof(Node) * fm->searchingList.length, -fm->searchingList.length);
         destroy_list(&(fm->searchingList));
-        printf("[LOG] Hasil pencarian sebelumnya telah dihapus\n");
+        logDebug("Hasil pencarian sebelumnya telah dihapus\n");
     }
 
     if (keyword == NULL || strlen(keyword) == 0) {
-        printf("[LOG] Keyword pencarian tidak boleh kosong\n");
+        logWarn("Keyword pencarian tidak boleh kosong\n");
         return;
     }
 
-    _searchingLinkedListRecursive(fm, node, keyword);
+    _searchingTrashList(fm, node, keyword);
 
     if (fm->searchingList.head == NULL) {
-        printf("[LOG] Tidak ada item yang cocok dengan keyword '%s'\n", keyword);
+        logInfo("Tidak ada item yang cocok dengan keyword '%s'\n", keyword);
     }
     else {
-        printf("[LOG] Pencarian selesai. Gunakan printSearchingList() untuk melihat hasil.\n");
+        logInfo("Pencarian selesai. Gunakan printSearchingList() untuk melihat hasil.\n");
     }
 }
 
+int appendDuplicateResults(FileManager* fm, DuplicateFinder* finder, int from) {
+    if (from == 0 && fm->searchingList.head != NULL) {
+        memAccount(MEM_SEARCH, -(long long)sizeof(Node) * fm->searchingList.length, -fm->searchingList.length);
+        destroy_list(&(fm->searchingList));
+    }
+    fm->isSearching = true;
+
+    int available = duplicateGroupCount(finder);
+    for (int i = from; i < available; i++) {
+        const DuplicateGroup* group = getDuplicateGroup(finder, i);
+        for (int j = 0; j < group->count; j++) {
+            // Node bisa sudah dihapus sejak scan dimulai
+            Tree node = resolve_node_handle(group->files[j]->node);
+            if (node != NULL) {
+                insert_last(&(fm->searchingList), node);
+                memAccount(MEM_SEARCH, (long long)sizeof(Node), 1);
+            }
+        }
+    }
+    return available;
+}
+
 void printSearchingList(FileManager* fm) {
     if (fm->searchingList.head == NULL) {
-        printf("[LOG] Tidak ada hasil pencarian\n");
+        logInfo("Tidak ada hasil pencarian\n");
         return;
     }
 
     Node* temp = fm->searchingList.head;
     while (temp != NULL) {
         Tree treePtr = (Tree)temp->data;
-        printf("[LOG] Hasil Pencarian: %s, Path: %s, Size: %ld, Type: %s\n",
+        logInfo("Hasil Pencarian: %s, Path: %s, Size: %ld, Type: %s\n",
             treePtr->item.name,
             treePtr->item.path,
             treePtr->item.size,
@@ -1030,26 +1117,20 @@ void printSearchingList(FileManager* fm) {
     }
 }
 
+bool goToHandle(FileManager* fm, NodeHandle handle) {
+    Tree tree = resolve_node_handle(handle);
+    if (!tree) {
+        logError("Error: Node target sudah tidak ada\n");
+        return false;
+    }
+    goTo(fm, tree);
+    return true;
+}
+
 void goTo(FileManager* fm, Tree tree) {
     if (!fm || !tree)
         return;
 
-    // Validasi tree node masih valid
-    if (!_isValidTreeNode(fm->root, tree)) {
-        printf("[LOG] Warning: Tree node tidak valid, mencari ulang...\n");
-        // Cari node berdasarkan path
-        if (tree->item.path) {
-            tree = _findNodeByPath(fm->root, tree->item.path);
-            if (!tree) {
-                printf("[LOG] Error: Tidak dapat menemukan node target\n");
-                return;
-            }
-        }
-        else {
-            return;
-        }
-    }
-
     fm->treeCursor = tree;
 
     char* temp = fm->currentPath;
@@ -1069,23 +1150,20 @@ void goTo(FileManager* fm, Tree tree) {
     refreshFileManager(fm);
     fm->isSearching = false;
 
-    // Safe string operations with bounds checking
-    if (fm->ctx && fm->ctx->navbar) {
-        memset(fm->ctx->navbar->textboxSearch, 0, MAX_STRING_LENGTH);
-
-        if (fm->isRootTrash) {
-            strncpy(fm->ctx->navbar->textboxPath, "root", MAX_STRING_LENGTH - 1);
-            fm->ctx->navbar->textboxPath[MAX_STRING_LENGTH - 1] = '\0';
-
-            // Free newPath since we're overriding with "root"
-            if (newPath) {
-                free(newPath);
-            }
-            fm->currentPath = strdup("root");
+    if (fm->isRootTrash) {
+        // Free newPath since we're overriding with "root"
+        if (newPath) {
+            free(newPath);
         }
+        fm->currentPath = strdup("root");
+    }
+
+    // Front-end menyesuaikan path/search box
+    if (fm->hooks.navigated) {
+        fm->hooks.navigated(fm, fm->hooks.userData);
     }
 
-    printf("[LOG] Navigated to: %s\n", fm->currentPath ? fm->currentPath : "unknown");
+    logDebug("Navigated to: %s\n", fm->currentPath ? fm->currentPath : "unknown");
 }
 
 void goBack(FileManager* fm) {
@@ -1116,17 +1194,19 @@ Tree getCurrentRoot(FileManager fm) {
 */
 
 void undo(FileManager* fm) {
+    PROFILE_FUNCTION();
     Operation* operationToUndo;
     Operation* operationToRedo;
-    Tree foundTree;
-    TrashItem* trashItem;
-    if (fm->undo == NULL) {
-        printf("[LOG] No actions to undo.\n");
+    if (isUndoHistoryEmpty(&fm->undo)) {
+        logInfo("No actions to undo.\n");
+        return;
+    }
+    operationToUndo = undoHistoryPop(&(fm->undo));
+    opJournalPopUndo(&fm->opJournal);
+    if (operationToUndo == NULL) {
         return;
     }
-    operationToUndo = alloc(Operation);
     operationToRedo = alloc(Operation);
-    operationToUndo = (Operation*)pop(&(fm->undo));
 
     *operationToRedo = createOperation(operationToUndo->from, operationToUndo->to, operationToUndo->type, operationToUndo->isDir, NULL);
     operationToRedo->itemTemp = alloc(Queue);
@@ -1149,26 +1229,30 @@ void undo(FileManager* fm) {
         _undoPaste(fm, operationToUndo, operationToRedo);
         break;
     default:
-        printf("[LOG] Unknown operation type: %d\n", operationToUndo->type);
+        logError("Unknown operation type: %d\n", operationToUndo->type);
         break;
     }
-    push(&(fm->redo), operationToRedo);
+    undoHistoryPush(&(fm->redo), operationToRedo);
+    destroyOperation(operationToRedo);
+    destroyOperation(operationToUndo);
     // printTree(fm->root, 0);
     refreshFileManager(fm);
     // printTree(fm->root, 0);
-    // printf("[LOG] Redo Pushed : %s\n", operationToUndo->from);
+    // logInfo("Redo Pushed : %s\n", operationToUndo->from);
 }
 
 void redo(FileManager* fm) {
+    PROFILE_FUNCTION();
     Operation* operationToRedo;
     Operation* operationToUndo;
-    Tree foundTree;
-    if (fm->redo == NULL) {
-        printf("[LOG] No actions to redo.\n");
+    if (isUndoHistoryEmpty(&fm->redo)) {
+        logInfo("No actions to redo.\n");
+        return;
+    }
+    operationToRedo = undoHistoryPop(&(fm->redo));
+    if (operationToRedo == NULL) {
         return;
     }
-    operationToRedo = alloc(Operation);
-    operationToRedo = (Operation*)pop(&(fm->redo));
     operationToUndo = alloc(Operation);
     *operationToUndo = (Operation){
         .from = operationToRedo->from ? strdup(operationToRedo->from) : NULL,
@@ -1192,10 +1276,11 @@ void redo(FileManager* fm) {
         _redoPaste(fm, operationToRedo, operationToUndo);
         break;
     default:
-        printf("[LOG] Unknown operation type: %d\n", operationToRedo->type);
+        logError("Unknown operation type: %d\n", operationToRedo->type);
         break;
     }
-    push(&(fm->undo), operationToUndo);
+    _pushUndo(fm, operationToUndo);
+    destroyOperation(operationToRedo);
     refreshFileManager(fm);
 }
 
@@ -1205,12 +1290,83 @@ void redo(FileManager* fm) {
 ================================================================================
 */
 
+long long getScannedEntryCount(void) {
+    return scannedEntries;
+}
+
+void collectMemoryReport(FileManager* fm, MemoryReport* report) {
+    PROFILE_FUNCTION();
+    for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+        getMemStats((MemCategory)i, &report->categories[i]);
+        report->reachableBytes[i] = -1;
+        report->reachableBlocks[i] = -1;
+    }
+
+    long long treeBytes = 0, treeBlocks = 0;
+    long long stringBytes = 0, stringBlocks = 0;
+
+    if (fm->root != NULL) {
+        TreeIterator it;
+        Tree node;
+        tree_iter_init(&it, fm->root, TREE_PRE_ORDER);
+        while ((node = tree_iter_next(&it)) != NULL) {
+            treeBytes += memBlockSize(node) + memBlockSize(node->children);
+            treeBlocks += node->children != NULL ? 2 : 1;
+            stringBytes += memBlockSize(node->item.name) + memBlockSize(node->item.path);
+            stringBlocks += (node->item.name != NULL) + (node->item.path != NULL);
+        }
+        tree_iter_destroy(&it);
+    }
+
+    // Item di trash menyimpan name/path sendiri, node tree-nya sudah dilepas
+    for (TrashNode* trashNode = fm->trash.head; trashNode != NULL; trashNode = trashNode->next) {
+        Item* item = &trashNode->data->item;
+        stringBytes += memBlockSize(item->name) + memBlockSize(item->path);
+        stringBlocks += (item->name != NULL) + (item->path != NULL);
+    }
+
+    long long searchBlocks = 0;
+    for (Node* result = fm->searchingList.head; result != NULL; result = result->next) {
+        searchBlocks++;
+    }
+
+    report->reachableBytes[MEM_TREE] = treeBytes;
+    report->reachableBlocks[MEM_TREE] = treeBlocks;
+    report->reachableBytes[MEM_STRINGS] = stringBytes;
+    report->reachableBlocks[MEM_STRINGS] = stringBlocks;
+    report->reachableBytes[MEM_SEARCH] = searchBlocks * (long long)sizeof(Node);
+    report->reachableBlocks[MEM_SEARCH] = searchBlocks;
+}
+
+void logMemoryReport(const MemoryReport* report) {
+    logInfo("[MEM] %lld bytes hidup di semua kategori\n", memTotalBytes());
+    for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+        const MemCategoryStats* stats = &report->categories[i];
+        if (report->reachableBytes[i] < 0) {
+            logInfo("[MEM] %-8s %lld bytes, %lld blok (peak %lld)\n",
+                memCategoryName((MemCategory)i), stats->bytes, stats->blocks, stats->peakBytes);
+            continue;
+        }
+
+        long long leakedBytes = stats->bytes - report->reachableBytes[i];
+        long long leakedBlocks = stats->blocks - report->reachableBlocks[i];
+        if (leakedBytes > 0) {
+            logWarn("[MEM] %-8s %lld bytes, %lld blok; %lld bytes di %lld blok tidak terjangkau (leak)\n",
+                memCategoryName((MemCategory)i), stats->bytes, stats->blocks, leakedBytes, leakedBlocks);
+        }
+        else {
+            logInfo("[MEM] %-8s %lld bytes, %lld blok (peak %lld), semua terjangkau\n",
+                memCategoryName((MemCategory)i), stats->bytes, stats->blocks, stats->peakBytes);
+        }
+    }
+}
+
 void windowsOpenWith(char* path) {
     if (path == NULL) {
         return;
     }
 
-    printf("[LOG] %s\n", path);
+    logDebug("%s\n", path);
 
 #ifdef _WIN32
     const char* command = "cmd /c start \"\"";
@@ -1221,7 +1377,7 @@ void windowsOpenWith(char* path) {
     }
 
     snprintf(executeableCommand, length, "%s \"%s\" /OPENAS", command, path);
-    printf("[LOG] %s\n", executeableCommand);
+    logDebug("%s\n", executeableCommand);
     system(executeableCommand);
     free(executeableCommand);
 #elif defined(__APPLE__)
@@ -1233,7 +1389,7 @@ void windowsOpenWith(char* path) {
     }
 
     snprintf(executeableCommand, length, "%s \"%s\"", command, path);
-    printf("[LOG] %s\n", executeableCommand);
+    logDebug("%s\n", executeableCommand);
     system(executeableCommand);
     free(executeableCommand);
 #else
@@ -1245,38 +1401,51 @@ void windowsOpenWith(char* path) {
     }
 
     snprintf(executeableCommand, length, "%s \"%s\"", command, path);
-    printf("[LOG] %s\n", executeableCommand);
+    logDebug("%s\n", executeableCommand);
     system(executeableCommand);
     free(executeableCommand);
 #endif
 }
 
 void sort_children(Tree* parent) {
-    if (!parent || !(*parent) || !(*parent)->first_son || !(*parent)->first_son->next_brother)
+    if (!parent || !(*parent) || (*parent)->child_count < 2)
         return;
 
-    Tree head = (*parent)->first_son;
-    Tree sorted = NULL;
+    Tree node = *parent;
+    Tree* children = node->children;
+    int count = node->child_count;
 
-    while (head) {
-        Tree current = head;
-        head = head->next_brother;
+    // Dipanggil tiap frame: keluar cepat bila sudah terurut
+    bool sorted = true;
+    for (int i = 1; i < count && sorted; i++) {
+        sorted = children[i - 1]->item.type <= children[i]->item.type;
+    }
+    if (sorted)
+        return;
 
-        if (!sorted || current->item.type < sorted->item.type) {
-            current->next_brother = sorted;
-            sorted = current;
+    // Partisi stabil berdasarkan tipe (folder sebelum file), O(n)
+    Tree* ordered = malloc(sizeof(Tree) * count);
+    if (ordered == NULL)
+        return;
+    int next = 0;
+    for (int i = 0; i < count; i++) {
+        if (children[i]->item.type == ITEM_FOLDER) {
+            ordered[next++] = children[i];
         }
-        else {
-            Tree temp = sorted;
-            while (temp->next_brother && current->item.type >= temp->next_brother->item.type) {
-                temp = temp->next_brother;
-            }
-            current->next_brother = temp->next_brother;
-            temp->next_brother = current;
+    }
+    for (int i = 0; i < count; i++) {
+        if (children[i]->item.type != ITEM_FOLDER) {
+            ordered[next++] = children[i];
         }
     }
 
-    (*parent)->first_son = sorted;
+    memcpy(children, ordered, sizeof(Tree) * count);
+    free(ordered);
+    node->first_son = children[0];
+    for (int i = 0; i < count - 1; i++) {
+        children[i]->next_brother = children[i + 1];
+    }
+    children[count - 1]->next_brother = NULL;
 }
 
 char* getNameFromPath(char* path) {
@@ -1290,6 +1459,175 @@ char* getNameFromPath(char* path) {
     return path; // kembalikan pathnya kalau gak ada slash (/) (ini berarti sudah nama file)
 };
 
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - JOURNAL OPERATIONS
+================================================================================
+*/
+
+/**
+ * @brief Compacts an operation onto the undo history and records it in the journal
+ *
+ * When the push evicts old entries the journal is checkpointed, so the
+ * evicted operations are not restored on the next start either.
+ *
+ * @param[in,out] fm Pointer to FileManager instance
+ * @param[in] operation Operation to push; freed here, its payload must own its strings
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _pushUndo(FileManager* fm, Operation* operation) {
+    opJournalPushUndo(&fm->opJournal, operation);
+    if (undoHistoryPush(&fm->undo, operation) > 0 &&
+        fm->activeOperation == 0 && fm->opJournal.incompleteCount == 0) {
+        // Entri lama sudah dibuang dari memori; buang juga dari journal
+        opJournalCheckpoint(&fm->opJournal, &fm->undo);
+    }
+    destroyOperation(operation);
+}
+
+/**
+ * @brief Resolves operations that were interrupted before their END record
+ *
+ * Each unfinished item is rolled back or finished by _recoverStep(). Paste
+ * and delete items that end up applied are pushed as a new undo entry, so
+ * the interrupted operation can still be undone after the restart.
+ *
+ * @param[in,out] fm Pointer to FileManager instance
+ *
+ * @pre Trash store loaded, op journal opened, tree not loaded yet
+ * @post Every interrupted operation is closed with END in the journal
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _recoverIncompleteOperations(FileManager* fm) {
+    OpJournal* journal = &fm->opJournal;
+
+    for (int i = 0; i < journal->incompleteCount; i++) {
+        OpJournalIncomplete* incomplete = &journal->incomplete[i];
+        Operation* operation = NULL;
+        int applied = 0;
+
+        if (incomplete->type == ACTION_PASTE || incomplete->type == ACTION_DELETE) {
+            operation = alloc(Operation);
+            *operation = createOperation(NULL, NULL, incomplete->type, false, NULL);
+            operation->isCopy = incomplete->isCopy;
+            operation->itemTemp = alloc(Queue);
+            create_queue(&(*(operation->itemTemp)));
+        }
+
+        for (int j = 0; j < incomplete->stepCount; j++) {
+            OpJournalStep* step = &incomplete->steps[j];
+            if (!_recoverStep(fm, incomplete, step)) {
+                continue;
+            }
+            applied++;
+
+            if (incomplete->type == ACTION_PASTE) {
+                PasteItem* pasteItem = alloc(PasteItem);
+                Item item = createItem(getNameFromPath(step->dest), step->dest, 0, step->type, time(NULL), time(NULL), 0);
+                *pasteItem = createPasteItem(item, step->src);
+                enqueue(&(*operation->itemTemp), pasteItem);
+            }
+            else if (incomplete->type == ACTION_DELETE) {
+                TrashItem* trashItem = alloc(TrashItem);
+                trashItem->item = createItem(getNameFromPath(step->src), step->src, 0, step->type, 0, 0, 0);
+                trashItem->originalPath = strdup(step->src);
+                trashItem->trashPath = strdup(step->dest);
+                trashItem->uid = step->uid ? strdup(step->uid) : NULL;
+                trashItem->deletedTime = time(NULL);
+                enqueue(&(*operation->itemTemp), trashItem);
+            }
+        }
+
+        if (operation != NULL && !is_queue_empty(*(operation->itemTemp))) {
+            _pushUndo(fm, operation);
+        }
+        else if (operation != NULL) {
+            free(operation->itemTemp);
+            free(operation);
+        }
+
+        opJournalEnd(journal, incomplete->seq);
+        logWarn("Operasi terputus #%lld dipulihkan: %d dari %d item diterapkan\n",
+            incomplete->seq, applied, incomplete->stepCount);
+    }
+
+    freeOpJournalIncomplete(journal);
+    saveTrashToFile(fm);
+}
+
+/**
+ * @brief Rolls one logged item of an interrupted operation back or forward
+ *
+ * - Paste (copy): an unfinished destination is a partial copy and is removed.
+ * - Paste (cut): a move that left both sides behind is resumed; a destination
+ *   without a source means the move itself completed.
+ * - Delete: an item whose UID is in the trash store was moved; an item that
+ *   reached the trash folder without a store entry is moved back.
+ * - Recover: an item that left the trash folder is dropped from the store.
+ *
+ * @param[in,out] fm Pointer to FileManager instance
+ * @param[in] incomplete Interrupted operation owning the step
+ * @param[in] step Logged item
+ * @return true if the item ends up applied, false if it is rolled back or never started
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _recoverStep(FileManager* fm, OpJournalIncomplete* incomplete, OpJournalStep* step) {
+    bool srcExists = fileExists(step->src) || directoryExists(step->src);
+    bool destExists = fileExists(step->dest) || directoryExists(step->dest);
+
+    switch (incomplete->type) {
+    case ACTION_PASTE:
+        if (step->done) {
+            return destExists;
+        }
+        if (incomplete->isCopy) {
+            if (destExists) {
+                logInfo("Menghapus hasil copy yang tidak lengkap: %s\n", step->dest);
+                _deleteSingleItem(step->dest, step->type, getNameFromPath(step->dest));
+            }
+            return false;
+        }
+        if (srcExists && destExists) {
+            logWarn("Melanjutkan move yang terputus: %s -> %s\n", step->src, step->dest);
+            return moveAcrossFilesystems(step->src, step->dest, NULL);
+        }
+        return destExists;
+
+    case ACTION_DELETE: {
+        if (step->uid != NULL && trashStoreFindByUID(&fm->trash, step->uid) != NULL) {
+            return true;
+        }
+        if (destExists && !srcExists) {
+            logWarn("Mengembalikan item yang gagal masuk trash: %s\n", step->src);
+            if (rename(step->dest, step->src) != 0) {
+                logError("Gagal mengembalikan %s (Error: %d)\n", step->src, errno);
+            }
+        }
+        return false;
+    }
+
+    case ACTION_RECOVER: {
+        TrashItem* trashItem = step->uid ? trashStoreFindByUID(&fm->trash, step->uid) : NULL;
+        if (trashItem != NULL && !srcExists && destExists) {
+            trashStoreRemove(&fm->trash, trashItem);
+            trashJournalAppendRemove(&fm->trashJournal, trashItem->uid);
+            freeTrashItem(trashItem);
+            return true;
+        }
+        return !srcExists && destExists;
+    }
+
+    default:
+        return false;
+    }
+}
+
 /*
 ================================================================================
     PRIVATE HELPER FUNCTIONS - TRASH OPERATIONS
@@ -1304,6 +1642,7 @@ char* getNameFromPath(char* path) {
  *
  * @param[in,out] fm Pointer to FileManager instance
  * @param[in] itemTree Tree node representing item to move to trash
+ * @return TrashItem owned by the trash store, or NULL if the move failed
  *
  * @pre itemTree is valid node in main tree
  * @post Item moved to trash directory, unique ID generated, item added to trash list
@@ -1311,10 +1650,33 @@ char* getNameFromPath(char* path) {
  * @internal
  * @since 1.0
  */
-static void _moveToTrash(FileManager* fm, Tree itemTree) {
+static TrashItem* _moveToTrash(FileManager* fm, Tree itemTree) {
+    TrashItem* trashItem = _trashNode(fm, itemTree);
+    if (trashItem != NULL) {
+        // Hapus dari tree utama
+        remove_node(fm, itemTree);
+    }
+    return trashItem;
+}
+
+/**
+ * @brief Moves an item to trash without touching the tree
+ *
+ * Does the filesystem move, trash store insert and journaling of
+ * _moveToTrash(). Batch deletes detach all nodes afterwards in one pass.
+ *
+ * @param[in,out] fm Pointer to FileManager instance
+ * @param[in] itemTree Tree node representing item to move to trash
+ * @return TrashItem owned by the trash store, or NULL if the move failed
+ *
+ * @internal
+ * @since 1.0
+ */
+static TrashItem* _trashNode(FileManager* fm, Tree itemTree) {
+    PROFILE_FUNCTION();
     char* trashDir = ".dir/trash";
-    if (!DirectoryExists(trashDir)) {
-        MakeDirectory(trashDir);
+    if (!directoryExists(trashDir)) {
+        makeDirectory(trashDir);
     }
 
     // Generate unique ID sebagai primary key
@@ -1325,7 +1687,8 @@ static void _moveToTrash(FileManager* fm, Tree itemTree) {
 
     // Simpan nama asli untuk display
     trashItem->item = itemTree->item;
-    trashItem->item.name = strdup(itemTree->item.name); // Nama asli untuk display
+    trashItem->item.name = itemStrdup(itemTree->item.name); // Nama asli untuk display
+    trashItem->item.selected = false;
 
     trashItem->uid = uid;                                  // Primary key unik
     trashItem->originalPath = strdup(itemTree->item.path); // Path asal
@@ -1335,7 +1698,7 @@ static void _moveToTrash(FileManager* fm, Tree itemTree) {
 
     // Gunakan UID untuk nama file fisik di trash (primary key)
     char* fileExtension = strrchr(itemTree->item.name, '.');
-    char* trashFileName;
+    const char* trashFileName;
 
     if (fileExtension && itemTree->item.type == ITEM_FILE) {
         // Untuk file dengan ekstensi: namaAsli_UID.ext
@@ -1344,50 +1707,49 @@ static void _moveToTrash(FileManager* fm, Tree itemTree) {
         strncpy(nameWithoutExt, itemTree->item.name, nameLen);
         nameWithoutExt[nameLen] = '\0';
 
-        trashFileName = TextFormat("%s_%s%s", nameWithoutExt, uid, fileExtension);
+        trashFileName = formatText("%s_%s%s", nameWithoutExt, uid, fileExtension);
         free(nameWithoutExt);
     }
     else {
         // Untuk folder atau file tanpa ekstensi: namaAsli_UID
-        trashFileName = TextFormat("%s_%s", itemTree->item.name, uid);
+        trashFileName = formatText("%s_%s", itemTree->item.name, uid);
     }
 
-    char* trashPath = TextFormat("%s/%s", trashDir, trashFileName);
+    const char* trashPath = formatText("%s/%s", trashDir, trashFileName);
     trashItem->trashPath = strdup(trashPath);
 
     // Update item properties untuk trash display
-    trashItem->item.path = strdup(trashPath);
+    trashItem->item.path = itemStrdup(trashPath);
     trashItem->item.deleted_at = trashItem->deletedTime; // Set deleted time
 
-    // Move ke trash secara fisik
+    // Move ke trash secara fisik; delete yang sedang berjalan mencatat intent lebih dulu
+    if (fm->activeOperation != 0) {
+        opJournalStep(&fm->opJournal, fm->activeOperation, itemTree->item.type, srcPath, trashPath, uid);
+    }
     if (rename(srcPath, trashPath) != 0) {
-        printf("[LOG] Gagal memindahkan %s ke trash\ntrashPath:%s\nsrcPath:%s\n",
+        logError("Gagal memindahkan %s ke trash\ntrashPath:%s\nsrcPath:%s\n",
             itemTree->item.name, trashPath, srcPath);
 
         // Cleanup on failure
         free(trashItem->uid);
-        free(trashItem->item.name);
+        freeItemString(trashItem->item.name);
         free(trashItem->originalPath);
         free(trashItem->trashPath);
-        free(trashItem->item.path);
+        freeItemString(trashItem->item.path);
         free(trashItem);
-        return;
+        return NULL;
     }
 
-    // Tambahkan ke LinkedList trash
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    newNode->data = trashItem;
-    newNode->next = fm->trash.head;
-    fm->trash.head = newNode;
-
-    // Hapus dari tree utama
-    remove_node(&(fm->root), itemTree);
+    // Tambahkan ke trash store (terindeks UID dan original path) lalu catat di journal
+    trashStoreInsert(&fm->trash, trashItem);
+    trashJournalAppendAdd(&fm->trashJournal, trashItem);
+    if (fm->activeOperation != 0) {
+        opJournalStepDone(&fm->opJournal, fm->activeOperation);
+    }
 
-    printf("[LOG] Item '%s' moved to trash with UID: %s (Deleted at: %ld)\n",
+    logDebug("Item '%s' moved to trash with UID: %s (Deleted at: %ld)\n",
         trashItem->item.name, uid, trashItem->deletedTime);
-
-    // Otomatis save ke file setelah perubahan
-    saveTrashToFile(fm);
+    return trashItem;
 }
 
 /**
@@ -1408,13 +1770,13 @@ static void _moveToTrash(FileManager* fm, Tree itemTree) {
  */
 static void _deletePermanently(char* fullPath, ItemType type, char* name) {
     if (type == ITEM_FOLDER) {
-        if (RemoveItemsRecurse(fullPath) != 0) {
-            printf("[LOG] Gagal menghapus folder %s\n", name);
+        if (RemoveItemsRecurse(fullPath) != 1) {
+            logError("Gagal menghapus folder %s\n", name);
         }
     }
     else {
         if (remove(fullPath) != 0) {
-            printf("[LOG] Gagal menghapus file %s\n", name);
+            logError("Gagal menghapus file %s\n", name);
         }
     }
 }
@@ -1441,93 +1803,275 @@ static void _deleteSingleItem(char* fullPath, ItemType type, char* name) {
 }
 
 /**
- * @brief Removes item from trash list by item name
+ * @brief Removes trash item by unique identifier
  *
- * Searches trash list and removes item with matching name.
- * Frees all associated memory including paths and metadata.
+ * Looks up the item through the UID index, detaches it from the trash
+ * store and frees all associated memory. Runs in O(1).
  *
  * @param[in,out] fm Pointer to FileManager instance
- * @param[in] itemName Name of item to remove from trash
+ * @param[in] uid Unique identifier of item to remove
  *
- * @pre itemName exists in trash list
- * @post Item removed from trash list, memory freed
+ * @pre uid exists in trash store
+ * @post Item with matching UID removed from trash, memory freed
  *
  * @internal
  * @since 1.0
  */
-static void _removeFromTrash(FileManager* fm, char* itemName) {
-    Node* current = fm->trash.head;
-    Node* prev = NULL;
+static void _removeFromTrashByUID(FileManager* fm, char* uid) {
+    TrashItem* trashItem = trashStoreFindByUID(&fm->trash, uid);
+    if (trashItem == NULL) {
+        logWarn("Trash item dengan UID %s tidak ditemukan\n", uid);
+        return;
+    }
 
-    while (current != NULL) {
-        TrashItem* trashItem = (TrashItem*)current->data;
-        if (strcmp(trashItem->item.name, itemName) == 0) {
-            if (prev == NULL) {
-                fm->trash.head = current->next;
-            }
-            else {
-                prev->next = current->next;
+    trashStoreRemove(&fm->trash, trashItem);
+    trashJournalAppendRemove(&fm->trashJournal, trashItem->uid);
+    logInfo("Trash item dengan UID %s berhasil dihapus\n", uid);
+    freeTrashItem(trashItem);
+}
+
+/**
+ * @brief Picks the path a trashed item is restored to
+ *
+ * Returns the original path, or a "(recovered)" variant of it when
+ * something else has been created there since the delete.
+ *
+ * @param[in] trashItem Trash item to restore
+ * @return Newly allocated path (caller frees)
+ *
+ * @internal
+ * @since 1.0
+ */
+static char* _recoveryPath(TrashItem* trashItem) {
+    char* recoverPath = trashItem->originalPath;
+    if (!fileExists(recoverPath) && !directoryExists(recoverPath)) {
+        return strdup(recoverPath);
+    }
+
+    if (trashItem->item.type == ITEM_FOLDER) {
+        char* dirPath = _getDirectoryFromPath(recoverPath);
+        char* folderPath = strdup(formatText("%s/%s(recovered)", dirPath, trashItem->item.name));
+        free(dirPath);
+        if (directoryExists(folderPath)) {
+            char* uniquePath = _createDuplicatedFolderName(folderPath, "(1)");
+            free(folderPath);
+            return uniquePath;
+        }
+        return folderPath;
+    }
+    return _createDuplicatedFileName(recoverPath, "(recovered)");
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - BATCH OPERATIONS
+================================================================================
+*/
+
+/**
+ * @brief Resolves the clipboard handles into an array of live items
+ *
+ * Handles whose node was removed or reloaded away since the copy are
+ * skipped, so paste never touches freed nodes. The array is a snapshot
+ * and stays valid if the clipboard is cleared while the batch runs.
+ *
+ * @param[in] fm FileManager holding the clipboard
+ * @param[out] items Newly allocated array (caller frees), NULL if empty
+ * @return Number of items in the array
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _collectClipboard(FileManager* fm, Item*** items) {
+    int count = get_queue_length(fm->clipboard);
+
+    *items = NULL;
+    if (count == 0) {
+        return 0;
+    }
+    *items = malloc(sizeof(Item*) * count);
+    if (*items == NULL) {
+        logError("Overflow, Memory allocation failed\n");
+        return 0;
+    }
+
+    int live = 0;
+    for (Node* node = fm->clipboard.front; node != NULL; node = node->next) {
+        Tree tree = resolve_node_handle(*(NodeHandle*)node->data);
+        if (tree == NULL) {
+            logWarn("Item clipboard sudah tidak ada, dilewati\n");
+            continue;
+        }
+        (*items)[live++] = &tree->item;
+    }
+    return live;
+}
+
+/**
+ * @brief Empties the clipboard and frees its handles
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _clearClipboard(FileManager* fm) {
+    while (!is_queue_empty(fm->clipboard)) {
+        free(dequeue(&fm->clipboard));
+    }
+}
+
+/**
+ * @brief Finds the tree nodes of many items in a single traversal
+ *
+ * Replaces one searchTree() per item (O(items * tree)) with a path lookup
+ * table and one iterative walk (O(items + tree)). Items nested inside
+ * another resolved folder are reported as NULL, since handling the
+ * folder already covers them.
+ *
+ * @param[in] root Tree to search
+ * @param[in] items Items to resolve (matched by path and name)
+ * @param[in] count Number of items
+ * @param[out] nodes Array of count entries, NULL where no node was found
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _resolveNodes(Tree root, Item** items, int count, Tree* nodes) {
+    HashMap wanted;
+    create_string_hashmap(&wanted);
+    for (int i = 0; i < count; i++) {
+        nodes[i] = NULL;
+        if (items[i] != NULL && items[i]->path != NULL) {
+            hashmap_put(&wanted, items[i]->path, (void*)(intptr_t)(i + 1));
+        }
+    }
+
+    int capacity = 64;
+    int top = 0;
+    int remaining = (int)wanted.size;
+    Tree* stack = malloc(sizeof(Tree) * capacity);
+    if (stack != NULL && root != NULL) {
+        stack[top++] = root;
+    }
+
+    while (top > 0 && remaining > 0) {
+        Tree current = stack[--top];
+
+        intptr_t slot = (intptr_t)hashmap_get(&wanted, current->item.path);
+        if (slot > 0 && nodes[slot - 1] == NULL && strcmp(current->item.name, items[slot - 1]->name) == 0) {
+            nodes[slot - 1] = current;
+            remaining--;
+        }
+
+        for (Tree child = current->first_son; child != NULL; child = child->next_brother) {
+            if (top == capacity) {
+                Tree* grown = realloc(stack, sizeof(Tree) * capacity * 2);
+                if (grown == NULL) {
+                    logError("Overflow, Memory allocation failed\n");
+                    top = 0;
+                    break;
+                }
+                stack = grown;
+                capacity *= 2;
             }
+            stack[top++] = child;
+        }
+    }
+    free(stack);
+    destroy_hashmap(&wanted);
 
-            // Free semua allocated memory termasuk UID
-            free(trashItem->uid);
-            free(trashItem->originalPath);
-            free(trashItem->trashPath);
-            free(trashItem);
-            free(current);
-            return;
+    // Item di dalam folder yang juga dipilih sudah tercakup oleh folder tersebut
+    HashMap resolved;
+    create_pointer_hashmap(&resolved);
+    for (int i = 0; i < count; i++) {
+        if (nodes[i] != NULL) {
+            hashmap_put(&resolved, nodes[i], nodes[i]);
         }
-        prev = current;
-        current = current->next;
     }
+    for (int i = 0; i < count; i++) {
+        if (nodes[i] == NULL) {
+            continue;
+        }
+        for (Tree ancestor = nodes[i]->parent; ancestor != NULL; ancestor = ancestor->parent) {
+            if (hashmap_contains(&resolved, ancestor)) {
+                logDebug("%s sudah termasuk dalam folder induk yang dipilih\n", items[i]->name);
+                nodes[i] = NULL;
+                break;
+            }
+        }
+    }
+    destroy_hashmap(&resolved);
 }
 
 /**
- * @brief Removes trash item by unique identifier
+ * @brief Unlinks many nodes from the tree and frees them
  *
- * Searches trash list for item with matching UID and removes it.
- * Frees all associated memory including paths and metadata.
+ * Each affected parent's child list is rebuilt once, instead of one
+ * sibling scan per removed node as remove_node() does. Like remove_node(),
+ * each node is freed with its whole subtree; nodes below another removed
+ * node go with their ancestor.
  *
  * @param[in,out] fm Pointer to FileManager instance
- * @param[in] uid Unique identifier of item to remove
+ * @param[in] nodes Nodes to remove; NULL entries are skipped
+ * @param[in] count Number of entries in nodes
  *
- * @pre uid exists in trash list
- * @post Item with matching UID removed from trash, memory freed
+ * @pre No selection or search result still points into the removed nodes
  *
  * @internal
  * @since 1.0
  */
-static void _removeFromTrashByUID(FileManager* fm, char* uid) {
-    Node* current = fm->trash.head;
-    Node* prev = NULL;
+static void _detachNodes(FileManager* fm, Tree* nodes, int count) {
+    HashMap doomed;
+    HashMap parents;
+    create_pointer_hashmap(&doomed);
+    create_pointer_hashmap(&parents);
+
+    for (int i = 0; i < count; i++) {
+        if (nodes[i] != NULL && !hashmap_contains(&doomed, nodes[i])) {
+            hashmap_put(&doomed, nodes[i], nodes[i]);
+        }
+    }
 
-    while (current != NULL) {
-        TrashItem* trashItem = (TrashItem*)current->data;
-        if (strcmp(trashItem->uid, uid) == 0) {
-            if (prev == NULL) {
-                fm->trash.head = current->next;
+    // Node di dalam subtree node lain ikut terhapus bersama ancestor-nya
+    bool* covered = calloc(count > 0 ? count : 1, sizeof(bool));
+    for (int i = 0; i < count; i++) {
+        for (Tree up = nodes[i] ? nodes[i]->parent : NULL; up != NULL && !covered[i]; up = up->parent) {
+            covered[i] = hashmap_contains(&doomed, up);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (nodes[i] == NULL || covered[i]) {
+            continue;
+        }
+        Tree parent = nodes[i]->parent;
+        if (parent == NULL) {
+            // Root tidak pernah dihapus lewat batch
+            logError("Root tidak dapat dihapus\n");
+            continue;
+        }
+        if (hashmap_contains(&parents, parent)) {
+            continue;
+        }
+        hashmap_put(&parents, parent, parent);
+
+        // Saring daftar anak parent ini sekali jalan
+        Tree* link = &parent->first_son;
+        while (*link != NULL) {
+            Tree child = *link;
+            if (hashmap_contains(&doomed, child)) {
+                *link = child->next_brother;
+                child->next_brother = NULL;
+                _dropSyncedChild(fm, parent, child);
             }
             else {
-                prev->next = current->next;
+                link = &child->next_brother;
             }
-
-            // Free semua allocated memory
-            free(trashItem->uid);
-            free(trashItem->item.name);
-            free(trashItem->item.path);
-            free(trashItem->originalPath);
-            free(trashItem->trashPath);
-            free(trashItem);
-            free(current);
-
-            printf("[LOG] Trash item dengan UID %s berhasil dihapus\n", uid);
-            return;
         }
-        prev = current;
-        current = current->next;
+        reindex_children(parent);
     }
 
-    printf("[LOG] Trash item dengan UID %s tidak ditemukan\n", uid);
+    free(covered);
+    destroy_hashmap(&parents);
+    destroy_hashmap(&doomed);
 }
 
 /*
@@ -1539,38 +2083,26 @@ static void _removeFromTrashByUID(FileManager* fm, char* uid) {
 /**
  * @brief Copies file content from source to destination
  *
- * Performs binary file copy with buffer-based transfer for efficiency.
- * Handles file opening, reading, writing, and proper resource cleanup.
+ * Delegates to the copy engine, which skips holes in sparse files and
+ * recreates them at the destination so sparse images keep their footprint.
  *
  * @param[in] srcPath Source file path
  * @param[in] destPath Destination file path
+ * @param[in,out] stats Optional copy statistics accumulator, may be NULL
+ * @return true if file copied completely, false otherwise
  *
  * @pre srcPath exists and is readable, destPath is writable
- * @post File content copied to destination
+ * @post File content copied to destination, stats updated
  *
  * @internal
  * @since 1.0
  */
-static void _copyFileContent(char* srcPath, char* destPath) {
-    FILE* src = fopen(srcPath, "rb");
-    FILE* dest = fopen(destPath, "wb");
-
-    if (!src || !dest) {
-        if (src)
-            fclose(src);
-        if (dest)
-            fclose(dest);
-        return;
-    }
-
-    char buffer[4096];
-    size_t bytes;
-    while ((bytes = fread(buffer, 1, sizeof(buffer), src)) > 0) {
-        fwrite(buffer, 1, bytes, dest);
+static bool _copyFileContent(char* srcPath, char* destPath, CopyStats* stats) {
+    if (!copyFileSparse(srcPath, destPath, stats)) {
+        logError("Gagal menyalin file: %s -> %s\n", srcPath, destPath);
+        return false;
     }
-
-    fclose(src);
-    fclose(dest);
+    return true;
 }
 
 /**
@@ -1581,6 +2113,7 @@ static void _copyFileContent(char* srcPath, char* destPath) {
  *
  * @param[in] srcPath Source folder path
  * @param[in] destPath Destination folder path
+ * @param[in,out] stats Optional copy statistics accumulator, may be NULL
  *
  * @pre srcPath exists and is readable, destPath parent exists
  * @post Complete folder structure copied to destination
@@ -1588,17 +2121,18 @@ static void _copyFileContent(char* srcPath, char* destPath) {
  * @internal
  * @since 1.0
  */
-static void _copyFolderRecursive(char* srcPath, char* destPath) {
+static void _copyFolderRecursive(char* srcPath, char* destPath, CopyStats* stats) {
+    PROFILE_FUNCTION();
     DIR* dp = opendir(srcPath);
     if (!dp) {
-        printf("[LOG] Gagal membuka direktori source: %s\n", srcPath);
+        logError("Gagal membuka direktori source: %s\n", srcPath);
         return;
     }
 
     struct dirent* ep;
     struct stat statbuf;
 
-    printf("[LOG] Copying dari %s ke %s\n", srcPath, destPath);
+    logTrace("Copying dari %s ke %s\n", srcPath, destPath);
 
     while ((ep = readdir(dp)) != NULL) {
         if (strcmp(ep->d_name, ".") == 0 || strcmp(ep->d_name, "..") == 0)
@@ -1611,10 +2145,10 @@ static void _copyFolderRecursive(char* srcPath, char* destPath) {
         sprintf(srcItem, "%s/%s", srcPath, ep->d_name);
         sprintf(destItem, "%s/%s", destPath, ep->d_name);
 
-        printf("[LOG] Processing: %s -> %s\n", srcItem, destItem);
+        logTrace("Processing: %s -> %s\n", srcItem, destItem);
 
         if (stat(srcItem, &statbuf) == -1) {
-            printf("[LOG] Gagal stat file: %s\n", srcItem);
+            logError("Gagal stat file: %s\n", srcItem);
             free(srcItem);
             free(destItem);
             continue;
@@ -1622,19 +2156,19 @@ static void _copyFolderRecursive(char* srcPath, char* destPath) {
 
         if (S_ISDIR(statbuf.st_mode)) {
             // Buat folder dan copy rekursif
-            printf("[LOG] Membuat direktori: %s\n", destItem);
-            if (MakeDirectory(destItem) != 0) {
-                printf("[LOG] Gagal membuat direktori: %s\n", destItem);
+            logTrace("Membuat direktori: %s\n", destItem);
+            if (makeDirectory(destItem) != 0) {
+                logError("Gagal membuat direktori: %s\n", destItem);
                 free(srcItem);
                 free(destItem);
                 continue;
             }
-            _copyFolderRecursive(srcItem, destItem);
+            _copyFolderRecursive(srcItem, destItem, stats);
         }
         else if (S_ISREG(statbuf.st_mode)) {
             // Copy file content
-            printf("[LOG] Copying file: %s -> %s\n", srcItem, destItem);
-            _copyFileContent(srcItem, destItem);
+            logTrace("Copying file: %s -> %s\n", srcItem, destItem);
+            _copyFileContent(srcItem, destItem, stats);
         }
 
         free(srcItem);
@@ -1668,6 +2202,7 @@ static void _copyFolderRecursive(char* srcPath, char* destPath) {
  * @since 1.0
  */
 static void _loadTree(Tree tree, char* path) {
+    PROFILE_FUNCTION();
     DIR* dp;
     struct dirent* ep;
     struct stat statbuf;
@@ -1682,6 +2217,7 @@ static void _loadTree(Tree tree, char* path) {
     while ((ep = readdir(dp)) != NULL) {
         if (strcmp(ep->d_name, ".") == 0 || strcmp(ep->d_name, "..") == 0)
             continue;
+        scannedEntries++;
 
         char* fullPath = malloc(strlen(path) + strlen(ep->d_name) + 2);
         sprintf(fullPath, "%s/%s", path, ep->d_name);
@@ -1703,7 +2239,7 @@ static void _loadTree(Tree tree, char* path) {
             insert_node(tree, data);
         }
         else {
-            printf("[LOG]   (Tipe lain) Ditemukan: %s\n", fullPath);
+            logTrace("  (Tipe lain) Ditemukan: %s\n", fullPath);
         }
 
         free(fullPath);
@@ -1716,16 +2252,17 @@ static void _loadTree(Tree tree, char* path) {
 }
 
 /**
- * @brief Loads persistent trash data from storage file
+ * @brief Loads legacy CSV trash data for migration
  *
- * Reads trash dump file and reconstructs trash linked list with all
- * deleted items including metadata. Parses CSV format with UID, original
- * name, original path, and deletion timestamp. Handles memory allocation
- * and proper trash item structure initialization.
+ * Reads the pre-journal trash dump file and reconstructs the trash store
+ * with all deleted items including metadata. Parses CSV format with UID,
+ * original name, original path, and deletion timestamp. Only used once,
+ * when no trash journal exists yet; the result is then written to the
+ * journal by trashJournalRewrite().
  *
- * @param[in,out] trash Pointer to trash linked list to populate
+ * @param[in,out] trash Pointer to trash store to populate
  *
- * @pre trash linked list is properly initialized
+ * @pre trash store is properly initialized
  * @post trash list populated with all persistent trash items
  *
  * @note Creates new file if trash dump doesn't exist
@@ -1734,16 +2271,16 @@ static void _loadTree(Tree tree, char* path) {
  * @note Reconstructs trash paths based on UID naming convention
  * @warning Memory allocation may fail for large trash files
  *
- * @see saveTrashToFile() for corresponding save operation
+ * @see trashJournalRewrite() for the migration target
  * @see _generateUID() for UID format details
  *
  * @internal
  * @since 1.0
  */
-static void _loadTrashFromFile(LinkedList* trash) {
+static void _loadTrashFromFile(TrashStore* trash) {
     FILE* trashFile = fopen(TRASH_DUMP, "r");
     if (trashFile == NULL) {
-        printf("[LOG] File trash tidak ditemukan, membuat baru\n");
+        logInfo("File trash tidak ditemukan, membuat baru\n");
         return;
     }
 
@@ -1784,7 +2321,7 @@ static void _loadTrashFromFile(LinkedList* trash) {
 
                 // Set data dengan nama asli untuk display
                 trashItem->uid = strdup(uid);
-                trashItem->item.name = strdup(originalName); // Nama asli untuk display
+                trashItem->item.name = itemStrdup(originalName); // Nama asli untuk display
                 trashItem->originalPath = strdup(originalPath);
                 trashItem->deletedTime = (time_t)atoll(deletedTimeStr);
 
@@ -1793,31 +2330,31 @@ static void _loadTrashFromFile(LinkedList* trash) {
                 trashItem->item.type = fileExtension ? ITEM_FILE : ITEM_FOLDER;
 
                 // Konstruksi trash path berdasarkan UID
-                char* trashFileName;
+                const char* trashFileName;
                 if (fileExtension && trashItem->item.type == ITEM_FILE) {
                     size_t nameLen = fileExtension - originalName;
                     char* nameWithoutExt = malloc(nameLen + 1);
                     strncpy(nameWithoutExt, originalName, nameLen);
                     nameWithoutExt[nameLen] = '\0';
 
-                    trashFileName = TextFormat("%s_%s%s", nameWithoutExt, uid, fileExtension);
+                    trashFileName = formatText("%s_%s%s", nameWithoutExt, uid, fileExtension);
                     free(nameWithoutExt);
                 }
                 else {
-                    trashFileName = TextFormat("%s_%s", originalName, uid);
+                    trashFileName = formatText("%s_%s", originalName, uid);
                 }
 
-                trashItem->trashPath = strdup(TextFormat("%s/%s", TRASH, trashFileName));
+                trashItem->trashPath = strdup(formatText("%s/%s", TRASH, trashFileName));
 
                 // Set item properties untuk display
-                trashItem->item.path = strdup(trashItem->trashPath);
+                trashItem->item.path = itemStrdup(trashItem->trashPath);
                 trashItem->item.size = 0; // Will be updated when needed
                 trashItem->item.created_at = 0;
                 trashItem->item.deleted_at = trashItem->deletedTime;
                 trashItem->item.selected = false;
 
-                insert_first(trash, trashItem);
-                printf("[LOG] Loaded trash item: %s (UID: %s, Deleted: %ld)\n",
+                trashStoreInsert(trash, trashItem);
+                logTrace("Loaded trash item: %s (UID: %s, Deleted: %ld)\n",
                     originalName, uid, trashItem->deletedTime);
             }
 
@@ -1840,33 +2377,36 @@ static void _loadTrashFromFile(LinkedList* trash) {
             TrashItem* trashItem = alloc(TrashItem);
             if (trashItem) {
                 trashItem->uid = strdup(uid);
-                trashItem->item.name = strdup(originalName);
+                trashItem->item.name = itemStrdup(originalName);
                 trashItem->originalPath = strdup(originalPath);
                 trashItem->deletedTime = (time_t)atoll(deletedTimeStr);
 
                 char* fileExtension = strrchr(originalName, '.');
                 trashItem->item.type = fileExtension ? ITEM_FILE : ITEM_FOLDER;
 
-                char* trashFileName;
+                const char* trashFileName;
                 if (fileExtension && trashItem->item.type == ITEM_FILE) {
                     size_t nameLen = fileExtension - originalName;
                     char* nameWithoutExt = malloc(nameLen + 1);
                     strncpy(nameWithoutExt, originalName, nameLen);
                     nameWithoutExt[nameLen] = '\0';
 
-                    trashFileName = TextFormat("%s_%s%s", nameWithoutExt, uid, fileExtension);
+                    trashFileName = formatText("%s_%s%s", nameWithoutExt, uid, fileExtension);
                     free(nameWithoutExt);
                 }
                 else {
-                    trashFileName = TextFormat("%s_%s", originalName, uid);
+                    trashFileName = formatText("%s_%s", originalName, uid);
                 }
 
-                trashItem->trashPath = strdup(TextFormat("%s/%s", TRASH, trashFileName));
-                trashItem->item.path = strdup(trashItem->trashPath);
+                trashItem->trashPath = strdup(formatText("%s/%s", TRASH, trashFileName));
+                trashItem->item.path = itemStrdup(trashItem->trashPath);
+                trashItem->item.size = 0;
+                trashItem->item.created_at = 0;
                 trashItem->item.deleted_at = trashItem->deletedTime;
+                trashItem->item.selected = false;
 
-                insert_first(trash, trashItem);
-                printf("[LOG] Loaded trash item: %s (UID: %s, Deleted: %ld)\n",
+                trashStoreInsert(trash, trashItem);
+                logTrace("Loaded trash item: %s (UID: %s, Deleted: %ld)\n",
                     originalName, uid, trashItem->deletedTime);
             }
         }
@@ -1888,7 +2428,7 @@ static void _loadTrashFromFile(LinkedList* trash) {
  * @pre tree pointer is valid (may point to NULL tree)
  * @post All tree memory freed, tree pointer set to NULL
  *
- * @note Recursively processes all children and siblings
+ * @note Recurses into children, iterates over siblings
  * @note Frees item name and path strings before freeing nodes
  * @note Safe to call with NULL tree pointer
  * @warning Tree becomes unusable after this operation
@@ -1899,15 +2439,16 @@ static void _loadTrashFromFile(LinkedList* trash) {
  * @since 1.0
  */
 static void _destroyTree(Tree* tree) {
-    if (*tree == NULL)
-        return;
-
-    _destroyTree(&(*tree)->first_son);
-    _destroyTree(&(*tree)->next_brother);
+    // Saudara diproses iteratif agar folder besar tidak menghabiskan stack
+    Tree current = *tree;
+    while (current != NULL) {
+        Tree next = current->next_brother;
+        _destroyTree(&current->first_son);
 
-    free((*tree)->item.name);
-    free((*tree)->item.path);
-    free(*tree);
+        destroyItem(&current->item);
+        free_node_tree(current);
+        current = next;
+    }
     *tree = NULL;
 }
 
@@ -1936,67 +2477,54 @@ static void _destroyTree(Tree* tree) {
 static void _addBackToTree(FileManager* fm, TrashItem* trashItem, char* recoverPath) {
     // Update item dengan path baru
     Item recoveredItem = trashItem->item;
-    recoveredItem.path = strdup(fm->currentPath);
-    recoveredItem.name = strdup(getNameFromPath(recoverPath));
+    recoveredItem.path = itemStrdup(fm->currentPath);
+    recoveredItem.name = itemStrdup(getNameFromPath(recoverPath));
     recoveredItem.deleted_at = 0; // Reset deleted time
 
     // Cari parent node di tree
     Tree parentNode = searchTree(fm->root,
-        createItem(getNameFromPath(fm->currentPath),
-            fm->currentPath, 0, ITEM_FOLDER, 0, 0, 0));
+        createItemKey(getNameFromPath(fm->currentPath), fm->currentPath, ITEM_FOLDER));
 
     if (parentNode != NULL) {
         // Insert ke tree sebagai child dari current directory
         insert_node(parentNode, recoveredItem);
-        printf("[LOG] Item berhasil ditambahkan kembali ke tree\n");
+        logDebug("Item berhasil ditambahkan kembali ke tree\n");
     }
     else {
-        printf("[LOG] Gagal menemukan parent directory di tree\n");
+        logError("Gagal menemukan parent directory di tree\n");
     }
 }
 
 /**
  * @brief Removes node from tree structure
  *
- * Safely removes tree node and updates parent-child relationships.
- * Handles both first child and sibling node removal cases.
+ * Unlinks the node from its parent and frees it with its whole subtree,
+ * so handles into the subtree stop resolving.
  *
- * @param[in,out] root Pointer to root tree node
+ * @param[in,out] fm Pointer to FileManager instance
  * @param[in] nodeToRemove Node to remove from tree
  *
  * @pre nodeToRemove exists in tree structure
- * @post Node removed from tree, relationships updated
+ * @post Node and descendants freed, relationships updated
  *
  * @internal
  * @since 1.0
  */
-static void remove_node(Tree* root, Tree nodeToRemove) {
-    if (*root == NULL || nodeToRemove == NULL)
+static void remove_node(FileManager* fm, Tree nodeToRemove) {
+    if (fm->root == NULL || nodeToRemove == NULL)
         return;
 
     Tree parent = nodeToRemove->parent;
 
     if (parent == NULL) {
-        *root = NULL;
-        free(nodeToRemove);
+        _forgetSubtree(fm, nodeToRemove);
+        fm->treeCursor = NULL;
+        _destroyTree(&fm->root);
         return;
     }
 
-    if (parent->first_son == nodeToRemove) {
-        parent->first_son = nodeToRemove->next_brother;
-    }
-    else {
-        Tree sibling = parent->first_son;
-        while (sibling != NULL && sibling->next_brother != nodeToRemove) {
-            sibling = sibling->next_brother;
-        }
-
-        if (sibling != NULL) {
-            sibling->next_brother = nodeToRemove->next_brother;
-        }
-    }
-
-    free(nodeToRemove);
+    remove_child(parent, nodeToRemove);
+    _dropSyncedChild(fm, parent, nodeToRemove);
 }
 
 /**
@@ -2021,7 +2549,7 @@ static void _reconstructTreeStructure(FileManager* fm, Tree sourceTree, char* ne
     Tree parentNode = fm->treeCursor;
 
     if (parentNode == NULL) {
-        printf("[LOG] Parent node tidak ditemukan\n");
+        logWarn("Parent node tidak ditemukan\n");
         return;
     }
 
@@ -2057,7 +2585,7 @@ static void _reconstructTreeStructure(FileManager* fm, Tree sourceTree, char* ne
  * @internal
  * @since 1.0
  */
-static void _loadTreeFromPath(Tree parentNode, char* basePath) {
+static void _loadTreeFromPath(Tree parentNode, const char* basePath) {
     DIR* dp;
     struct dirent* ep;
     struct stat statbuf;
@@ -2070,8 +2598,9 @@ static void _loadTreeFromPath(Tree parentNode, char* basePath) {
     while ((ep = readdir(dp)) != NULL) {
         if (strcmp(ep->d_name, ".") == 0 || strcmp(ep->d_name, "..") == 0)
             continue;
+        scannedEntries++;
 
-        char* fullPath = TextFormat("%s/%s", basePath, ep->d_name);
+        const char* fullPath = formatText("%s/%s", basePath, ep->d_name);
 
         if (stat(fullPath, &statbuf) == -1) {
             continue;
@@ -2128,11 +2657,11 @@ static void _addBackToTreeFromTrash(FileManager* fm, TrashItem* trashItem, char*
         );
 
         insert_node(parentNode, recoveredItem);
-        printf("[LOG] Item '%s' berhasil ditambahkan kembali ke tree di %s\n",
+        logDebug("Item '%s' berhasil ditambahkan kembali ke tree di %s\n",
             recoveredItem.name, parentDir);
     }
     else {
-        printf("[LOG] Gagal menemukan parent directory di tree: %s\n", parentDir);
+        logError("Gagal menemukan parent directory di tree: %s\n", parentDir);
     }
 
     free(parentDir);
@@ -2160,22 +2689,23 @@ static void _addTreeStructureRecursive(Tree parentNode, char* folderPath) {
 
     dp = opendir(folderPath);
     if (dp == NULL) {
-        printf("[LOG] Gagal membuka direktori: %s\n", folderPath);
+        logError("Gagal membuka direktori: %s\n", folderPath);
         return;
     }
 
-    printf("[LOG] Memproses direktori: %s\n", folderPath);
+    logTrace("Memproses direktori: %s\n", folderPath);
 
     while ((ep = readdir(dp)) != NULL) {
         if (strcmp(ep->d_name, ".") == 0 || strcmp(ep->d_name, "..") == 0) {
             continue;
         }
+        scannedEntries++;
 
         // PERBAIKAN: Gunakan manual string construction yang aman
         size_t pathLen = strlen(folderPath) + strlen(ep->d_name) + 2;
         char* fullPath = malloc(pathLen);
         if (!fullPath) {
-            printf("[LOG] Gagal alokasi memory untuk fullPath\n");
+            logError("Gagal alokasi memory untuk fullPath\n");
             continue;
         }
         snprintf(fullPath, pathLen, "%s/%s", folderPath, ep->d_name);
@@ -2185,8 +2715,8 @@ static void _addTreeStructureRecursive(Tree parentNode, char* folderPath) {
 
             // Buat item baru
             Item newItem = createItem(
-                strdup(ep->d_name), // PERBAIKAN: strdup untuk memory safety
-                strdup(fullPath),   // PERBAIKAN: strdup untuk memory safety
+                ep->d_name, // createItem menyalin nama dan path
+                fullPath,
                 statbuf.st_size,
                 type,
                 statbuf.st_ctime,
@@ -2196,25 +2726,25 @@ static void _addTreeStructureRecursive(Tree parentNode, char* folderPath) {
             // Tambahkan ke parent node
             Tree newNode = insert_node(parentNode, newItem);
 
-            printf("[LOG] Added to tree: %s (type: %s, path: %s)\n",
+            logTrace("Added to tree: %s (type: %s, path: %s)\n",
                 ep->d_name, type == ITEM_FOLDER ? "FOLDER" : "FILE", fullPath);
 
             // PERBAIKAN: Jika folder, rekursif tambahkan isinya
             if (type == ITEM_FOLDER && newNode != NULL) {
-                printf("[LOG] Recursively processing folder: %s\n", fullPath);
+                logTrace("Recursively processing folder: %s\n", fullPath);
                 _addTreeStructureRecursive(newNode, fullPath);
-                printf("[LOG] Finished processing folder: %s\n", fullPath);
+                logTrace("Finished processing folder: %s\n", fullPath);
             }
         }
         else {
-            printf("[LOG] Gagal stat file: %s\n", fullPath);
+            logError("Gagal stat file: %s\n", fullPath);
         }
 
         free(fullPath);
     }
 
     closedir(dp);
-    printf("[LOG] Selesai memproses direktori: %s\n", folderPath);
+    logTrace("Selesai memproses direktori: %s\n", folderPath);
 }
 
 /*
@@ -2231,7 +2761,7 @@ static void _addTreeStructureRecursive(Tree parentNode, char* folderPath) {
  *
  * @param[in] dirPath Original directory path
  * @param[in] suffix Suffix to append for uniqueness
- * @return Unique directory path string
+ * @return Unique directory path (caller frees)
  *
  * @pre dirPath and suffix are valid strings
  * @post Unique directory path returned
@@ -2239,10 +2769,12 @@ static void _addTreeStructureRecursive(Tree parentNode, char* folderPath) {
  * @internal
  * @since 1.0
  */
-static char* _createDuplicatedFolderName(char* filePath, char* suffix) {
-    char* newPath = TextFormat("%s%s", filePath, suffix);
-    if (DirectoryExists(newPath)) {
-        newPath = _createDuplicatedFolderName(newPath, suffix);
+static char* _createDuplicatedFolderName(const char* dirPath, const char* suffix) {
+    char* newPath = strdup(formatText("%s%s", dirPath, suffix));
+    while (directoryExists(newPath)) {
+        char* nextPath = strdup(formatText("%s%s", newPath, suffix));
+        free(newPath);
+        newPath = nextPath;
     }
     return newPath;
 }
@@ -2255,7 +2787,7 @@ static char* _createDuplicatedFolderName(char* filePath, char* suffix) {
  *
  * @param[in] filePath Original file path
  * @param[in] suffix Suffix to insert for uniqueness
- * @return Unique file path string
+ * @return Unique file path (caller frees)
  *
  * @pre filePath and suffix are valid strings
  * @post Unique file path returned
@@ -2263,22 +2795,21 @@ static char* _createDuplicatedFolderName(char* filePath, char* suffix) {
  * @internal
  * @since 1.0
  */
-static char* _createDuplicatedFileName(char* filePath, char* suffix) {
-    size_t len;
-    char* extention = strrchr(filePath, '.');
-    if (extention) {
-        len = extention - filePath;
-    }
-    else {
-        len = strlen(filePath);
-    }
-    char* nameOnly = (char*)malloc(len + 1);
-    strncpy(nameOnly, filePath, len);
-    nameOnly[len] = '\0';
-
-    char* newPath = TextFormat("%s%s%s", nameOnly, suffix, extention);
-    if (FileExists(newPath)) {
-        newPath = _createDuplicatedFileName(newPath, suffix);
+static char* _createDuplicatedFileName(const char* filePath, const char* suffix) {
+    // Ekstensi hanya dicari di nama file, bukan di nama folder induknya
+    const char* name = strrchr(filePath, '/');
+    name = name ? name + 1 : filePath;
+    const char* extention = strrchr(name, '.');
+    if (extention == NULL || extention == name) {
+        extention = "";
+    }
+    int len = (int)(strlen(filePath) - strlen(extention));
+
+    char* newPath = strdup(formatText("%.*s%s%s", len, filePath, suffix, extention));
+    if (fileExists(newPath)) {
+        char* nextPath = _createDuplicatedFileName(newPath, suffix);
+        free(newPath);
+        newPath = nextPath;
     }
     return newPath;
 }
@@ -2484,16 +3015,16 @@ static bool _validateImportPath(char* path) {
  */
 static void _undoCreate(FileManager* fm, Operation* operationToUndo) {
     Tree foundTree;
-    printf("[LOG] Undo Path: %s\n", operationToUndo->from);
+    logDebug("Undo Path: %s\n", operationToUndo->from);
     // Hapus item yang baru dibuat
-    foundTree = searchTree(fm->root, createItem(getNameFromPath(operationToUndo->from), operationToUndo->from, 0, ITEM_FILE, 0, 0, 0));
+    foundTree = searchTree(fm->root, createItemKey(getNameFromPath(operationToUndo->from), operationToUndo->from, ITEM_FILE));
     if (foundTree != NULL) {
         operationToUndo->isDir = foundTree->item.type == ITEM_FILE ? false : true;
         _deleteSingleItem(foundTree->item.path, foundTree->item.type, foundTree->item.name);
-        printf("[LOG] Undo create: %s\n", operationToUndo->from);
+        logDebug("Undo create: %s\n", operationToUndo->from);
     }
     else {
-        printf("[LOG] Item tidak ditemukan untuk dihapus: %s\n", operationToUndo->from);
+        logWarn("Item tidak ditemukan untuk dihapus: %s\n", operationToUndo->from);
     }
 }
 
@@ -2501,7 +3032,8 @@ static void _undoCreate(FileManager* fm, Operation* operationToUndo) {
  * @brief Undoes delete operation by restoring items
  *
  * Reverses delete operation by restoring items from trash.
- * Recreates items in original locations and removes from trash.
+ * Moves each item back from the trash to its original path (or a
+ * "(recovered)" name if that path is taken), like recoverFile() does.
  *
  * @param[in,out] fm Pointer to FileManager instance
  * @param[in] opToUndo Operation to undo
@@ -2514,26 +3046,42 @@ static void _undoCreate(FileManager* fm, Operation* operationToUndo) {
  * @since 1.0
  */
 static void _undoDelete(FileManager* fm, Operation* operationToUndo, Operation* operationToRedo) {
-    Tree foundTree;
     TrashItem* trashItem;
-    operationToRedo->itemTemp = alloc(Queue);
-    create_queue(&(*(operationToRedo->itemTemp)));
-    // Kembalikan item yang dihapus
-    if (is_queue_empty(*(operationToUndo->itemTemp))) {
-        printf("bajigur, kosong\n");
-    }
+    long long seq = opJournalBegin(&fm->opJournal, ACTION_RECOVER, false);
+    // Kembalikan item yang dihapus dari trash ke lokasi asalnya
     while (!is_queue_empty(*(operationToUndo->itemTemp))) {
         trashItem = (TrashItem*)dequeue(&(*operationToUndo->itemTemp));
-        printf("Item origin path:%s\n", trashItem->originalPath);
         enqueue(&(*operationToRedo->itemTemp), trashItem);
-        // Buat item baru dengan path yang sudah dihapus
-        createFile(fm, trashItem->item.type, _getDirectoryFromPath(trashItem->originalPath), trashItem->item.name, false);
-        _removeFromTrash(fm, trashItem->item.name);
-        _deletePermanently(trashItem->trashPath, trashItem->item.type, trashItem->item.name);
-        printf("[LOG] Undo delete item: %s\n", trashItem->item.name);
-        // enqueue(&(operationToRedo->itemTemp), trashItem);
+
+        if (trashStoreFindByUID(&fm->trash, trashItem->uid) == NULL) {
+            logWarn("Item %s sudah tidak ada di trash (UID: %s)\n", trashItem->item.name, trashItem->uid);
+            continue;
+        }
+
+        char* recoverPath = _recoveryPath(trashItem);
+        opJournalStep(&fm->opJournal, seq, trashItem->item.type, trashItem->trashPath, recoverPath, trashItem->uid);
+        if (rename(trashItem->trashPath, recoverPath) == 0) {
+            _removeFromTrashByUID(fm, trashItem->uid);
+            opJournalStepDone(&fm->opJournal, seq);
+
+            // Tambah kembali ke tree; isi folder ikut dibangun ulang
+            _addBackToTreeFromTrash(fm, trashItem, recoverPath);
+            if (trashItem->item.type == ITEM_FOLDER) {
+                Tree restored = _findNodeByPath(fm->root, recoverPath);
+                if (restored != NULL) {
+                    _addTreeStructureRecursive(restored, recoverPath);
+                }
+            }
+            logDebug("Undo delete item: %s -> %s\n", trashItem->item.name, recoverPath);
+        }
+        else {
+            logError("Gagal mengembalikan %s dari trash (UID: %s)\n", trashItem->item.name, trashItem->uid);
+        }
+        free(recoverPath);
     }
-    printf("[LOG] Undo delete selesai\n");
+    opJournalEnd(&fm->opJournal, seq);
+    saveTrashToFile(fm);
+    logInfo("Undo delete selesai\n");
 }
 
 /**
@@ -2554,10 +3102,10 @@ static void _undoDelete(FileManager* fm, Operation* operationToUndo, Operation*
 static void _undoRename(FileManager* fm, Operation* operationToUndo) {
     Tree foundTree;
     // Kembalikan nama item yang diubah
-    foundTree = searchTree(fm->root, createItem(getNameFromPath(operationToUndo->to), operationToUndo->to, 0, ITEM_FILE, 0, 0, 0));
+    foundTree = searchTree(fm->root, createItemKey(getNameFromPath(operationToUndo->to), operationToUndo->to, ITEM_FILE));
     if (foundTree != NULL) {
         renameFile(fm, foundTree->item.path, getNameFromPath(operationToUndo->from), false);
-        printf("[LOG] Undo update: %s to %s\n", operationToUndo->to, operationToUndo->from);
+        logDebug("Undo update: %s to %s\n", operationToUndo->to, operationToUndo->from);
     }
 }
 
@@ -2582,80 +3130,87 @@ static void _undoPaste(FileManager* fm, Operation* operationToUndo, Operation* o
     operationToRedo->isCopy = operationToUndo->isCopy;
     if (!operationToUndo->isCopy) {
         // Jika cut, perlu mengembalikan item ke lokasi asalnya
+        long long seq = opJournalBegin(&fm->opJournal, ACTION_PASTE, false);
         while (!is_queue_empty(*(operationToUndo->itemTemp))) {
             PasteItem* pasteItem = (PasteItem*)dequeue(&(*operationToUndo->itemTemp));
-            Tree parentOriginTree = searchTree(fm->root, createItem(getNameFromPath(_getDirectoryFromPath(pasteItem->originalPath)), _getDirectoryFromPath(pasteItem->originalPath), 0, ITEM_FOLDER, 0, 0, 0));
+            char* parentPath = _getDirectoryFromPath(pasteItem->originalPath);
+            Tree parentOriginTree = searchTree(fm->root, createItemKey(getNameFromPath(parentPath), parentPath, ITEM_FOLDER));
+            free(parentPath);
             if (parentOriginTree == NULL) {
-                printf("[LOG] Parent origin tree tidak ditemukan untuk path: %s\n", pasteItem->originalPath);
+                logWarn("Parent origin tree tidak ditemukan untuk path: %s\n", pasteItem->originalPath);
                 continue;
             }
-            foundTree = searchTree(fm->root, createItem(pasteItem->item.name, pasteItem->item.path, 0, pasteItem->item.type, 0, 0, 0));
+            foundTree = searchTree(fm->root, createItemKey(pasteItem->item.name, pasteItem->item.path, pasteItem->item.type));
             if (foundTree != NULL) {
-                printf("[LOG] Undo cut path: %s\n", pasteItem->item.path);
-                printf("[LOG] Undo cut name: %s\n", pasteItem->item.name);
+                logDebug("Undo cut path: %s\n", pasteItem->item.path);
+                logDebug("Undo cut name: %s\n", pasteItem->item.name);
                 // Pindahkan kembali ke lokasi asal
-                char* destPath = strdup(pasteItem->item.path);
                 char* originalPath = pasteItem->originalPath;
-                // Hapus item dari tree
+                opJournalStep(&fm->opJournal, seq, pasteItem->item.type, foundTree->item.path, originalPath, NULL);
                 if (rename(foundTree->item.path, originalPath) != 0) {
-                    printf("[LOG] Gagal mengembalikan item %s ke %s\n", pasteItem->item.name, originalPath);
+                    logError("Gagal mengembalikan item %s ke %s\n", pasteItem->item.name, originalPath);
                 }
                 else {
-                    // Update item path di tree
-                    foundTree->item.path = strdup(pasteItem->originalPath);
-                    foundTree->item.name = strdup(pasteItem->item.name);
-                    // Tambahkan ke tree parent asal
-                    Item newItem = createItem(foundTree->item.name, foundTree->item.path, foundTree->item.size, foundTree->item.type, foundTree->item.created_at, time(NULL), 0);
+                    opJournalStepDone(&fm->opJournal, seq);
+                    // Tambahkan ke tree parent asal; node lama dihapus di bawah
+                    Item newItem = createItem(pasteItem->item.name, originalPath, foundTree->item.size, foundTree->item.type, foundTree->item.created_at, time(NULL), 0);
                     Tree newTree = insert_node(parentOriginTree, newItem);
                     if (newItem.type == ITEM_FOLDER) {
                         _addTreeStructureRecursive(newTree, newItem.path);
-                        printf("[LOG] Folder %s berhasil dikembalikan ke %s\n", pasteItem->item.name, parentOriginTree->item.path);
+                        logDebug("Folder %s berhasil dikembalikan ke %s\n", pasteItem->item.name, parentOriginTree->item.path);
                     }
-                    printf("[LOG] Item %s berhasil dikembalikan ke %s\n", pasteItem->item.name, foundTree->item.path);
-
-                    pasteItem->originalPath = strdup(destPath);          // Update originalPath untuk redo
-                    pasteItem->item.path = strdup(foundTree->item.path); // Update path item
-                    pasteItem->item.name = strdup(foundTree->item.name); // Update name item
-                    printf("[LOG] Original path diupdate menjadi: %s\n", pasteItem->originalPath);
-                    free(destPath);
-                    remove_node(&(fm->root), foundTree);
-                    printf("[LOG] Item %s berhasil dihapus dari tree\n", pasteItem->item.name);
+                    logDebug("Item %s berhasil dikembalikan ke %s\n", pasteItem->item.name, originalPath);
+
+                    char* destPath = strdup(pasteItem->item.path);
+                    char* restoredName = itemStrdup(pasteItem->item.name);
+                    char* restoredPath = itemStrdup(originalPath);
+                    free(pasteItem->originalPath);
+                    destroyItem(&pasteItem->item);
+                    pasteItem->originalPath = destPath;  // Update originalPath untuk redo
+                    pasteItem->item.path = restoredPath; // Update path item
+                    pasteItem->item.name = restoredName; // Update name item
+                    logDebug("Original path diupdate menjadi: %s\n", pasteItem->originalPath);
+                    remove_node(fm, foundTree);
+                    logDebug("Item %s berhasil dihapus dari tree\n", pasteItem->item.name);
                 }
             }
             else {
-                printf("[LOG] Item tidak ditemukan untuk di-undo cut: %s\n", pasteItem->item.name);
+                logWarn("Item tidak ditemukan untuk di-undo cut: %s\n", pasteItem->item.name);
             }
             enqueue(&(*operationToRedo->itemTemp), pasteItem);
         }
+        opJournalEnd(&fm->opJournal, seq);
     }
     else {
         // Jika hanya copy, Hapus item yang sudah di-paste
         while (!is_queue_empty(*(operationToUndo->itemTemp))) {
             PasteItem* pasteItem = (PasteItem*)dequeue(&(*operationToUndo->itemTemp));
-            foundTree = searchTree(fm->root, createItem(pasteItem->item.name, pasteItem->item.path, 0, pasteItem->item.type, 0, 0, 0));
+            foundTree = searchTree(fm->root, createItemKey(pasteItem->item.name, pasteItem->item.path, pasteItem->item.type));
             if (foundTree != NULL) {
-                printf("[LOG] Undo paste path: %s\n", pasteItem->item.path);
-                printf("[LOG] Undo paste name: %s\n", pasteItem->item.name);
-                printf("[LOG] Original path: %s\n", pasteItem->originalPath);
+                logDebug("Undo paste path: %s\n", pasteItem->item.path);
+                logDebug("Undo paste name: %s\n", pasteItem->item.name);
+                logDebug("Original path: %s\n", pasteItem->originalPath);
                 char* destPath = strdup(pasteItem->item.path);
                 _deleteSingleItem(foundTree->item.path, foundTree->item.type, foundTree->item.name);
                 // Hapus dari tree
-                remove_node(&(fm->root), foundTree);
+                remove_node(fm, foundTree);
                 // ubah paste item ke original path
-                pasteItem->item.path = strdup(pasteItem->originalPath);                   // Update path item ke original path
-                pasteItem->item.name = strdup(getNameFromPath(pasteItem->originalPath)); // Update name item ke nama asli
-                pasteItem->originalPath = strdup(destPath);                               // Update originalPath untuk redo
-                printf("[LOG] Item %s berhasil dihapus dari tree\n", pasteItem->item.name);
+                destroyItem(&pasteItem->item);
+                pasteItem->item.path = itemStrdup(pasteItem->originalPath);                   // Update path item ke original path
+                pasteItem->item.name = itemStrdup(getNameFromPath(pasteItem->originalPath)); // Update name item ke nama asli
+                free(pasteItem->originalPath);
+                pasteItem->originalPath = destPath;                                       // Update originalPath untuk redo
+                logDebug("Item %s berhasil dihapus dari tree\n", pasteItem->item.name);
                 enqueue(&(*operationToRedo->itemTemp), pasteItem);
-                printf("[DEBUG] Enqueuing item for redo: name=%s, path=%s, type=%d\n",
+                logDebug("Enqueuing item for redo: name=%s, path=%s, type=%d\n",
                     pasteItem->item.name, pasteItem->item.path, pasteItem->item.type);
             }
             else {
-                printf("[LOG] Item tidak ditemukan untuk dihapus: %s\n", pasteItem->item.path);
+                logWarn("Item tidak ditemukan untuk dihapus: %s\n", pasteItem->item.path);
             }
         }
     }
-    printf("[LOG] Undo paste operation completed\n");
+    logInfo("Undo paste operation completed\n");
 }
 
 /**
@@ -2681,8 +3236,8 @@ static void _undoRecover(FileManager* fm, Operation* operationToUndo, Operation*
     while (!is_queue_empty(*(operationToUndo->itemTemp))) {
         trashItem = (TrashItem*)dequeue(&(*operationToUndo->itemTemp));
         enqueue(&(*operationToRedo->itemTemp), trashItem);
-        foundTree = searchTree(fm->root, createItem(trashItem->item.name, trashItem->item.path, 0, trashItem->item.type, 0, 0, 0));
-        printf("[LOG] Undo recover item: %s\n", trashItem->item.name);
+        foundTree = searchTree(fm->root, createItemKey(trashItem->item.name, trashItem->item.path, trashItem->item.type));
+        logDebug("Undo recover item: %s\n", trashItem->item.name);
         // Pindahkan kembali ke trash
         _moveToTrash(fm, foundTree);
     }
@@ -2706,7 +3261,7 @@ static void _undoRecover(FileManager* fm, Operation* operationToUndo, Operation*
 static void _redoCreate(FileManager* fm, Operation* operationToRedo) {
     // Buat item yang sudah dihapus
     createFile(fm, operationToRedo->isDir ? ITEM_FOLDER : ITEM_FILE, _getDirectoryFromPath(operationToRedo->from), getNameFromPath(operationToRedo->from), false);
-    printf("[LOG] Redo create: %s\n", operationToRedo->from);
+    logDebug("Redo create: %s\n", operationToRedo->from);
 }
 
 /**
@@ -2731,17 +3286,26 @@ static void _redoDelete(FileManager* fm, Operation* operationToRedo, Operation*
     while (!is_queue_empty(*(operationToRedo->itemTemp))) {
         TrashItem* trashItem = (TrashItem*)dequeue(&(*operationToRedo->itemTemp));
         enqueue(&(*operationToUndo->itemTemp), trashItem);
-        printf("[LOG] Redo delete item: %s\n", trashItem->item.name);
-        foundTree = searchTree(fm->root, createItem(trashItem->item.name, trashItem->item.path, 0, trashItem->item.type, 0, 0, 0));
+        logDebug("Redo delete item: %s\n", trashItem->item.name);
+        foundTree = searchTree(fm->root, createItemKey(trashItem->item.name, trashItem->item.path, trashItem->item.type));
         if (foundTree == NULL) {
-            printf("[LOG] Item tidak ditemukan untuk di-delete kembali: %s\n", trashItem->item.name);
+            logWarn("Item tidak ditemukan untuk di-delete kembali: %s\n", trashItem->item.name);
             continue;
         }
-        _moveToTrash(fm, foundTree);
-        printf("[LOG] Redo delete: %s\n", trashItem->item.name);
+        TrashItem* movedItem = _moveToTrash(fm, foundTree);
+        if (movedItem == NULL) {
+            continue;
+        }
+        // Lokasi trash baru, supaya undo berikutnya memulihkan dari sini
+        free(trashItem->trashPath);
+        free(trashItem->uid);
+        trashItem->trashPath = strdup(movedItem->trashPath);
+        trashItem->uid = strdup(movedItem->uid);
+        trashItem->deletedTime = movedItem->deletedTime;
+        logDebug("Redo delete: %s\n", trashItem->item.name);
     }
 
-    printf("[LOG] Redo delete completed\n");
+    logInfo("Redo delete completed\n");
 }
 
 /**
@@ -2761,13 +3325,13 @@ static void _redoDelete(FileManager* fm, Operation* operationToRedo, Operation*
  */
 static void _redoRename(FileManager* fm, Operation* operationToRedo) {
     Tree foundTree;
-    foundTree = searchTree(fm->root, createItem(getNameFromPath(operationToRedo->from), operationToRedo->from, 0, ITEM_FILE, 0, 0, 0));
+    foundTree = searchTree(fm->root, createItemKey(getNameFromPath(operationToRedo->from), operationToRedo->from, ITEM_FILE));
     if (foundTree == NULL) {
-        printf("[LOG] Item tidak ditemukan untuk di-rename: %s\n", operationToRedo->from);
+        logWarn("Item tidak ditemukan untuk di-rename: %s\n", operationToRedo->from);
         return;
     }
     renameFile(fm, foundTree->item.path, getNameFromPath(operationToRedo->to), false);
-    printf("[LOG] Redo rename: %s\n", operationToRedo->from);
+    logDebug("Redo rename: %s\n", operationToRedo->from);
 }
 
 /**
@@ -2789,97 +3353,109 @@ static void _redoRename(FileManager* fm, Operation* operationToRedo) {
 static void _redoPaste(FileManager* fm, Operation* operationToRedo, Operation* operationToUndo) {
     Tree foundTree;
 
-    printf("[LOG] isCopy: %s\n", operationToRedo->isCopy ? "true" : "false");
+    logDebug("isCopy: %s\n", operationToRedo->isCopy ? "true" : "false");
     operationToUndo->isCopy = operationToRedo->isCopy;
     if (!operationToRedo->isCopy) {
         // Jika cut, perlu memindahkan item ke lokasi baru
+        long long seq = opJournalBegin(&fm->opJournal, ACTION_PASTE, false);
         while (!is_queue_empty(*(operationToRedo->itemTemp))) {
             PasteItem* pasteItem = (PasteItem*)dequeue(&(*operationToRedo->itemTemp));
-            Tree parentToSearch = searchTree(fm->root, createItem(getNameFromPath(_getDirectoryFromPath(pasteItem->originalPath)), _getDirectoryFromPath(pasteItem->originalPath), 0, ITEM_FOLDER, 0, 0, 0));
+            char* parentPath = _getDirectoryFromPath(pasteItem->originalPath);
+            Tree parentToSearch = searchTree(fm->root, createItemKey(getNameFromPath(parentPath), parentPath, ITEM_FOLDER));
+            free(parentPath);
             if (parentToSearch == NULL) {
-                printf("[LOG] Parent directory tidak ditemukan untuk path: %s\n", pasteItem->originalPath);
+                logWarn("Parent directory tidak ditemukan untuk path: %s\n", pasteItem->originalPath);
                 continue;
             }
-            foundTree = searchTree(fm->root, createItem(pasteItem->item.name, pasteItem->item.path, 0, pasteItem->item.type, 0, 0, 0));
+            foundTree = searchTree(fm->root, createItemKey(pasteItem->item.name, pasteItem->item.path, pasteItem->item.type));
             if (foundTree != NULL) {
-                printf("[LOG] Undo cut path: %s\n", pasteItem->item.path);
-                printf("[LOG] Undo cut name: %s\n", pasteItem->item.name);
-                // Pindahkan kembali ke lokasi asal
-                char* destPath = strdup(pasteItem->item.path);
+                logDebug("Undo cut path: %s\n", pasteItem->item.path);
+                logDebug("Undo cut name: %s\n", pasteItem->item.name);
+                // Pindahkan kembali ke lokasi tujuan
                 char* originalPath = pasteItem->originalPath;
+                opJournalStep(&fm->opJournal, seq, pasteItem->item.type, foundTree->item.path, originalPath, NULL);
                 if (rename(foundTree->item.path, originalPath) != 0) {
-                    printf("[LOG] Gagal mengembalikan item %s ke %s\n", pasteItem->item.name, originalPath);
+                    logError("Gagal memindahkan item %s ke %s\n", pasteItem->item.name, originalPath);
                 }
                 else {
-                    // Update item path di tree
-                    foundTree->item.path = strdup(pasteItem->originalPath);
-                    foundTree->item.name = strdup(pasteItem->item.name);
-                    // Tambahkan ke tree parent asal
-                    Item newItem = createItem(foundTree->item.name, foundTree->item.path, foundTree->item.size, foundTree->item.type, foundTree->item.created_at, time(NULL), 0);
+                    opJournalStepDone(&fm->opJournal, seq);
+                    // Tambahkan ke tree parent tujuan; node lama dihapus di bawah
+                    Item newItem = createItem(pasteItem->item.name, originalPath, foundTree->item.size, foundTree->item.type, foundTree->item.created_at, time(NULL), 0);
                     Tree newTree = insert_node(parentToSearch, newItem);
                     if (newItem.type == ITEM_FOLDER) {
                         _addTreeStructureRecursive(newTree, newItem.path);
-                        printf("[LOG] Folder %s berhasil dikembalikan ke %s\n", pasteItem->item.name, parentToSearch->item.path);
+                        logDebug("Folder %s berhasil dipindahkan ke %s\n", pasteItem->item.name, parentToSearch->item.path);
                     }
 
-                    pasteItem->originalPath = strdup(destPath);          // Update originalPath untuk redo
-                    pasteItem->item.path = strdup(foundTree->item.path); // Update path item
-                    pasteItem->item.name = strdup(foundTree->item.name); // Update name item
-                    printf("[LOG] Original path diupdate menjadi: %s\n", pasteItem->originalPath);
-                    free(destPath);
-                    remove_node(&(fm->root), foundTree);
-                    printf("[LOG] Item %s berhasil dihapus dari tree\n", pasteItem->item.name);
+                    char* destPath = strdup(pasteItem->item.path);
+                    char* movedName = itemStrdup(pasteItem->item.name);
+                    char* movedPath = itemStrdup(originalPath);
+                    free(pasteItem->originalPath);
+                    destroyItem(&pasteItem->item);
+                    pasteItem->originalPath = destPath; // Update originalPath untuk undo
+                    pasteItem->item.path = movedPath;   // Update path item
+                    pasteItem->item.name = movedName;   // Update name item
+                    logDebug("Original path diupdate menjadi: %s\n", pasteItem->originalPath);
+                    remove_node(fm, foundTree);
+                    logDebug("Item %s berhasil dihapus dari tree\n", pasteItem->item.name);
                 }
             }
             else {
-                printf("[LOG] Item tidak ditemukan untuk di-redo cut: %s\n", pasteItem->item.path);
+                logWarn("Item tidak ditemukan untuk di-redo cut: %s\n", pasteItem->item.path);
             }
             enqueue(&(*operationToUndo->itemTemp), pasteItem);
         }
+        opJournalEnd(&fm->opJournal, seq);
     }
     else {
         // Jika hanya copy, paste ulang
         while (!is_queue_empty(*(operationToRedo->itemTemp))) {
             PasteItem* pasteItem = (PasteItem*)dequeue(&(*operationToRedo->itemTemp));
-            printf("[DEBUG] Processing item in redo: name=%s, path=%s, type=%d\n",
+            logDebug("Processing item in redo: name=%s, path=%s, type=%d\n",
                 pasteItem->item.name, pasteItem->item.path, pasteItem->item.type);
-            Tree parentToSearch = searchTree(fm->root, createItem(getNameFromPath(_getDirectoryFromPath(pasteItem->originalPath)), _getDirectoryFromPath(pasteItem->originalPath), 0, ITEM_FOLDER, 0, 0, 0));
+            char* parentPath = _getDirectoryFromPath(pasteItem->originalPath);
+            Tree parentToSearch = searchTree(fm->root, createItemKey(getNameFromPath(parentPath), parentPath, ITEM_FOLDER));
+            free(parentPath);
             if (parentToSearch == NULL) {
-                printf("[LOG] Parent directory tidak ditemukan untuk path: %s\n", pasteItem->originalPath);
+                logWarn("Parent directory tidak ditemukan untuk path: %s\n", pasteItem->originalPath);
                 continue;
             }
-            foundTree = searchTree(fm->root, createItem(pasteItem->item.name, pasteItem->item.path, 0, pasteItem->item.type, 0, 0, 0));
+            foundTree = searchTree(fm->root, createItemKey(pasteItem->item.name, pasteItem->item.path, pasteItem->item.type));
             if (foundTree != NULL) {
-                printf("[LOG] Redo paste path: %s\n", pasteItem->item.path);
-                printf("[LOG] Redo paste name: %s\n", pasteItem->item.name);
-                printf("[LOG] Destination path: %s\n", pasteItem->originalPath);
+                logDebug("Redo paste path: %s\n", pasteItem->item.path);
+                logDebug("Redo paste name: %s\n", pasteItem->item.name);
+                logDebug("Destination path: %s\n", pasteItem->originalPath);
                 if (pasteItem->item.type == ITEM_FOLDER) {
-                    printf("[DEBUG] Redoing paste for folder: %s\n", pasteItem->item.name);
-                    if (DirectoryExists(pasteItem->originalPath)) {
-                        printf("[LOG] Destination folder already exists: %s\n", pasteItem->originalPath);
-                        pasteItem->originalPath = _createDuplicatedFolderName(pasteItem->originalPath, "(1)");
+                    logDebug("Redoing paste for folder: %s\n", pasteItem->item.name);
+                    if (directoryExists(pasteItem->originalPath)) {
+                        logWarn("Destination folder already exists: %s\n", pasteItem->originalPath);
+                        char* duplicatedPath = _createDuplicatedFolderName(pasteItem->originalPath, "(1)");
+                        free(pasteItem->originalPath);
+                        pasteItem->originalPath = duplicatedPath;
                     }
-                    if (MakeDirectory(pasteItem->originalPath) != 0) {
-                        printf("[LOG] Gagal membuat folder\n");
+                    if (makeDirectory(pasteItem->originalPath) != 0) {
+                        logError("Gagal membuat folder\n");
                         continue;
                     }
-                    printf("[DEBUG] Calling _copyFolderRecursive for folder: %s\n", pasteItem->item.name);
-                    _copyFolderRecursive(pasteItem->item.path, pasteItem->originalPath);
-                    printf("[DEBUG] Finished _copyFolderRecursive for folder: %s\n", pasteItem->item.name);
+                    logDebug("Calling _copyFolderRecursive for folder: %s\n", pasteItem->item.name);
+                    _copyFolderRecursive(pasteItem->item.path, pasteItem->originalPath, NULL);
+                    logDebug("Finished _copyFolderRecursive for folder: %s\n", pasteItem->item.name);
                 }
                 else if (pasteItem->item.type == ITEM_FILE) {
-                    printf("[DEBUG] Redoing paste for file: %s\n", pasteItem->item.name);
-                    if (FileExists(pasteItem->originalPath)) {
-                        printf("[LOG] Destination file already exists: %s\n", pasteItem->originalPath);
-                        pasteItem->originalPath = _createDuplicatedFileName(pasteItem->originalPath, "(1)");
+                    logDebug("Redoing paste for file: %s\n", pasteItem->item.name);
+                    if (fileExists(pasteItem->originalPath)) {
+                        logWarn("Destination file already exists: %s\n", pasteItem->originalPath);
+                        char* duplicatedPath = _createDuplicatedFileName(pasteItem->originalPath, "(1)");
+                        free(pasteItem->originalPath);
+                        pasteItem->originalPath = duplicatedPath;
                     }
 
-                    _copyFileContent(pasteItem->item.path, pasteItem->originalPath);
+                    _copyFileContent(pasteItem->item.path, pasteItem->originalPath, NULL);
                 }
                 // Tambahkan item baru ke tree di lokasi tujuan
                 Item newItem = createItem(
                     pasteItem->item.name,
-                    TextFormat("%s/%s", parentToSearch->item.path, pasteItem->item.name), // Update path
+                    formatText("%s/%s", parentToSearch->item.path, pasteItem->item.name), // Update path
                     pasteItem->item.size,
                     pasteItem->item.type,
                     pasteItem->item.created_at,
@@ -2887,27 +3463,27 @@ static void _redoPaste(FileManager* fm, Operation* operationToRedo, Operation* o
                     0);
                 Tree newTree = insert_node(parentToSearch, newItem);
                 if (newTree == NULL) {
-                    printf("[LOG] Gagal menambahkan item ke tree selama redo: %s\n", newItem.name);
+                    logError("Gagal menambahkan item ke tree selama redo: %s\n", newItem.name);
                 }
                 else {
-                    printf("[LOG] Item berhasil ditambahkan item: %s, ke tree dengan parent: %s\n",
+                    logDebug("Item berhasil ditambahkan item: %s, ke tree dengan parent: %s\n",
                         newItem.path, parentToSearch->item.path);
                 }
-                // Update paste item untuk undo
-                char* origin = strdup(pasteItem->originalPath);
+                // Update paste item untuk undo: tukar path sumber dan tujuan
+                char* origin = pasteItem->originalPath;
                 pasteItem->originalPath = strdup(pasteItem->item.path); // Update originalPath untuk undo
-                pasteItem->item.path = strdup(origin);                  // Update path item
-                pasteItem->item.name = strdup(pasteItem->item.name);    // Update name item
-                printf("[LOG] Item path diupdate menjadi: %s\n", pasteItem->item.path);
-                enqueue(&(*operationToUndo->itemTemp), pasteItem);
+                freeItemString(pasteItem->item.path);
+                pasteItem->item.path = itemStrdup(origin);              // Update path item
                 free(origin);
+                logDebug("Item path diupdate menjadi: %s\n", pasteItem->item.path);
+                enqueue(&(*operationToUndo->itemTemp), pasteItem);
             }
             else {
-                printf("[LOG] Item tidak ditemukan untuk di-redo copy: %s\n", pasteItem->item.path);
+                logWarn("Item tidak ditemukan untuk di-redo copy: %s\n", pasteItem->item.path);
             }
         }
     }
-    printf("[LOG] Redo paste operation completed\n");
+    logInfo("Redo paste operation completed\n");
     // printTree(fm->root, 0);
 }
 
@@ -2933,7 +3509,7 @@ static void _redoRecover(FileManager* fm, Operation* operationToRedo, Operation*
     while (!is_queue_empty(*(operationToRedo->itemTemp))) {
         TrashItem* trashItem = (TrashItem*)dequeue(&(*operationToRedo->itemTemp));
         enqueue(&(*operationToUndo->itemTemp), trashItem);
-        printf("[LOG] Redo recover item: %s\n", trashItem->item.name);
+        logDebug("Redo recover item: %s\n", trashItem->item.name);
         // 2. Kembalikan item ke tree
         _addBackToTree(fm, trashItem, trashItem->originalPath);
     }
@@ -2945,31 +3521,6 @@ static void _redoRecover(FileManager* fm, Operation* operationToRedo, Operation*
 ================================================================================
 */
 
-/**
- * @brief Calculates total number of items in paste operation
- *
- * Counts items in clipboard queue to determine progress bar necessity.
- * Used for UI optimization in bulk paste operations.
- *
- * @param[in] fm Pointer to FileManager instance
- * @return Total number of items in clipboard
- *
- * @pre fm and clipboard are valid
- * @post Item count returned
- *
- * @internal
- * @since 1.0
- */
-static int _calculateTotalPasteItems(FileManager* fm) {
-    int totalItems = 0;
-    Node* countNode = fm->clipboard.front;
-    while (countNode != NULL) {
-        totalItems++;
-        countNode = countNode->next;
-    }
-    return totalItems;
-}
-
 /**
  * @brief Processes single item in paste operation
  *
@@ -2978,6 +3529,7 @@ static int _calculateTotalPasteItems(FileManager* fm) {
  *
  * @param[in,out] fm Pointer to FileManager instance
  * @param[in] itemToPaste Item to process for paste
+ * @param[in] sourceNode Tree node of the item, resolved once for the whole batch (may be NULL)
  * @param[out] originPath Pointer to origin path string
  * @return true if item can be pasted, false otherwise
  *
@@ -2987,34 +3539,41 @@ static int _calculateTotalPasteItems(FileManager* fm) {
  * @internal
  * @since 1.0
  */
-static bool _processSinglePasteItem(FileManager* fm, Item* itemToPaste, char** originPath) {
+static bool _processSinglePasteItem(FileManager* fm, Item* itemToPaste, Tree sourceNode, char** originPath) {
     // Path untuk file/folder baru di lokasi tujuan
-    char* destinationFullPath = TextFormat("%s%s", _DIR, fm->currentPath);
-    char* newPath = TextFormat("%s/%s", destinationFullPath, itemToPaste->name);
+    const char* destinationFullPath = formatText("%s%s", _DIR, fm->currentPath);
+    const char* newPath = formatText("%s/%s", destinationFullPath, itemToPaste->name);
     *originPath = itemToPaste->path;
 
-    printf("[LOG] Mencoba paste: %s -> %s\n", *originPath, newPath);
-    printf("[LOG] Is Copy: %s\n", fm->isCopy ? "true" : "false");
-    printf("[LOG] Item type: %d (ITEM_FOLDER=%d, ITEM_FILE=%d)\n", itemToPaste->type, ITEM_FOLDER, ITEM_FILE);
+    logDebug("Mencoba paste: %s -> %s\n", *originPath, newPath);
+    logDebug("Is Copy: %s\n", fm->isCopy ? "true" : "false");
+    logDebug("Item type: %d (ITEM_FOLDER=%d, ITEM_FILE=%d)\n", itemToPaste->type, ITEM_FOLDER, ITEM_FILE);
 
     // COPY operation - update origin path
     if (fm->isCopy) {
-        Tree foundTree = searchTree(fm->root, *itemToPaste);
-        if (foundTree == NULL) {
-            printf("[LOG] File tidak ditemukan untuk copy: %s\n", itemToPaste->name);
+        if (sourceNode == NULL) {
+            logWarn("File tidak ditemukan untuk copy: %s\n", itemToPaste->name);
             return false;
         }
-        *originPath = foundTree->item.path;
-        printf("[LOG] Origin path updated to: %s\n", *originPath);
+        *originPath = sourceNode->item.path;
+        logDebug("Origin path updated to: %s\n", *originPath);
     }
 
     // Cek apakah source file/folder masih ada
-    if (!FileExists(*originPath) && !DirectoryExists(*originPath)) {
-        printf("[LOG] Source tidak ditemukan: %s\n", *originPath);
+    if (!fileExists(*originPath) && !directoryExists(*originPath)) {
+        logWarn("Source tidak ditemukan: %s\n", *originPath);
         return false;
     }
 
-    printf("[LOG] Source exists, proceeding with copy/cut\n");
+    // Folder tidak boleh di-paste ke dalam dirinya sendiri (copy rekursif tak berujung)
+    size_t originLength = strlen(*originPath);
+    if (itemToPaste->type == ITEM_FOLDER && strncmp(destinationFullPath, *originPath, originLength) == 0 &&
+        (destinationFullPath[originLength] == '\0' || destinationFullPath[originLength] == '/')) {
+        logWarn("Folder tidak bisa di-paste ke dalam dirinya sendiri: %s\n", *originPath);
+        return false;
+    }
+
+    logDebug("Source exists, proceeding with copy/cut\n");
     return true;
 }
 
@@ -3027,7 +3586,7 @@ static bool _processSinglePasteItem(FileManager* fm, Item* itemToPaste, char** o
  * @param[in,out] fm Pointer to FileManager instance
  * @param[in] itemToPaste Folder item to paste
  * @param[in] originPath Original path of folder
- * @param[in] newPath Destination path for folder
+ * @param[in] newPath Destination path for folder (already deduplicated)
  * @return true if folder paste successful, false otherwise
  *
  * @pre itemToPaste is valid folder, paths are accessible
@@ -3037,33 +3596,29 @@ static bool _processSinglePasteItem(FileManager* fm, Item* itemToPaste, char** o
  * @since 1.0
  */
 static bool _pasteFolderItem(FileManager* fm, Item* itemToPaste, char* originPath, char* newPath) {
-    printf("[LOG] Processing folder: %s\n", itemToPaste->name);
-
-    if (DirectoryExists(newPath)) {
-        printf("[LOG] Destination exists, creating duplicate name\n");
-        newPath = _createDuplicatedFolderName(newPath, "(1)");
-        printf("[LOG] New path after duplicate check: %s\n", newPath);
-    }
+    logDebug("Processing folder: %s\n", itemToPaste->name);
 
-    // Untuk CUT, pindah langsung. Untuk COPY, buat folder baru lalu copy
+    // Untuk CUT, pindah langsung (fallback streaming move bila beda mount). Untuk COPY, buat folder baru lalu copy
     if (!fm->isCopy) {
-        printf("[LOG] CUT operation - moving folder\n");
+        logDebug("CUT operation - moving folder\n");
         if (rename(originPath, newPath) != 0) {
-            printf("[LOG] Gagal memindahkan folder %s\n", itemToPaste->name);
-            return false;
+            if (errno != EXDEV || !moveAcrossFilesystems(originPath, newPath, &fm->lastPasteStats)) {
+                logError("Gagal memindahkan folder %s\n", itemToPaste->name);
+                return false;
+            }
         }
     }
     else {
-        printf("[LOG] COPY operation - copying folder\n");
-        printf("[LOG] Membuat folder destination: %s\n", newPath);
-        if (MakeDirectory(newPath) != 0) {
-            printf("[LOG] Gagal membuat folder\n");
+        logDebug("COPY operation - copying folder\n");
+        logDebug("Membuat folder destination: %s\n", newPath);
+        if (makeDirectory(newPath) != 0) {
+            logError("Gagal membuat folder\n");
             return false;
         }
-        printf("[LOG] Folder destination created successfully\n");
-        printf("[LOG] Mulai copy recursive dari %s ke %s\n", originPath, newPath);
-        _copyFolderRecursive(originPath, newPath);
-        printf("[LOG] Selesai copy recursive\n");
+        logDebug("Folder destination created successfully\n");
+        logDebug("Mulai copy recursive dari %s ke %s\n", originPath, newPath);
+        _copyFolderRecursive(originPath, newPath, &fm->lastPasteStats);
+        logDebug("Selesai copy recursive\n");
     }
 
     // Tambahkan ke tree struktur
@@ -3074,13 +3629,13 @@ static bool _pasteFolderItem(FileManager* fm, Item* itemToPaste, char* originPat
 /**
  * @brief Processes file item in paste operation
  *
- * Handles file-specific paste logic including content copying
- * and conflict resolution for duplicate names.
+ * Handles file-specific paste logic including content copying.
+ * Duplicate names are resolved by pasteFile() before the item is journaled.
  *
  * @param[in,out] fm Pointer to FileManager instance
  * @param[in] itemToPaste File item to paste
  * @param[in] originPath Original path of file
- * @param[in] newPath Destination path for file
+ * @param[in] newPath Destination path for file (already deduplicated)
  * @return true if file paste successful, false otherwise
  *
  * @pre itemToPaste is valid file, paths are accessible
@@ -3090,20 +3645,19 @@ static bool _pasteFolderItem(FileManager* fm, Item* itemToPaste, char* originPat
  * @since 1.0
  */
 static bool _pasteFileItem(FileManager* fm, Item* itemToPaste, char* originPath, char* newPath) {
-    printf("[LOG] Processing file: %s\n", itemToPaste->name);
-
-    if (FileExists(newPath)) {
-        newPath = _createDuplicatedFileName(newPath, "(1)");
-    }
+    logDebug("Processing file: %s\n", itemToPaste->name);
 
     if (!fm->isCopy) {
         if (rename(originPath, newPath) != 0) {
-            printf("[LOG] Gagal memindahkan file %s\n", itemToPaste->name);
-            return false;
+            // Sumber di mount lain (mis. hasil import): fallback copy + unlink
+            if (errno != EXDEV || !moveAcrossFilesystems(originPath, newPath, &fm->lastPasteStats)) {
+                logError("Gagal memindahkan file %s\n", itemToPaste->name);
+                return false;
+            }
         }
     }
-    else {
-        _copyFileContent(originPath, newPath);
+    else if (!_copyFileContent(originPath, newPath, &fm->lastPasteStats)) {
+        return false;
     }
 
     // Tambahkan item baru ke tree di lokasi tujuan
@@ -3140,32 +3694,7 @@ static void _addItemToCurrentTree(FileManager* fm, Item* itemToPaste, char* newP
             time(NULL),
             0);
         insert_node(currentNode, newItem);
-        printf("[LOG] Item %s berhasil ditambahkan ke tree\n", newItem.name);
-    }
-}
-
-/**
- * @brief Handles cleanup after cut operation
- *
- * Removes cut items from original location in tree structure.
- * Only applies to cut operations, not copy operations.
- *
- * @param[in,out] fm Pointer to FileManager instance
- * @param[in] itemToPaste Item that was cut and pasted
- *
- * @pre item was cut (not copied) and successfully pasted
- * @post Item removed from original tree location
- *
- * @internal
- * @since 1.0
- */
-static void _handleCutCleanup(FileManager* fm, Item* itemToPaste) {
-    if (!fm->isCopy) {
-        Tree foundTree = searchTree(fm->root, *itemToPaste);
-        if (foundTree != NULL) {
-            remove_node(&(fm->root), foundTree);
-            printf("[LOG] Item %s berhasil dihapus dari tree asal\n", itemToPaste->name);
-        }
+        logDebug("Item %s berhasil ditambahkan ke tree\n", newItem.name);
     }
 }
 
@@ -3187,7 +3716,7 @@ static void _handleCutCleanup(FileManager* fm, Item* itemToPaste) {
 static void _createPasteItemRecord(Item* itemToPaste, char* originPath) {
     PasteItem* pasteItem = alloc(PasteItem);
     *pasteItem = createPasteItem(*itemToPaste, originPath);
-    printf("[LOG] PasteItem created for %s with original path %s\n", itemToPaste->name, originPath);
+    logDebug("PasteItem created for %s with original path %s\n", itemToPaste->name, originPath);
 }
 
 /*
@@ -3197,250 +3726,339 @@ static void _createPasteItemRecord(Item* itemToPaste, char* originPath) {
 */
 
 /**
- * @brief Checks if two items are equal
+ * @brief Cleans up invalid selections from selection list
  *
- * Compares two items by path and name to determine equality.
- * Used for selection management and duplicate detection.
+ * Removes items from selection list that are no longer present in
+ * the current directory. Children are matched by identity in O(1) each;
+ * entries that are not children are dropped without being dereferenced,
+ * since their nodes may already be freed.
  *
- * @param[in] item1 First item to compare
- * @param[in] item2 Second item to compare
- * @return true if items are equal, false otherwise
+ * @param[in,out] fm Pointer to FileManager instance
  *
- * @pre both items are valid
- * @post Boolean result indicating item equality
+ * @pre fm and treeCursor are valid
+ * @post Invalid selections removed from selectedItem list
  *
  * @internal
  * @since 1.0
  */
-static bool _isItemEqual(Item* item1, Item* item2) {
-    return (strcmp(item1->path, item2->path) == 0 &&
-        strcmp(item1->name, item2->name) == 0);
+static void _cleanupInvalidSelections(FileManager* fm) {
+    if (!fm->treeCursor)
+        return;
+
+    // Pindahkan anak yang masih terpilih ke set baru, sisanya dibuang
+    SelectionSet valid;
+    createSelectionSet(&valid);
+    for (Tree child = fm->treeCursor->first_son; child != NULL; child = child->next_brother) {
+        if (selectionSetContains(&fm->selectedItem, &child->item)) {
+            selectionSetAdd(&valid, &child->item);
+        }
+    }
+
+    int removed = fm->selectedItem.count - valid.count;
+    destroySelectionSet(&fm->selectedItem);
+    fm->selectedItem = valid;
+    if (removed > 0) {
+        logWarn("Removed %d invalid selection(s)\n", removed);
+    }
 }
 
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - REFRESH OPERATIONS
+================================================================================
+*/
+
 /**
- * @brief Frees selected node and associated memory
+ * @brief Safely refreshes tree structure
+ *
+ * Merges the filesystem state into the existing nodes instead of
+ * rebuilding them, so selection, sidebar expansion, handles and cached
+ * sizes survive. Only folders whose mtime changed are read again; the
+ * others cost one stat() each, so the work follows the size of the change.
  *
- * Safely frees node memory used in selection list.
- * Does not free item data as it points to tree items.
+ * @param[in,out] fm Pointer to FileManager instance
+ * @param[in] targetNode Folder node to refresh (subfolders included)
  *
- * @param[in] node Node to free
+ * @pre targetNode is a live folder node of fm->root
+ * @post Tree matches the filesystem below targetNode
  *
- * @pre node is valid allocated node
- * @post Node memory freed, item data preserved
+ * @note A file modified in place does not change its folder's mtime and
+ *       keeps its cached size until the folder itself changes
  *
  * @internal
  * @since 1.0
  */
-static void _freeSelectedNode(Node* node) {
-    if (node) {
-        // Tidak perlu free item karena itu pointer ke item di tree
-        free(node);
+static void _refreshTreeSafely(FileManager* fm, Tree targetNode) {
+    if (!targetNode) {
+        logWarn("Target node tidak ditemukan untuk refresh\n");
+        return;
     }
+
+    SyncStats stats = { time(NULL), 0, 0, 0, 0, 0 };
+    _syncFolder(fm, targetNode, &stats);
+
+    logInfo("Refresh %s: %d folder dibaca, %d dilewati, +%d -%d ~%d item\n",
+        targetNode->item.path, stats.dirsRead, stats.dirsSkipped,
+        stats.inserted, stats.removed, stats.updated);
 }
 
 /**
- * @brief Cleans up invalid selections from selection list
+ * @brief Reconciles one folder node with its directory on disk
  *
- * Removes items from selection list that are no longer present in
- * the current directory. Validates each selected item against current tree.
+ * If the directory mtime matches the node, only the subfolders are
+ * visited. A folder scanned in the same second as its mtime may have
+ * changed again within that second, so it is always read. Otherwise
+ * the entries are merged by name: new entries are inserted (new
+ * folders loaded in full), changed metadata is updated in place and
+ * nodes missing on disk are freed.
  *
  * @param[in,out] fm Pointer to FileManager instance
- *
- * @pre fm and treeCursor are valid
- * @post Invalid selections removed from selectedItem list
+ * @param[in,out] folder Folder node to reconcile
+ * @param[in,out] stats Counters for the refresh log
  *
  * @internal
  * @since 1.0
  */
-static void _cleanupInvalidSelections(FileManager* fm) {
-    if (!fm->treeCursor)
+static void _syncFolder(FileManager* fm, Tree folder, SyncStats* stats) {
+    struct stat statbuf;
+    if (stat(folder->item.path, &statbuf) == -1 || !S_ISDIR(statbuf.st_mode)) {
+        logError("Folder tidak dapat dibaca: %s\n", folder->item.path);
         return;
+    }
 
-    Node* current = fm->selectedItem.head;
-    Node* prev = NULL;
+    int existing = get_child_count(folder);
+    if (statbuf.st_mtime == folder->item.updated_at && !hashmap_contains(&fm->racyFolders, folder)) {
+        stats->dirsSkipped++;
+        for (int i = 0; i < existing; i++) {
+            Tree child = get_child(folder, i);
+            if (child->item.type == ITEM_FOLDER) {
+                _syncFolder(fm, child, stats);
+            }
+        }
+        return;
+    }
 
-    while (current != NULL) {
-        Item* item = (Item*)current->data;
-        Node* next = current->next;
+    DIR* dp = opendir(folder->item.path);
+    if (dp == NULL) {
+        perror("Tidak dapat membuka direktori");
+        return;
+    }
+    stats->dirsRead++;
 
-        // Cek apakah item masih ada di current directory
-        bool foundInCurrentDir = false;
-        Tree child = fm->treeCursor->first_son;
+    // Nama -> posisi+1 anak yang sudah ada
+    HashMap byName;
+    create_string_hashmap(&byName);
+    for (int i = 0; i < existing; i++) {
+        hashmap_put(&byName, get_child(folder, i)->item.name, (void*)(intptr_t)(i + 1));
+    }
+    bool* seen = calloc(existing > 0 ? existing : 1, sizeof(bool));
+    Tree* stale = calloc(existing > 0 ? existing : 1, sizeof(Tree));
+    int staleCount = 0;
 
-        while (child != NULL) {
-            if (_isItemEqual(&child->item, item)) {
-                foundInCurrentDir = true;
-                break;
-            }
-            child = child->next_brother;
+    struct dirent* ep;
+    struct stat entry;
+    long long size = 0;
+    while ((ep = readdir(dp)) != NULL) {
+        if (strcmp(ep->d_name, ".") == 0 || strcmp(ep->d_name, "..") == 0)
+            continue;
+        scannedEntries++;
+
+        char* fullPath = malloc(strlen(folder->item.path) + strlen(ep->d_name) + 2);
+        sprintf(fullPath, "%s/%s", folder->item.path, ep->d_name);
+        if (stat(fullPath, &entry) == -1 || !(S_ISDIR(entry.st_mode) || S_ISREG(entry.st_mode))) {
+            free(fullPath);
+            continue;
+        }
+        size += entry.st_size;
+        ItemType type = S_ISDIR(entry.st_mode) ? ITEM_FOLDER : ITEM_FILE;
+
+        int position = (int)(intptr_t)hashmap_get(&byName, ep->d_name) - 1;
+        Tree child = position >= 0 ? get_child(folder, position) : NULL;
+        if (position >= 0) {
+            seen[position] = true;
+        }
+        if (child != NULL && child->item.type != type) {
+            // File diganti folder (atau sebaliknya): hapus lalu muat ulang
+            stale[staleCount++] = child;
+            child = NULL;
         }
 
-        // Jika item tidak ditemukan di current directory, hapus dari selection
-        if (!foundInCurrentDir) {
-            item->selected = false;
+        if (child == NULL) {
+            Tree newNode = insert_node(folder, createItem(ep->d_name, fullPath, entry.st_size, type,
+                entry.st_ctime, entry.st_mtime, 0));
+            if (newNode != NULL && type == ITEM_FOLDER) {
+                _loadTree(newNode, fullPath);
+                _markRacyFolders(fm, newNode, stats->startedAt);
+            }
+            stats->inserted++;
+        }
+        else if (type == ITEM_FOLDER) {
+            // mtime folder dicek oleh rekursi; ukuran dihitung ulang di sana
+            _syncFolder(fm, child, stats);
+        }
+        else if (child->item.size != entry.st_size || child->item.updated_at != entry.st_mtime) {
+            child->item.size = entry.st_size;
+            child->item.updated_at = entry.st_mtime;
+            child->item.created_at = entry.st_ctime;
+            stats->updated++;
+        }
+        free(fullPath);
+    }
+    closedir(dp);
 
-            if (prev == NULL) {
-                fm->selectedItem.head = next;
+    for (int i = 0; i < existing; i++) {
+        if (!seen[i]) {
+            stale[staleCount++] = get_child(folder, i);
+        }
+    }
+    if (staleCount > 0) {
+        // Saring daftar anak sekali jalan, lalu bebaskan yang hilang
+        HashMap doomed;
+        create_pointer_hashmap(&doomed);
+        for (int i = 0; i < staleCount; i++) {
+            hashmap_put(&doomed, stale[i], stale[i]);
+        }
+        Tree* link = &folder->first_son;
+        while (*link != NULL) {
+            if (hashmap_contains(&doomed, *link)) {
+                *link = (*link)->next_brother;
             }
             else {
-                prev->next = next;
+                link = &(*link)->next_brother;
             }
-
-            _freeSelectedNode(current);
-            printf("[LOG] Removed invalid selection: %s\n", item->name);
         }
-        else {
-            prev = current;
+        destroy_hashmap(&doomed);
+
+        for (int i = 0; i < staleCount; i++) {
+            _dropSyncedChild(fm, folder, stale[i]);
         }
+        reindex_children(folder);
+    }
+    stats->removed += staleCount;
 
-        current = next;
+    folder->item.size = size;
+    folder->item.updated_at = statbuf.st_mtime;
+    hashmap_remove(&fm->racyFolders, folder);
+    if (statbuf.st_mtime >= stats->startedAt) {
+        hashmap_put(&fm->racyFolders, folder, folder);
     }
-}
 
-/*
-================================================================================
-    PRIVATE HELPER FUNCTIONS - REFRESH OPERATIONS
-================================================================================
-*/
+    free(seen);
+    free(stale);
+    destroy_hashmap(&byName);
+}
 
 /**
- * @brief Safely refreshes tree structure
+ * @brief Frees an unlinked child with its whole subtree
  *
- * Refreshes tree at target path while preserving tree integrity.
- * Handles node validation and safe tree reconstruction.
+ * Used for children gone from disk and for removed nodes. Moves the tree
+ * cursor to folder if it was inside the removed subtree. The caller has
+ * already unlinked child and rebuilds the child array if needed.
  *
  * @param[in,out] fm Pointer to FileManager instance
- * @param[in] targetPath Path to refresh in tree
- *
- * @pre targetPath exists in tree structure
- * @post Tree refreshed at target path, structure integrity maintained
+ * @param[in,out] folder Parent of child
+ * @param[in] child Child to remove with its subtree
  *
  * @internal
  * @since 1.0
  */
-static void _refreshTreeSafely(FileManager* fm, char* targetPath) {
-    // Cari node target di tree
-    Tree targetNode = _findNodeByPath(fm->root, targetPath);
-
-    if (!targetNode) {
-        printf("[LOG] Target node tidak ditemukan untuk refresh\n");
-        return;
-    }
-
-    // Hapus hanya children dari target node
-    if (targetNode->first_son) {
-        _destroyTree(&targetNode->first_son);
-        targetNode->first_son = NULL;
+static void _dropSyncedChild(FileManager* fm, Tree folder, Tree child) {
+    for (Tree node = fm->treeCursor; node != NULL; node = node->parent) {
+        if (node == child) {
+            fm->treeCursor = folder;
+            break;
+        }
     }
+    _forgetSubtree(fm, child);
 
-    // Load ulang children
-    _loadTree(targetNode, targetPath);
+    _destroyTree(&child->first_son);
+    destroyItem(&child->item);
+    free_node_tree(child);
 }
 
 /**
- * @brief Finds tree node by path
+ * @brief Removes every node of a subtree from the selection, search results
+ * and racy folder set
  *
- * Recursively searches tree structure to find node with matching path.
- * Returns pointer to found node or NULL if not found.
- *
- * @param[in] root Root of tree to search
- * @param[in] targetPath Path to search for
- * @return Tree node with matching path or NULL
- *
- * @pre root is valid tree, targetPath is valid string
- * @post Matching node returned or NULL if not found
+ * @param[in,out] fm Pointer to FileManager instance
+ * @param[in] node Root of the subtree about to be freed
  *
  * @internal
  * @since 1.0
  */
-static Tree _findNodeByPath(Tree root, char* targetPath) {
-    if (!root || !targetPath)
-        return NULL;
-
-    // Jika path cocok, return node ini
-    if (root->item.path && strcmp(root->item.path, targetPath) == 0) {
-        return root;
+static void _forgetSubtree(FileManager* fm, Tree node) {
+    selectionSetForget(&fm->selectedItem, &node->item);
+    hashmap_remove(&fm->racyFolders, node);
+    if (fm->isSearching && is_exist(fm->searchingList, node)) {
+        void* removed;
+        delete_val(&fm->searchingList, node, &removed);
+        memAccount(MEM_SEARCH, -(long long)sizeof(Node), -1);
     }
-
-    // Cari di children
-    Tree current = root->first_son;
-    while (current) {
-        Tree found = _findNodeByPath(current, targetPath);
-        if (found)
-            return found;
-        current = current->next_brother;
+    for (Tree child = node->first_son; child != NULL; child = child->next_brother) {
+        _forgetSubtree(fm, child);
     }
-
-    return NULL;
 }
 
 /**
- * @brief Safely refreshes sidebar component
+ * @brief Marks freshly loaded folders whose mtime falls in the scan second
  *
- * Refreshes sidebar while preserving expansion state and selection.
- * Collects current state before refresh and restores afterward.
+ * Directory mtimes have one-second resolution here: a change made later in
+ * the same second as the scan would leave the mtime equal to the recorded
+ * one. Such folders are read again on the next refresh.
  *
  * @param[in,out] fm Pointer to FileManager instance
- *
- * @pre fm has valid sidebar context
- * @post Sidebar refreshed with preserved state
+ * @param[in] folder Root of the loaded subtree
+ * @param[in] scanStart time() taken before the subtree was loaded
  *
  * @internal
  * @since 1.0
  */
-static void _refreshSidebarSafely(FileManager* fm) {
-    if (!fm->ctx || !fm->ctx->sidebar)
-        return;
-
-    // Collect state sebelum destroy
-    SidebarState* stateList = NULL;
-    if (fm->ctx->sidebar->sidebarRoot) {
-        collectSidebarState(fm->ctx->sidebar->sidebarRoot, &stateList);
-        destroySidebarItem(&fm->ctx->sidebar->sidebarRoot);
-        fm->ctx->sidebar->sidebarRoot = NULL;
+static void _markRacyFolders(FileManager* fm, Tree folder, time_t scanStart) {
+    if (folder->item.updated_at >= scanStart && !hashmap_contains(&fm->racyFolders, folder)) {
+        hashmap_put(&fm->racyFolders, folder, folder);
     }
-
-    // Rebuild dengan state yang tersimpan
-    fm->ctx->sidebar->sidebarRoot = createSidebarItemWithState(fm->root, stateList);
-
-    // Cleanup state
-    if (stateList) {
-        destroySidebarState(stateList);
+    for (Tree child = folder->first_son; child != NULL; child = child->next_brother) {
+        if (child->item.type == ITEM_FOLDER) {
+            _markRacyFolders(fm, child, scanStart);
+        }
     }
 }
 
 /**
- * @brief Validates tree node existence
+ * @brief Finds tree node by path
  *
- * Checks if target node still exists in tree structure.
- * Used for safety validation before tree operations.
+ * Recursively searches tree structure to find node with matching path.
+ * Returns pointer to found node or NULL if not found.
  *
- * @param[in] root Root of tree to validate against
- * @param[in] target Target node to validate
- * @return true if target exists in tree, false otherwise
+ * @param[in] root Root of tree to search
+ * @param[in] targetPath Path to search for
+ * @return Tree node with matching path or NULL
  *
- * @pre root and target are potentially valid tree nodes
- * @post Boolean result indicating node validity
+ * @pre root is valid tree, targetPath is valid string
+ * @post Matching node returned or NULL if not found
  *
  * @internal
  * @since 1.0
  */
-static bool _isValidTreeNode(Tree root, Tree target) {
-    if (!root || !target)
-        return false;
+static Tree _findNodeByPath(Tree root, char* targetPath) {
+    if (!root || !targetPath)
+        return NULL;
 
-    if (root == target)
-        return true;
+    // Jika path cocok, return node ini
+    if (root->item.path && strcmp(root->item.path, targetPath) == 0) {
+        return root;
+    }
 
-    // Cek di children
+    // Cari di children
     Tree current = root->first_son;
     while (current) {
-        if (_isValidTreeNode(current, target))
-            return true;
+        Tree found = _findNodeByPath(current, targetPath);
+        if (found)
+            return found;
         current = current->next_brother;
     }
 
-    return false;
+    return NULL;
 }
 
 /*
@@ -3450,11 +4068,11 @@ static bool _isValidTreeNode(Tree root, Tree target) {
 */
 
 /**
- * @brief Recursively searches tree for items matching keyword
+ * @brief Searches a subtree for items matching keyword
  *
- * Performs case-insensitive recursive search through tree structure
- * looking for items whose names contain the specified keyword. Adds
- * matching items to results linked list for later processing.
+ * Performs case-insensitive search through tree structure looking for
+ * items whose names contain the specified keyword. Adds matching items
+ * to results linked list for later processing.
  *
  * @param[in,out] linkedList Results list to store matching items
  * @param[in] tree Tree node to search from (root for full search)
@@ -3464,9 +4082,9 @@ static bool _isValidTreeNode(Tree root, Tree target) {
  * @post All matching items added to linkedList
  *
  * @note Performs case-insensitive substring matching
- * @note Searches both current node and all descendants recursively
- * @note Processes both children (first_son) and siblings (next_brother)
- * @note Creates lowercase copies for comparison without modifying originals
+ * @note Searches tree and all its descendants in pre-order; siblings of
+ *       tree are not searched
+ * @note Uses tree_iter_next(), so huge folders cannot overflow the call stack
  * @warning keyword must be valid null-terminated string
  *
  * @see searchingTreeItem() for public interface
@@ -3475,78 +4093,75 @@ static bool _isValidTreeNode(Tree root, Tree target) {
  * @internal
  * @since 1.0
  */
-static void _searchingTreeItemRecursive(LinkedList* linkedList, Tree tree, char* keyword) {
-    if (tree == NULL)
-        return;
-
-    char* lowerName = strdup(tree->item.name);
+static void _searchingTreeItem(LinkedList* linkedList, Tree tree, char* keyword) {
     char* lowerKeyword = strdup(keyword);
-
-    toLowerStr(lowerName);
     toLowerStr(lowerKeyword);
 
-    if (strstr(lowerName, lowerKeyword) != NULL) {
-        printf("===========================================================\n");
-        insert_last(linkedList, tree);
-        printf("[LOG] keyword: %s\n", keyword);
-        printf("[LOG] lower keyword: %s\n", lowerKeyword);
-        printf("[LOG] Menemukan item: %s\n", tree->item.name);
-        printf("[LOG] Menemukan lower item: %s\n", lowerName);
-        printf("[LOG] Path: %s\n", tree->item.path);
-        printf("===========================================================\n");
+    TreeIterator it;
+    tree_iter_init(&it, tree, TREE_PRE_ORDER);
+
+    Tree current;
+    while ((current = tree_iter_next(&it)) != NULL) {
+        char* lowerName = strdup(current->item.name);
+        toLowerStr(lowerName);
+
+        if (strstr(lowerName, lowerKeyword) != NULL) {
+            insert_last(linkedList, current);
+            memAccount(MEM_SEARCH, (long long)sizeof(Node), 1);
+            logTrace("Menemukan item: %s (path: %s)\n", current->item.name, current->item.path);
+        }
+        free(lowerName);
     }
 
-    _searchingTreeItemRecursive(linkedList, tree->first_son, keyword);
-    _searchingTreeItemRecursive(linkedList, tree->next_brother, keyword);
+    tree_iter_destroy(&it);
+    free(lowerKeyword);
 }
 
 /**
- * @brief Recursively searches linked list nodes for keyword matches
+ * @brief Searches trash list nodes for keyword matches
  *
- * Traverses linked list containing tree node pointers and performs
- * case-insensitive search for items matching keyword. Used for searching
- * within specific result sets or filtered lists.
+ * Walks the deletion-time ordered trash list iteratively and performs
+ * case-insensitive search for items matching keyword. TrashItem starts
+ * with its Item, so each match is stored as a Tree-compatible pointer
+ * the same way the trash view draws it.
  *
  * @param[in,out] fm FileManager instance for result storage
- * @param[in] node Current linked list node to process
+ * @param[in] node First trash node to process
  * @param[in] keyword Search term to match against item names
  *
  * @pre fm is valid, node may be NULL, keyword is valid string
  * @post Matching items added to fm->searchingList
  *
  * @note Performs case-insensitive substring matching
- * @note Recursively processes remaining list nodes
- * @note Each node->data contains Tree pointer to search
- * @note Creates lowercase copies for safe comparison
- * @warning keyword must be valid null-terminated string
+ * @note Iterative so large trash lists cannot overflow the call stack
  *
- * @see searchingLinkedListItem() for public interface
+ * @see searchingTrashItem() for public interface
  * @see toLowerStr() for case conversion utility
  *
  * @internal
  * @since 1.0
  */
-static void _searchingLinkedListRecursive(FileManager* fm, Node* node, char* keyword) {
-    if (node == NULL)
-        return;
+static void _searchingTrashList(FileManager* fm, TrashNode* node, char* keyword) {
+    char* lowerKeyword = strdup(keyword);
+    toLowerStr(lowerKeyword);
 
-    Tree current = (Tree)node->data;
+    while (node != NULL) {
+        Tree current = (Tree)node->data;
 
-    char* lowerName = strdup(current->item.name);
-    char* lowerKeyword = strdup(keyword);
+        char* lowerName = strdup(current->item.name);
+        toLowerStr(lowerName);
 
-    toLowerStr(lowerName);
-    toLowerStr(lowerKeyword);
+        if (strstr(lowerName, lowerKeyword) != NULL) {
+            logTrace("Menemukan item: %s (path: %s)\n", lowerName, current->item.path);
+            insert_last(&(fm->searchingList), current);
+            memAccount(MEM_SEARCH, (long long)sizeof(Node), 1);
+        }
 
-    if (strstr(lowerName, lowerKeyword) != NULL) {
-        printf("===========================================================\n");
-        printf("[LOG] keyword: %s\n", lowerKeyword);
-        printf("[LOG] Menemukan item: %s\n [LOG] Path: %s\n", lowerName, current->item.path);
-        insert_last(&(fm->searchingList), current);
-        printf("===========================================================\n");
+        free(lowerName);
+        node = node->next;
     }
 
-    _searchingLinkedListRecursive(fm, node->next, keyword);
+    free(lowerKeyword);
 }
 
 /**
@@ -3562,7 +4177,8 @@ static void _searchingLinkedListRecursive(FileManager* fm, Node* node, char* key
  * @post Selected items copied to clipboard, previous clipboard cleared
  *
  * @note Clears both clipboard and copied queues before operation
- * @note Copies item pointers, not item data (shallow copy)
+ * @note Stores node handles, so items removed before paste are detected
+ * @note Trash items are not tree nodes and cannot be copied
  * @note Logs each item added to clipboard for debugging
  * @note Handles empty selection gracefully with error message
  * @warning Requires valid selections in fm->selectedItem list
@@ -3574,40 +4190,47 @@ static void _searchingLinkedListRecursive(FileManager* fm, Node* node, char* key
  * @since 1.0
  */
 static void _copyToClipboard(FileManager* fm) {
+    if (fm->isRootTrash) {
+        logWarn("Item di trash tidak bisa disalin\n");
+        return;
+    }
+
     // Clear clipboard yang lama
     if (!is_queue_empty(fm->clipboard)) {
-        clear_queue(&fm->clipboard);
-        printf("[LOG] Clipboard lama telah dibersihkan\n");
+        _clearClipboard(fm);
+        logDebug("Clipboard lama telah dibersihkan\n");
     }
 
     // Clear copied queue untuk memastikan konsistensi
     if (!is_queue_empty(fm->copied)) {
         clear_queue(&fm->copied);
-        printf("[LOG] Copied queue telah dibersihkan\n");
+        logDebug("Copied queue telah dibersihkan\n");
     }
 
     // Copy item yang selected ke clipboard
-    Node* temp = fm->selectedItem.head;
+    SelectionNode* temp = fm->selectedItem.head;
     int copiedCount = 0;
 
     while (temp != NULL) {
 
         Item* itemToCopy = (Item*)temp->data;
+        NodeHandle* handle = alloc(NodeHandle);
+        *handle = get_node_handle(node_from_item(itemToCopy));
 
         // Enqueue ke clipboard (bukan ke copied)
-        enqueue(&(fm->clipboard), itemToCopy);
+        enqueue(&(fm->clipboard), handle);
         copiedCount++;
 
-        printf("[LOG] Item %s ditambahkan ke clipboard\n", itemToCopy->name);
+        logDebug("Item %s ditambahkan ke clipboard\n", itemToCopy->name);
         temp = temp->next;
     }
 
     if (copiedCount == 0) {
-        printf("[LOG] Gagal Menyalin File - tidak ada item yang dipilih!\n");
+        logError("Gagal Menyalin File - tidak ada item yang dipilih!\n");
         return;
     }
 
-    printf("[LOG] %d file berhasil disalin ke clipboard\n", copiedCount);
+    logInfo("%d file berhasil disalin ke clipboard\n", copiedCount);
 }
 
 /*
@@ -3655,7 +4278,7 @@ static char* _generateUID() {
         tv.tv_usec);
 
     uid = strdup(timestamp);
-    printf("[LOG] Generated UID: %s\n", uid);
+    logDebug("Generated UID: %s\n", uid);
     return uid;
 }
 
@@ -0,0 +1,449 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "file_preview.h"
+#include "logger.h"
+#include "profiler.h"
+
+#define PREVIEW_PENDING_CHECKPOINTS 256
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static bool _mapFile(FilePreview* preview);                                   // Map the file read-only
+static void _unmapFile(FilePreview* preview);                                 // Release the mapping
+static bool _looksBinary(const unsigned char* data, long long size);          // NUL or many control bytes
+static void* _indexWorker(void* arg);                                         // Background newline scan
+static bool _publish(FilePreview* preview, const long long* pending, int count,
+                     long long lines, long long bytes, bool complete);        // Hand progress to readers
+static bool _lineStart(FilePreview* preview, long long line, long long* start); // Offset of a line
+
+/*
+================================================================================
+    LIFECYCLE
+================================================================================
+*/
+
+bool openFilePreview(FilePreview* preview, const char* path) {
+    PROFILE_FUNCTION();
+    memset(preview, 0, sizeof(FilePreview));
+    preview->path = strdup(path);
+    if (preview->path == NULL || !_mapFile(preview)) {
+        logWarn("Preview gagal membuka %s\n", path);
+        free(preview->path);
+        preview->path = NULL;
+        return false;
+    }
+
+    pthread_mutex_init(&preview->lock, NULL);
+    pthread_cond_init(&preview->progress, NULL);
+    preview->cursorLine = -1;
+
+    long long sniff = preview->size < PREVIEW_SNIFF_BYTES ? preview->size : PREVIEW_SNIFF_BYTES;
+    preview->binary = _looksBinary(preview->data, sniff);
+    if (preview->binary || preview->size == 0) {
+        preview->complete = true;
+        preview->indexedBytes = preview->size;
+        return true;
+    }
+
+    preview->checkpointCapacity = 64;
+    preview->checkpoints = malloc(sizeof(long long) * preview->checkpointCapacity);
+    if (preview->checkpoints == NULL) {
+        closeFilePreview(preview);
+        return false;
+    }
+    preview->checkpoints[0] = 0;
+    preview->checkpointCount = 1;
+
+    if (pthread_create(&preview->indexer, NULL, _indexWorker, preview) == 0) {
+        preview->indexerRunning = true;
+    }
+    else {
+        logWarn("Indexer preview tidak bisa dijalankan, mengindeks langsung\n");
+        _indexWorker(preview);
+    }
+    return true;
+}
+
+void closeFilePreview(FilePreview* preview) {
+    if (preview->path == NULL) {
+        return;
+    }
+    if (preview->indexerRunning) {
+        pthread_mutex_lock(&preview->lock);
+        preview->cancel = true;
+        pthread_mutex_unlock(&preview->lock);
+        pthread_join(preview->indexer, NULL);
+        preview->indexerRunning = false;
+    }
+
+    _unmapFile(preview);
+    free(preview->checkpoints);
+    free(preview->path);
+    pthread_cond_destroy(&preview->progress);
+    pthread_mutex_destroy(&preview->lock);
+    memset(preview, 0, sizeof(FilePreview));
+}
+
+/*
+================================================================================
+    ACCESS
+================================================================================
+*/
+
+long long previewRowCount(FilePreview* preview, bool* complete) {
+    if (preview->binary) {
+        if (complete != NULL) {
+            *complete = true;
+        }
+        return (preview->size + PREVIEW_HEX_BYTES - 1) / PREVIEW_HEX_BYTES;
+    }
+
+    pthread_mutex_lock(&preview->lock);
+    long long rows = preview->lineCount;
+    if (complete != NULL) {
+        *complete = preview->complete;
+    }
+    pthread_mutex_unlock(&preview->lock);
+    return rows;
+}
+
+double previewIndexProgress(FilePreview* preview) {
+    if (preview->size == 0) {
+        return 1.0;
+    }
+    pthread_mutex_lock(&preview->lock);
+    double progress = (double)preview->indexedBytes / (double)preview->size;
+    pthread_mutex_unlock(&preview->lock);
+    return progress;
+}
+
+bool previewWaitForLine(FilePreview* preview, long long line) {
+    if (preview->binary) {
+        return line < previewRowCount(preview, NULL);
+    }
+
+    pthread_mutex_lock(&preview->lock);
+    while (!preview->complete && line >= preview->lineCount) {
+        pthread_cond_wait(&preview->progress, &preview->lock);
+    }
+    bool exists = line < preview->lineCount;
+    pthread_mutex_unlock(&preview->lock);
+    return exists;
+}
+
+int previewTextLine(FilePreview* preview, long long line, char* out, int size) {
+    long long start;
+    if (size <= 0 || !_lineStart(preview, line, &start)) {
+        return -1;
+    }
+
+    const unsigned char* begin = preview->data + start;
+    const unsigned char* newline = memchr(begin, '\n', (size_t)(preview->size - start));
+    long long length = newline != NULL ? newline - begin : preview->size - start;
+    if (length > 0 && begin[length - 1] == '\r') {
+        length--;
+    }
+    if (length > size - 1) {
+        length = size - 1;
+    }
+
+    for (long long i = 0; i < length; i++) {
+        unsigned char c = begin[i];
+        out[i] = c == '\t' ? ' ' : (c < 0x20 || c == 0x7f) ? '.' : (char)c;
+    }
+    out[length] = '\0';
+    return (int)length;
+}
+
+int previewHexRow(FilePreview* preview, long long row, char* out, int size) {
+    long long offset = row * PREVIEW_HEX_BYTES;
+    if (size <= 0 || row < 0 || offset >= preview->size) {
+        return -1;
+    }
+
+    int count = preview->size - offset < PREVIEW_HEX_BYTES ? (int)(preview->size - offset) : PREVIEW_HEX_BYTES;
+    const unsigned char* bytes = preview->data + offset;
+    char hex[PREVIEW_HEX_BYTES * 3 + 2] = "";
+    char ascii[PREVIEW_HEX_BYTES + 1];
+    int used = 0;
+    for (int i = 0; i < PREVIEW_HEX_BYTES; i++) {
+        // Spasi tambahan di tengah baris, seperti hexdump -C
+        const char* gap = i == PREVIEW_HEX_BYTES / 2 ? " " : "";
+        if (i < count) {
+            used += snprintf(hex + used, sizeof(hex) - used, "%s%02x ", gap, bytes[i]);
+            ascii[i] = bytes[i] >= 0x20 && bytes[i] < 0x7f ? (char)bytes[i] : '.';
+        }
+        else {
+            used += snprintf(hex + used, sizeof(hex) - used, "%s   ", gap);
+        }
+    }
+    ascii[count] = '\0';
+
+    int written = snprintf(out, size, "%010llx  %s |%s|", offset, hex, ascii);
+    return written < size ? written : size - 1;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Maps the whole file read-only; an empty file gets no mapping
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _mapFile(FilePreview* preview) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(preview->path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    preview->fileHandle = file;
+    preview->size = size.QuadPart;
+    if (preview->size == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (view == NULL) {
+        if (mapping != NULL) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    preview->mappingHandle = mapping;
+    preview->data = view;
+    return true;
+#else
+    int fd = open(preview->path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+    preview->size = st.st_size;
+    if (preview->size > 0) {
+        void* view = mmap(NULL, (size_t)preview->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        preview->data = view;
+    }
+    // Mapping tetap berlaku setelah descriptor ditutup
+    close(fd);
+    return true;
+#endif
+}
+
+/**
+ * @brief Releases the mapping created by _mapFile()
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _unmapFile(FilePreview* preview) {
+#ifdef _WIN32
+    if (preview->data != NULL) {
+        UnmapViewOfFile(preview->data);
+    }
+    if (preview->mappingHandle != NULL) {
+        CloseHandle(preview->mappingHandle);
+    }
+    if (preview->fileHandle != NULL) {
+        CloseHandle(preview->fileHandle);
+    }
+#else
+    if (preview->data != NULL) {
+        munmap((void*)preview->data, (size_t)preview->size);
+    }
+#endif
+    preview->data = NULL;
+}
+
+/**
+ * @brief Treats data as binary if it has a NUL byte or over 10% control bytes
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _looksBinary(const unsigned char* data, long long size) {
+    long long control = 0;
+    for (long long i = 0; i < size; i++) {
+        unsigned char c = data[i];
+        if (c == 0) {
+            return true;
+        }
+        if (c < 0x20 && c != '\n' && c != '\r' && c != '\t' && c != '\f' && c != 0x1b) {
+            control++;
+        }
+    }
+    return control * 10 > size;
+}
+
+/**
+ * @brief Scans the mapping for newlines and publishes checkpoints in batches
+ *
+ * Checkpoints and line counts are collected locally and handed over every
+ * PREVIEW_PENDING_CHECKPOINTS checkpoints or PREVIEW_PUBLISH_BYTES bytes,
+ * so readers take the lock rarely and always see a consistent index.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void* _indexWorker(void* arg) {
+    FilePreview* preview = (FilePreview*)arg;
+    PROFILE_THREAD_NAME("preview indexer");
+    PROFILE_ZONE("preview index");
+
+    const unsigned char* data = preview->data;
+    long long size = preview->size;
+    long long pending[PREVIEW_PENDING_CHECKPOINTS];
+    int pendingCount = 0;
+    long long lines = 0;
+    long long pos = 0;
+    long long lastPublish = 0;
+
+    while (pos < size) {
+        const unsigned char* newline = memchr(data + pos, '\n', (size_t)(size - pos));
+        if (newline == NULL) {
+            pos = size;
+            break;
+        }
+        pos = newline - data + 1;
+        lines++;
+
+        // Checkpoint = awal baris ke-(lines), hanya jika baris itu ada
+        if (lines % PREVIEW_INDEX_STRIDE == 0 && pos < size) {
+            pending[pendingCount++] = pos;
+        }
+        if (pendingCount == PREVIEW_PENDING_CHECKPOINTS || pos - lastPublish >= PREVIEW_PUBLISH_BYTES) {
+            if (!_publish(preview, pending, pendingCount, lines, pos, false)) {
+                return NULL;
+            }
+            pendingCount = 0;
+            lastPublish = pos;
+        }
+    }
+
+    // Baris terakhir tanpa newline tetap dihitung
+    if (size > 0 && data[size - 1] != '\n') {
+        lines++;
+    }
+    _publish(preview, pending, pendingCount, lines, size, true);
+    logDebug("Preview %s: %lld baris, %d checkpoint\n", preview->path, lines, preview->checkpointCount);
+    return NULL;
+}
+
+/**
+ * @brief Appends checkpoints and updates the progress under the lock
+ *
+ * @return bool false if the preview is being closed or memory ran out
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _publish(FilePreview* preview, const long long* pending, int count,
+                     long long lines, long long bytes, bool complete) {
+    pthread_mutex_lock(&preview->lock);
+    bool ok = !preview->cancel;
+
+    if (ok && preview->checkpointCount + count > preview->checkpointCapacity) {
+        int capacity = preview->checkpointCapacity;
+        while (preview->checkpointCount + count > capacity) {
+            capacity *= 2;
+        }
+        long long* grown = realloc(preview->checkpoints, sizeof(long long) * capacity);
+        if (grown == NULL) {
+            logError("Index preview kehabisan memori di %lld baris\n", preview->lineCount);
+            // Index berhenti di sini, baris yang sudah terindeks tetap bisa dibaca
+            preview->complete = true;
+            ok = false;
+        }
+        else {
+            preview->checkpoints = grown;
+            preview->checkpointCapacity = capacity;
+        }
+    }
+
+    if (ok) {
+        memcpy(preview->checkpoints + preview->checkpointCount, pending, sizeof(long long) * count);
+        preview->checkpointCount += count;
+        preview->lineCount = lines;
+        preview->indexedBytes = bytes;
+        preview->complete = complete;
+    }
+    pthread_cond_broadcast(&preview->progress);
+    pthread_mutex_unlock(&preview->lock);
+    return ok;
+}
+
+/**
+ * @brief Finds the byte offset of a line from its checkpoint or the previous lookup
+ *
+ * @return bool false if the line is not indexed (yet)
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _lineStart(FilePreview* preview, long long line, long long* start) {
+    if (line < 0 || preview->binary) {
+        return false;
+    }
+
+    pthread_mutex_lock(&preview->lock);
+    bool indexed = line < preview->lineCount;
+    long long offset = indexed ? preview->checkpoints[line / PREVIEW_INDEX_STRIDE] : 0;
+    pthread_mutex_unlock(&preview->lock);
+    if (!indexed) {
+        return false;
+    }
+
+    // Lanjut dari baris terakhir jika lebih dekat dari checkpoint (scroll berurutan)
+    long long from = line - line % PREVIEW_INDEX_STRIDE;
+    if (preview->cursorLine > from && preview->cursorLine <= line) {
+        from = preview->cursorLine;
+        offset = preview->cursorOffset;
+    }
+
+    for (long long skip = line - from; skip > 0; skip--) {
+        const unsigned char* newline = memchr(preview->data + offset, '\n', (size_t)(preview->size - offset));
+        if (newline == NULL) {
+            return false;
+        }
+        offset = newline - preview->data + 1;
+    }
+    preview->cursorLine = line;
+    preview->cursorOffset = offset;
+    *start = offset;
+    return true;
+}
@@ -1,8 +1,12 @@
 #include "gui/body.h"
+#include "gui/duplicates.h"
+#include "gui/preview.h"
+#include "gui/thumbnail.h"
 #include "ctx.h"
 #include "file_manager.h"
 #include "item.h"
 #include "macro.h"
+#include "profiler.h"
 
 // #include <time.h>
 
@@ -11,6 +15,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define GRID_THUMB_SIZE 64  // Kotak thumbnail/ikon di dalam tile grid
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void _handleItemClick(Context *ctx, Body *body, Tree subTree, int index, Rectangle hitRec);  // Klik, Ctrl+klik, double klik
+static void _drawSelectionCheckbox(Context *ctx, Rectangle checkBox, Tree subTree);               // Checkbox seleksi item
+static void _drawThumbnail(const Texture2D *thumbnail, Rectangle box);                            // Gambar thumbnail di tengah box
+static void _drawEmptyState(Context *ctx, Body *body, float startX, float startY);                // Label hasil kosong / trash kosong
+
 void createBody(Context *ctx, Body *b) {
     Body body = {0};
     body.ctx = ctx;
@@ -21,6 +38,7 @@ void createBody(Context *ctx, Body *b) {
 
     body.focusedIndex = -1;
     body.showCheckbox = true;
+    body.viewMode = BODY_VIEW_DETAILS;
     body.selectedAll = false;
     body.previousSelectedAll = false;
 
@@ -37,35 +55,32 @@ void updateBody(Context *ctx, Body *body) {
         body->currentZeroPosition.width - 170 - DEFAULT_PADDING,
         body->currentZeroPosition.height - DEFAULT_PADDING * 2 - 24 * 3};
 
+    // Sisakan sisi kanan untuk preview pane (F4)
+    if (ctx->preview && ctx->preview->visible)
+        body->panelRec.width -= body->panelRec.width * PREVIEW_PANE_RATIO;
+
     if (ctx->fileManager->treeCursor) {
-        Tree cursor = ctx->fileManager->treeCursor->first_son;
-        int totalItems = 0;
-        int selectedItems = 0;
-
-        while (cursor != NULL) {
-            totalItems++;
-            if (cursor->item.selected) {
-                selectedItems++;
-            }
-            cursor = cursor->next_brother;
-        }
+        int selectedItems = ctx->fileManager->selectedItem.count;
 
-        if (totalItems == 0) {
+        if (selectedItems == 0) {
             body->selectedAll = false;
-        } else if (selectedItems == totalItems) {
-            body->selectedAll = true;
         } else {
-            body->selectedAll = false;
+            // Seleksi hanya berisi anak direktori ini, cukup bandingkan jumlah
+            body->selectedAll = (get_child_count(ctx->fileManager->treeCursor) == selectedItems);
         }
     }
 }
 
 void drawBody(Context *ctx, Body *body) {
+    PROFILE_FUNCTION();
     Tree cursor = ctx->fileManager->treeCursor;
 
     sort_children(&cursor);
 
-    cursor = cursor->first_son;
+    if (body->viewMode == BODY_VIEW_GRID) {
+        drawGridView(ctx, body);
+        return;
+    }
 
     float headerHeight = 30;
     float rowHeight = 24;
@@ -88,67 +103,35 @@ void drawBody(Context *ctx, Body *body) {
     float startX = body->panelRec.x + body->panelScroll.x;
 
     if (ctx->fileManager->isSearching || ctx->fileManager->isRootTrash) {
-        // Jika tidak ada hasil pencarian
-        if (ctx->fileManager->isSearching && ctx->fileManager->searchingList.head == NULL) {
-            Rectangle noResultRec = {
-                startX,
-                startY,
-                body->panelContentRec.width,
-                body->panelContentRec.height - headerHeight};
-            // DrawRectangleRec(noResultRec, Fade(LIGHTGRAY, 0.5f));
-
-            Rectangle labelRec = {
-                startX + 10,
-                startY + 10,
-                body->panelContentRec.width - 20,
-                30};
-            GuiSetStyle(LABEL, TEXT_ALIGNMENT, TEXT_ALIGN_LEFT);
-            GuiSetStyle(LABEL, TEXT_COLOR_NORMAL, ColorToInt(DARKGRAY));
-            GuiLabel(labelRec, "Tidak ada hasil pencarian");
-            GuiSetStyle(LABEL, TEXT_COLOR_NORMAL, ColorToInt(DARKGRAY)); // Reset style
-        }
-
-        if (ctx->fileManager->trash.head == NULL && ctx->fileManager->isRootTrash) {
-            Rectangle noTrashRec = {
-                startX,
-                startY,
-                body->panelContentRec.width,
-                body->panelContentRec.height - headerHeight};
-            // DrawRectangleRec(noTrashRec, Fade(LIGHTGRAY, 0.5f));
-
-            Rectangle labelRec = {
-                startX + 10,
-                startY + 10,
-                body->panelContentRec.width - 20,
-                30};
-            GuiSetStyle(LABEL, TEXT_ALIGNMENT, TEXT_ALIGN_LEFT);
-            GuiSetStyle(LABEL, TEXT_COLOR_NORMAL, ColorToInt(DARKGRAY));
-            GuiLabel(labelRec, "Trash kosong");
-            GuiSetStyle(LABEL, TEXT_COLOR_NORMAL, ColorToInt(DARKGRAY)); // Reset style
-        }
+        _drawEmptyState(ctx, body, startX, startY);
 
         int i = 0;
-        Node *temp = ctx->fileManager->trash.head;
         if (ctx->fileManager->isSearching) {
-            temp = ctx->fileManager->searchingList.head;
-        }
-
-        while (temp != NULL) {
-            Tree treePtr = (Tree)temp->data;
-            drawTableItem(ctx, body, treePtr, i, startX, body->panelRec.y + headerHeight + body->panelScroll.y, rowHeight, colWidths);
-            temp = temp->next;
-            i++;
+            Node *temp = ctx->fileManager->searchingList.head;
+            while (temp != NULL) {
+                Tree treePtr = (Tree)temp->data;
+                drawTableItem(ctx, body, treePtr, i, startX, body->panelRec.y + headerHeight + body->panelScroll.y, rowHeight, colWidths);
+                temp = temp->next;
+                i++;
+            }
+        } else {
+            // Trash store terurut berdasarkan waktu hapus (terbaru dulu)
+            TrashNode *temp = ctx->fileManager->trash.head;
+            while (temp != NULL) {
+                Tree treePtr = (Tree)temp->data;
+                drawTableItem(ctx, body, treePtr, i, startX, body->panelRec.y + headerHeight + body->panelScroll.y, rowHeight, colWidths);
+                temp = temp->next;
+                i++;
+            }
         }
         body->panelContentRec.height = (i * rowHeight) + headerHeight;
     } else {
-        int i = 0;
-        while (cursor != NULL) {
-            drawTableItem(ctx, body, cursor, i, startX, body->panelRec.y + headerHeight + body->panelScroll.y, rowHeight, colWidths);
-
-            i++;
-            cursor = cursor->next_brother;
+        Tree folder = ctx->fileManager->treeCursor;
+        int count = get_child_count(folder);
+        for (int i = 0; i < count; i++) {
+            drawTableItem(ctx, body, get_child(folder, i), i, startX, body->panelRec.y + headerHeight + body->panelScroll.y, rowHeight, colWidths);
         }
-        body->panelContentRec.height = (i * rowHeight) + headerHeight;
+        body->panelContentRec.height = (count * rowHeight) + headerHeight;
     }
 
     float headerX = body->panelRec.x + body->panelScroll.x;
@@ -167,43 +150,7 @@ void drawTableItem(Context *ctx, Body *body, Tree subTree, int index, float star
 
     Rectangle rowRec = {rowX + checkboxWidth, rowY, totalContentWidth - checkboxWidth, rowHeight};
 
-    if (CheckCollisionPointRec(GetMousePosition(), rowRec) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !ctx->disableGroundClick) {
-        body->focusedIndex = index;
-
-        // Handle double tap untuk navigation/open
-        if (GetGestureDetected() == GESTURE_DOUBLETAP && ctx->fileManager->isRootTrash == false) {
-            if (item.type == ITEM_FOLDER) {
-                ctx->fileManager->isSearching = false;
-                // ctx->navbar
-                goTo(ctx->fileManager, subTree);
-            } else if (item.type == ITEM_FILE) {
-                windowsOpenWith(item.path);
-            }
-        }
-        // Handle single tap
-        else if (GetGestureDetected() == GESTURE_TAP || GetGestureDetected() == GESTURE_NONE) {
-            // Ctrl + Click untuk selection
-            if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)) {
-                // Toggle selection status
-                subTree->item.selected = !subTree->item.selected;
-
-                if (subTree->item.selected) {
-                    selectFile(ctx->fileManager, &subTree->item);
-                } else {
-                    deselectFile(ctx->fileManager, &subTree->item);
-                }
-            }
-            // Single click tanpa Ctrl = clear selection dan focus item ini
-            else {
-                // Clear semua selection dulu
-                clearSelectedFile(ctx->fileManager);
-
-                // Select item yang diklik
-                subTree->item.selected = true;
-                selectFile(ctx->fileManager, &subTree->item);
-            }
-        }
-    }
+    _handleItemClick(ctx, body, subTree, index, rowRec);
 
     Color bgColor;
     // Tolong cek warnanya dong. layar monitorku ga akurat warnanya
@@ -230,26 +177,7 @@ void drawTableItem(Context *ctx, Body *body, Tree subTree, int index, float star
             rowY + (rowHeight - 14) / 2,
             14, 14};
 
-        bool previousSelected = subTree->item.selected;
-
-        // PERBAIKAN: Hanya proses jika tidak dalam mode disabled
-        if (!ctx->disableGroundClick) {
-            GuiCheckBox(checkBox, NULL, &subTree->item.selected);
-
-            // Update selection state hanya jika ada perubahan
-            if (subTree->item.selected != previousSelected) {
-                if (subTree->item.selected) {
-                    selectFile(ctx->fileManager, &subTree->item);
-                } else {
-                    deselectFile(ctx->fileManager, &subTree->item);
-                }
-            }
-        } else {
-            // Dalam mode disabled, hanya tampilkan tanpa interaksi
-            GuiDisable();
-            GuiCheckBox(checkBox, NULL, &subTree->item.selected);
-            GuiEnable();
-        }
+        _drawSelectionCheckbox(ctx, checkBox, subTree);
 
         colX += checkboxWidth;
     }
@@ -257,7 +185,15 @@ void drawTableItem(Context *ctx, Body *body, Tree subTree, int index, float star
     // PERBAIKAN: Warna text berdasarkan status selection
     Color textColor = DARKGRAY;
 
-    if (item.type == ITEM_FOLDER) {
+    // Thumbnail hanya diminta untuk baris yang terlihat; selama belum siap pakai ikon biasa
+    const Texture2D *thumbnail = NULL;
+    bool rowVisible = rowY + rowHeight >= body->panelView.y && rowY <= body->panelView.y + body->panelView.height;
+    if (rowVisible && ctx->thumbnails && isThumbnailCandidate(&item))
+        thumbnail = requestThumbnail(ctx->thumbnails, item.path, item.updated_at);
+
+    if (thumbnail) {
+        _drawThumbnail(thumbnail, (Rectangle){colX + 8, rowY + (rowHeight - 16) / 2, 16, 16});
+    } else if (item.type == ITEM_FOLDER) {
         GuiLabel((Rectangle){colX + 8, rowY + 6, 16, rowHeight - 12}, "#217#");
     } else if (item.type == ITEM_FILE) {
         GuiLabel((Rectangle){colX + 8, rowY + 6, 16, rowHeight - 12}, "#218#");
@@ -295,6 +231,108 @@ void drawTableItem(Context *ctx, Body *body, Tree subTree, int index, float star
     DrawText(TextFormat("%s", buffer), colX + 8, rowY + 6, 10, textColor);
 }
 
+void drawGridView(Context *ctx, Body *body) {
+    FileManager *fm = ctx->fileManager;
+    int count = fm->isSearching ? fm->searchingList.length
+                : fm->isRootTrash ? fm->trash.count
+                : get_child_count(fm->treeCursor);
+
+    float usableWidth = body->panelRec.width - GuiGetStyle(LISTVIEW, SCROLLBAR_WIDTH) - 2 * GuiGetStyle(DEFAULT, BORDER_WIDTH);
+    int columns = (int)(usableWidth / GRID_TILE_WIDTH);
+    if (columns < 1)
+        columns = 1;
+    int rows = (count + columns - 1) / columns;
+
+    // Ukuran konten dihitung sebelum scroll panel, scrollbar tidak tertinggal satu frame
+    body->panelContentRec.width = columns * GRID_TILE_WIDTH;
+    body->panelContentRec.height = rows * GRID_TILE_HEIGHT;
+
+    if (ctx->disableGroundClick)
+        GuiDisable();
+
+    GuiScrollPanel(body->panelRec, NULL, body->panelContentRec, &body->panelScroll, &body->panelView);
+    GuiEnable();
+
+    BeginScissorMode(body->panelView.x, body->panelView.y, body->panelView.width, body->panelView.height);
+
+    float startX = body->panelView.x + body->panelScroll.x;
+    float startY = body->panelView.y + body->panelScroll.y;
+
+    if (fm->isSearching || fm->isRootTrash)
+        _drawEmptyState(ctx, body, startX, startY);
+
+    // Hanya baris tile yang beririsan dengan panelView yang digambar
+    int firstRow = (int)((body->panelView.y - startY) / GRID_TILE_HEIGHT);
+    int lastRow = (int)((body->panelView.y + body->panelView.height - startY) / GRID_TILE_HEIGHT);
+    int first = firstRow * columns;
+    int end = (lastRow + 1) * columns;
+    if (end > count)
+        end = count;
+
+    int i = 0;
+    if (fm->isSearching) {
+        // Linked list: lewati node sebelum tile pertama tanpa menggambar
+        for (Node *temp = fm->searchingList.head; temp != NULL && i < end; temp = temp->next, i++) {
+            if (i >= first)
+                drawGridItem(ctx, body, (Tree)temp->data, i,
+                             (Rectangle){startX + (i % columns) * GRID_TILE_WIDTH, startY + (i / columns) * GRID_TILE_HEIGHT, GRID_TILE_WIDTH, GRID_TILE_HEIGHT});
+        }
+    } else if (fm->isRootTrash) {
+        for (TrashNode *temp = fm->trash.head; temp != NULL && i < end; temp = temp->next, i++) {
+            if (i >= first)
+                drawGridItem(ctx, body, (Tree)temp->data, i,
+                             (Rectangle){startX + (i % columns) * GRID_TILE_WIDTH, startY + (i / columns) * GRID_TILE_HEIGHT, GRID_TILE_WIDTH, GRID_TILE_HEIGHT});
+        }
+    } else {
+        // Folder biasa: akses langsung lewat array children
+        Tree folder = fm->treeCursor;
+        for (i = first; i < end; i++) {
+            drawGridItem(ctx, body, get_child(folder, i), i,
+                         (Rectangle){startX + (i % columns) * GRID_TILE_WIDTH, startY + (i / columns) * GRID_TILE_HEIGHT, GRID_TILE_WIDTH, GRID_TILE_HEIGHT});
+        }
+    }
+
+    EndScissorMode();
+}
+
+void drawGridItem(Context *ctx, Body *body, Tree subTree, int index, Rectangle tile) {
+    Item item = subTree->item;
+
+    // Tile yang terpotong tepi panel hanya bisa diklik di bagian yang terlihat
+    _handleItemClick(ctx, body, subTree, index, GetCollisionRec(tile, body->panelView));
+
+    Color bgColor = WHITE;
+    if (subTree->item.selected) {
+        bgColor = Fade(BLUE, 0.3f);
+    } else if (body->focusedIndex == index) {
+        bgColor = Fade(BLUE, 0.15f);
+    }
+    DrawRectangleRec((Rectangle){tile.x + 2, tile.y + 2, tile.width - 4, tile.height - 4}, bgColor);
+
+    Rectangle thumbRec = {tile.x + (tile.width - GRID_THUMB_SIZE) / 2, tile.y + 6, GRID_THUMB_SIZE, GRID_THUMB_SIZE};
+    const Texture2D *thumbnail = NULL;
+    if (ctx->thumbnails && isThumbnailCandidate(&item))
+        thumbnail = requestThumbnail(ctx->thumbnails, item.path, item.updated_at);
+
+    if (thumbnail) {
+        _drawThumbnail(thumbnail, thumbRec);
+    } else {
+        GuiDrawIcon(item.type == ITEM_FOLDER ? 217 : 218, thumbRec.x, thumbRec.y, GRID_THUMB_SIZE / 16, GetColor(GuiGetStyle(LABEL, TEXT_COLOR_NORMAL)));
+    }
+
+    GuiSetStyle(LABEL, TEXT_ALIGNMENT, TEXT_ALIGN_CENTER);
+    GuiLabel((Rectangle){tile.x + 4, thumbRec.y + GRID_THUMB_SIZE + 2, tile.width - 8, tile.height - GRID_THUMB_SIZE - 12}, item.name);
+    GuiSetStyle(LABEL, TEXT_ALIGNMENT, TEXT_ALIGN_LEFT);
+
+    if (body->showCheckbox)
+        _drawSelectionCheckbox(ctx, (Rectangle){tile.x + 6, tile.y + 6, 14, 14}, subTree);
+}
+
+void toggleBodyViewMode(Body *body) {
+    body->viewMode = body->viewMode == BODY_VIEW_GRID ? BODY_VIEW_DETAILS : BODY_VIEW_GRID;
+    body->panelScroll = (Vector2){0};
+}
+
 void drawTableHeader(Context *ctx, Body *body, float x, float y, float colWidths[]) {
     int fontSize = 10;
     int headerHeight = 30;
@@ -354,4 +392,135 @@ void getFolderSize(Tree tree, long *size) {
             child = child->next_brother;
         }
     }
-}
\ No newline at end of file
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Handles a click on an item row or tile
+ *
+ * Double click opens (folder: navigate, file: open with), Ctrl+click
+ * toggles the selection, a plain click selects only this item.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _handleItemClick(Context *ctx, Body *body, Tree subTree, int index, Rectangle hitRec) {
+    Item item = subTree->item;
+
+    if (CheckCollisionPointRec(GetMousePosition(), hitRec) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !ctx->disableGroundClick) {
+        body->focusedIndex = index;
+
+        // Handle double tap untuk navigation/open
+        if (GetGestureDetected() == GESTURE_DOUBLETAP && ctx->fileManager->isRootTrash == false) {
+            if (item.type == ITEM_FOLDER) {
+                ctx->fileManager->isSearching = false;
+                // ctx->navbar
+                goTo(ctx->fileManager, subTree);
+            } else if (item.type == ITEM_FILE) {
+                windowsOpenWith(item.path);
+            }
+        }
+        // Handle single tap
+        else if (GetGestureDetected() == GESTURE_TAP || GetGestureDetected() == GESTURE_NONE) {
+            // Ctrl + Click untuk selection
+            if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)) {
+                // Toggle selection status
+                subTree->item.selected = !subTree->item.selected;
+
+                if (subTree->item.selected) {
+                    selectFile(ctx->fileManager, &subTree->item);
+                } else {
+                    deselectFile(ctx->fileManager, &subTree->item);
+                }
+            }
+            // Single click tanpa Ctrl = clear selection dan focus item ini
+            else {
+                // Clear semua selection dulu
+                clearSelectedFile(ctx->fileManager);
+
+                // Select item yang diklik
+                subTree->item.selected = true;
+                selectFile(ctx->fileManager, &subTree->item);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Draws the selection checkbox of an item and syncs the selection
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _drawSelectionCheckbox(Context *ctx, Rectangle checkBox, Tree subTree) {
+    bool previousSelected = subTree->item.selected;
+
+    // PERBAIKAN: Hanya proses jika tidak dalam mode disabled
+    if (!ctx->disableGroundClick) {
+        GuiCheckBox(checkBox, NULL, &subTree->item.selected);
+
+        // Update selection state hanya jika ada perubahan
+        if (subTree->item.selected != previousSelected) {
+            if (subTree->item.selected) {
+                selectFile(ctx->fileManager, &subTree->item);
+            } else {
+                deselectFile(ctx->fileManager, &subTree->item);
+            }
+        }
+    } else {
+        // Dalam mode disabled, hanya tampilkan tanpa interaksi
+        GuiDisable();
+        GuiCheckBox(checkBox, NULL, &subTree->item.selected);
+        GuiEnable();
+    }
+}
+
+/**
+ * @brief Draws a thumbnail centered in box, scaled to fit with its aspect ratio
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _drawThumbnail(const Texture2D *thumbnail, Rectangle box) {
+    float scaleX = box.width / thumbnail->width;
+    float scaleY = box.height / thumbnail->height;
+    float scale = scaleX < scaleY ? scaleX : scaleY;
+    float width = thumbnail->width * scale;
+    float height = thumbnail->height * scale;
+
+    Rectangle source = {0, 0, (float)thumbnail->width, (float)thumbnail->height};
+    Rectangle dest = {box.x + (box.width - width) / 2, box.y + (box.height - height) / 2, width, height};
+    DrawTexturePro(*thumbnail, source, dest, (Vector2){0, 0}, 0, WHITE);
+}
+
+/**
+ * @brief Draws the "no search results" / "trash is empty" label when applicable
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _drawEmptyState(Context *ctx, Body *body, float startX, float startY) {
+    const char *message = NULL;
+    // Jika tidak ada hasil pencarian
+    if (ctx->fileManager->isSearching && ctx->fileManager->searchingList.head == NULL)
+        message = duplicateViewScanning(ctx->duplicates) ? "Mencari duplikat..." : "Tidak ada hasil pencarian";
+    else if (isTrashStoreEmpty(&ctx->fileManager->trash) && ctx->fileManager->isRootTrash)
+        message = "Trash kosong";
+    if (message == NULL)
+        return;
+
+    Rectangle labelRec = {
+        startX + 10,
+        startY + 10,
+        body->panelContentRec.width - 20,
+        30};
+    GuiSetStyle(LABEL, TEXT_ALIGNMENT, TEXT_ALIGN_LEFT);
+    GuiSetStyle(LABEL, TEXT_COLOR_NORMAL, ColorToInt(DARKGRAY));
+    GuiLabel(labelRec, message);
+    GuiSetStyle(LABEL, TEXT_COLOR_NORMAL, ColorToInt(DARKGRAY)); // Reset style
+}
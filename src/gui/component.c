@@ -129,9 +129,6 @@ void showPasteProgressBar(int currentProgress, int totalItems, const char *curre
         progressState.shouldCancel = false;
     }
 
-    BeginDrawing();
-    ClearBackground(RAYWHITE);
-
     // Hitung persentase
     float progressValue = (float)currentProgress / (float)totalItems;
 
@@ -192,8 +189,6 @@ void showPasteProgressBar(int currentProgress, int totalItems, const char *curre
     if (GuiButton(cancelBtn, "Cancel")) {
         progressState.shouldCancel = true;
     }
-
-    EndDrawing();
 }
 
 bool shouldCancelPaste() {
@@ -0,0 +1,81 @@
+#include "gui/duplicates.h"
+#include "ctx.h"
+#include "file_manager.h"
+#include "logger.h"
+#include "macro.h"
+#include "profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+================================================================================
+--------------------------------------------------------------------------------
+                                IMPLEMENTATION
+--------------------------------------------------------------------------------
+================================================================================
+*/
+
+void createDuplicateView(DuplicateView *view, Context *ctx) {
+    memset(view, 0, sizeof(DuplicateView));
+    view->ctx = ctx;
+}
+
+void startDuplicateView(DuplicateView *view, Tree folder) {
+    closeDuplicateView(view);
+    if (folder == NULL)
+        return;
+    if (!startDuplicateFinder(&view->finder, folder, 0))
+        return;
+
+    view->active = true;
+    clearSelectedFile(view->ctx->fileManager);
+    // from = 0 mengosongkan hasil pencarian lama dan masuk ke mode search
+    view->shownGroups = appendDuplicateResults(view->ctx->fileManager, &view->finder, 0);
+    logInfo("Mencari duplikat di %s\n", folder->item.path);
+}
+
+void updateDuplicateView(DuplicateView *view) {
+    PROFILE_FUNCTION();
+    if (!view->active)
+        return;
+
+    FileManager *fm = view->ctx->fileManager;
+    if (!fm->isSearching) {
+        closeDuplicateView(view);
+        return;
+    }
+    if (duplicateGroupCount(&view->finder) > view->shownGroups)
+        view->shownGroups = appendDuplicateResults(fm, &view->finder, view->shownGroups);
+}
+
+void closeDuplicateView(DuplicateView *view) {
+    if (!view->active)
+        return;
+    destroyDuplicateFinder(&view->finder);
+    view->active = false;
+    view->shownGroups = 0;
+}
+
+bool duplicateViewStatus(DuplicateView *view, char *out, int size) {
+    if (!view->active)
+        return false;
+
+    DuplicateStats stats;
+    getDuplicateStats(&view->finder, &stats);
+    double reclaim = stats.reclaimableBytes / (double)MB_SIZE;
+    if (stats.done)
+        snprintf(out, size, "%d grup duplikat, %.2f MB bisa dihemat", stats.groups, reclaim);
+    else
+        snprintf(out, size, "%d grup duplikat, %.2f MB bisa dihemat (hash %lld/%lld)", stats.groups, reclaim,
+                 stats.hashed, stats.sizeCandidates + stats.edgeCandidates);
+    return true;
+}
+
+bool duplicateViewScanning(DuplicateView *view) {
+    if (!view->active)
+        return false;
+    DuplicateStats stats;
+    getDuplicateStats(&view->finder, &stats);
+    return !stats.done;
+}
@@ -1,8 +1,10 @@
 #include "footer.h"
 #include "ctx.h"
+#include "duplicates.h"
 #include "file_manager.h"
 #include "item.h"
 #include "macro.h"
+#include "profiler.h"
 #include "raygui.h"
 #include <stdio.h>
 
@@ -36,20 +38,13 @@ void updateFooter(Footer *footer, Context *ctx) {
 }
 
 void drawFooter(Footer *footer) {
+    PROFILE_FUNCTION();
     if (!footer || !footer->ctx)
         return;
 
     FileManager *fm = footer->ctx->fileManager;
-    Node *node = fm->selectedItem.head;
-
-    int selectedCount = 0;
-    long totalSize = 0;
-    while (node) {
-        Item *it = (Item *)node->data;
-        selectedCount++;
-        totalSize += it->size;
-        node = node->next;
-    }
+    int selectedCount = fm->selectedItem.count;
+    long long totalSize = fm->selectedItem.totalBytes;
 
     char text1[64];
     snprintf(text1, sizeof(text1), "%d item%s selected", selectedCount, selectedCount != 1 ? "s" : "");
@@ -57,7 +52,7 @@ void drawFooter(Footer *footer) {
     char text2[64];
     snprintf(text2, sizeof(text2), "%.2f KB", totalSize / 1024.0);
     if (totalSize < KB_SIZE) {
-        snprintf(text2, sizeof(text2), "%ld B", totalSize);
+        snprintf(text2, sizeof(text2), "%lld B", totalSize);
     } else if (totalSize < MB_SIZE) {
         snprintf(text2, sizeof(text2), "%.2f KB", totalSize / 1024.0);
     } else if (totalSize < GB_SIZE) {
@@ -89,4 +84,16 @@ void drawFooter(Footer *footer) {
     Rectangle r3 = {x, y, MeasureTextEx(GuiGetFont(), text2, GuiGetStyle(DEFAULT, TEXT_SIZE), 1).x + 8, labelHeight};
     GuiLabel(r3, text2);
     x += r3.width + spacing;
+
+    // Total scan duplikat (Ctrl+D) selama hasilnya tampil
+    char text3[128];
+    if (duplicateViewStatus(footer->ctx->duplicates, text3, sizeof(text3))) {
+        Rectangle r4 = {x, y, 12, labelHeight};
+        GuiLabel(r4, "|");
+        x += r4.width + spacing;
+
+        Rectangle r5 = {x, y, MeasureTextEx(GuiGetFont(), text3, GuiGetStyle(DEFAULT, TEXT_SIZE), 1).x + 8, labelHeight};
+        GuiLabel(r5, text3);
+        x += r5.width + spacing;
+    }
 }
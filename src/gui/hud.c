@@ -0,0 +1,270 @@
+#include "hud.h"
+#include "copy_engine.h"
+#include "ctx.h"
+#include "file_manager.h"
+#include "logger.h"
+#include "mem_stats.h"
+#include "nbtree.h"
+#include "profiler.h"
+#include "raygui.h"
+#include "thumbnail.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HUD_REFRESH_SECONDS 0.25
+#define HUD_PADDING 8
+#define HUD_LINE_HEIGHT 16
+#define HUD_FONT_SIZE 14
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void _refresh(Hud *hud, double now);                                 // Rebuild the text from the counters
+static void _percentiles(const float *samples, int count, float *p50, float *p99);  // p50/p99 of a sample ring
+static float _average(const float *samples, int count);                     // Mean of a sample ring
+static int _compareFloat(const void *a, const void *b);                     // qsort comparator
+static void _addLine(Hud *hud, const char *format, ...) __attribute__((format(printf, 2, 3)));  // Append one text line
+
+/*
+================================================================================
+--------------------------------------------------------------------------------
+                                IMPLEMENTATION
+--------------------------------------------------------------------------------
+================================================================================
+*/
+
+void createHud(Hud *hud, Context *ctx) {
+    if (!hud)
+        return;
+
+    memset(hud, 0, sizeof(Hud));
+    hud->ctx = ctx;
+    hud->visible = false;
+}
+
+void hudBeginFrame(Hud *hud) {
+    if (!hud)
+        return;
+
+    double now = GetTime();
+    if (hud->frameStart > 0) {
+        hud->frameMs[hud->sampleNext] = (float)((now - hud->frameStart) * 1000.0);
+        hud->updateMs[hud->sampleNext] = hud->pendingUpdateMs;
+        hud->drawMs[hud->sampleNext] = hud->pendingDrawMs;
+        hud->sampleNext = (hud->sampleNext + 1) % HUD_FRAME_SAMPLES;
+        if (hud->sampleCount < HUD_FRAME_SAMPLES)
+            hud->sampleCount++;
+    }
+    hud->frameStart = now;
+    hud->pendingUpdateMs = 0;
+    hud->pendingDrawMs = 0;
+}
+
+void hudBeginDraw(Hud *hud) {
+    if (!hud)
+        return;
+
+    hud->drawStart = GetTime();
+    hud->pendingUpdateMs = (float)((hud->drawStart - hud->frameStart) * 1000.0);
+}
+
+void hudEndDraw(Hud *hud) {
+    if (!hud)
+        return;
+
+    hud->pendingDrawMs = (float)((GetTime() - hud->drawStart) * 1000.0);
+}
+
+void toggleHud(Hud *hud) {
+    if (!hud)
+        return;
+
+    hud->visible = !hud->visible;
+    // Paksa refresh saat ditampilkan, tanpa throughput dari interval lama
+    hud->lastRefresh = 0;
+}
+
+void drawHud(Hud *hud) {
+    PROFILE_FUNCTION();
+    if (!hud || !hud->visible || !hud->ctx)
+        return;
+
+    double now = GetTime();
+    if (hud->lastRefresh == 0 || now - hud->lastRefresh >= HUD_REFRESH_SECONDS)
+        _refresh(hud, now);
+
+    Font font = GuiGetFont();
+    float width = 0;
+    for (int i = 0; i < hud->lineCount; i++) {
+        float lineWidth = MeasureTextEx(font, hud->lines[i], HUD_FONT_SIZE, 1).x;
+        if (lineWidth > width)
+            width = lineWidth;
+    }
+
+    Rectangle panel = {
+        GetScreenWidth() - width - HUD_PADDING * 3,
+        HUD_PADDING * 5,
+        width + HUD_PADDING * 2,
+        hud->lineCount * HUD_LINE_HEIGHT + HUD_PADDING * 2};
+
+    DrawRectangleRec(panel, Fade(BLACK, 0.75f));
+    for (int i = 0; i < hud->lineCount; i++) {
+        Vector2 position = {panel.x + HUD_PADDING, panel.y + HUD_PADDING + i * HUD_LINE_HEIGHT};
+        DrawTextEx(font, hud->lines[i], position, HUD_FONT_SIZE, 1, RAYWHITE);
+    }
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Rebuilds the overlay text from the subsystem counters
+ *
+ * Every value is an O(1) read: running tree totals, HashMap sizes,
+ * queue lengths and the copy/scan counters, whose deltas since the last
+ * refresh give the throughput.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _refresh(Hud *hud, double now) {
+    FileManager *fm = hud->ctx->fileManager;
+    char size[32];
+    char rate[32];
+    char sparse[32];
+
+    hud->lineCount = 0;
+
+    float frameP50, frameP99, updateP50, updateP99, drawP50, drawP99;
+    _percentiles(hud->frameMs, hud->sampleCount, &frameP50, &frameP99);
+    _percentiles(hud->updateMs, hud->sampleCount, &updateP50, &updateP99);
+    _percentiles(hud->drawMs, hud->sampleCount, &drawP50, &drawP99);
+    float frameAvg = _average(hud->frameMs, hud->sampleCount);
+    _addLine(hud, "frame  p50 %.2f ms  p99 %.2f ms  (%.0f fps)", frameP50, frameP99, frameAvg > 0 ? 1000.0f / frameAvg : 0.0f);
+    _addLine(hud, "update p50 %.2f ms  p99 %.2f ms", updateP50, updateP99);
+    _addLine(hud, "draw   p50 %.2f ms  p99 %.2f ms", drawP50, drawP99);
+
+    TreeStats tree;
+    get_tree_stats(&tree);
+    formatCopySize((long long)(tree.node_bytes + tree.children_bytes + tree.slot_bytes), size, sizeof(size));
+    _addLine(hud, "tree   %ld nodes  %s  (slots %u, %u free)", tree.live_nodes, size, tree.slots_used, tree.slots_free);
+
+    _addLine(hud, "index  trash %zu/%zu/%zu  sel %zu  racy %zu  search %d",
+             fm->trash.byUid.size, fm->trash.byOriginalPath.size, fm->trash.byItem.size,
+             fm->selectedItem.index.size, fm->racyFolders.size, fm->searchingList.length);
+
+    char redoSize[32];
+    formatCopySize((long long)undoHistoryBytes(&fm->undo), size, sizeof(size));
+    formatCopySize((long long)undoHistoryBytes(&fm->redo), redoSize, sizeof(redoSize));
+    _addLine(hud, "undo   %d (%s)  redo %d (%s)", fm->undo.entries.size, size, fm->redo.entries.size, redoSize);
+
+    // Ukuran per kategori dari counter atomik, tanpa walk tree; dua baris agar muat
+    char memLine[2][HUD_LINE_LENGTH] = { "", "" };
+    int half = (MEM_CATEGORY_COUNT + 1) / 2;
+    for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+        MemCategoryStats stats;
+        getMemStats((MemCategory)i, &stats);
+        formatCopySize(stats.bytes, size, sizeof(size));
+        char *line = memLine[i / half];
+        size_t used = strlen(line);
+        snprintf(line + used, HUD_LINE_LENGTH - used, "%s%s %s", used > 0 ? "  " : "", memCategoryName((MemCategory)i), size);
+    }
+    formatCopySize(memTotalBytes(), size, sizeof(size));
+    _addLine(hud, "mem    %s total  %s", size, memLine[0]);
+    _addLine(hud, "       %s", memLine[1]);
+
+    _addLine(hud, "jobs   purge %d  log %d  compact %s  thumb %d",
+             trashPurgerPending(&fm->trashPurger), logPendingCount(),
+             trashJournalCompacting(&fm->trashJournal) ? "running" : "idle",
+             hud->ctx->thumbnails ? thumbnailPending(hud->ctx->thumbnails) : 0);
+
+    // Throughput dari selisih counter sejak refresh terakhir
+    CopyStats copy;
+    getCopyTotals(&copy);
+    long long scanned = getScannedEntryCount();
+    double elapsed = now - hud->lastRefresh;
+    bool haveRate = hud->lastRefresh > 0 && elapsed > 0;
+
+    formatCopySize(haveRate ? (long long)((copy.dataBytes - hud->lastCopyBytes) / elapsed) : 0, rate, sizeof(rate));
+    formatCopySize(copy.dataBytes, size, sizeof(size));
+    formatCopySize(copy.sparseBytes, sparse, sizeof(sparse));
+    _addLine(hud, "copy   %s/s  (%s, %lld files total)  sparse saved %s", rate, size, copy.filesCopied, sparse);
+    _addLine(hud, "scan   %.0f entries/s  (%lld total)",
+             haveRate ? (scanned - hud->lastScanned) / elapsed : 0.0, scanned);
+
+    hud->lastCopyBytes = copy.dataBytes;
+    hud->lastScanned = scanned;
+    hud->lastRefresh = now;
+}
+
+/**
+ * @brief Computes the 50th and 99th percentile of a sample ring
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _percentiles(const float *samples, int count, float *p50, float *p99) {
+    *p50 = 0;
+    *p99 = 0;
+    if (count == 0)
+        return;
+
+    float sorted[HUD_FRAME_SAMPLES];
+    memcpy(sorted, samples, sizeof(float) * count);
+    qsort(sorted, count, sizeof(float), _compareFloat);
+    *p50 = sorted[(count - 1) / 2];
+    *p99 = sorted[(count - 1) * 99 / 100];
+}
+
+/**
+ * @brief Mean of a sample ring
+ *
+ * @internal
+ * @since 1.0
+ */
+static float _average(const float *samples, int count) {
+    if (count == 0)
+        return 0;
+
+    float sum = 0;
+    for (int i = 0; i < count; i++)
+        sum += samples[i];
+    return sum / count;
+}
+
+/**
+ * @brief Ascending float comparator for qsort
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _compareFloat(const void *a, const void *b) {
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Formats one line into the next free slot
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _addLine(Hud *hud, const char *format, ...) {
+    if (hud->lineCount >= HUD_MAX_LINES)
+        return;
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(hud->lines[hud->lineCount++], HUD_LINE_LENGTH, format, args);
+    va_end(args);
+}
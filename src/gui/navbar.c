@@ -6,11 +6,14 @@
 #include "raygui.h"
 
 #include "file_manager.h"
+#include "logger.h"
 #include "macro.h"
 
 #include "ctx.h"
 #include "gui/component.h"
+#include "gui/duplicates.h"
 #include "gui/navbar.h"
+#include "profiler.h"
 
 void trimTrailingSlash(char* path);
 
@@ -58,19 +61,19 @@ void updateNavbar(Navbar* navbar, Context* ctx) {
             ctx->fileManager->isRootTrash = true;
             ctx->fileManager->currentPath = "trash";
 
-            printf("[LOG] Opening Trash...\n");
+            logDebug("Opening Trash...\n");
             return;
         }
         else if (TextIsEqual(subPath, "root")) {
             ctx->fileManager->isRootTrash = false;
         }
 
-        Item itemToSearch = createItem(
+        Item itemToSearch = createItemKey(
             getNameFromPath(trimmedPath),
-            TextFormat("%s/%s", ".dir", trimmedPath),
-            0, ITEM_FILE, 0, 0, 0);
+            (char *)TextFormat("%s/%s", ".dir", trimmedPath),
+            ITEM_FILE);
 
-        printf("[LOG] Searching for item: %s\n", itemToSearch.path);
+        logDebug("Searching for item: %s\n", itemToSearch.path);
 
         Tree result = searchTree(root, itemToSearch);
         if (result) {
@@ -90,10 +93,12 @@ void updateNavbar(Navbar* navbar, Context* ctx) {
             return;
         }
 
+        // Pencarian biasa menggantikan hasil scan duplikat
+        closeDuplicateView(ctx->duplicates);
         ctx->fileManager->isSearching = true;
 
         if (ctx->fileManager->isRootTrash) {
-            searchingLinkedListItem(ctx->fileManager, ctx->fileManager->trash.head, navbar->textboxSearch);
+            searchingTrashItem(ctx->fileManager, navbar->textboxSearch);
         }
         else {
             searchingTreeItem(ctx->fileManager, navbar->textboxSearch);
@@ -134,6 +139,7 @@ void updateNavbar(Navbar* navbar, Context* ctx) {
 }
 
 void drawNavbar(Navbar* navbar) {
+    PROFILE_FUNCTION();
     float x = navbar->currentZeroPosition.x;
     float y = navbar->currentZeroPosition.y;
     float totalWidth = navbar->currentZeroPosition.width;
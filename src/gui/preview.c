@@ -0,0 +1,323 @@
+#include "gui/preview.h"
+#include "gui/body.h"
+#include "ctx.h"
+#include "file_manager.h"
+#include "logger.h"
+#include "macro.h"
+#include "profiler.h"
+#include "raygui.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PREVIEW_HEADER_HEIGHT 24
+#define PREVIEW_ROW_HEIGHT 14
+#define PREVIEW_FONT_SIZE 10
+#define PREVIEW_SCROLLBAR_WIDTH 10
+#define PREVIEW_MIN_THUMB 16
+#define PREVIEW_WHEEL_ROWS 3
+#define PREVIEW_GUTTER_MAX_DIGITS 20
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void _followSelection(PreviewPane *pane, FileManager *fm);          // Open the single selected file
+static void _closeFile(PreviewPane *pane);                                  // Close the file and forget its path
+static void _handleScroll(PreviewPane *pane);                               // Wheel, keys and scrollbar
+static Rectangle _textRec(const PreviewPane *pane);                         // Area of the rows
+static Rectangle _scrollbarRec(const PreviewPane *pane);                    // Scrollbar track
+static Rectangle _thumbRec(const PreviewPane *pane, long long rows);        // Scrollbar thumb
+static int _visibleRows(const PreviewPane *pane);                           // Rows that fit in the pane
+static void _drawMonospace(const char *text, float x, float y, float maxX, float advance, Color color);  // Fixed-width text
+
+/*
+================================================================================
+--------------------------------------------------------------------------------
+                                IMPLEMENTATION
+--------------------------------------------------------------------------------
+================================================================================
+*/
+
+void createPreviewPane(PreviewPane *pane, Context *ctx) {
+    memset(pane, 0, sizeof(PreviewPane));
+    pane->ctx = ctx;
+}
+
+void togglePreviewPane(PreviewPane *pane) {
+    pane->visible = !pane->visible;
+    if (!pane->visible)
+        _closeFile(pane);
+}
+
+void updatePreviewPane(PreviewPane *pane, Context *ctx) {
+    PROFILE_FUNCTION();
+    if (!pane->visible)
+        return;
+
+    // Sisi kanan body, sampai tepi kanan area kerja
+    Rectangle bodyRec = ctx->body->panelRec;
+    float left = bodyRec.x + bodyRec.width + DEFAULT_PADDING;
+    pane->bounds = (Rectangle){
+        left,
+        bodyRec.y,
+        ctx->currentZeroPosition->x + ctx->currentZeroPosition->width - left,
+        bodyRec.height};
+
+    _followSelection(pane, ctx->fileManager);
+    if (pane->fileOpen)
+        _handleScroll(pane);
+}
+
+void drawPreviewPane(PreviewPane *pane) {
+    PROFILE_FUNCTION();
+    if (!pane->visible)
+        return;
+
+    Rectangle bounds = pane->bounds;
+    Rectangle header = {bounds.x, bounds.y, bounds.width, PREVIEW_HEADER_HEIGHT};
+    DrawRectangleRec(bounds, WHITE);
+    DrawRectangleLinesEx(bounds, 1, GRAY);
+    DrawRectangleRec(header, LIGHTGRAY);
+    DrawRectangleLinesEx(header, 1, DARKGRAY);
+
+    if (pane->shownPath == NULL) {
+        GuiLabel((Rectangle){header.x + 8, header.y, header.width - 16, header.height}, "Pilih satu file untuk preview");
+        return;
+    }
+    if (!pane->fileOpen) {
+        GuiLabel((Rectangle){header.x + 8, header.y, header.width - 16, header.height},
+                 TextFormat("%s tidak bisa dibuka", GetFileName(pane->shownPath)));
+        return;
+    }
+
+    FilePreview *file = &pane->file;
+    bool complete = false;
+    long long rows = previewRowCount(file, &complete);
+    const char *info;
+    if (file->binary)
+        info = TextFormat("hex, %lld byte", file->size);
+    else if (complete)
+        info = TextFormat("%lld baris", rows);
+    else
+        info = TextFormat("%lld+ baris, mengindeks %d%%", rows, (int)(previewIndexProgress(file) * 100));
+    GuiLabel((Rectangle){header.x + 8, header.y, header.width - 16, header.height},
+             TextFormat("%s  (%s)", GetFileName(pane->shownPath), info));
+
+    Rectangle text = _textRec(pane);
+    float advance = MeasureTextEx(GuiGetFont(), "M", PREVIEW_FONT_SIZE, 1).x + 1;
+    int visibleRows = _visibleRows(pane);
+    char line[PREVIEW_PANE_LINE_LENGTH];
+
+    // Lebar gutter mengikuti nomor baris terbesar yang terlihat
+    char number[PREVIEW_GUTTER_MAX_DIGITS + 1];
+    int gutterDigits = snprintf(number, sizeof(number), "%lld", pane->firstRow + visibleRows);
+    if (gutterDigits < 4)
+        gutterDigits = 4;
+    if (gutterDigits > PREVIEW_GUTTER_MAX_DIGITS)
+        gutterDigits = PREVIEW_GUTTER_MAX_DIGITS;
+    float textX = file->binary ? text.x : text.x + (gutterDigits + 1) * advance;
+
+    BeginScissorMode(text.x, text.y, text.width, text.height);
+    for (int i = 0; i < visibleRows; i++) {
+        long long row = pane->firstRow + i;
+        int length = file->binary ? previewHexRow(file, row, line, sizeof(line))
+                                  : previewTextLine(file, row, line, sizeof(line));
+        if (length < 0)
+            break;
+
+        float y = text.y + i * PREVIEW_ROW_HEIGHT;
+        if (!file->binary) {
+            snprintf(number, sizeof(number), "%*lld", gutterDigits, row + 1);
+            _drawMonospace(number, text.x, y, textX, advance, GRAY);
+        }
+        _drawMonospace(line, textX, y, text.x + text.width, advance, DARKGRAY);
+    }
+    EndScissorMode();
+
+    if (rows > visibleRows) {
+        DrawRectangleRec(_scrollbarRec(pane), Fade(LIGHTGRAY, 0.6f));
+        DrawRectangleRec(_thumbRec(pane, rows), pane->draggingScrollbar ? DARKGRAY : GRAY);
+    }
+}
+
+void closePreviewPane(PreviewPane *pane) {
+    _closeFile(pane);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Opens the selected file when exactly one file is selected
+ *
+ * A file is reopened only when the selection moves to another path or
+ * its modification time changes, not every frame.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _followSelection(PreviewPane *pane, FileManager *fm) {
+    Item *item = NULL;
+    if (fm->selectedItem.count == 1 && fm->selectedItem.head->data->type == ITEM_FILE)
+        item = fm->selectedItem.head->data;
+
+    if (item == NULL) {
+        _closeFile(pane);
+        return;
+    }
+    if (pane->shownPath != NULL && strcmp(pane->shownPath, item->path) == 0 && pane->shownMtime == item->updated_at)
+        return;
+
+    _closeFile(pane);
+    pane->shownPath = strdup(item->path);
+    pane->shownMtime = item->updated_at;
+    pane->firstRow = 0;
+    pane->fileOpen = openFilePreview(&pane->file, item->path);
+}
+
+/**
+ * @brief Closes the previewed file and forgets its path
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _closeFile(PreviewPane *pane) {
+    if (pane->fileOpen)
+        closeFilePreview(&pane->file);
+    pane->fileOpen = false;
+    pane->draggingScrollbar = false;
+    free(pane->shownPath);
+    pane->shownPath = NULL;
+}
+
+/**
+ * @brief Moves firstRow with the wheel, PageUp/PageDown, Home/End and the scrollbar
+ *
+ * The scrollbar maps its track onto the rows available now, so dragging
+ * it to the bottom of a half-indexed file lands on the last indexed line.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _handleScroll(PreviewPane *pane) {
+    long long rows = previewRowCount(&pane->file, NULL);
+    int visibleRows = _visibleRows(pane);
+    Vector2 mouse = GetMousePosition();
+
+    if (CheckCollisionPointRec(mouse, pane->bounds)) {
+        pane->firstRow -= (long long)(GetMouseWheelMove() * PREVIEW_WHEEL_ROWS);
+        if (IsKeyPressed(KEY_PAGE_DOWN) || IsKeyPressedRepeat(KEY_PAGE_DOWN))
+            pane->firstRow += visibleRows;
+        if (IsKeyPressed(KEY_PAGE_UP) || IsKeyPressedRepeat(KEY_PAGE_UP))
+            pane->firstRow -= visibleRows;
+        if (IsKeyPressed(KEY_HOME))
+            pane->firstRow = 0;
+        if (IsKeyPressed(KEY_END))
+            pane->firstRow = rows;
+    }
+
+    Rectangle track = _scrollbarRec(pane);
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionPointRec(mouse, track))
+        pane->draggingScrollbar = true;
+    if (!IsMouseButtonDown(MOUSE_BUTTON_LEFT))
+        pane->draggingScrollbar = false;
+
+    long long maxFirst = rows > visibleRows ? rows - visibleRows : 0;
+    if (pane->draggingScrollbar && maxFirst > 0) {
+        float thumbHeight = _thumbRec(pane, rows).height;
+        float t = (mouse.y - track.y - thumbHeight / 2) / (track.height - thumbHeight);
+        t = t < 0 ? 0 : t > 1 ? 1 : t;
+        pane->firstRow = (long long)(t * maxFirst);
+    }
+
+    if (pane->firstRow > maxFirst)
+        pane->firstRow = maxFirst;
+    if (pane->firstRow < 0)
+        pane->firstRow = 0;
+}
+
+/**
+ * @brief Area below the header, left of the scrollbar
+ *
+ * @internal
+ * @since 1.0
+ */
+static Rectangle _textRec(const PreviewPane *pane) {
+    return (Rectangle){
+        pane->bounds.x + TINY_PADDING,
+        pane->bounds.y + PREVIEW_HEADER_HEIGHT + TINY_PADDING,
+        pane->bounds.width - PREVIEW_SCROLLBAR_WIDTH - TINY_PADDING * 2,
+        pane->bounds.height - PREVIEW_HEADER_HEIGHT - TINY_PADDING * 2};
+}
+
+/**
+ * @brief Scrollbar track along the right edge, below the header
+ *
+ * @internal
+ * @since 1.0
+ */
+static Rectangle _scrollbarRec(const PreviewPane *pane) {
+    return (Rectangle){
+        pane->bounds.x + pane->bounds.width - PREVIEW_SCROLLBAR_WIDTH - 1,
+        pane->bounds.y + PREVIEW_HEADER_HEIGHT,
+        PREVIEW_SCROLLBAR_WIDTH,
+        pane->bounds.height - PREVIEW_HEADER_HEIGHT - 1};
+}
+
+/**
+ * @brief Scrollbar thumb sized by the visible share of rows, never below PREVIEW_MIN_THUMB
+ *
+ * @internal
+ * @since 1.0
+ */
+static Rectangle _thumbRec(const PreviewPane *pane, long long rows) {
+    Rectangle track = _scrollbarRec(pane);
+    int visibleRows = _visibleRows(pane);
+    if (rows <= visibleRows)
+        return track;
+
+    float height = track.height * visibleRows / (float)rows;
+    if (height < PREVIEW_MIN_THUMB)
+        height = PREVIEW_MIN_THUMB;
+    float t = (float)pane->firstRow / (float)(rows - visibleRows);
+    return (Rectangle){track.x, track.y + t * (track.height - height), track.width, height};
+}
+
+/**
+ * @brief Number of whole rows in the text area
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _visibleRows(const PreviewPane *pane) {
+    int rows = (int)(_textRec(pane).height / PREVIEW_ROW_HEIGHT);
+    return rows > 0 ? rows : 0;
+}
+
+/**
+ * @brief Draws UTF-8 text with a fixed advance per codepoint, up to maxX
+ *
+ * The GUI font is proportional; a fixed advance keeps hex columns and
+ * code indentation aligned.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _drawMonospace(const char *text, float x, float y, float maxX, float advance, Color color) {
+    Font font = GuiGetFont();
+    for (int i = 0; text[i] != '\0' && x < maxX;) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(text + i, &bytes);
+        if (codepoint != ' ')
+            DrawTextCodepoint(font, codepoint, (Vector2){x, y}, PREVIEW_FONT_SIZE, color);
+        x += advance;
+        i += bytes;
+    }
+}
@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "file_manager.h"
+#include "body.h"
+#include "duplicates.h"
+#include "ctx.h"
+
+#include "logger.h"
+#include "profiler.h"
+#include "raylib.h"
+
+#include "hud.h"
+#include "navbar.h"
+#include "preview.h"
+#include "shortcut.h"
+#include "toolbar.h"
+#include "utils.h"
+
+#define CONTROL_KEY_PRESSED IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)
+#define SHIFT_KEY_PRESSED IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)
+#define ALT_KEY_PRESSED IsKeyDown(KEY_LEFT_ALT) || IsKeyDown(KEY_RIGHT_ALT)
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+// Shortcuts
+static void _handleClipboardOperations(Context* ctx);       // Handle CTRL+C, CTRL+V, CTRL+X shortcuts
+static void _handleUndoRedoOperations(Context* ctx);        // Handle CTRL+Z, CTRL+Y shortcuts
+static void _handleDeleteOperation(Context* ctx);           // Handle DELETE key or CTRL+DELETE shortcut
+static void _handleRenameOperation(Context* ctx);           // Handle F2 key for renaming
+static void _handleRefreshOperation(Context* ctx);          // Handle F5 key or CTRL+R for refreshing
+static void _handleBackNavigation(Context* ctx);            // Handle BACKSPACE or ALT+LEFT for navigating back
+static void _handleSelectAllOperation(Context* ctx);        // Handle CTRL+A for selecting all items
+static void _handleNewItemOperations(Context* ctx);         // Handle CTRL+N for new file, CTRL+SHIFT+N for new folder
+static void _handleSearchAndPathOperations(Context* ctx);   // Handle CTRL+F for search and CTRL+L for path edit mode
+static void _handleArrowNavigation(Context* ctx);           // Handle arrow keys for navigating through items
+static void _handleEnterKey(Context* ctx);                  // Handle Enter key for folder/file opening
+static void _handleProfilerToggle(void);                    // Handle F9 to start/stop a trace capture
+static void _handleHudToggle(Context* ctx);                 // Handle F3 to show/hide the performance overlay
+static void _handleViewToggle(Context* ctx);                // Handle CTRL+G to switch between details and grid view
+static void _handlePreviewToggle(Context* ctx);             // Handle F4 to show/hide the preview pane
+static void _handleDuplicateScan(Context* ctx);             // Handle CTRL+D to find duplicates below the current folder
+
+// Utilities
+static int _getTotalItems(Context* ctx);                    // Count total items in current directory
+static void _selectItemAtIndex(Context* ctx, int index);    // Select item at a specific index
+
+/*
+================================================================================
+--------------------------------------------------------------------------------
+                                IMPLEMENTATION
+--------------------------------------------------------------------------------
+================================================================================
+*/
+
+void ShortcutKeys(Context* ctx) {
+    PROFILE_FUNCTION();
+    _handleClipboardOperations(ctx);
+    _handleUndoRedoOperations(ctx);
+    _handleDeleteOperation(ctx);
+    _handleRenameOperation(ctx);
+    _handleRefreshOperation(ctx);
+    _handleBackNavigation(ctx);
+    _handleSelectAllOperation(ctx);
+    _handleNewItemOperations(ctx);
+    _handleSearchAndPathOperations(ctx);
+    _handleArrowNavigation(ctx);
+    _handleEnterKey(ctx);
+    _handleProfilerToggle();
+    _handleHudToggle(ctx);
+    _handleViewToggle(ctx);
+    _handlePreviewToggle(ctx);
+    _handleDuplicateScan(ctx);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - SHORTCUTS OPERATIONS
+================================================================================
+*/
+
+static void _handleClipboardOperations(Context* ctx) {
+    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_C)) {
+        copyFile(ctx->fileManager);
+    }
+
+    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_V)) {
+        pasteFile(ctx->fileManager, true);
+    }
+
+    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_X)) {
+        cutFile(ctx->fileManager);
+    }
+}
+
+static void _handleUndoRedoOperations(Context* ctx) {
+    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_Z)) {
+        if (ctx->fileManager != NULL) {
+            undo(ctx->fileManager);
+            logDebug("Undo shortcut activated\n");
+        }
+    }
+
+    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_Y)) {
+        if (ctx->fileManager != NULL) {
+            redo(ctx->fileManager);
+            logDebug("Redo shortcut activated\n");
+        }
+    }
+}
+
+static void _handleDeleteOperation(Context* ctx) {
+    if (IsKeyPressed(KEY_DELETE) || ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_DELETE))) {
+        ctx->toolbar->isButtonDeleteClicked = true;
+        logDebug("Delete shortcut activated\n");
+    }
+}
+
+static void _handleRenameOperation(Context* ctx) {
+    if (IsKeyPressed(KEY_F2)) {
+        if (ctx->fileManager != NULL && ctx->fileManager->selectedItem.head != NULL) {
+            Item* selectedItem = (Item*)ctx->fileManager->selectedItem.head->data;
+            if (selectedItem != NULL) {
+                logDebug("Rename shortcut activated for: %s\n", selectedItem->name);
+                // renameFile(ctx->fileManager, selectedItem->path, "new_name"); // Implement proper rename UI
+            }
+        }
+    }
+}
+
+static void _handleRefreshOperation(Context* ctx) {
+    if (IsKeyPressed(KEY_F5) || ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_R))) {
+        syncFileManager(ctx->fileManager);
+    }
+}
+
+static void _handleProfilerToggle(void) {
+    if (!IsKeyPressed(KEY_F9)) {
+        return;
+    }
+    if (!profilerRecording()) {
+        profilerStart();
+        return;
+    }
+
+    // Trace disimpan di .dir dengan nama berdasarkan waktu
+    profilerStop();
+    char stamp[32];
+    time_t now = time(NULL);
+    strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+    profilerExport(formatText(".dir/trace-%s.json", stamp));
+}
+
+static void _handleHudToggle(Context* ctx) {
+    if (IsKeyPressed(KEY_F3)) {
+        toggleHud(ctx->hud);
+    }
+}
+
+static void _handleViewToggle(Context* ctx) {
+    if (!ctx->disableGroundClick && (CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_G)) {
+        toggleBodyViewMode(ctx->body);
+    }
+}
+
+static void _handlePreviewToggle(Context* ctx) {
+    if (!ctx->disableGroundClick && IsKeyPressed(KEY_F4)) {
+        togglePreviewPane(ctx->preview);
+    }
+}
+
+static void _handleDuplicateScan(Context* ctx) {
+    if (!ctx->disableGroundClick && !ctx->fileManager->isRootTrash && (CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_D)) {
+        startDuplicateView(ctx->duplicates, ctx->fileManager->treeCursor);
+    }
+}
+
+static void _handleBackNavigation(Context* ctx) {
+    if (!ctx->disableGroundClick &&
+        !ctx->navbar->textboxPatheditMode &&
+        !ctx->navbar->textboxSearcheditMode &&
+        (IsKeyPressed(KEY_BACKSPACE) || (IsKeyDown(KEY_LEFT_ALT) && IsKeyPressed(KEY_LEFT)))) {
+        if (ctx->fileManager != NULL &&
+            ctx->fileManager->treeCursor != NULL &&
+            ctx->fileManager->treeCursor->parent != NULL) {
+            goBack(ctx->fileManager);
+        }
+    }
+}
+
+static void _handleSelectAllOperation(Context* ctx) {
+    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_A)) {
+        if (ctx->fileManager != NULL && ctx->fileManager->treeCursor != NULL) {
+            if (!ctx->body->selectedAll) {
+                selectAll(ctx->fileManager);
+                ctx->body->selectedAll = true;
+            }
+            else {
+                clearSelectedFile(ctx->fileManager);
+                ctx->body->selectedAll = false;
+            }
+            logDebug("Select all shortcut activated\n");
+        }
+    }
+}
+
+static void _handleNewItemOperations(Context* ctx) {
+    // NEW FOLDER (Ctrl + Shift + N)
+    if ((CONTROL_KEY_PRESSED) && (SHIFT_KEY_PRESSED) && IsKeyPressed(KEY_N)) {
+        ctx->toolbar->selectedType = ITEM_FOLDER;
+        ctx->disableGroundClick = true;
+        if (!ctx->disableGroundClick) {
+            char* name = ctx->toolbar->inputCreateItemBuffer;
+            const char* dirPath = TextFormat(".dir/%s", ctx->fileManager->currentPath);
+            createFile(ctx->fileManager, ITEM_FOLDER, dirPath, name, true);
+        }
+    }
+
+    // NEW FILE (Ctrl + N)
+    if (!ctx->disableGroundClick &&
+        (CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_N) && !(SHIFT_KEY_PRESSED)) {
+        ctx->navbar->textboxPatheditMode = false;
+        ctx->navbar->textboxSearcheditMode = false;
+        if (ctx->fileManager != NULL) {
+            ctx->toolbar->selectedType = ITEM_FILE;
+            ctx->disableGroundClick = true;
+            if (!ctx->disableGroundClick) {
+                char* name = ctx->toolbar->inputCreateItemBuffer;
+                const char* dirPath = TextFormat(".dir/%s", ctx->fileManager->currentPath);
+                createFile(ctx->fileManager, ITEM_FILE, dirPath, name, true);
+            }
+        }
+    }
+}
+
+static void _handleSearchAndPathOperations(Context* ctx) {
+    // CTRL+F / FIND
+    if (!ctx->disableGroundClick && (CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_F)) {
+        ctx->navbar->textboxPatheditMode = false;
+        ctx->disableGroundClick = false;
+        if (ctx->navbar->textboxSearcheditMode) {
+            ctx->navbar->textboxSearcheditMode = false;
+            logDebug("Search mode deactivated\n");
+        }
+        else {
+            ctx->navbar->textboxSearcheditMode = true;
+            logDebug("Search mode activated\n");
+        }
+    }
+
+    // CTRL+L / ADDRESS/PATH
+    if (!ctx->disableGroundClick && (CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_L)) {
+        ctx->navbar->textboxSearcheditMode = false;
+        ctx->disableGroundClick = false;
+        if (ctx->navbar->textboxPatheditMode) {
+            ctx->navbar->textboxPatheditMode = false;
+            logDebug("Path edit mode deactivated\n");
+        }
+        else {
+            ctx->navbar->textboxPatheditMode = true;
+            logDebug("Path edit mode activated\n");
+        }
+    }
+}
+
+static void _handleArrowNavigation(Context* ctx) {
+    if (!ctx->navbar->textboxPatheditMode && !ctx->navbar->textboxSearcheditMode && !ctx->disableGroundClick) {
+        if (IsKeyPressed(KEY_UP)) {
+            if (ctx->body->focusedIndex > 0) {
+                ctx->body->focusedIndex--;
+                _selectItemAtIndex(ctx, ctx->body->focusedIndex);
+                logDebug("Arrow up navigation - index: %d\n", ctx->body->focusedIndex);
+            }
+        }
+
+        if (IsKeyPressed(KEY_DOWN)) {
+            int totalItems = _getTotalItems(ctx);
+            if (ctx->body->focusedIndex < totalItems - 1) {
+                ctx->body->focusedIndex++;
+                _selectItemAtIndex(ctx, ctx->body->focusedIndex);
+                logDebug("Arrow down navigation - index: %d\n", ctx->body->focusedIndex);
+            }
+        }
+    }
+}
+
+static void _handleEnterKey(Context* ctx) {
+    if (!ctx->navbar->textboxPatheditMode && !ctx->navbar->textboxSearcheditMode && !ctx->disableGroundClick) {
+        if (IsKeyPressed(KEY_ENTER)) {
+            if (ctx->body->focusedIndex >= 0) {
+                Tree cursor = get_child(ctx->fileManager->treeCursor, ctx->body->focusedIndex);
+
+                if (cursor != NULL) {
+                    Item item = cursor->item;
+
+                    if (item.type == ITEM_FOLDER) {
+                        goTo(ctx->fileManager, cursor);
+                        ctx->body->focusedIndex = 0;
+                        logDebug("Keyboard action - enter folder: %s\n", item.name);
+                    }
+                    else if (item.type == ITEM_FILE) {
+                        windowsOpenWith(item.path);
+                        logDebug("Keyboard action - open file: %s\n", item.name);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void _selectItemAtIndex(Context* ctx, int index) {
+    clearSelectedFile(ctx->fileManager);
+
+    Tree cursor = get_child(ctx->fileManager->treeCursor, index);
+    if (cursor != NULL) {
+        cursor->item.selected = true;
+        selectFile(ctx->fileManager, &cursor->item);
+    }
+}
+
+static int _getTotalItems(Context* ctx) {
+    return get_child_count(ctx->fileManager->treeCursor);
+}
@@ -7,61 +7,96 @@
 #include "gui/component.h"
 #include "gui/navbar.h"
 #include "gui/sidebar.h"
+#include "logger.h"
 #include "macro.h"
+#include "mem_stats.h"
+#include "profiler.h"
 #include "raygui.h"
 
 // SidebarItem Management
 SidebarItem *createSidebarItem(Tree root) {
-    if (root == NULL)
-        return NULL;
-
-    SidebarItem *sidebarItem = malloc(sizeof(SidebarItem));
-    sidebarItem->tree = root;
-    sidebarItem->isExpanded = false;
-    sidebarItem->first_son = createSidebarItem(root->first_son);
-    sidebarItem->next_brother = createSidebarItem(root->next_brother);
-    return sidebarItem;
+    return createSidebarItemWithState(root, NULL);
 }
 
 SidebarItem *createSidebarItemWithState(Tree root, SidebarState *stateList) {
-    if (root == NULL)
-        return NULL;
-
-    SidebarItem *sidebarItem = malloc(sizeof(SidebarItem));
-    sidebarItem->tree = root;
-    sidebarItem->isExpanded = getExpandedForTree(root, stateList);
-    sidebarItem->first_son = createSidebarItemWithState(root->first_son, stateList);
-    sidebarItem->next_brother = createSidebarItemWithState(root->next_brother, stateList);
-    return sidebarItem;
+    SidebarItem *result = NULL;
+    // lastAtDepth[d]: item terakhir di kedalaman d milik parent yang sedang dibangun
+    SidebarItem **lastAtDepth = NULL;
+    int depthCapacity = 0;
+
+    TreeIterator it;
+    tree_iter_init(&it, root, TREE_PRE_ORDER);
+
+    Tree node;
+    while ((node = tree_iter_next(&it)) != NULL) {
+        int depth = it.depth;
+        if (depth + 1 >= depthCapacity) {
+            int capacity = depthCapacity ? depthCapacity * 2 : 16;
+            SidebarItem **grown = realloc(lastAtDepth, sizeof(SidebarItem *) * capacity);
+            if (grown == NULL)
+                break;
+            lastAtDepth = grown;
+            depthCapacity = capacity;
+        }
+
+        SidebarItem *sidebarItem = malloc(sizeof(SidebarItem));
+        if (sidebarItem == NULL)
+            break;
+        memTrackAlloc(MEM_SIDEBAR, sidebarItem);
+        sidebarItem->handle = get_node_handle(node);
+        sidebarItem->isExpanded = getExpandedForTree(node, stateList);
+        sidebarItem->first_son = NULL;
+        sidebarItem->next_brother = NULL;
+
+        if (depth == 0)
+            result = sidebarItem;
+        else if (lastAtDepth[depth] != NULL)
+            lastAtDepth[depth]->next_brother = sidebarItem;
+        else
+            lastAtDepth[depth - 1]->first_son = sidebarItem;
+
+        lastAtDepth[depth] = sidebarItem;
+        lastAtDepth[depth + 1] = NULL;
+    }
+
+    tree_iter_destroy(&it);
+    free(lastAtDepth);
+    return result;
 }
 
 void destroySidebarItem(SidebarItem **item) {
-    if (item == NULL || *item == NULL)
+    if (item == NULL)
         return;
 
-    destroySidebarItem(&(*item)->first_son);
-    destroySidebarItem(&(*item)->next_brother);
-    free(*item);
+    // Saudara diproses iteratif; rekursi hanya sedalam pohon folder
+    SidebarItem *current = *item;
+    while (current) {
+        SidebarItem *next = current->next_brother;
+        destroySidebarItem(&current->first_son);
+        memTrackFree(MEM_SIDEBAR, current);
+        free(current);
+        current = next;
+    }
     *item = NULL;
 }
 
 void collectSidebarState(SidebarItem *item, SidebarState **stateList) {
-    if (item == NULL)
-        return;
-
-    SidebarState *state = malloc(sizeof(SidebarState));
-    state->treeNode = item->tree;
-    state->isExpanded = item->isExpanded;
-    state->next = *stateList;
-    *stateList = state;
-
-    collectSidebarState(item->first_son, stateList);
-    collectSidebarState(item->next_brother, stateList);
+    for (; item != NULL; item = item->next_brother) {
+        SidebarState *state = malloc(sizeof(SidebarState));
+        memTrackAlloc(MEM_SIDEBAR, state);
+        state->handle = item->handle;
+        state->isExpanded = item->isExpanded;
+        state->next = *stateList;
+        *stateList = state;
+
+        collectSidebarState(item->first_son, stateList);
+    }
 }
 
 bool getExpandedForTree(Tree tree, SidebarState *stateList) {
+    NodeHandle handle = get_node_handle(tree);
     while (stateList) {
-        if (stateList->treeNode == tree)
+        if (node_handle_equals(stateList->handle, handle))
             return stateList->isExpanded;
         stateList = stateList->next;
     }
@@ -73,10 +108,31 @@ void destroySidebarState(SidebarState *stateList) {
     while (stateList) {
         tmp = stateList;
         stateList = stateList->next;
+        memTrackFree(MEM_SIDEBAR, tmp);
         free(tmp);
     }
 }
 
+void rebuildSidebar(Sidebar *sidebar, Tree root) {
+    if (!sidebar)
+        return;
+
+    // Collect state sebelum destroy
+    SidebarState *stateList = NULL;
+    if (sidebar->sidebarRoot) {
+        collectSidebarState(sidebar->sidebarRoot, &stateList);
+        destroySidebarItem(&sidebar->sidebarRoot);
+    }
+
+    // Rebuild dengan state yang tersimpan
+    sidebar->sidebarRoot = createSidebarItemWithState(root, stateList);
+
+    // Cleanup state
+    if (stateList) {
+        destroySidebarState(stateList);
+    }
+}
+
 // Sidebar lifecycle
 void createSidebar(Sidebar *sidebar, Context *ctx) {
     sidebar->ctx = ctx;
@@ -110,7 +166,7 @@ void updateSidebar(Sidebar *sidebar, Context *ctx) {
         strcpy(sidebar->ctx->navbar->textboxPath, "trash");
         sidebar->ctx->fileManager->currentPath = "trash";
         sidebar->ctx->fileManager->isRootTrash = true;
-        printf("[LOG] Opening Trash...\n");
+        logDebug("Opening Trash...\n");
     }
 
     if (sidebar->isButtonGoBackClicked) {
@@ -120,11 +176,12 @@ void updateSidebar(Sidebar *sidebar, Context *ctx) {
         strcpy(sidebar->ctx->navbar->textboxPath, "root");
         sidebar->ctx->fileManager->currentPath = "root";
         sidebar->ctx->fileManager->isRootTrash = false;
-        printf("[LOG] Going back to root...\n");
+        logDebug("Going back to root...\n");
     }
 }
 
 void drawSidebar(Sidebar *sidebar) {
+    PROFILE_FUNCTION();
     float itemHeight = 24;
     Vector2 scroll = sidebar->panelScroll;
 
@@ -182,9 +239,10 @@ void drawSidebar(Sidebar *sidebar) {
 
 void drawSidebarItem(Sidebar *sidebar, SidebarItem *node, FileManager *fileManager, Vector2 *pos, int depth, float width, float height, float *scrollWidth) {
     while (node) {
-        Tree itemNode = node->tree;
+        // Node yang sudah dihapus dilewati sampai sidebar dibangun ulang
+        Tree itemNode = resolve_node_handle(node->handle);
 
-        if (itemNode->item.type == ITEM_FOLDER) {
+        if (itemNode != NULL && itemNode->item.type == ITEM_FOLDER) {
             float indent = (DEFAULT_PADDING * 2) * depth;
             const char *arrow = node->isExpanded ? "#116#" : "#115#";
             const char *label = TextFormat("%s %s", arrow, itemNode->item.name);
@@ -206,7 +264,7 @@ void drawSidebarItem(Sidebar *sidebar, SidebarItem *node, FileManager *fileManag
                         if (CheckCollisionPointRec(mouse, (Rectangle){labelBounds.x, labelBounds.y, 20, height}) && itemNode->first_son) {
                             node->isExpanded = !node->isExpanded;
                         } else {
-                            goTo(sidebar->ctx->fileManager, itemNode);
+                            goToHandle(sidebar->ctx->fileManager, node->handle);
                             sidebar->ctx->fileManager->isRootTrash = false;
                         }
                     }
@@ -0,0 +1,329 @@
+#include "gui/thumbnail.h"
+#include "logger.h"
+#include "profiler.h"
+#include "utils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define THUMB_EXTENSIONS ".png;.jpg;.jpeg;.bmp;.tga;.gif;.qoi"
+#define THUMB_KEY_LENGTH 1100
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void *_decodeWorker(void *arg);                                    // Decoder thread loop
+static void _decode(ThumbEntry *entry);                                   // Load, downscale and cache one image
+static void _diskPath(const char *key, char *out, size_t size);           // .dir/thumbs/<hash>.png
+static void _lruPushFront(ThumbnailCache *cache, ThumbEntry *entry);      // Insert as most recent
+static void _lruUnlink(ThumbnailCache *cache, ThumbEntry *entry);         // Remove from the LRU list
+static void _freeEntry(ThumbEntry *entry);                                // Free pixels, texture and strings
+
+/*
+================================================================================
+--------------------------------------------------------------------------------
+                                IMPLEMENTATION
+--------------------------------------------------------------------------------
+================================================================================
+*/
+
+void createThumbnailCache(ThumbnailCache *cache, int capacity) {
+    memset(cache, 0, sizeof(ThumbnailCache));
+    create_string_hashmap(&cache->byKey);
+    cache->capacity = capacity > 0 ? capacity : THUMB_CACHE_CAPACITY;
+    create_queue(&cache->jobs);
+    create_queue(&cache->done);
+    pthread_mutex_init(&cache->lock, NULL);
+    pthread_cond_init(&cache->wake, NULL);
+
+    if (!directoryExists(THUMB_DISK_DIR))
+        makeDirectory(THUMB_DISK_DIR);
+
+    for (int i = 0; i < THUMB_WORKERS; i++) {
+        if (pthread_create(&cache->workers[i], NULL, _decodeWorker, cache) != 0) {
+            logWarn("Gagal memulai decoder thumbnail ke-%d\n", i + 1);
+            break;
+        }
+        cache->workerCount++;
+    }
+}
+
+void destroyThumbnailCache(ThumbnailCache *cache) {
+    pthread_mutex_lock(&cache->lock);
+    cache->stopping = true;
+    pthread_cond_broadcast(&cache->wake);
+    pthread_mutex_unlock(&cache->lock);
+    for (int i = 0; i < cache->workerCount; i++)
+        pthread_join(cache->workers[i], NULL);
+
+    // Setelah join tidak ada thread lain; semua entry ada di antrian atau di LRU
+    while (!is_queue_empty(cache->jobs))
+        _freeEntry(dequeue(&cache->jobs));
+    while (!is_queue_empty(cache->done))
+        _freeEntry(dequeue(&cache->done));
+    while (cache->mostRecent != NULL) {
+        ThumbEntry *entry = cache->mostRecent;
+        _lruUnlink(cache, entry);
+        _freeEntry(entry);
+    }
+
+    logInfo("Thumbnail: %lld texture diupload, %lld dibuang LRU\n", cache->uploaded, cache->evicted);
+    destroy_hashmap(&cache->byKey);
+    pthread_cond_destroy(&cache->wake);
+    pthread_mutex_destroy(&cache->lock);
+}
+
+bool isThumbnailCandidate(const Item *item) {
+    if (item->type != ITEM_FILE || item->size <= 0 || item->size > THUMB_MAX_SOURCE_BYTES)
+        return false;
+    return IsFileExtension(item->name, THUMB_EXTENSIONS);
+}
+
+const Texture2D *requestThumbnail(ThumbnailCache *cache, const char *path, time_t mtime) {
+    char key[THUMB_KEY_LENGTH];
+    snprintf(key, sizeof(key), "%lld:%s", (long long)mtime, path);
+
+    ThumbEntry *entry = hashmap_get(&cache->byKey, key);
+    if (entry != NULL) {
+        if (entry->state != THUMB_READY)
+            return NULL;
+        // Digambar frame ini: pindah ke depan LRU
+        if (cache->mostRecent != entry) {
+            _lruUnlink(cache, entry);
+            _lruPushFront(cache, entry);
+        }
+        return &entry->texture;
+    }
+
+    entry = calloc(1, sizeof(ThumbEntry));
+    if (entry == NULL)
+        return NULL;
+    entry->key = strdup(key);
+    entry->path = strdup(path);
+    entry->state = THUMB_QUEUED;
+    hashmap_put(&cache->byKey, entry->key, entry);
+
+    ThumbEntry *dropped = NULL;
+    pthread_mutex_lock(&cache->lock);
+    // Antrian penuh (scroll cepat): buang request tertua, baris itu sudah tidak terlihat
+    if (cache->jobs.length >= THUMB_MAX_PENDING)
+        dropped = dequeue(&cache->jobs);
+    enqueue(&cache->jobs, entry);
+    pthread_cond_signal(&cache->wake);
+    pthread_mutex_unlock(&cache->lock);
+
+    if (dropped != NULL) {
+        hashmap_remove(&cache->byKey, dropped->key);
+        _freeEntry(dropped);
+    }
+    return NULL;
+}
+
+void uploadThumbnails(ThumbnailCache *cache, int budget) {
+    PROFILE_FUNCTION();
+
+    // Tanpa decoder thread, decode satu gambar per frame di sini
+    if (cache->workerCount == 0 && !is_queue_empty(cache->jobs)) {
+        ThumbEntry *entry = dequeue(&cache->jobs);
+        _decode(entry);
+        enqueue(&cache->done, entry);
+    }
+
+    for (int i = 0; i < budget; i++) {
+        pthread_mutex_lock(&cache->lock);
+        ThumbEntry *entry = is_queue_empty(cache->done) ? NULL : dequeue(&cache->done);
+        pthread_mutex_unlock(&cache->lock);
+        if (entry == NULL)
+            break;
+
+        if (entry->image.data != NULL) {
+            entry->texture = LoadTextureFromImage(entry->image);
+            UnloadImage(entry->image);
+            entry->image = (Image){0};
+            SetTextureFilter(entry->texture, TEXTURE_FILTER_BILINEAR);
+            entry->state = entry->texture.id != 0 ? THUMB_READY : THUMB_FAILED;
+            cache->uploaded++;
+        } else {
+            entry->state = THUMB_FAILED;
+        }
+        _lruPushFront(cache, entry);
+    }
+
+    while (cache->cached > cache->capacity) {
+        ThumbEntry *victim = cache->leastRecent;
+        _lruUnlink(cache, victim);
+        hashmap_remove(&cache->byKey, victim->key);
+        if (victim->state == THUMB_READY)
+            cache->evicted++;
+        _freeEntry(victim);
+    }
+}
+
+int thumbnailPending(ThumbnailCache *cache) {
+    pthread_mutex_lock(&cache->lock);
+    int pending = cache->jobs.length + cache->done.length;
+    pthread_mutex_unlock(&cache->lock);
+    return pending;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Decoder loop: takes the next queued entry and hands it back decoded
+ *
+ * Runs below normal priority so decoding a folder of photos does not
+ * compete with the UI thread.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void *_decodeWorker(void *arg) {
+    ThumbnailCache *cache = (ThumbnailCache *)arg;
+    PROFILE_THREAD_NAME("thumbnail");
+#ifdef __linux__
+    setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 10);
+#endif
+
+    while (true) {
+        pthread_mutex_lock(&cache->lock);
+        while (is_queue_empty(cache->jobs) && !cache->stopping)
+            pthread_cond_wait(&cache->wake, &cache->lock);
+        if (cache->stopping) {
+            pthread_mutex_unlock(&cache->lock);
+            break;
+        }
+        ThumbEntry *entry = dequeue(&cache->jobs);
+        pthread_mutex_unlock(&cache->lock);
+
+        _decode(entry);
+
+        pthread_mutex_lock(&cache->lock);
+        enqueue(&cache->done, entry);
+        pthread_mutex_unlock(&cache->lock);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Loads one thumbnail from the disk cache, or decodes and downscales the source
+ *
+ * A freshly made thumbnail is written back as PNG so the next session
+ * reads a few KB instead of decoding the original. Only entry->image is
+ * written; the state is left to the main thread. On failure image.data
+ * stays NULL.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _decode(ThumbEntry *entry) {
+    PROFILE_FUNCTION();
+    char diskPath[256];
+    _diskPath(entry->key, diskPath, sizeof(diskPath));
+
+    if (FileExists(diskPath)) {
+        entry->image = LoadImage(diskPath);
+        if (entry->image.data != NULL)
+            return;
+    }
+
+    Image image = LoadImage(entry->path);
+    if (image.data == NULL) {
+        logDebug("Thumbnail gagal: %s\n", entry->path);
+        return;
+    }
+
+    // Perkecil dengan rasio tetap; gambar kecil tidak diperbesar
+    int longest = image.width > image.height ? image.width : image.height;
+    if (longest > THUMB_SIZE) {
+        int width = image.width * THUMB_SIZE / longest;
+        int height = image.height * THUMB_SIZE / longest;
+        ImageResize(&image, width > 0 ? width : 1, height > 0 ? height : 1);
+    }
+    if (!ExportImage(image, diskPath))
+        logDebug("Thumbnail tidak tersimpan ke %s\n", diskPath);
+
+    entry->image = image;
+}
+
+/**
+ * @brief Disk cache file of a key: FNV-1a 64 of "mtime:path" in hex
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _diskPath(const char *key, char *out, size_t size) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (const unsigned char *c = (const unsigned char *)key; *c; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
+    }
+    snprintf(out, size, "%s/%016llx.png", THUMB_DISK_DIR, (unsigned long long)hash);
+}
+
+/**
+ * @brief Inserts an entry at the most recently used end
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _lruPushFront(ThumbnailCache *cache, ThumbEntry *entry) {
+    entry->prev = NULL;
+    entry->next = cache->mostRecent;
+    if (cache->mostRecent != NULL)
+        cache->mostRecent->prev = entry;
+    else
+        cache->leastRecent = entry;
+    cache->mostRecent = entry;
+    cache->cached++;
+}
+
+/**
+ * @brief Unlinks an entry from the LRU list
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _lruUnlink(ThumbnailCache *cache, ThumbEntry *entry) {
+    if (entry->prev != NULL)
+        entry->prev->next = entry->next;
+    else
+        cache->mostRecent = entry->next;
+    if (entry->next != NULL)
+        entry->next->prev = entry->prev;
+    else
+        cache->leastRecent = entry->prev;
+    entry->prev = NULL;
+    entry->next = NULL;
+    cache->cached--;
+}
+
+/**
+ * @brief Releases the pixels, the texture and the strings of an entry
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _freeEntry(ThumbEntry *entry) {
+    if (entry->image.data != NULL)
+        UnloadImage(entry->image);
+    if (entry->state == THUMB_READY)
+        UnloadTexture(entry->texture);
+    free(entry->key);
+    free(entry->path);
+    free(entry);
+}
@@ -3,6 +3,7 @@
 #include "ctx.h"
 #include "macro.h"
 #include "navbar.h"
+#include "profiler.h"
 #include "raygui.h"
 #include "sidebar.h"
 #include "titlebar.h"
@@ -212,6 +213,7 @@ void updateTitleBar(TitleBar *titleBar, Context *ctx) {
 }
 
 void drawTitleBar(TitleBar *titleBar) {
+    PROFILE_FUNCTION();
     titleBar->exitWindow = GuiWindowBox((Rectangle){0, 0, titleBar->screenWidth, titleBar->screenHeight}, "#198# PORTABLE WINDOW");
 
     GuiSetStyle(BUTTON, BORDER_WIDTH, 1);
@@ -1,10 +1,14 @@
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "ctx.h"
+#include "gui/body.h"
 #include "gui/component.h"
 #include "gui/sidebar.h"
 #include "gui/toolbar.h"
+#include "logger.h"
+#include "profiler.h"
 #include "win_utils.h" // Include Windows utils
 
 #include "macro.h"
@@ -24,6 +28,7 @@ void createToolbar(Toolbar *toolbar, Context *ctx) {
     toolbar->isButtonPermanentDeleteClicked = false;
     toolbar->isButtonImportClicked = false;
     toolbar->isButtonCreateItemClicked = false;
+    toolbar->isButtonViewClicked = false;
 
     toolbar->showCreateModal = false;
     toolbar->createItemModalResult = false;
@@ -82,7 +87,7 @@ void updateToolbar(Toolbar *toolbar, Context *ctx) {
         if (ctx->fileManager->isRootTrash) {
             deletePermanentFile(ctx->fileManager);
         } else {
-            printf("[ERROR] Permanent delete can only be used in Trash.\n");
+            logError("Permanent delete can only be used in Trash.\n");
         }
     }
 
@@ -93,7 +98,7 @@ void updateToolbar(Toolbar *toolbar, Context *ctx) {
 
     if (toolbar->createItemModalResult) {
         char *name = toolbar->inputCreateItemBuffer;
-        char *dirPath = ctx->fileManager->treeCursor
+        const char *dirPath = ctx->fileManager->treeCursor
             ? ctx->fileManager->treeCursor->item.path
             : TextFormat(".dir/%s", ctx->fileManager->currentPath);
         createFile(ctx->fileManager, toolbar->selectedType, dirPath, name, true);
@@ -127,24 +132,30 @@ void updateToolbar(Toolbar *toolbar, Context *ctx) {
         Item *item = ctx->fileManager->selectedItem.head ? (Item *)ctx->fileManager->selectedItem.head->data : NULL;
 
         if (item && strlen(newName) > 0) {
-            char *filePath = TextFormat(".dir/%s/%s", ctx->fileManager->currentPath, item->name);
+            char *filePath = strdup(TextFormat(".dir/%s/%s", ctx->fileManager->currentPath, item->name));
             printf("Renaming %s → %s\n", filePath, newName);
 
             renameFile(ctx->fileManager, filePath, newName, true);
+            free(filePath);
         } else {
-            printf("[ERROR] No item selected or empty new name.\n");
+            logError("No item selected or empty new name.\n");
         }
 
         toolbar->renameInputBuffer[0] = '\0';
         toolbar->renameModalResult = false;
     }
 
+    if (toolbar->isButtonViewClicked) {
+        toolbar->isButtonViewClicked = false;
+        toggleBodyViewMode(ctx->body);
+    }
+
     // Menambahkan handling untuk import
     if (toolbar->isButtonImportClicked) {
         toolbar->isButtonImportClicked = false;
         toolbar->showImportModal = true;
         toolbar->importPath[0] = '\0'; // Clear path
-        printf("[LOG] Import modal activated\n");
+        logDebug("Import modal activated\n");
     }
 
     // Handle import modal result
@@ -153,7 +164,7 @@ void updateToolbar(Toolbar *toolbar, Context *ctx) {
 
         if (strlen(toolbar->importPath) > 0) {
             importFile(ctx->fileManager, toolbar->importPath, true);
-            printf("[LOG] Import file operation would execute: %s\n", toolbar->importPath);
+            logDebug("Import file operation would execute: %s\n", toolbar->importPath);
         }
 
         // Clear after use
@@ -162,16 +173,17 @@ void updateToolbar(Toolbar *toolbar, Context *ctx) {
 }
 
 void drawToolbar(Toolbar *toolbar) {
+    PROFILE_FUNCTION();
     float x = toolbar->currentZeroPosition.x;
     float y = toolbar->currentZeroPosition.y;
     float width = toolbar->currentZeroPosition.width;
 
     int rightStartx = x + width;
-    int selectedItemCount = get_length(toolbar->ctx->fileManager->selectedItem);
+    int selectedItemCount = toolbar->ctx->fileManager->selectedItem.count;
 
     GuiLine((Rectangle){toolbar->currentZeroPosition.x, toolbar->currentZeroPosition.y + 24, toolbar->currentZeroPosition.width, 10}, NULL);
 
-    // printf("[LOG] Selected Item Count: %d, boolean: %d\n", selectedItemCount, selectedItemCount <= 0);
+    // logDebug("Selected Item Count: %d, boolean: %d\n", selectedItemCount, selectedItemCount <= 0);
 
     if (!toolbar->ctx->fileManager->isRootTrash) {
         toolbar->isButtonCreateItemClicked = GuiButtonCustom((Rectangle){x, y, 100, 24}, "#65# New", "Create Item", false, toolbar->ctx->disableGroundClick);
@@ -193,6 +205,10 @@ void drawToolbar(Toolbar *toolbar) {
         x += 24 + DEFAULT_PADDING;
         toolbar->isButtonImportClicked = GuiButtonCustom((Rectangle){x, y, 50, 24}, "#132#", "IMPORT", false, toolbar->ctx->disableGroundClick);
 
+        // Ikon menunjukkan mode tujuan: grid saat di tabel, list saat di grid
+        x += 50 + DEFAULT_PADDING;
+        toolbar->isButtonViewClicked = GuiButtonCustom((Rectangle){x, y, 24, 24}, toolbar->ctx->body->viewMode == BODY_VIEW_GRID ? "#214#" : "#97#", "VIEW", false, toolbar->ctx->disableGroundClick);
+
         rightStartx -= 24;
 
         // Normal
@@ -224,6 +240,9 @@ void drawToolbar(Toolbar *toolbar) {
         GuiSetStyle(DEFAULT, BORDER_COLOR_PRESSED, GuiGetStyle(DEFAULT, BORDER_COLOR_PRESSED));
     } else {
         toolbar->isButtonRestoreClicked = GuiButtonCustom((Rectangle){x, y, 100, 24}, "#77# Restore", "RESTORE SELECTED ITEM", selectedItemCount <= 0, toolbar->ctx->disableGroundClick);
+
+        x += 100 + DEFAULT_PADDING;
+        toolbar->isButtonViewClicked = GuiButtonCustom((Rectangle){x, y, 24, 24}, toolbar->ctx->body->viewMode == BODY_VIEW_GRID ? "#214#" : "#97#", "VIEW", false, toolbar->ctx->disableGroundClick);
         // Normal
         GuiSetStyle(BUTTON, BASE_COLOR_NORMAL, ColorToInt((Color){230, 0, 0, 255}));
         GuiSetStyle(BUTTON, TEXT_COLOR_NORMAL, ColorToInt(WHITE));
@@ -313,6 +332,7 @@ void DrawNewButtonDropdown(Context *ctx, Rectangle btnRect) {
 }
 
 void DrawNewItemModal(Context *ctx) {
+    PROFILE_FUNCTION();
     Toolbar *toolbar = ctx->toolbar;
     if (!toolbar->showCreateModal)
         return;
@@ -385,6 +405,7 @@ void DrawNewItemModal(Context *ctx) {
 }
 
 void DrawRenameItemModal(Context *ctx) {
+    PROFILE_FUNCTION();
     Toolbar *toolbar = ctx->toolbar;
     if (!toolbar->showRenameModal)
         return;
@@ -438,6 +459,7 @@ void DrawRenameItemModal(Context *ctx) {
 }
 
 void DrawImportModal(Context *ctx) {
+    PROFILE_FUNCTION();
     bool *showImportModal = &ctx->toolbar->showImportModal;
     char *importPath = ctx->toolbar->importPath;
     int pathSize = sizeof(ctx->toolbar->importPath);
@@ -517,7 +539,7 @@ void DrawImportModal(Context *ctx) {
         if (OpenWindowsFileDialog(selectedPath, sizeof(selectedPath))) {
             strncpy(importPath, selectedPath, pathSize - 1);
             importPath[pathSize - 1] = '\0';
-            printf("[LOG] File selected: %s\n", selectedPath);
+            logDebug("File selected: %s\n", selectedPath);
         }
     }
 
@@ -533,7 +555,7 @@ void DrawImportModal(Context *ctx) {
         if (OpenWindowsFolderDialog(selectedPath, sizeof(selectedPath))) {
             strncpy(importPath, selectedPath, pathSize - 1);
             importPath[pathSize - 1] = '\0';
-            printf("[LOG] Folder selected: %s\n", selectedPath);
+            logDebug("Folder selected: %s\n", selectedPath);
         }
     }
 
@@ -557,7 +579,7 @@ void DrawImportModal(Context *ctx) {
         if (GetWindowsCommonPath(WIN_FOLDER_DESKTOP, desktopPath, sizeof(desktopPath))) {
             strncpy(importPath, desktopPath, pathSize - 1);
             importPath[pathSize - 1] = '\0';
-            printf("[LOG] Desktop path set: %s\n", importPath);
+            logDebug("Desktop path set: %s\n", importPath);
         }
     }
 
@@ -568,7 +590,7 @@ void DrawImportModal(Context *ctx) {
         if (GetWindowsCommonPath(WIN_FOLDER_DOCUMENTS, documentsPath, sizeof(documentsPath))) {
             strncpy(importPath, documentsPath, pathSize - 1);
             importPath[pathSize - 1] = '\0';
-            printf("[LOG] Documents path set: %s\n", importPath);
+            logDebug("Documents path set: %s\n", importPath);
         }
     }
 
@@ -579,7 +601,7 @@ void DrawImportModal(Context *ctx) {
         if (GetWindowsCommonPath(WIN_FOLDER_DOWNLOADS, downloadsPath, sizeof(downloadsPath))) {
             strncpy(importPath, downloadsPath, pathSize - 1);
             importPath[pathSize - 1] = '\0';
-            printf("[LOG] Downloads path set: %s\n", importPath);
+            logDebug("Downloads path set: %s\n", importPath);
         }
     }
 
@@ -590,7 +612,7 @@ void DrawImportModal(Context *ctx) {
         if (GetWindowsCommonPath(WIN_FOLDER_PICTURES, picturesPath, sizeof(picturesPath))) {
             strncpy(importPath, picturesPath, pathSize - 1);
             importPath[pathSize - 1] = '\0';
-            printf("[LOG] Pictures path set: %s\n", importPath);
+            logDebug("Pictures path set: %s\n", importPath);
         }
     }
 
@@ -650,7 +672,7 @@ void DrawImportModal(Context *ctx) {
     if (GuiButton(importBtnRect, "#84# Import") && canImport) {
         *modalResult = true;
         *showImportModal = false;
-        printf("[LOG] Import confirmed for: %s\n", importPath);
+        logInfo("Import confirmed for: %s\n", importPath);
     }
 
     // Reset button style
@@ -661,7 +683,7 @@ void DrawImportModal(Context *ctx) {
     if (IsKeyPressed(KEY_ENTER) && canImport) {
         *modalResult = true;
         *showImportModal = false;
-        printf("[LOG] Import confirmed with Enter: %s\n", importPath);
+        logInfo("Import confirmed with Enter: %s\n", importPath);
     }
 
     // Cancel button
@@ -1,15 +1,15 @@
 #include "item.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include "linked.h"
+#include "mem_stats.h"
 
-Item createItem(char* name, char* path, long size, ItemType type, time_t created_at, time_t updated_at, time_t deleted_at) {
-  const char* safeName = name ? name : "";
-  const char* safePath = path ? path : "";
+Item createItem(const char* name, const char* path, long size, ItemType type, time_t created_at, time_t updated_at, time_t deleted_at) {
   return (Item) {
-    .name = strdup(safeName),
-      .path = strdup(safePath),
+    .name = itemStrdup(name),
+      .path = itemStrdup(path),
       .size = size,
       .type = type,
       .selected = false,
@@ -19,43 +19,39 @@ Item createItem(char* name, char* path, long size, ItemType type, time_t created
   };
 }
 
-TrashItem searchTrashItem(LinkedList trash, char* originalPath) {
-  TrashItem* trashItemToFind;
-  Node* current;
-  if (trash.head == NULL) {
-    printf("[LOG] Sampah kosong\n");
-    return (TrashItem) {
-      .deletedTime = 0,
-        .item = { 0 },
-        .originalPath = NULL,
-        .trashPath = NULL
-    };
-  }
-  current = trash.head;
-  if (current != NULL) {
-    trashItemToFind = (TrashItem*)current->data;
-    if (strcmp(originalPath, trashItemToFind->originalPath) == 0) {
-      return  *trashItemToFind;
-    }
-    current = current->next;
-  }
-
-  printf("[LOG] Item sampah tidak ditemukan\n");
-
-  return (TrashItem) {
-    .deletedTime = 0,
-      .item = { 0 },
-      .originalPath = NULL,
-      .trashPath = NULL
-  };
-}
-
 PasteItem createPasteItem(Item item, char* originalPath) {
   return (PasteItem) {
     .item = item,
     .originalPath = strdup(originalPath ? originalPath : ""),
   };
 }
+
+Item createItemKey(char* name, char* path, ItemType type) {
+  return (Item) {
+    .name = name,
+      .path = path,
+      .type = type
+  };
+}
+
+char* itemStrdup(const char* text) {
+  char* copy = strdup(text ? text : "");
+  memTrackAlloc(MEM_STRINGS, copy);
+  return copy;
+}
+
+void freeItemString(char* text) {
+  memTrackFree(MEM_STRINGS, text);
+  free(text);
+}
+
+void destroyItem(Item* item) {
+  freeItemString(item->name);
+  freeItemString(item->path);
+  item->name = NULL;
+  item->path = NULL;
+}
+
 // TrashItem createTrashItem(Item item, char* origin) {
 //   return (TrashItem) {
 //     .item = item,
@@ -0,0 +1,462 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#include "journal_io.h"
+#include "logger.h"
+
+#define JOURNAL_NULL_STRING 0xFFFFFFFFu
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static bool _reserve(JournalBuffer* buffer, size_t extra);                     // Grow buffer
+static uint32_t _checksum(const unsigned char* data, size_t length);            // FNV-1a 32
+static bool _readBytes(JournalReader* reader, void* out, size_t length);        // Bounds-checked copy
+static unsigned char* _mapFile(int fd, size_t length);                          // mmap / read whole file
+static void _unmapFile(unsigned char* data, size_t length);                     // Release _mapFile result
+static bool _isTornTail(const unsigned char* tail, size_t length);              // Crash-cut final record?
+static bool _quarantine(const char* path, const char* magic, const unsigned char* records, size_t length);  // Keep a .corrupt backup
+
+/*
+================================================================================
+    ENCODING
+================================================================================
+*/
+
+void journalPut(JournalBuffer* buffer, const void* data, size_t length) {
+    if (!_reserve(buffer, length)) {
+        return;
+    }
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+}
+
+void journalPutU8(JournalBuffer* buffer, uint8_t value) {
+    journalPut(buffer, &value, sizeof(value));
+}
+
+void journalPutI64(JournalBuffer* buffer, int64_t value) {
+    journalPut(buffer, &value, sizeof(value));
+}
+
+void journalPutString(JournalBuffer* buffer, const char* str) {
+    uint32_t length = str ? (uint32_t)strlen(str) : JOURNAL_NULL_STRING;
+    journalPut(buffer, &length, sizeof(length));
+    if (str != NULL && length > 0) {
+        journalPut(buffer, str, length);
+    }
+}
+
+void journalBeginRecord(JournalBuffer* buffer, size_t* headerOffset) {
+    uint32_t zero[2] = { 0, 0 };
+    *headerOffset = buffer->length;
+    journalPut(buffer, zero, sizeof(zero));
+}
+
+void journalEndRecord(JournalBuffer* buffer, size_t headerOffset) {
+    if (buffer->data == NULL) {
+        return;
+    }
+    size_t payloadOffset = headerOffset + JOURNAL_RECORD_HEADER;
+    uint32_t header[2];
+    header[0] = (uint32_t)(buffer->length - payloadOffset);
+    header[1] = _checksum(buffer->data + payloadOffset, header[0]);
+    memcpy(buffer->data + headerOffset, header, sizeof(header));
+}
+
+void journalBufferFree(JournalBuffer* buffer) {
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+/*
+================================================================================
+    DECODING
+================================================================================
+*/
+
+uint8_t journalReadU8(JournalReader* reader) {
+    uint8_t value = 0;
+    _readBytes(reader, &value, sizeof(value));
+    return value;
+}
+
+int64_t journalReadI64(JournalReader* reader) {
+    int64_t value = 0;
+    _readBytes(reader, &value, sizeof(value));
+    return value;
+}
+
+char* journalReadString(JournalReader* reader) {
+    uint32_t length = 0;
+    if (!_readBytes(reader, &length, sizeof(length)) || length == JOURNAL_NULL_STRING) {
+        return NULL;
+    }
+    if ((size_t)(reader->end - reader->cursor) < length) {
+        reader->ok = false;
+        return NULL;
+    }
+
+    char* str = malloc((size_t)length + 1);
+    if (str == NULL) {
+        reader->ok = false;
+        return NULL;
+    }
+    memcpy(str, reader->cursor, length);
+    str[length] = '\0';
+    reader->cursor += length;
+    return str;
+}
+
+bool journalNextRecord(const unsigned char* records, size_t length, size_t* offset, JournalReader* payload) {
+    if (*offset > length || length - *offset < JOURNAL_RECORD_HEADER) {
+        return false;
+    }
+
+    uint32_t header[2];
+    memcpy(header, records + *offset, sizeof(header));
+    if (header[0] == 0 || length - *offset - JOURNAL_RECORD_HEADER < header[0]) {
+        return false;
+    }
+
+    const unsigned char* data = records + *offset + JOURNAL_RECORD_HEADER;
+    if (_checksum(data, header[0]) != header[1]) {
+        return false;
+    }
+
+    payload->cursor = data;
+    payload->end = data + header[0];
+    payload->ok = true;
+    *offset += JOURNAL_RECORD_HEADER + header[0];
+    return true;
+}
+
+/*
+================================================================================
+    FILE OPERATIONS
+================================================================================
+*/
+
+int journalOpen(const char* path, const char* magic, JournalReplayFunction replay, void* context) {
+    int fd = open(path, O_RDWR | O_CREAT | O_BINARY, 0644);
+    if (fd < 0) {
+        logError("Gagal membuka journal %s (Error: %d)\n", path, errno);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        logError("Gagal membaca ukuran journal %s (Error: %d)\n", path, errno);
+        close(fd);
+        return -1;
+    }
+
+    size_t fileSize = (size_t)st.st_size;
+    unsigned char* data = NULL;
+    if (fileSize > 0) {
+        data = _mapFile(fd, fileSize);
+        if (data == NULL) {
+            logError("Gagal memetakan journal %s (Error: %d)\n", path, errno);
+            close(fd);
+            return -1;
+        }
+    }
+
+    bool ok = true;
+    size_t magicLength = fileSize < JOURNAL_MAGIC_LEN ? fileSize : JOURNAL_MAGIC_LEN;
+    if (magicLength > 0 && memcmp(data, magic, magicLength) != 0) {
+        logWarn("Journal tidak dikenali, disimpan sebagai .corrupt: %s\n", path);
+        close(fd);
+        fd = -1;
+        ok = _quarantine(path, magic, NULL, 0);
+    }
+    else if (fileSize < JOURNAL_MAGIC_LEN) {
+        // File baru, atau magic terpotong saat file dibuat
+        ok = ftruncate(fd, 0) == 0 && journalWriteAll(fd, magic, JOURNAL_MAGIC_LEN);
+    }
+    else {
+        size_t validLength = JOURNAL_MAGIC_LEN + replay(data + JOURNAL_MAGIC_LEN, fileSize - JOURNAL_MAGIC_LEN, context);
+        if (validLength == fileSize) {
+            logTrace("Journal %s utuh (%zu byte)\n", path, fileSize);
+        }
+        else if (_isTornTail(data + validLength, fileSize - validLength)) {
+            logWarn("Journal %s: record terakhir terpotong (%zu byte) dibuang\n", path, fileSize - validLength);
+            if (ftruncate(fd, (off_t)validLength) != 0) {
+                logError("Gagal memotong journal %s (Error: %d)\n", path, errno);
+            }
+        }
+        else {
+            // Kerusakan di tengah file: record yang valid dipertahankan, file asli disimpan utuh
+            logWarn("Journal %s rusak pada byte %zu dari %zu, disimpan sebagai .corrupt\n", path, validLength, fileSize);
+            close(fd);
+            fd = -1;
+            ok = _quarantine(path, magic, data + JOURNAL_MAGIC_LEN, validLength - JOURNAL_MAGIC_LEN);
+        }
+    }
+    _unmapFile(data, fileSize);
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (!ok) {
+        return -1;
+    }
+
+    fd = open(path, O_WRONLY | O_APPEND | O_BINARY);
+    if (fd < 0) {
+        logError("Gagal membuka journal %s untuk append (Error: %d)\n", path, errno);
+    }
+    return fd;
+}
+
+int journalCreateFile(const char* path, const char* magic, const unsigned char* data, size_t length) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_BINARY, 0644);
+    if (fd < 0) {
+        return -1;
+    }
+    if (!journalWriteAll(fd, magic, JOURNAL_MAGIC_LEN) || (length > 0 && !journalWriteAll(fd, data, length))) {
+        close(fd);
+        remove(path);
+        return -1;
+    }
+    return fd;
+}
+
+bool journalWriteAll(int fd, const void* data, size_t length) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    while (length > 0) {
+        ssize_t written = write(fd, bytes, length);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        bytes += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+bool journalFlush(int fd) {
+#ifdef _WIN32
+    return _commit(fd) == 0;
+#else
+    return fsync(fd) == 0;
+#endif
+}
+
+bool journalReplaceFile(const char* tmpPath, const char* path, int* oldFd) {
+#ifdef _WIN32
+    // Windows tidak bisa rename menimpa file yang masih terbuka
+    if (*oldFd >= 0) {
+        close(*oldFd);
+        *oldFd = -1;
+    }
+    remove(path);
+#else
+    (void)oldFd;
+#endif
+    return rename(tmpPath, path) == 0;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Ensures buffer can hold extra bytes
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _reserve(JournalBuffer* buffer, size_t extra) {
+    if (buffer->length + extra <= buffer->capacity) {
+        return true;
+    }
+    size_t capacity = buffer->capacity ? buffer->capacity : 256;
+    while (capacity < buffer->length + extra) {
+        capacity *= 2;
+    }
+    unsigned char* data = realloc(buffer->data, capacity);
+    if (data == NULL) {
+        logError("Overflow, Memory allocation failed\n");
+        return false;
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief FNV-1a 32-bit checksum used to detect torn records
+ *
+ * @internal
+ * @since 1.0
+ */
+static uint32_t _checksum(const unsigned char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Copies length bytes from the reader, marking it failed on overrun
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _readBytes(JournalReader* reader, void* out, size_t length) {
+    if (!reader->ok || (size_t)(reader->end - reader->cursor) < length) {
+        reader->ok = false;
+        return false;
+    }
+    memcpy(out, reader->cursor, length);
+    reader->cursor += length;
+    return true;
+}
+
+/**
+ * @brief Maps a whole file read-only (reads it into memory on Windows)
+ *
+ * @internal
+ * @since 1.0
+ */
+static unsigned char* _mapFile(int fd, size_t length) {
+#ifdef _WIN32
+    unsigned char* data = malloc(length);
+    if (data != NULL && read(fd, data, (unsigned int)length) != (int)length) {
+        free(data);
+        data = NULL;
+    }
+    return data;
+#else
+    void* mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    return (mapped == MAP_FAILED) ? NULL : (unsigned char*)mapped;
+#endif
+}
+
+/**
+ * @brief Releases memory returned by _mapFile
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _unmapFile(unsigned char* data, size_t length) {
+    if (data == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    (void)length;
+    free(data);
+#else
+    munmap(data, length);
+#endif
+}
+
+/**
+ * @brief Whether the bytes after the last valid record are a crash-cut append
+ *
+ * Appends only ever add one record at the end, so a crash can leave a
+ * partial header, a record running past the end of the file, a final
+ * record with a bad checksum, or a zero-filled tail. Anything else (a bad
+ * record followed by more data, or a checksum-valid record the replay
+ * rejected) is corruption and must not be cut off.
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _isTornTail(const unsigned char* tail, size_t length) {
+    if (length < JOURNAL_RECORD_HEADER) {
+        return true;
+    }
+
+    uint32_t header[2];
+    memcpy(header, tail, sizeof(header));
+    if (header[0] == 0) {
+        for (size_t i = 0; i < length; i++) {
+            if (tail[i] != 0)
+                return false;
+        }
+        return true;
+    }
+
+    size_t payloadLength = length - JOURNAL_RECORD_HEADER;
+    if (header[0] > payloadLength) {
+        return true;
+    }
+    return header[0] == payloadLength && _checksum(tail + JOURNAL_RECORD_HEADER, header[0]) != header[1];
+}
+
+/**
+ * @brief Moves a corrupt journal to path.corrupt and starts a new one
+ *
+ * The new file holds the magic plus the records that replayed before the
+ * corruption, so the replayed state and the file stay in sync. The
+ * original bytes are kept in the backup for inspection.
+ *
+ * @param[in] path Journal path
+ * @param[in] magic 8-byte file magic
+ * @param[in] records Valid record bytes to carry over (may be NULL)
+ * @param[in] length Length of records
+ * @return true if the backup and the new file were written
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _quarantine(const char* path, const char* magic, const unsigned char* records, size_t length) {
+    size_t pathLength = strlen(path) + sizeof(".corrupt");
+    char* backupPath = malloc(pathLength);
+    char* tmpPath = malloc(pathLength);
+    if (backupPath == NULL || tmpPath == NULL) {
+        free(backupPath);
+        free(tmpPath);
+        return false;
+    }
+    snprintf(backupPath, pathLength, "%s.corrupt", path);
+    snprintf(tmpPath, pathLength, "%s.rebuild", path);
+
+    int fd = journalCreateFile(tmpPath, magic, records, length);
+    bool ok = fd >= 0 && journalFlush(fd);
+    if (fd >= 0) {
+        close(fd);
+    }
+#ifdef _WIN32
+    remove(backupPath);
+#endif
+    ok = ok && rename(path, backupPath) == 0;
+    int noFd = -1;
+    ok = ok && journalReplaceFile(tmpPath, path, &noFd);
+    if (!ok) {
+        logError("Gagal membuat backup journal %s (Error: %d)\n", backupPath, errno);
+        remove(tmpPath);
+    }
+
+    free(backupPath);
+    free(tmpPath);
+    return ok;
+}
@@ -0,0 +1,435 @@
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "logger.h"
+#include "profiler.h"
+#include "utils.h"
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+/**
+ * @brief One ring entry
+ *
+ * sequence follows the bounded MPMC queue scheme: a slot is free for the
+ * producer claiming position p when sequence == p, and holds a message for
+ * the consumer at position p when sequence == p + 1.
+ */
+typedef struct LogSlot {
+    atomic_size_t sequence;
+    int level;
+    struct timespec time;
+    char text[LOG_MESSAGE_LENGTH];
+} LogSlot;
+
+/**
+ * @brief Process-wide logger state
+ */
+typedef struct Logger {
+    LogSlot ring[LOG_RING_CAPACITY];
+    atomic_size_t enqueuePos;      ///< Next position claimed by a producer
+    size_t dequeuePos;             ///< Next position read by the writer (writer only)
+    atomic_size_t drained;         ///< dequeuePos published for logPendingCount()
+    atomic_int level;              ///< Runtime level
+    atomic_bool running;           ///< Ring accepts messages
+    atomic_bool stopping;          ///< Writer drains and exits
+    atomic_bool sleeping;          ///< Writer is in (or entering) its timed wait
+    atomic_llong dropped;          ///< Messages lost to a full ring
+    long long droppedReported;     ///< Dropped count already written (writer only)
+
+    pthread_t thread;
+    pthread_mutex_t lock;          ///< Only for the writer's timed wait
+    pthread_cond_t wake;
+    bool consoleAll;               ///< Echo every level to stderr
+
+    FILE* file;
+    char path[512];
+    long fileSize;
+} Logger;
+
+static Logger logger = { .level = LOG_LEVEL_INFO };
+
+static const char* levelNames[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR" };
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void* _writerThread(void* arg);                        // Drain ring ke file
+static bool _drainOnce(void);                                 // Tulis semua slot yang siap
+static bool _hasPending(void);                                // Ada slot siap dibaca
+static void _emit(int level, const struct timespec* time, const char* text); // Tulis satu baris
+static void _rotate(void);                                    // Geser file log lama
+static int _parseLevel(const char* name, int fallback);       // Nama level -> angka
+
+/*
+================================================================================
+    LIFECYCLE
+================================================================================
+*/
+
+bool logInit(const char* path) {
+    if (atomic_load(&logger.running)) {
+        return true;
+    }
+
+    for (size_t i = 0; i < LOG_RING_CAPACITY; i++) {
+        atomic_init(&logger.ring[i].sequence, i);
+    }
+    atomic_init(&logger.enqueuePos, 0);
+    logger.dequeuePos = 0;
+    atomic_init(&logger.drained, 0);
+    atomic_init(&logger.dropped, 0);
+    logger.droppedReported = 0;
+    atomic_init(&logger.stopping, false);
+    atomic_init(&logger.sleeping, false);
+    atomic_store(&logger.level, _parseLevel(getenv("ALPENLI_LOG_LEVEL"), LOG_LEVEL_INFO));
+    const char* console = getenv("ALPENLI_LOG_CONSOLE");
+    logger.consoleAll = console != NULL && strcmp(console, "1") == 0;
+
+    snprintf(logger.path, sizeof(logger.path), "%s", path);
+    char* dir = strdup(logger.path);
+    char* slash = strrchr(dir, '/');
+    if (slash != NULL) {
+        *slash = '\0';
+        makeDirectory(dir);
+    }
+    free(dir);
+
+    logger.file = fopen(logger.path, "a");
+    if (logger.file == NULL) {
+        printf("[LOG] Gagal membuka file log %s: %s\n", logger.path, strerror(errno));
+        return false;
+    }
+    fseek(logger.file, 0, SEEK_END);
+    logger.fileSize = ftell(logger.file);
+
+    pthread_mutex_init(&logger.lock, NULL);
+    pthread_cond_init(&logger.wake, NULL);
+    atomic_store(&logger.running, true);
+    if (pthread_create(&logger.thread, NULL, _writerThread, NULL) != 0) {
+        atomic_store(&logger.running, false);
+        pthread_cond_destroy(&logger.wake);
+        pthread_mutex_destroy(&logger.lock);
+        fclose(logger.file);
+        logger.file = NULL;
+        printf("[LOG] Gagal memulai thread logger, log tetap ke stdout\n");
+        return false;
+    }
+    return true;
+}
+
+void logShutdown(void) {
+    if (!atomic_load(&logger.running)) {
+        return;
+    }
+
+    // Tolak pesan baru, lalu writer menghabiskan isi ring
+    atomic_store(&logger.running, false);
+    pthread_mutex_lock(&logger.lock);
+    atomic_store(&logger.stopping, true);
+    pthread_cond_signal(&logger.wake);
+    pthread_mutex_unlock(&logger.lock);
+    pthread_join(logger.thread, NULL);
+
+    pthread_cond_destroy(&logger.wake);
+    pthread_mutex_destroy(&logger.lock);
+    if (logger.file != stderr) {
+        fclose(logger.file);
+    }
+    logger.file = NULL;
+}
+
+/*
+================================================================================
+    LOGGING
+================================================================================
+*/
+
+void logSetLevel(int level) {
+    atomic_store(&logger.level, level);
+}
+
+bool logEnabled(int level) {
+    return level >= atomic_load_explicit(&logger.level, memory_order_relaxed);
+}
+
+void logWrite(int level, const char* format, ...) {
+    if (!logEnabled(level)) {
+        return;
+    }
+
+    va_list args;
+    if (!atomic_load_explicit(&logger.running, memory_order_acquire)) {
+        // Belum ada writer: perilaku lama, langsung ke stdout
+        printf("[LOG] ");
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+        size_t length = strlen(format);
+        if (length == 0 || format[length - 1] != '\n') {
+            putchar('\n');
+        }
+        return;
+    }
+
+    // Klaim slot: CAS pada enqueuePos, tanpa lock
+    LogSlot* slot;
+    size_t pos = atomic_load_explicit(&logger.enqueuePos, memory_order_relaxed);
+    while (true) {
+        slot = &logger.ring[pos & (LOG_RING_CAPACITY - 1)];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&logger.enqueuePos, &pos, pos + 1,
+                memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // Ring penuh; jangan blok pemanggil
+            atomic_fetch_add_explicit(&logger.dropped, 1, memory_order_relaxed);
+            return;
+        }
+        else {
+            pos = atomic_load_explicit(&logger.enqueuePos, memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    clock_gettime(CLOCK_REALTIME, &slot->time);
+    va_start(args, format);
+    vsnprintf(slot->text, sizeof(slot->text), format, args);
+    va_end(args);
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+
+    // Bangunkan writer yang sedang tidur; tanpa mutex, wakeup yang hilang
+    // hanya menunda sampai timed wait berikutnya
+    if (atomic_load_explicit(&logger.sleeping, memory_order_relaxed) &&
+        atomic_exchange_explicit(&logger.sleeping, false, memory_order_relaxed)) {
+        pthread_cond_signal(&logger.wake);
+    }
+}
+
+long long logDroppedCount(void) {
+    return atomic_load(&logger.dropped);
+}
+
+int logPendingCount(void) {
+    size_t claimed = atomic_load_explicit(&logger.enqueuePos, memory_order_relaxed);
+    size_t drained = atomic_load_explicit(&logger.drained, memory_order_relaxed);
+    return claimed > drained ? (int)(claimed - drained) : 0;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Writer loop: drains the ring, then waits briefly when it is empty
+ *
+ * The first producer to find the writer asleep signals it without taking
+ * the mutex. Such a wakeup can be lost, so the wait is also bounded by a
+ * short timeout. logShutdown() wakes it immediately.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void* _writerThread(void* arg) {
+    (void)arg;
+    PROFILE_THREAD_NAME("logger");
+    while (true) {
+        bool wrote = _drainOnce();
+        if (atomic_load(&logger.stopping)) {
+            // Pesan yang sempat masuk sebelum running = false
+            while (_drainOnce()) {
+            }
+            break;
+        }
+        if (!wrote) {
+            fflush(logger.file);
+            struct timespec until;
+            clock_gettime(CLOCK_REALTIME, &until);
+            until.tv_nsec += 20 * 1000000L;
+            if (until.tv_nsec >= 1000000000L) {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000L;
+            }
+            pthread_mutex_lock(&logger.lock);
+            atomic_store(&logger.sleeping, true);
+            // Pesan yang masuk sebelum flag terlihat tidak akan membangunkan writer
+            if (!atomic_load(&logger.stopping) && !_hasPending()) {
+                pthread_cond_timedwait(&logger.wake, &logger.lock, &until);
+            }
+            atomic_store(&logger.sleeping, false);
+            pthread_mutex_unlock(&logger.lock);
+        }
+    }
+    fflush(logger.file);
+    return NULL;
+}
+
+/**
+ * @brief Writes every published slot in order
+ *
+ * @return bool true if at least one message was written
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _drainOnce(void) {
+    bool wrote = false;
+    while (true) {
+        LogSlot* slot = &logger.ring[logger.dequeuePos & (LOG_RING_CAPACITY - 1)];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (sequence != logger.dequeuePos + 1) {
+            break;
+        }
+        _emit(slot->level, &slot->time, slot->text);
+        atomic_store_explicit(&slot->sequence, logger.dequeuePos + LOG_RING_CAPACITY, memory_order_release);
+        logger.dequeuePos++;
+        wrote = true;
+    }
+    if (wrote) {
+        atomic_store_explicit(&logger.drained, logger.dequeuePos, memory_order_relaxed);
+    }
+
+    long long dropped = atomic_load_explicit(&logger.dropped, memory_order_relaxed);
+    if (dropped != logger.droppedReported) {
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        char text[96];
+        snprintf(text, sizeof(text), "%lld pesan log dibuang (ring penuh)", dropped - logger.droppedReported);
+        _emit(LOG_LEVEL_WARN, &now, text);
+        logger.droppedReported = dropped;
+    }
+    return wrote;
+}
+
+/**
+ * @brief Checks whether the next slot is published
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _hasPending(void) {
+    LogSlot* slot = &logger.ring[logger.dequeuePos & (LOG_RING_CAPACITY - 1)];
+    return atomic_load_explicit(&slot->sequence, memory_order_acquire) == logger.dequeuePos + 1;
+}
+
+/**
+ * @brief Writes one line to the file (and stderr when configured)
+ *
+ * Leading and trailing newlines of the message are dropped; each record is
+ * exactly one line.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _emit(int level, const struct timespec* time, const char* text) {
+    while (*text == '\n') {
+        text++;
+    }
+    int length = (int)strlen(text);
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r')) {
+        length--;
+    }
+
+    // Stempel waktu diformat sekali per detik
+    static time_t stampSecond = -1;
+    static char stamp[32];
+    if (time->tv_sec != stampSecond) {
+        struct tm local;
+        time_t seconds = time->tv_sec;
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+        stampSecond = time->tv_sec;
+    }
+
+    int written = fprintf(logger.file, "%s.%03ld %-5s %.*s\n",
+        stamp, time->tv_nsec / 1000000L, levelNames[level], length, text);
+    if (written > 0) {
+        logger.fileSize += written;
+    }
+    if (logger.consoleAll || level >= LOG_LEVEL_WARN) {
+        fprintf(stderr, "[%s] %.*s\n", levelNames[level], length, text);
+    }
+    if (logger.fileSize >= LOG_ROTATE_BYTES) {
+        _rotate();
+    }
+}
+
+/**
+ * @brief Shifts path.N-1 -> path.N ... path -> path.1 and reopens path
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _rotate(void) {
+    fclose(logger.file);
+
+    char from[600];
+    char to[600];
+    for (int i = LOG_ROTATE_KEEP - 1; i >= 1; i--) {
+        snprintf(from, sizeof(from), "%s.%d", logger.path, i);
+        snprintf(to, sizeof(to), "%s.%d", logger.path, i + 1);
+        rename(from, to);
+    }
+    snprintf(to, sizeof(to), "%s.1", logger.path);
+    remove(to);
+    rename(logger.path, to);
+
+    logger.file = fopen(logger.path, "w");
+    if (logger.file == NULL) {
+        // Tanpa file, log tetap bisa dibaca di stderr
+        logger.file = stderr;
+    }
+    logger.fileSize = 0;
+}
+
+/**
+ * @brief Parses a level name (case-insensitive) or digit
+ *
+ * @internal
+ * @since 1.0
+ */
+static int _parseLevel(const char* name, int fallback) {
+    if (name == NULL || name[0] == '\0') {
+        return fallback;
+    }
+    if (name[0] >= '0' && name[0] <= '5' && name[1] == '\0') {
+        return name[0] - '0';
+    }
+
+    static const char* names[] = { "trace", "debug", "info", "warn", "error", "off" };
+    char lower[16];
+    size_t i = 0;
+    for (; name[i] != '\0' && i < sizeof(lower) - 1; i++) {
+        lower[i] = (char)((name[i] >= 'A' && name[i] <= 'Z') ? name[i] + 32 : name[i]);
+    }
+    lower[i] = '\0';
+    for (int level = 0; level <= LOG_LEVEL_OFF; level++) {
+        if (strcmp(lower, names[level]) == 0) {
+            return level;
+        }
+    }
+    return fallback;
+}
@@ -7,16 +7,22 @@
 
 #include "body.h"
 #include "component.h"
+#include "duplicates.h"
 #include "file_manager.h"
 #include "footer.h"
+#include "hud.h"
+#include "logger.h"
 #include "macro.h"
+#include "profiler.h"
+#include "preview.h"
 #include "navbar.h"
 #include "raygui.h"
 #include "raylib.h"
 #include "sidebar.h"
+#include "thumbnail.h"
 #include "titlebar.h"
 #include "toolbar.h"
-#include "utils.h"
+#include "shortcut.h"
 
 #include "ctx.h"
 
@@ -68,6 +74,8 @@ int main() {
 
     FileManager fileManager;
 
+    logInit(LOG_DEFAULT_PATH);
+    PROFILE_THREAD_NAME("main");
     createFileManager(&fileManager);
 
     initFileManager(&fileManager);
@@ -105,14 +113,20 @@ int main() {
     // createBody(&ctx, ctx.body);
 
     while (!ctx.titleBar->exitWindow && !WindowShouldClose()) {
+        PROFILE_BEGIN(frameZone, "frame");
+        hudBeginFrame(ctx.hud);
 
         // Update
         //----------------------------------------------------------------------------------
         updateContext(&ctx, &fileManager);
+        // Upload texture thumbnail di main thread, dibatasi per frame
+        uploadThumbnails(ctx.thumbnails, THUMB_UPLOADS_PER_FRAME);
+        enforceTrashRetention(&fileManager);
 
         ShortcutKeys(&ctx);
         // Draw
         //----------------------------------------------------------------------------------
+        hudBeginDraw(ctx.hud);
         BeginDrawing();
 
         ClearBackground(RAYWHITE);
@@ -121,6 +135,8 @@ int main() {
 
         drawBody(&ctx, ctx.body);
 
+        drawPreviewPane(ctx.preview);
+
         drawSidebar(ctx.sidebar);
 
         drawToolbar(ctx.toolbar);
@@ -129,14 +145,32 @@ int main() {
 
         drawNavbar(ctx.navbar);
 
+        drawHud(ctx.hud);
+
         DrawNewItemModal(&ctx);
         DrawRenameItemModal(&ctx);
         DrawImportModal(&ctx);
 
+        hudEndDraw(ctx.hud);
         EndDrawing();
+        PROFILE_END(frameZone);
     }
 
+    stopTrashPurger(&fileManager.trashPurger);
+    trashPurgerReclaim(&fileManager.trashPurger, &fileManager.trash);
     saveTrashToFile(&fileManager);
+    closeTrashJournal(&fileManager.trashJournal);
+    opJournalCheckpoint(&fileManager.opJournal, &fileManager.undo);
+    closeOpJournal(&fileManager.opJournal);
+
+    MemoryReport report;
+    collectMemoryReport(&fileManager, &report);
+    logMemoryReport(&report);
+
+    closeDuplicateView(ctx.duplicates);
+    closePreviewPane(ctx.preview);
+    destroyThumbnailCache(ctx.thumbnails);
+    logShutdown();
     CloseWindow();
     return 0;
 }
@@ -0,0 +1,130 @@
+#include <stdatomic.h>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include "mem_stats.h"
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+typedef struct MemCounters {
+    atomic_llong bytes;
+    atomic_llong blocks;
+    atomic_llong peakBytes;
+    atomic_llong allocations;
+} MemCounters;
+
+static MemCounters counters[MEM_CATEGORY_COUNT];
+
+static const char* categoryNames[MEM_CATEGORY_COUNT] = {
+    "tree", "strings", "sidebar", "search", "undo", "trash"
+};
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void _raisePeak(MemCounters* counter, long long bytes);  // Naikkan peak jika perlu
+
+/*
+================================================================================
+    REPORTING
+================================================================================
+*/
+
+void memTrackAlloc(MemCategory category, const void* block) {
+    if (block == NULL) {
+        return;
+    }
+    atomic_fetch_add_explicit(&counters[category].allocations, 1, memory_order_relaxed);
+    memAccount(category, (long long)memBlockSize(block), 1);
+}
+
+void memTrackFree(MemCategory category, const void* block) {
+    if (block == NULL) {
+        return;
+    }
+    memAccount(category, -(long long)memBlockSize(block), -1);
+}
+
+void memAccount(MemCategory category, long long bytes, long long blocks) {
+    MemCounters* counter = &counters[category];
+    long long live = atomic_fetch_add_explicit(&counter->bytes, bytes, memory_order_relaxed) + bytes;
+    atomic_fetch_add_explicit(&counter->blocks, blocks, memory_order_relaxed);
+    if (bytes > 0) {
+        _raisePeak(counter, live);
+    }
+}
+
+size_t memBlockSize(const void* block) {
+    if (block == NULL) {
+        return 0;
+    }
+#if defined(_WIN32)
+    return _msize((void*)block);
+#elif defined(__APPLE__)
+    return malloc_size(block);
+#else
+    return malloc_usable_size((void*)block);
+#endif
+}
+
+/*
+================================================================================
+    QUERIES
+================================================================================
+*/
+
+void getMemStats(MemCategory category, MemCategoryStats* stats) {
+    MemCounters* counter = &counters[category];
+    stats->bytes = atomic_load_explicit(&counter->bytes, memory_order_relaxed);
+    stats->blocks = atomic_load_explicit(&counter->blocks, memory_order_relaxed);
+    stats->peakBytes = atomic_load_explicit(&counter->peakBytes, memory_order_relaxed);
+    stats->allocations = atomic_load_explicit(&counter->allocations, memory_order_relaxed);
+}
+
+long long memTotalBytes(void) {
+    long long total = 0;
+    for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+        total += atomic_load_explicit(&counters[i].bytes, memory_order_relaxed);
+    }
+    return total;
+}
+
+const char* memCategoryName(MemCategory category) {
+    if (category < 0 || category >= MEM_CATEGORY_COUNT) {
+        return "?";
+    }
+    return categoryNames[category];
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Raises the category peak to bytes if it is higher
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _raisePeak(MemCounters* counter, long long bytes) {
+    long long peak = atomic_load_explicit(&counter->peakBytes, memory_order_relaxed);
+    while (bytes > peak &&
+           !atomic_compare_exchange_weak_explicit(&counter->peakBytes, &peak, bytes,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
@@ -0,0 +1,552 @@
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "journal_io.h"
+#include "logger.h"
+#include "mem_stats.h"
+#include "op_journal.h"
+
+#define OP_JOURNAL_MAGIC "ALPOPJ01"
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+typedef struct ReplayState {
+    OpJournal* journal;     // Journal being opened
+    Operation** history;    // Undo entries, oldest first
+    int historyCount;
+    int historyCapacity;
+} ReplayState;
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+// ENCODING
+static void _encodeOperation(JournalBuffer* buffer, const Operation* operation);   // PUSH record
+static void _encodeSeqRecord(JournalBuffer* buffer, OpJournalRecord kind, long long seq);  // BEGIN/DONE/END style header
+
+// DECODING
+static size_t _replay(const unsigned char* data, size_t length, void* context);     // Rebuild history + incomplete list
+static Operation* _decodeOperation(JournalReader* reader);                          // PUSH payload -> Operation
+static OpJournalIncomplete* _findIncomplete(OpJournal* journal, long long seq);    // Lookup by seq
+static void _removeIncomplete(OpJournal* journal, long long seq);                  // Drop after END
+
+// FILE OPERATIONS
+static void _append(OpJournal* journal, JournalBuffer* record, bool flush);        // Write one record
+
+/*
+================================================================================
+    LIFECYCLE
+================================================================================
+*/
+
+bool openOpJournal(OpJournal* journal, const char* path, UndoHistory* undoHistory) {
+    memset(journal, 0, sizeof(OpJournal));
+    journal->path = strdup(path);
+    journal->nextSeq = 1;
+
+    ReplayState state = { journal, NULL, 0, 0 };
+    journal->fd = journalOpen(path, OP_JOURNAL_MAGIC, _replay, &state);
+
+    // Urutan file: entri terlama lebih dulu; budget riwayat berlaku saat dimuat
+    for (int i = 0; i < state.historyCount; i++) {
+        undoHistoryPush(undoHistory, state.history[i]);
+        destroyOperation(state.history[i]);
+    }
+    free(state.history);
+
+    if (journal->fd < 0) {
+        return false;
+    }
+
+    logInfo("Operation journal dimuat: %d riwayat undo, %d operasi terputus\n",
+        state.historyCount, journal->incompleteCount);
+    return true;
+}
+
+void closeOpJournal(OpJournal* journal) {
+    if (journal->fd >= 0) {
+        journalFlush(journal->fd);
+        close(journal->fd);
+        journal->fd = -1;
+    }
+    freeOpJournalIncomplete(journal);
+    free(journal->path);
+    journal->path = NULL;
+}
+
+void freeOpJournalIncomplete(OpJournal* journal) {
+    for (int i = 0; i < journal->incompleteCount; i++) {
+        OpJournalIncomplete* incomplete = &journal->incomplete[i];
+        for (int j = 0; j < incomplete->stepCount; j++) {
+            free(incomplete->steps[j].src);
+            free(incomplete->steps[j].dest);
+            free(incomplete->steps[j].uid);
+        }
+        free(incomplete->steps);
+    }
+    free(journal->incomplete);
+    journal->incomplete = NULL;
+    journal->incompleteCount = 0;
+}
+
+bool opJournalCheckpoint(OpJournal* journal, const UndoHistory* undoHistory) {
+    if (journal->fd < 0) {
+        return false;
+    }
+
+    // Tulis dari entri terlama agar replay push berurutan
+    JournalBuffer snapshot = { 0 };
+    long count = 0;
+    for (DLLNode* node = undoHistory->entries.tail; node != NULL; node = node->prev) {
+        Operation* operation = undoHistoryExpand((const UndoEntry*)node->data);
+        if (operation != NULL) {
+            _encodeOperation(&snapshot, operation);
+            destroyOperation(operation);
+            count++;
+        }
+    }
+
+    size_t pathLength = strlen(journal->path) + sizeof(".compact");
+    char* tmpPath = malloc(pathLength);
+    if (tmpPath == NULL) {
+        journalBufferFree(&snapshot);
+        return false;
+    }
+    snprintf(tmpPath, pathLength, "%s.compact", journal->path);
+
+    int fd = journalCreateFile(tmpPath, OP_JOURNAL_MAGIC, snapshot.data, snapshot.length);
+    bool ok = fd >= 0 && journalFlush(fd) && journalReplaceFile(tmpPath, journal->path, &journal->fd);
+    if (ok) {
+        if (journal->fd >= 0) {
+            close(journal->fd);
+        }
+        journal->fd = fd;
+        journal->records = count;
+    }
+    else {
+        logError("Gagal checkpoint operation journal (Error: %d)\n", errno);
+        if (fd >= 0) {
+            close(fd);
+        }
+        remove(tmpPath);
+    }
+
+    free(tmpPath);
+    journalBufferFree(&snapshot);
+    return ok;
+}
+
+/*
+================================================================================
+    WRITE-AHEAD RECORDS
+================================================================================
+*/
+
+long long opJournalBegin(OpJournal* journal, ActionType type, bool isCopy) {
+    long long seq = journal->nextSeq++;
+    JournalBuffer record = { 0 };
+    size_t header;
+
+    journalBeginRecord(&record, &header);
+    journalPutU8(&record, OP_JOURNAL_BEGIN);
+    journalPutI64(&record, seq);
+    journalPutU8(&record, (uint8_t)type);
+    journalPutU8(&record, isCopy ? 1 : 0);
+    journalEndRecord(&record, header);
+
+    _append(journal, &record, false);
+    return seq;
+}
+
+void opJournalStep(OpJournal* journal, long long seq, ItemType type, const char* src, const char* dest, const char* uid) {
+    JournalBuffer record = { 0 };
+    size_t header;
+
+    journalBeginRecord(&record, &header);
+    journalPutU8(&record, OP_JOURNAL_STEP);
+    journalPutI64(&record, seq);
+    journalPutU8(&record, (uint8_t)type);
+    journalPutString(&record, src);
+    journalPutString(&record, dest);
+    journalPutString(&record, uid);
+    journalEndRecord(&record, header);
+
+    // Write-ahead: intent harus sudah di disk sebelum filesystem disentuh
+    _append(journal, &record, true);
+}
+
+void opJournalStepDone(OpJournal* journal, long long seq) {
+    JournalBuffer record = { 0 };
+    _encodeSeqRecord(&record, OP_JOURNAL_STEP_DONE, seq);
+    _append(journal, &record, false);
+}
+
+void opJournalEnd(OpJournal* journal, long long seq) {
+    JournalBuffer record = { 0 };
+    _encodeSeqRecord(&record, OP_JOURNAL_END, seq);
+    _append(journal, &record, true);
+}
+
+/*
+================================================================================
+    UNDO HISTORY
+================================================================================
+*/
+
+void opJournalPushUndo(OpJournal* journal, const Operation* operation) {
+    JournalBuffer record = { 0 };
+    _encodeOperation(&record, operation);
+    _append(journal, &record, false);
+}
+
+void opJournalPopUndo(OpJournal* journal) {
+    JournalBuffer record = { 0 };
+    size_t header;
+    journalBeginRecord(&record, &header);
+    journalPutU8(&record, OP_JOURNAL_POP);
+    journalEndRecord(&record, header);
+    _append(journal, &record, false);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - ENCODING
+================================================================================
+*/
+
+/**
+ * @brief Encodes a record carrying only a kind and a sequence number
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _encodeSeqRecord(JournalBuffer* buffer, OpJournalRecord kind, long long seq) {
+    size_t header;
+    journalBeginRecord(buffer, &header);
+    journalPutU8(buffer, (uint8_t)kind);
+    journalPutI64(buffer, seq);
+    journalEndRecord(buffer, header);
+}
+
+/**
+ * @brief Encodes a PUSH record with the operation and its item payload
+ *
+ * DELETE/RECOVER operations carry TrashItem*, PASTE carries PasteItem*,
+ * other types have no items.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _encodeOperation(JournalBuffer* buffer, const Operation* operation) {
+    size_t header;
+    int64_t count = 0;
+    bool hasItems = operation->itemTemp != NULL &&
+        (operation->type == ACTION_DELETE || operation->type == ACTION_RECOVER || operation->type == ACTION_PASTE);
+
+    if (hasItems) {
+        count = get_queue_length(*operation->itemTemp);
+    }
+
+    journalBeginRecord(buffer, &header);
+    journalPutU8(buffer, OP_JOURNAL_PUSH);
+    journalPutU8(buffer, (uint8_t)operation->type);
+    journalPutU8(buffer, operation->isDir ? 1 : 0);
+    journalPutU8(buffer, operation->isCopy ? 1 : 0);
+    journalPutString(buffer, operation->from);
+    journalPutString(buffer, operation->to);
+    journalPutI64(buffer, count);
+
+    if (hasItems) {
+        for (Node* node = operation->itemTemp->front; node != NULL; node = node->next) {
+            if (operation->type == ACTION_PASTE) {
+                PasteItem* pasteItem = (PasteItem*)node->data;
+                journalPutString(buffer, pasteItem->item.name);
+                journalPutString(buffer, pasteItem->item.path);
+                journalPutString(buffer, pasteItem->originalPath);
+                journalPutU8(buffer, (uint8_t)pasteItem->item.type);
+                journalPutI64(buffer, pasteItem->item.size);
+                journalPutI64(buffer, (int64_t)pasteItem->item.created_at);
+            }
+            else {
+                TrashItem* trashItem = (TrashItem*)node->data;
+                journalPutString(buffer, trashItem->item.name);
+                journalPutString(buffer, trashItem->item.path);
+                journalPutString(buffer, trashItem->originalPath);
+                journalPutString(buffer, trashItem->trashPath);
+                journalPutString(buffer, trashItem->uid);
+                journalPutU8(buffer, (uint8_t)trashItem->item.type);
+                journalPutI64(buffer, trashItem->item.size);
+                journalPutI64(buffer, (int64_t)trashItem->deletedTime);
+            }
+        }
+    }
+    journalEndRecord(buffer, header);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - DECODING
+================================================================================
+*/
+
+/**
+ * @brief Replays records: rebuilds the undo stack and the interrupted list
+ *
+ * @internal
+ * @since 1.0
+ */
+static size_t _replay(const unsigned char* data, size_t length, void* context) {
+    ReplayState* state = (ReplayState*)context;
+    OpJournal* journal = state->journal;
+    size_t offset = 0;
+    size_t validLength = 0;
+    JournalReader reader;
+
+    while (journalNextRecord(data, length, &offset, &reader)) {
+        uint8_t kind = journalReadU8(&reader);
+
+        if (kind == OP_JOURNAL_PUSH) {
+            Operation* operation = _decodeOperation(&reader);
+            if (operation == NULL) {
+                break;
+            }
+            if (state->historyCount == state->historyCapacity) {
+                int capacity = state->historyCapacity ? state->historyCapacity * 2 : 32;
+                Operation** history = realloc(state->history, sizeof(Operation*) * capacity);
+                if (history == NULL) {
+                    destroyOperation(operation);
+                    break;
+                }
+                state->history = history;
+                state->historyCapacity = capacity;
+            }
+            state->history[state->historyCount++] = operation;
+        }
+        else if (kind == OP_JOURNAL_POP) {
+            if (state->historyCount > 0) {
+                destroyOperation(state->history[--state->historyCount]);
+            }
+        }
+        else if (kind == OP_JOURNAL_BEGIN) {
+            long long seq = journalReadI64(&reader);
+            ActionType type = (ActionType)journalReadU8(&reader);
+            bool isCopy = journalReadU8(&reader) != 0;
+            if (!reader.ok) {
+                break;
+            }
+
+            OpJournalIncomplete* grown = realloc(journal->incomplete, sizeof(OpJournalIncomplete) * (journal->incompleteCount + 1));
+            if (grown == NULL) {
+                break;
+            }
+            journal->incomplete = grown;
+            journal->incomplete[journal->incompleteCount++] = (OpJournalIncomplete){ seq, type, isCopy, NULL, 0, 0 };
+            if (seq >= journal->nextSeq) {
+                journal->nextSeq = seq + 1;
+            }
+        }
+        else if (kind == OP_JOURNAL_STEP) {
+            long long seq = journalReadI64(&reader);
+            OpJournalStep step = { 0 };
+            step.type = (ItemType)journalReadU8(&reader);
+            step.src = journalReadString(&reader);
+            step.dest = journalReadString(&reader);
+            step.uid = journalReadString(&reader);
+
+            OpJournalIncomplete* incomplete = reader.ok ? _findIncomplete(journal, seq) : NULL;
+            if (incomplete != NULL && incomplete->stepCount == incomplete->stepCapacity) {
+                int capacity = incomplete->stepCapacity ? incomplete->stepCapacity * 2 : 8;
+                OpJournalStep* steps = realloc(incomplete->steps, sizeof(OpJournalStep) * capacity);
+                if (steps != NULL) {
+                    incomplete->steps = steps;
+                    incomplete->stepCapacity = capacity;
+                }
+            }
+            if (incomplete == NULL || incomplete->stepCount == incomplete->stepCapacity) {
+                free(step.src);
+                free(step.dest);
+                free(step.uid);
+                if (!reader.ok) {
+                    break;
+                }
+            }
+            else {
+                incomplete->steps[incomplete->stepCount++] = step;
+            }
+        }
+        else if (kind == OP_JOURNAL_STEP_DONE || kind == OP_JOURNAL_END) {
+            long long seq = journalReadI64(&reader);
+            if (!reader.ok) {
+                break;
+            }
+            if (kind == OP_JOURNAL_END) {
+                _removeIncomplete(journal, seq);
+            }
+            else {
+                OpJournalIncomplete* incomplete = _findIncomplete(journal, seq);
+                if (incomplete != NULL && incomplete->stepCount > 0) {
+                    incomplete->steps[incomplete->stepCount - 1].done = true;
+                }
+            }
+        }
+        else {
+            break;
+        }
+
+        validLength = offset;
+        journal->records++;
+    }
+
+    return validLength;
+}
+
+/**
+ * @brief Decodes a PUSH payload into a newly allocated Operation
+ *
+ * @internal
+ * @since 1.0
+ */
+static Operation* _decodeOperation(JournalReader* reader) {
+    Operation* operation = calloc(1, sizeof(Operation));
+    if (operation == NULL) {
+        return NULL;
+    }
+    operation->type = (ActionType)journalReadU8(reader);
+    operation->isDir = journalReadU8(reader) != 0;
+    operation->isCopy = journalReadU8(reader) != 0;
+    operation->from = journalReadString(reader);
+    operation->to = journalReadString(reader);
+    int64_t count = journalReadI64(reader);
+
+    operation->itemTemp = malloc(sizeof(Queue));
+    if (operation->itemTemp == NULL) {
+        destroyOperation(operation);
+        return NULL;
+    }
+    create_queue(operation->itemTemp);
+
+    for (int64_t i = 0; i < count && reader->ok; i++) {
+        if (operation->type == ACTION_PASTE) {
+            PasteItem* pasteItem = calloc(1, sizeof(PasteItem));
+            if (pasteItem == NULL) {
+                reader->ok = false;
+                break;
+            }
+            pasteItem->item.name = journalReadString(reader);
+            pasteItem->item.path = journalReadString(reader);
+            memTrackAlloc(MEM_STRINGS, pasteItem->item.name);
+            memTrackAlloc(MEM_STRINGS, pasteItem->item.path);
+            pasteItem->originalPath = journalReadString(reader);
+            pasteItem->item.type = (ItemType)journalReadU8(reader);
+            pasteItem->item.size = (long)journalReadI64(reader);
+            pasteItem->item.created_at = (time_t)journalReadI64(reader);
+            enqueue(operation->itemTemp, pasteItem);
+        }
+        else {
+            TrashItem* trashItem = calloc(1, sizeof(TrashItem));
+            if (trashItem == NULL) {
+                reader->ok = false;
+                break;
+            }
+            trashItem->item.name = journalReadString(reader);
+            trashItem->item.path = journalReadString(reader);
+            memTrackAlloc(MEM_STRINGS, trashItem->item.name);
+            memTrackAlloc(MEM_STRINGS, trashItem->item.path);
+            trashItem->originalPath = journalReadString(reader);
+            trashItem->trashPath = journalReadString(reader);
+            trashItem->uid = journalReadString(reader);
+            trashItem->item.type = (ItemType)journalReadU8(reader);
+            trashItem->item.size = (long)journalReadI64(reader);
+            trashItem->deletedTime = (time_t)journalReadI64(reader);
+            trashItem->item.deleted_at = trashItem->deletedTime;
+            enqueue(operation->itemTemp, trashItem);
+        }
+    }
+
+    if (!reader->ok) {
+        destroyOperation(operation);
+        return NULL;
+    }
+    return operation;
+}
+
+/**
+ * @brief Finds an interrupted operation by sequence number
+ *
+ * @internal
+ * @since 1.0
+ */
+static OpJournalIncomplete* _findIncomplete(OpJournal* journal, long long seq) {
+    for (int i = journal->incompleteCount - 1; i >= 0; i--) {
+        if (journal->incomplete[i].seq == seq) {
+            return &journal->incomplete[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Removes a finished operation from the interrupted list
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _removeIncomplete(OpJournal* journal, long long seq) {
+    for (int i = 0; i < journal->incompleteCount; i++) {
+        OpJournalIncomplete* incomplete = &journal->incomplete[i];
+        if (incomplete->seq != seq) {
+            continue;
+        }
+        for (int j = 0; j < incomplete->stepCount; j++) {
+            free(incomplete->steps[j].src);
+            free(incomplete->steps[j].dest);
+            free(incomplete->steps[j].uid);
+        }
+        free(incomplete->steps);
+        journal->incomplete[i] = journal->incomplete[--journal->incompleteCount];
+        return;
+    }
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - FILE OPERATIONS
+================================================================================
+*/
+
+/**
+ * @brief Appends one record, optionally flushing it to disk
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _append(OpJournal* journal, JournalBuffer* record, bool flush) {
+    if (journal->fd >= 0 && record->data != NULL) {
+        if (!journalWriteAll(journal->fd, record->data, record->length)) {
+            logError("Gagal menulis operation journal (Error: %d)\n", errno);
+        }
+        else {
+            journal->records++;
+            if (flush) {
+                journalFlush(journal->fd);
+            }
+        }
+    }
+    journalBufferFree(record);
+}
@@ -1,7 +1,8 @@
 #include "operation.h"
 #include <string.h>
+#include "item.h"
 
-Operation createOperation(char* from, char* to, ActionType type, bool isDir, Queue* itemTemp) {
+Operation createOperation(const char* from, const char* to, ActionType type, bool isDir, Queue* itemTemp) {
     return (Operation) {
         .from = from ? strdup(from) : NULL,
         .to = to ? strdup(to) : NULL,
@@ -10,3 +11,33 @@ Operation createOperation(char* from, char* to, ActionType type, bool isDir, Que
         .itemTemp = itemTemp
     };
 }
+
+void destroyOperation(Operation* operation) {
+    if (operation == NULL) {
+        return;
+    }
+
+    if (operation->itemTemp != NULL) {
+        while (!is_queue_empty(*operation->itemTemp)) {
+            void* data = dequeue(operation->itemTemp);
+            if (operation->type == ACTION_PASTE) {
+                PasteItem* pasteItem = (PasteItem*)data;
+                destroyItem(&pasteItem->item);
+                free(pasteItem->originalPath);
+                free(pasteItem);
+            }
+            else if (operation->type == ACTION_DELETE || operation->type == ACTION_RECOVER) {
+                TrashItem* trashItem = (TrashItem*)data;
+                destroyItem(&trashItem->item);
+                free(trashItem->originalPath);
+                free(trashItem->trashPath);
+                free(trashItem->uid);
+                free(trashItem);
+            }
+        }
+        free(operation->itemTemp);
+    }
+    free(operation->from);
+    free(operation->to);
+    free(operation);
+}
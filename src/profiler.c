@@ -0,0 +1,309 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "logger.h"
+#include "profiler.h"
+
+#ifdef ALPENLI_PROFILE
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+/**
+ * @brief Completed zone
+ */
+typedef struct ProfileEvent {
+    const char* name;
+    long long start;               ///< Monotonic ns
+    long long duration;            ///< ns
+} ProfileEvent;
+
+/**
+ * @brief Per-thread event buffer, linked into a global list on first use
+ *
+ * Only the owning thread appends; count is published with release order
+ * so the exporting thread reads complete events.
+ */
+typedef struct ProfileBuffer {
+    ProfileEvent* events;
+    atomic_int count;
+    atomic_uint session;           ///< Capture the events belong to
+    int tid;
+    char threadName[32];
+    struct ProfileBuffer* next;
+} ProfileBuffer;
+
+static atomic_bool recording = false;
+static atomic_uint currentSession = 0;
+static long long captureStart = 0;
+static pthread_mutex_t buffersLock = PTHREAD_MUTEX_INITIALIZER;
+static ProfileBuffer* buffers = NULL;
+static int nextTid = 1;
+static atomic_llong dropped = 0;
+static _Thread_local ProfileBuffer* threadBuffer = NULL;
+static _Thread_local char pendingThreadName[32];
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static long long _nowNs(void);                           // Waktu monotonic dalam ns
+static ProfileBuffer* _threadBuffer(void);               // Buffer milik thread ini
+static void _writeName(FILE* file, const char* name);    // Nama sebagai string JSON
+
+/*
+================================================================================
+    CAPTURE CONTROL
+================================================================================
+*/
+
+bool profilerAvailable(void) {
+    return true;
+}
+
+bool profilerRecording(void) {
+    return atomic_load(&recording);
+}
+
+bool profilerStart(void) {
+    if (atomic_load(&recording)) {
+        return true;
+    }
+    // Event sesi lama diabaikan lewat nomor sesi, buffer tidak perlu dikosongkan di sini
+    atomic_fetch_add(&currentSession, 1);
+    atomic_store(&dropped, 0);
+    captureStart = _nowNs();
+    atomic_store(&recording, true);
+    logInfo("Profiling dimulai\n");
+    return true;
+}
+
+void profilerStop(void) {
+    if (atomic_exchange(&recording, false)) {
+        logInfo("Profiling berhenti\n");
+    }
+}
+
+bool profilerExport(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        logError("Gagal menulis trace %s\n", path);
+        return false;
+    }
+
+    unsigned session = atomic_load(&currentSession);
+    long long events = 0;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"AlpenliCloud\"}}");
+
+    pthread_mutex_lock(&buffersLock);
+    for (ProfileBuffer* buffer = buffers; buffer != NULL; buffer = buffer->next) {
+        if (atomic_load_explicit(&buffer->session, memory_order_acquire) != session) {
+            continue;
+        }
+        if (buffer->threadName[0] != '\0') {
+            fprintf(file, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":", buffer->tid);
+            _writeName(file, buffer->threadName);
+            fprintf(file, "}}");
+        }
+
+        int count = atomic_load_explicit(&buffer->count, memory_order_acquire);
+        for (int i = 0; i < count; i++) {
+            ProfileEvent* event = &buffer->events[i];
+            // Chrome trace memakai mikrodetik
+            fprintf(file, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+                buffer->tid, (double)(event->start - captureStart) / 1000.0, (double)event->duration / 1000.0);
+            _writeName(file, event->name);
+            fprintf(file, "}");
+        }
+        events += count;
+    }
+    pthread_mutex_unlock(&buffersLock);
+
+    fprintf(file, "\n]}\n");
+    bool ok = fclose(file) == 0;
+    long long lost = atomic_load(&dropped);
+    if (lost > 0) {
+        logWarn("Trace %s: %lld event dibuang (buffer thread penuh)\n", path, lost);
+    }
+    logInfo("Trace %s ditulis: %lld event\n", path, events);
+    return ok;
+}
+
+void profilerSetThreadName(const char* name) {
+    snprintf(pendingThreadName, sizeof(pendingThreadName), "%s", name);
+    if (threadBuffer != NULL) {
+        snprintf(threadBuffer->threadName, sizeof(threadBuffer->threadName), "%s", name);
+    }
+}
+
+/*
+================================================================================
+    ZONES
+================================================================================
+*/
+
+ProfileZone profileZoneBegin(const char* name) {
+    ProfileZone zone = { name, 0, 0 };
+    if (atomic_load_explicit(&recording, memory_order_relaxed)) {
+        zone.session = atomic_load_explicit(&currentSession, memory_order_relaxed);
+        zone.start = _nowNs();
+    }
+    return zone;
+}
+
+void profileZoneEnd(ProfileZone* zone) {
+    if (zone->start == 0 || !atomic_load_explicit(&recording, memory_order_relaxed)) {
+        return;
+    }
+    long long end = _nowNs();
+    ProfileBuffer* buffer = _threadBuffer();
+    if (buffer == NULL) {
+        return;
+    }
+
+    // Buffer dipakai ulang saat sesi baru dimulai
+    unsigned session = atomic_load_explicit(&currentSession, memory_order_relaxed);
+    if (zone->session != session) {
+        return;
+    }
+    if (atomic_load_explicit(&buffer->session, memory_order_relaxed) != session) {
+        atomic_store_explicit(&buffer->count, 0, memory_order_relaxed);
+        atomic_store_explicit(&buffer->session, session, memory_order_release);
+    }
+
+    int index = atomic_load_explicit(&buffer->count, memory_order_relaxed);
+    if (index >= PROFILE_EVENTS_PER_THREAD) {
+        atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+        return;
+    }
+    buffer->events[index].name = zone->name;
+    buffer->events[index].start = zone->start;
+    buffer->events[index].duration = end - zone->start;
+    atomic_store_explicit(&buffer->count, index + 1, memory_order_release);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Monotonic clock in nanoseconds
+ *
+ * @internal
+ * @since 1.0
+ */
+static long long _nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+ * @brief Returns the calling thread's buffer, creating it on first use
+ *
+ * Buffers are never freed: a thread that exits keeps its events for the
+ * export, and the list only grows by one entry per thread.
+ *
+ * @internal
+ * @since 1.0
+ */
+static ProfileBuffer* _threadBuffer(void) {
+    if (threadBuffer != NULL) {
+        return threadBuffer;
+    }
+
+    ProfileBuffer* buffer = calloc(1, sizeof(ProfileBuffer));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    buffer->events = malloc(sizeof(ProfileEvent) * PROFILE_EVENTS_PER_THREAD);
+    if (buffer->events == NULL) {
+        free(buffer);
+        return NULL;
+    }
+    atomic_init(&buffer->count, 0);
+    atomic_init(&buffer->session, 0);
+    snprintf(buffer->threadName, sizeof(buffer->threadName), "%s", pendingThreadName);
+
+    pthread_mutex_lock(&buffersLock);
+    buffer->tid = nextTid++;
+    buffer->next = buffers;
+    buffers = buffer;
+    pthread_mutex_unlock(&buffersLock);
+
+    threadBuffer = buffer;
+    return buffer;
+}
+
+/**
+ * @brief Writes a zone name as a JSON string
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _writeName(FILE* file, const char* name) {
+    fputc('"', file);
+    for (const char* c = name; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+        }
+        fputc((unsigned char)*c < 0x20 ? ' ' : *c, file);
+    }
+    fputc('"', file);
+}
+
+#else
+
+/*
+================================================================================
+    DISABLED BUILD
+================================================================================
+*/
+
+bool profilerAvailable(void) {
+    return false;
+}
+
+bool profilerRecording(void) {
+    return false;
+}
+
+bool profilerStart(void) {
+    logWarn("Profiling tidak tersedia; build ulang dengan make PROFILE=1\n");
+    return false;
+}
+
+void profilerStop(void) {
+}
+
+bool profilerExport(const char* path) {
+    (void)path;
+    return false;
+}
+
+void profilerSetThreadName(const char* name) {
+    (void)name;
+}
+
+ProfileZone profileZoneBegin(const char* name) {
+    ProfileZone zone = { name, 0, 0 };
+    return zone;
+}
+
+void profileZoneEnd(ProfileZone* zone) {
+    (void)zone;
+}
+
+#endif
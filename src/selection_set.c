@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "logger.h"
+#include "selection_set.h"
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void _unlink(SelectionSet* set, SelectionNode* node);   // Detach node and update totals
+
+/*
+================================================================================
+    LIFECYCLE
+================================================================================
+*/
+
+void createSelectionSet(SelectionSet* set) {
+    set->head = NULL;
+    create_pointer_hashmap(&set->index);
+    set->count = 0;
+    set->totalBytes = 0;
+}
+
+void destroySelectionSet(SelectionSet* set) {
+    SelectionNode* node = set->head;
+    while (node != NULL) {
+        SelectionNode* next = node->next;
+        free(node);
+        node = next;
+    }
+    set->head = NULL;
+    set->count = 0;
+    set->totalBytes = 0;
+    destroy_hashmap(&set->index);
+}
+
+/*
+================================================================================
+    OPERATIONS
+================================================================================
+*/
+
+bool selectionSetAdd(SelectionSet* set, Item* item) {
+    item->selected = true;
+    if (hashmap_contains(&set->index, item)) {
+        return false;
+    }
+
+    SelectionNode* node = malloc(sizeof(SelectionNode));
+    if (node == NULL) {
+        logError("Gagal mengalokasi memory untuk selected item\n");
+        return false;
+    }
+    node->data = item;
+    node->size = item->size;
+    node->prev = NULL;
+    node->next = set->head;
+    if (set->head != NULL) {
+        set->head->prev = node;
+    }
+    set->head = node;
+
+    hashmap_put(&set->index, item, node);
+    set->count++;
+    set->totalBytes += node->size;
+    return true;
+}
+
+bool selectionSetRemove(SelectionSet* set, Item* item) {
+    item->selected = false;
+    return selectionSetForget(set, item);
+}
+
+bool selectionSetForget(SelectionSet* set, const Item* item) {
+    SelectionNode* node = hashmap_remove(&set->index, item);
+    if (node == NULL) {
+        return false;
+    }
+    _unlink(set, node);
+    return true;
+}
+
+bool selectionSetContains(const SelectionSet* set, const Item* item) {
+    return hashmap_contains(&set->index, item);
+}
+
+void selectionSetClear(SelectionSet* set) {
+    SelectionNode* node = set->head;
+    while (node != NULL) {
+        SelectionNode* next = node->next;
+        node->data->selected = false;
+        free(node);
+        node = next;
+    }
+    set->head = NULL;
+    set->count = 0;
+    set->totalBytes = 0;
+    clear_hashmap(&set->index);
+}
+
+int selectionSetToArray(const SelectionSet* set, Item*** items) {
+    *items = NULL;
+    if (set->count == 0) {
+        return 0;
+    }
+    *items = malloc(sizeof(Item*) * set->count);
+    if (*items == NULL) {
+        logError("Overflow, Memory allocation failed\n");
+        return 0;
+    }
+
+    int i = 0;
+    for (SelectionNode* node = set->head; node != NULL; node = node->next) {
+        (*items)[i++] = node->data;
+    }
+    return i;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Unlinks a node from the list, frees it and updates the totals
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _unlink(SelectionSet* set, SelectionNode* node) {
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    }
+    else {
+        set->head = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+
+    set->count--;
+    set->totalBytes -= node->size;
+    free(node);
+}
@@ -0,0 +1,465 @@
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "journal_io.h"
+#include "logger.h"
+#include "mem_stats.h"
+#include "profiler.h"
+#include "trash_journal.h"
+
+#define TRASH_JOURNAL_MAGIC "ALPTRJ01"
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+typedef struct ReplayContext {
+    TrashStore* store;   // Store receiving replayed items
+    long records;        // Valid records seen
+} ReplayContext;
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+// ENCODING
+static void _encodeAdd(JournalBuffer* buffer, const TrashItem* trashItem);                   // Encode ADD record
+static void _encodeRemove(JournalBuffer* buffer, const char* uid);                           // Encode REMOVE record
+
+// DECODING
+static size_t _replay(const unsigned char* data, size_t length, void* context);               // Apply records to store
+
+// FILE OPERATIONS
+static void _appendRecord(TrashJournal* journal, JournalBuffer* record, int liveDelta);       // Append encoded record
+static void _serializeStore(const TrashStore* store, JournalBuffer* buffer, long* count);      // Encode all live items
+static char* _compactPath(const char* path);                                                  // "<path>.compact"
+static bool _swapCompacted(TrashJournal* journal, int fd, const char* tmpPath, long records);  // Append tail + rename
+static void* _compactWorker(void* arg);                                                       // Background compaction
+
+/*
+================================================================================
+    LIFECYCLE
+================================================================================
+*/
+
+bool openTrashJournal(TrashJournal* journal, const char* path, TrashStore* store) {
+    memset(journal, 0, sizeof(TrashJournal));
+    journal->path = strdup(path);
+    pthread_mutex_init(&journal->lock, NULL);
+
+    ReplayContext context = { store, 0 };
+    journal->fd = journalOpen(path, TRASH_JOURNAL_MAGIC, _replay, &context);
+    if (journal->fd < 0) {
+        return false;
+    }
+    journal->totalRecords = context.records;
+    journal->liveRecords = store->count;
+
+    logInfo("Trash journal dimuat: %ld record, %ld item aktif\n", journal->totalRecords, journal->liveRecords);
+    return true;
+}
+
+void closeTrashJournal(TrashJournal* journal) {
+    if (journal->compactorJoinable) {
+        pthread_join(journal->compactor, NULL);
+        journal->compactorJoinable = false;
+    }
+
+    trashJournalSync(journal);
+
+    if (journal->fd >= 0) {
+        close(journal->fd);
+        journal->fd = -1;
+    }
+    free(journal->path);
+    journal->path = NULL;
+    pthread_mutex_destroy(&journal->lock);
+}
+
+/*
+================================================================================
+    RECORDING
+================================================================================
+*/
+
+void trashJournalAppendAdd(TrashJournal* journal, const TrashItem* trashItem) {
+    JournalBuffer record = { 0 };
+    _encodeAdd(&record, trashItem);
+    _appendRecord(journal, &record, +1);
+    journalBufferFree(&record);
+}
+
+void trashJournalAppendRemove(TrashJournal* journal, const char* uid) {
+    JournalBuffer record = { 0 };
+    _encodeRemove(&record, uid);
+    _appendRecord(journal, &record, -1);
+    journalBufferFree(&record);
+}
+
+void trashJournalSync(TrashJournal* journal) {
+    PROFILE_FUNCTION();
+    pthread_mutex_lock(&journal->lock);
+    if (journal->fd >= 0 && journal->pendingSync > 0) {
+        if (!journalFlush(journal->fd)) {
+            logError("Gagal fsync trash journal (Error: %d)\n", errno);
+        }
+        journal->pendingSync = 0;
+    }
+    pthread_mutex_unlock(&journal->lock);
+}
+
+void trashJournalMaybeCompact(TrashJournal* journal, const TrashStore* store) {
+    PROFILE_FUNCTION();
+    pthread_mutex_lock(&journal->lock);
+    bool busy = journal->compacting;
+    long total = journal->totalRecords;
+    long live = journal->liveRecords;
+    pthread_mutex_unlock(&journal->lock);
+
+    if (busy || journal->fd < 0 || total < TRASH_JOURNAL_COMPACT_MIN || (total - live) <= total / 2) {
+        return;
+    }
+
+    if (journal->compactorJoinable) {
+        pthread_join(journal->compactor, NULL);
+        journal->compactorJoinable = false;
+    }
+
+    JournalBuffer snapshot = { 0 };
+    long count = 0;
+    _serializeStore(store, &snapshot, &count);
+
+    pthread_mutex_lock(&journal->lock);
+    journal->snapshot = snapshot.data;
+    journal->snapshotLength = snapshot.length;
+    journal->snapshotRecords = count;
+    journal->tailLength = 0;
+    journal->tailRecords = 0;
+    journal->compacting = true;
+    pthread_mutex_unlock(&journal->lock);
+
+    if (pthread_create(&journal->compactor, NULL, _compactWorker, journal) != 0) {
+        pthread_mutex_lock(&journal->lock);
+        journal->compacting = false;
+        free(journal->snapshot);
+        journal->snapshot = NULL;
+        pthread_mutex_unlock(&journal->lock);
+        logError("Gagal memulai kompaksi trash journal\n");
+        return;
+    }
+    journal->compactorJoinable = true;
+    logInfo("Kompaksi trash journal dimulai (%ld record, %ld aktif)\n", total, live);
+}
+
+bool trashJournalCompacting(TrashJournal* journal) {
+    pthread_mutex_lock(&journal->lock);
+    bool busy = journal->compacting;
+    pthread_mutex_unlock(&journal->lock);
+    return busy;
+}
+
+bool trashJournalRewrite(TrashJournal* journal, const TrashStore* store) {
+    PROFILE_FUNCTION();
+    if (journal->compactorJoinable) {
+        pthread_join(journal->compactor, NULL);
+        journal->compactorJoinable = false;
+    }
+
+    JournalBuffer snapshot = { 0 };
+    long count = 0;
+    _serializeStore(store, &snapshot, &count);
+
+    char* tmpPath = _compactPath(journal->path);
+    int fd = tmpPath ? journalCreateFile(tmpPath, TRASH_JOURNAL_MAGIC, snapshot.data, snapshot.length) : -1;
+
+    pthread_mutex_lock(&journal->lock);
+    bool ok = fd >= 0 && _swapCompacted(journal, fd, tmpPath, count);
+    if (ok) {
+        journal->liveRecords = count;
+    }
+    pthread_mutex_unlock(&journal->lock);
+
+    free(tmpPath);
+    journalBufferFree(&snapshot);
+    return ok;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - ENCODING
+================================================================================
+*/
+
+/**
+ * @brief Encodes an ADD record
+ *
+ * Payload: op, deletedTime, size, created_at, type, uid, name, originalPath, trashPath
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _encodeAdd(JournalBuffer* buffer, const TrashItem* trashItem) {
+    size_t header;
+    journalBeginRecord(buffer, &header);
+    journalPutU8(buffer, TRASH_JOURNAL_ADD);
+    journalPutI64(buffer, (int64_t)trashItem->deletedTime);
+    journalPutI64(buffer, (int64_t)trashItem->item.size);
+    journalPutI64(buffer, (int64_t)trashItem->item.created_at);
+    journalPutU8(buffer, (uint8_t)trashItem->item.type);
+    journalPutString(buffer, trashItem->uid);
+    journalPutString(buffer, trashItem->item.name);
+    journalPutString(buffer, trashItem->originalPath);
+    journalPutString(buffer, trashItem->trashPath);
+    journalEndRecord(buffer, header);
+}
+
+/**
+ * @brief Encodes a REMOVE record
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _encodeRemove(JournalBuffer* buffer, const char* uid) {
+    size_t header;
+    journalBeginRecord(buffer, &header);
+    journalPutU8(buffer, TRASH_JOURNAL_REMOVE);
+    journalPutString(buffer, uid);
+    journalEndRecord(buffer, header);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - DECODING
+================================================================================
+*/
+
+/**
+ * @brief Replays records into the store in one sequential pass
+ *
+ * @param[in] data Record area (after magic header)
+ * @param[in] length Length of record area
+ * @param[in,out] context ReplayContext with the target store
+ * @return Number of bytes that form complete, valid records
+ *
+ * @internal
+ * @since 1.0
+ */
+static size_t _replay(const unsigned char* data, size_t length, void* context) {
+    ReplayContext* replay = (ReplayContext*)context;
+    TrashStore* store = replay->store;
+    size_t offset = 0;
+    size_t validLength = 0;
+    JournalReader reader;
+
+    while (journalNextRecord(data, length, &offset, &reader)) {
+        uint8_t op = journalReadU8(&reader);
+
+        if (op == TRASH_JOURNAL_ADD) {
+            TrashItem* trashItem = calloc(1, sizeof(TrashItem));
+            if (trashItem == NULL) {
+                break;
+            }
+            trashItem->deletedTime = (time_t)journalReadI64(&reader);
+            trashItem->item.size = (long)journalReadI64(&reader);
+            trashItem->item.created_at = (time_t)journalReadI64(&reader);
+            trashItem->item.type = (ItemType)journalReadU8(&reader);
+            trashItem->uid = journalReadString(&reader);
+            trashItem->item.name = journalReadString(&reader);
+            memTrackAlloc(MEM_STRINGS, trashItem->item.name);
+            trashItem->originalPath = journalReadString(&reader);
+            trashItem->trashPath = journalReadString(&reader);
+
+            if (!reader.ok || trashItem->uid == NULL || trashItem->originalPath == NULL || trashItem->trashPath == NULL) {
+                freeTrashItem(trashItem);
+                break;
+            }
+
+            trashItem->item.deleted_at = trashItem->deletedTime;
+            trashItem->item.path = itemStrdup(trashItem->trashPath);
+            trashItem->item.selected = false;
+
+            if (trashStoreFindByUID(store, trashItem->uid) != NULL || !trashStoreInsert(store, trashItem)) {
+                freeTrashItem(trashItem);
+            }
+        }
+        else if (op == TRASH_JOURNAL_REMOVE) {
+            char* uid = journalReadString(&reader);
+            if (!reader.ok) {
+                free(uid);
+                break;
+            }
+            TrashItem* trashItem = trashStoreFindByUID(store, uid);
+            if (trashItem != NULL) {
+                trashStoreRemove(store, trashItem);
+                freeTrashItem(trashItem);
+            }
+            free(uid);
+        }
+        else {
+            break;
+        }
+
+        validLength = offset;
+        replay->records++;
+    }
+
+    return validLength;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - FILE OPERATIONS
+================================================================================
+*/
+
+/**
+ * @brief Appends one encoded record and syncs when the batch is full
+ *
+ * While a compaction is running the record is also kept in the tail
+ * buffer so the compactor can append it to the new file before swapping.
+ *
+ * @param[in,out] journal Open journal
+ * @param[in] record Encoded record
+ * @param[in] liveDelta +1 for ADD, -1 for REMOVE
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _appendRecord(TrashJournal* journal, JournalBuffer* record, int liveDelta) {
+    if (record->data == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&journal->lock);
+    if (journal->fd >= 0) {
+        if (!journalWriteAll(journal->fd, record->data, record->length)) {
+            logError("Gagal menulis trash journal (Error: %d)\n", errno);
+        }
+        else {
+            journal->totalRecords++;
+            journal->liveRecords += liveDelta;
+            journal->pendingSync++;
+
+            if (journal->compacting) {
+                JournalBuffer tail = { journal->tail, journal->tailLength, journal->tailCapacity };
+                journalPut(&tail, record->data, record->length);
+                journal->tail = tail.data;
+                journal->tailLength = tail.length;
+                journal->tailCapacity = tail.capacity;
+                journal->tailRecords++;
+            }
+
+            if (journal->pendingSync >= TRASH_JOURNAL_SYNC_BATCH) {
+                journalFlush(journal->fd);
+                journal->pendingSync = 0;
+            }
+        }
+    }
+    pthread_mutex_unlock(&journal->lock);
+}
+
+/**
+ * @brief Encodes every item of the store as ADD records, oldest first
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _serializeStore(const TrashStore* store, JournalBuffer* buffer, long* count) {
+    *count = 0;
+    for (TrashNode* node = store->tail; node != NULL; node = node->prev) {
+        _encodeAdd(buffer, node->data);
+        (*count)++;
+    }
+}
+
+/**
+ * @brief Appends the tail buffer to the compacted file and swaps it in
+ *
+ * Must be called with journal->lock held so no record is appended to the
+ * old file between the tail copy and the rename.
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _swapCompacted(TrashJournal* journal, int fd, const char* tmpPath, long records) {
+    bool ok = journal->tailLength == 0 || journalWriteAll(fd, journal->tail, journal->tailLength);
+    ok = ok && journalFlush(fd);
+    ok = ok && journalReplaceFile(tmpPath, journal->path, &journal->fd);
+
+    if (!ok) {
+        logError("Gagal menulis trash journal terkompaksi (Error: %d)\n", errno);
+        close(fd);
+        remove(tmpPath);
+        return false;
+    }
+
+    if (journal->fd >= 0) {
+        close(journal->fd);
+    }
+    journal->fd = fd;
+    journal->totalRecords = records + journal->tailRecords;
+    journal->pendingSync = 0;
+    return true;
+}
+
+/**
+ * @brief Builds "<path>.compact"
+ *
+ * @internal
+ * @since 1.0
+ */
+static char* _compactPath(const char* path) {
+    size_t length = strlen(path) + sizeof(".compact");
+    char* tmpPath = malloc(length);
+    if (tmpPath != NULL) {
+        snprintf(tmpPath, length, "%s.compact", path);
+    }
+    return tmpPath;
+}
+
+/**
+ * @brief Background thread writing the compacted journal
+ *
+ * The snapshot is written without holding the lock so appends from the UI
+ * thread are not blocked; only the tail copy and the rename are locked.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void* _compactWorker(void* arg) {
+    PROFILE_THREAD_NAME("journal compaction");
+    PROFILE_FUNCTION();
+    TrashJournal* journal = (TrashJournal*)arg;
+    char* tmpPath = _compactPath(journal->path);
+    int fd = tmpPath ? journalCreateFile(tmpPath, TRASH_JOURNAL_MAGIC, journal->snapshot, journal->snapshotLength) : -1;
+
+    pthread_mutex_lock(&journal->lock);
+    bool ok = fd >= 0 && _swapCompacted(journal, fd, tmpPath, journal->snapshotRecords);
+    journal->compacting = false;
+    free(journal->snapshot);
+    journal->snapshot = NULL;
+    journal->snapshotLength = 0;
+    free(journal->tail);
+    journal->tail = NULL;
+    journal->tailLength = 0;
+    journal->tailCapacity = 0;
+    journal->tailRecords = 0;
+    pthread_mutex_unlock(&journal->lock);
+
+    free(tmpPath);
+    logInfo("Kompaksi trash journal %s\n", ok ? "selesai" : "gagal");
+    return NULL;
+}
@@ -0,0 +1,300 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "logger.h"
+#include "profiler.h"
+#include "trash_purger.h"
+#include "win_utils.h"
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void* _purgeWorker(void* arg);                         // Worker thread loop
+static void _purgeItem(TrashPurger* purger, TrashItem* item);  // Delete one item from disk
+static void _lowerThreadPriority(void);                       // Idle CPU + I/O priority
+static void _throttle(long size);                             // Sleep according to I/O budget
+static long _envLong(const char* name, long fallback);        // Read numeric env override
+
+/*
+================================================================================
+    RETENTION POLICY
+================================================================================
+*/
+
+void loadTrashRetention(TrashRetention* retention) {
+    retention->maxAgeSeconds = _envLong("ALPENLI_TRASH_MAX_AGE_DAYS", TRASH_RETENTION_MAX_AGE_DAYS) * 24L * 60L * 60L;
+    retention->maxBytes = (long long)_envLong("ALPENLI_TRASH_MAX_MB", (long)(TRASH_RETENTION_MAX_BYTES >> 20)) << 20;
+    retention->maxItems = (int)_envLong("ALPENLI_TRASH_MAX_ITEMS", TRASH_RETENTION_MAX_ITEMS);
+
+    logInfo("Retensi trash: umur %ld hari, ukuran %lld MB, %d item\n",
+        retention->maxAgeSeconds / (24L * 60L * 60L), retention->maxBytes >> 20, retention->maxItems);
+}
+
+bool isTrashOverRetention(const TrashRetention* retention, const TrashStore* store, time_t now) {
+    if (store->tail == NULL) {
+        return false;
+    }
+    if (retention->maxItems > 0 && store->count > retention->maxItems) {
+        return true;
+    }
+    if (retention->maxBytes > 0 && store->totalBytes > retention->maxBytes) {
+        return true;
+    }
+    if (retention->maxAgeSeconds > 0 && now - store->tail->data->deletedTime > retention->maxAgeSeconds) {
+        return true;
+    }
+    return false;
+}
+
+/*
+================================================================================
+    PURGE WORKER
+================================================================================
+*/
+
+bool startTrashPurger(TrashPurger* purger, TrashJournal* journal) {
+    create_queue(&purger->jobs);
+    create_queue(&purger->failed);
+    purger->journal = journal;
+    purger->running = false;
+    purger->stopping = false;
+    purger->purgedItems = 0;
+    purger->purgedBytes = 0;
+    pthread_mutex_init(&purger->lock, NULL);
+    pthread_cond_init(&purger->wake, NULL);
+
+    if (pthread_create(&purger->thread, NULL, _purgeWorker, purger) != 0) {
+        logError("Gagal memulai worker purge trash, purge berjalan langsung\n");
+        return false;
+    }
+    purger->running = true;
+    return true;
+}
+
+void trashPurgerSubmit(TrashPurger* purger, TrashItem* trashItem) {
+    if (!purger->running) {
+        _purgeItem(purger, trashItem);
+        return;
+    }
+
+    pthread_mutex_lock(&purger->lock);
+    enqueue(&purger->jobs, trashItem);
+    pthread_cond_signal(&purger->wake);
+    pthread_mutex_unlock(&purger->lock);
+}
+
+int trashPurgerReclaim(TrashPurger* purger, TrashStore* store) {
+    // Setelah stop worker sudah selesai, antrean gagal tidak perlu dikunci
+    bool locked = purger->running;
+    if (locked) {
+        pthread_mutex_lock(&purger->lock);
+    }
+
+    int reclaimed = 0;
+    while (!is_queue_empty(purger->failed)) {
+        TrashItem* trashItem = (TrashItem*)dequeue(&purger->failed);
+        if (trashStoreInsert(store, trashItem)) {
+            reclaimed++;
+        }
+        else {
+            // Record ADD masih ada di journal, item kembali saat load berikutnya
+            logError("Gagal mengembalikan %s ke trash\n", trashItem->item.name);
+            freeTrashItem(trashItem);
+        }
+    }
+    if (locked) {
+        pthread_mutex_unlock(&purger->lock);
+    }
+
+    if (reclaimed > 0) {
+        logWarn("Purge trash: %d item gagal dihapus, dicoba lagi pada purge berikutnya\n", reclaimed);
+    }
+    return reclaimed;
+}
+
+int trashPurgerPending(TrashPurger* purger) {
+    if (!purger->running) {
+        return 0;
+    }
+    pthread_mutex_lock(&purger->lock);
+    int pending = purger->jobs.length;
+    pthread_mutex_unlock(&purger->lock);
+    return pending;
+}
+
+void stopTrashPurger(TrashPurger* purger) {
+    if (purger->running) {
+        pthread_mutex_lock(&purger->lock);
+        purger->stopping = true;
+        pthread_cond_signal(&purger->wake);
+        pthread_mutex_unlock(&purger->lock);
+
+        pthread_join(purger->thread, NULL);
+        purger->running = false;
+    }
+
+    if (purger->purgedItems > 0) {
+        logInfo("Purge trash: %lld item (%lld byte) dihapus\n", purger->purgedItems, purger->purgedBytes);
+    }
+    pthread_cond_destroy(&purger->wake);
+    pthread_mutex_destroy(&purger->lock);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Worker loop: waits for jobs and deletes them one at a time
+ *
+ * @internal
+ * @since 1.0
+ */
+static void* _purgeWorker(void* arg) {
+    TrashPurger* purger = (TrashPurger*)arg;
+    PROFILE_THREAD_NAME("trash purger");
+    _lowerThreadPriority();
+
+    while (true) {
+        pthread_mutex_lock(&purger->lock);
+        while (is_queue_empty(purger->jobs) && !purger->stopping) {
+            pthread_cond_wait(&purger->wake, &purger->lock);
+        }
+        if (is_queue_empty(purger->jobs)) {
+            pthread_mutex_unlock(&purger->lock);
+            break;
+        }
+        TrashItem* trashItem = (TrashItem*)dequeue(&purger->jobs);
+        bool stopping = purger->stopping;
+        pthread_mutex_unlock(&purger->lock);
+
+        long size = trashItem->item.size;
+        _purgeItem(purger, trashItem);
+
+        if (!stopping) {
+            _throttle(size);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Deletes a detached trash item from disk, journals it and frees it
+ *
+ * On failure the item is neither journaled nor freed but parked in the
+ * failed queue until the owning thread reclaims it.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _purgeItem(TrashPurger* purger, TrashItem* trashItem) {
+    PROFILE_FUNCTION();
+    bool removed;
+    if (trashItem->item.type == ITEM_FOLDER) {
+        removed = RemoveItemsRecurse(trashItem->trashPath) == 1;
+    }
+    else {
+        removed = remove(trashItem->trashPath) == 0 || errno == ENOENT;
+    }
+
+    if (!removed) {
+        logWarn("Gagal purge trash %s (Error: %d), item tetap di trash\n", trashItem->item.name, errno);
+        if (purger->running) {
+            pthread_mutex_lock(&purger->lock);
+        }
+        enqueue(&purger->failed, trashItem);
+        if (purger->running) {
+            pthread_mutex_unlock(&purger->lock);
+        }
+        return;
+    }
+
+    trashJournalAppendRemove(purger->journal, trashItem->uid);
+    purger->purgedItems++;
+    purger->purgedBytes += trashItem->item.size;
+    logDebug("Purge trash: %s (UID: %s)\n", trashItem->item.name, trashItem->uid);
+    freeTrashItem(trashItem);
+}
+
+/**
+ * @brief Drops the calling thread to idle CPU and I/O priority
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _lowerThreadPriority(void) {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#elif defined(__linux__)
+    // Di Linux nice dan ioprio berlaku per thread
+    pid_t tid = (pid_t)syscall(SYS_gettid);
+    setpriority(PRIO_PROCESS, tid, 19);
+#ifdef SYS_ioprio_set
+    const int ioprioWhoProcess = 1;
+    const int ioprioClassIdle = 3;
+    syscall(SYS_ioprio_set, ioprioWhoProcess, tid, ioprioClassIdle << 13);
+#endif
+#endif
+}
+
+/**
+ * @brief Sleeps long enough to keep deletes under the I/O budget
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _throttle(long size) {
+    long long delayMs = TRASH_PURGE_ITEM_DELAY_MS;
+    if (size > 0) {
+        delayMs += (long long)size * 1000 / TRASH_PURGE_BYTES_PER_SEC;
+    }
+    if (delayMs > 2000) {
+        delayMs = 2000;
+    }
+
+#ifdef _WIN32
+    Sleep((DWORD)delayMs);
+#else
+    struct timespec ts = { (time_t)(delayMs / 1000), (long)(delayMs % 1000) * 1000000L };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+#endif
+}
+
+/**
+ * @brief Reads a non-negative integer from the environment
+ *
+ * @internal
+ * @since 1.0
+ */
+static long _envLong(const char* name, long fallback) {
+    const char* value = getenv(name);
+    if (value == NULL || *value == '\0') {
+        return fallback;
+    }
+    char* end = NULL;
+    long parsed = strtol(value, &end, 10);
+    if (end == value || parsed < 0) {
+        return fallback;
+    }
+    return parsed;
+}
@@ -0,0 +1,293 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "logger.h"
+#include "mem_stats.h"
+#include "trash_store.h"
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+static void _linkBefore(TrashStore* store, TrashNode* node, TrashNode* before);  // Link node before another (NULL = tail)
+static bool _indexNode(TrashStore* store, TrashNode* node);                      // Add node to all indexes
+static void _unindexNode(TrashStore* store, TrashNode* node);                    // Remove node from all indexes
+static long long _footprint(const TrashNode* node);                               // Heap bytes owned through a node
+
+/*
+================================================================================
+    LIFECYCLE
+================================================================================
+*/
+
+void createTrashStore(TrashStore* store) {
+    store->head = NULL;
+    store->tail = NULL;
+    store->count = 0;
+    store->totalBytes = 0;
+    create_string_hashmap(&store->byUid);
+    create_string_hashmap(&store->byOriginalPath);
+    create_pointer_hashmap(&store->byItem);
+}
+
+void destroyTrashStore(TrashStore* store) {
+    TrashNode* current = store->head;
+    while (current != NULL) {
+        TrashNode* next = current->next;
+        memAccount(MEM_TRASH, -_footprint(current), -2);
+        freeTrashItem(current->data);
+        free(current);
+        current = next;
+    }
+
+    destroy_hashmap(&store->byUid);
+    destroy_hashmap(&store->byOriginalPath);
+    destroy_hashmap(&store->byItem);
+    store->head = NULL;
+    store->tail = NULL;
+    store->count = 0;
+    store->totalBytes = 0;
+}
+
+void freeTrashItem(TrashItem* trashItem) {
+    if (trashItem == NULL) {
+        return;
+    }
+    free(trashItem->uid);
+    destroyItem(&trashItem->item);
+    free(trashItem->originalPath);
+    free(trashItem->trashPath);
+    free(trashItem);
+}
+
+/*
+================================================================================
+    OPERATIONS
+================================================================================
+*/
+
+bool trashStoreInsert(TrashStore* store, TrashItem* trashItem) {
+    TrashNode* node = (TrashNode*)malloc(sizeof(TrashNode));
+    if (node == NULL) {
+        logError("Gagal mengalokasikan node trash\n");
+        return false;
+    }
+    node->data = trashItem;
+    node->next = NULL;
+    node->prev = NULL;
+    node->samePathNext = NULL;
+    node->samePathPrev = NULL;
+
+    if (!_indexNode(store, node)) {
+        free(node);
+        return false;
+    }
+
+    // Urutan: terbaru di head. Kasus umum O(1): paling baru atau paling lama.
+    if (store->head == NULL || trashItem->deletedTime >= store->head->data->deletedTime) {
+        _linkBefore(store, node, store->head);
+    }
+    else if (trashItem->deletedTime <= store->tail->data->deletedTime) {
+        _linkBefore(store, node, NULL);
+    }
+    else {
+        TrashNode* cursor = store->head;
+        while (cursor != NULL && cursor->data->deletedTime > trashItem->deletedTime) {
+            cursor = cursor->next;
+        }
+        _linkBefore(store, node, cursor);
+    }
+
+    store->count++;
+    store->totalBytes += trashItem->item.size;
+    memAccount(MEM_TRASH, _footprint(node), 2);
+    return true;
+}
+
+bool trashStoreRemove(TrashStore* store, TrashItem* trashItem) {
+    if (trashItem == NULL) {
+        return false;
+    }
+
+    TrashNode* node = (TrashNode*)hashmap_get(&store->byItem, &trashItem->item);
+    if (node == NULL) {
+        return false;
+    }
+
+    _unindexNode(store, node);
+
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    }
+    else {
+        store->head = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+    else {
+        store->tail = node->prev;
+    }
+
+    store->count--;
+    store->totalBytes -= trashItem->item.size;
+    memAccount(MEM_TRASH, -_footprint(node), -2);
+    free(node);
+    return true;
+}
+
+TrashItem* trashStoreFindByUID(const TrashStore* store, const char* uid) {
+    if (uid == NULL) {
+        return NULL;
+    }
+    TrashNode* node = (TrashNode*)hashmap_get(&store->byUid, uid);
+    return node ? node->data : NULL;
+}
+
+TrashItem* trashStoreFindByOriginalPath(const TrashStore* store, const char* originalPath) {
+    if (originalPath == NULL) {
+        return NULL;
+    }
+    TrashNode* node = (TrashNode*)hashmap_get(&store->byOriginalPath, originalPath);
+    return node ? node->data : NULL;
+}
+
+TrashItem* trashStoreFindByItem(const TrashStore* store, const Item* item) {
+    if (item == NULL) {
+        return NULL;
+    }
+    TrashNode* node = (TrashNode*)hashmap_get(&store->byItem, item);
+    return node ? node->data : NULL;
+}
+
+bool isTrashStoreEmpty(const TrashStore* store) {
+    return store->head == NULL;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS
+================================================================================
+*/
+
+/**
+ * @brief Links node into the ordered list before another node
+ *
+ * @param[in,out] store Target store
+ * @param[in] node Node to link
+ * @param[in] before Node that will follow, or NULL to append at tail
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _linkBefore(TrashStore* store, TrashNode* node, TrashNode* before) {
+    if (before == NULL) {
+        node->prev = store->tail;
+        node->next = NULL;
+        if (store->tail != NULL) {
+            store->tail->next = node;
+        }
+        else {
+            store->head = node;
+        }
+        store->tail = node;
+        return;
+    }
+
+    node->next = before;
+    node->prev = before->prev;
+    if (before->prev != NULL) {
+        before->prev->next = node;
+    }
+    else {
+        store->head = node;
+    }
+    before->prev = node;
+}
+
+/**
+ * @brief Adds node to UID, original path and item indexes
+ *
+ * @param[in,out] store Target store
+ * @param[in] node Node to index
+ * @return true if all indexes were updated
+ *
+ * @internal
+ * @since 1.0
+ */
+static bool _indexNode(TrashStore* store, TrashNode* node) {
+    TrashItem* trashItem = node->data;
+
+    if (!hashmap_put(&store->byUid, trashItem->uid, node)) {
+        return false;
+    }
+    if (!hashmap_put(&store->byItem, &trashItem->item, node)) {
+        hashmap_remove_entry(&store->byUid, trashItem->uid, node);
+        return false;
+    }
+
+    // Satu entry per path; item lain dari path yang sama dirantai di node
+    TrashNode* samePath = (TrashNode*)hashmap_remove(&store->byOriginalPath, trashItem->originalPath);
+    if (!hashmap_put(&store->byOriginalPath, trashItem->originalPath, node)) {
+        if (samePath != NULL) {
+            hashmap_put(&store->byOriginalPath, samePath->data->originalPath, samePath);
+        }
+        hashmap_remove_entry(&store->byUid, trashItem->uid, node);
+        hashmap_remove_entry(&store->byItem, &trashItem->item, node);
+        return false;
+    }
+    node->samePathNext = samePath;
+    if (samePath != NULL) {
+        samePath->samePathPrev = node;
+    }
+    return true;
+}
+
+/**
+ * @brief Removes node from all indexes
+ *
+ * @param[in,out] store Target store
+ * @param[in] node Node to unindex
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _unindexNode(TrashStore* store, TrashNode* node) {
+    TrashItem* trashItem = node->data;
+    hashmap_remove_entry(&store->byUid, trashItem->uid, node);
+    hashmap_remove_entry(&store->byItem, &trashItem->item, node);
+
+    if (node->samePathPrev != NULL) {
+        node->samePathPrev->samePathNext = node->samePathNext;
+    }
+    else {
+        // Node adalah entry index; gantikan dengan item berikutnya dari path yang sama
+        hashmap_remove_entry(&store->byOriginalPath, trashItem->originalPath, node);
+        if (node->samePathNext != NULL) {
+            hashmap_put(&store->byOriginalPath, node->samePathNext->data->originalPath, node->samePathNext);
+        }
+    }
+    if (node->samePathNext != NULL) {
+        node->samePathNext->samePathPrev = node->samePathPrev;
+    }
+}
+
+/**
+ * @brief Heap bytes the store owns through one node
+ *
+ * The node, the TrashItem struct and its uid, originalPath and trashPath.
+ * Item name and path are counted as MEM_STRINGS by whoever made them.
+ * None of these change while the item is in the store, so insert and
+ * remove report the same amount.
+ *
+ * @internal
+ * @since 1.0
+ */
+static long long _footprint(const TrashNode* node) {
+    const TrashItem* trashItem = node->data;
+    return (long long)(memBlockSize(node) + memBlockSize(trashItem) + memBlockSize(trashItem->uid) +
+                       memBlockSize(trashItem->originalPath) + memBlockSize(trashItem->trashPath));
+}
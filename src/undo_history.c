@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "logger.h"
+#include "mem_stats.h"
+#include "undo_history.h"
+
+/*
+================================================================================
+    PRIVATE TYPES
+================================================================================
+*/
+
+typedef struct InternedPath {
+    size_t refs;     // Entries referencing this string
+    char text[];     // NUL-terminated string, also the map key
+} InternedPath;
+
+/*
+================================================================================
+    PRIVATE HELPER PROTOTYPES
+================================================================================
+*/
+
+// PATH POOL
+static const char* _intern(PathPool* pool, const char* text);    // Share or add a string
+static void _release(PathPool* pool, const char* text);          // Drop one reference
+
+// ENTRIES
+static void _releaseEntry(UndoHistory* history, UndoEntry* entry);   // Release strings and item array
+static void _evictOldest(UndoHistory* history);                      // Drop tail entry
+static const char* _baseName(const char* path);                     // Last path component
+static char* _dupOrNull(const char* text);                          // strdup that keeps NULL
+
+/*
+================================================================================
+    LIFECYCLE
+================================================================================
+*/
+
+size_t loadUndoBudget(void) {
+    const char* value = getenv("ALPENLI_UNDO_BUDGET_KB");
+    if (value == NULL || *value == '\0') {
+        return UNDO_HISTORY_BUDGET_BYTES;
+    }
+    char* end = NULL;
+    long parsed = strtol(value, &end, 10);
+    if (end == value || parsed < 0) {
+        return UNDO_HISTORY_BUDGET_BYTES;
+    }
+    return (size_t)parsed * 1024;
+}
+
+void createUndoHistory(UndoHistory* history, size_t budget) {
+    history->entries.head = NULL;
+    history->entries.tail = NULL;
+    history->entries.size = 0;
+    create_string_hashmap(&history->paths.map);
+    history->paths.bytes = 0;
+    history->entryBytes = 0;
+    history->budget = budget;
+    history->evicted = 0;
+}
+
+void destroyUndoHistory(UndoHistory* history) {
+    clearUndoHistory(history);
+    destroy_hashmap(&history->paths.map);
+}
+
+/*
+================================================================================
+    STACK OPERATIONS
+================================================================================
+*/
+
+int undoHistoryPush(UndoHistory* history, const Operation* operation) {
+    UndoEntry* entry = malloc(sizeof(UndoEntry));
+    if (entry == NULL) {
+        logError("Overflow, Memory allocation failed\n");
+        return 0;
+    }
+
+    entry->from = _intern(&history->paths, operation->from);
+    entry->to = _intern(&history->paths, operation->to);
+    entry->type = (uint8_t)operation->type;
+    entry->flags = (operation->isDir ? UNDO_FLAG_DIR : 0) | (operation->isCopy ? UNDO_FLAG_COPY : 0);
+    entry->items = NULL;
+    entry->itemCount = 0;
+
+    bool hasItems = operation->itemTemp != NULL &&
+        (operation->type == ACTION_PASTE || operation->type == ACTION_DELETE || operation->type == ACTION_RECOVER);
+    int count = 0;
+    if (hasItems) {
+        count = get_queue_length(*operation->itemTemp);
+    }
+    if (count > 0) {
+        entry->items = malloc(sizeof(UndoItem) * count);
+        if (entry->items == NULL) {
+            logError("Overflow, Memory allocation failed\n");
+            count = 0;
+        }
+    }
+
+    Node* node = hasItems ? operation->itemTemp->front : NULL;
+    for (int i = 0; i < count; i++, node = node->next) {
+        UndoItem* record = &entry->items[i];
+        const Item* item;
+
+        if (operation->type == ACTION_PASTE) {
+            const PasteItem* pasteItem = (const PasteItem*)node->data;
+            item = &pasteItem->item;
+            record->originalPath = _intern(&history->paths, pasteItem->originalPath);
+            record->trashPath = NULL;
+            record->uid = NULL;
+            record->time = item->created_at;
+        }
+        else {
+            const TrashItem* trashItem = (const TrashItem*)node->data;
+            item = &trashItem->item;
+            record->originalPath = _intern(&history->paths, trashItem->originalPath);
+            record->trashPath = _intern(&history->paths, trashItem->trashPath);
+            record->uid = _intern(&history->paths, trashItem->uid);
+            record->time = trashItem->deletedTime;
+        }
+
+        record->path = _intern(&history->paths, item->path);
+        bool derivable = item->name == NULL || (item->path != NULL && strcmp(item->name, _baseName(item->path)) == 0);
+        record->name = derivable ? NULL : _intern(&history->paths, item->name);
+        record->size = item->size;
+        record->flags = (item->type == ITEM_FOLDER) ? UNDO_ITEM_FOLDER : 0;
+        entry->itemCount++;
+    }
+
+    DLL_insertFront(&history->entries, entry);
+    size_t entryBytes = sizeof(UndoEntry) + sizeof(UndoItem) * (size_t)entry->itemCount;
+    history->entryBytes += entryBytes;
+    memAccount(MEM_UNDO, (long long)entryBytes, 1);
+
+    int evicted = 0;
+    while (history->budget > 0 && history->entries.size > 1 && undoHistoryBytes(history) > history->budget) {
+        _evictOldest(history);
+        evicted++;
+    }
+    if (evicted > 0) {
+        history->evicted += evicted;
+        logWarn("Riwayat undo melebihi batas %zu KB: %d entri terlama dibuang\n", history->budget / 1024, evicted);
+    }
+    return evicted;
+}
+
+Operation* undoHistoryPop(UndoHistory* history) {
+    if (history->entries.head == NULL) {
+        return NULL;
+    }
+    UndoEntry* entry = (UndoEntry*)history->entries.head->data;
+    Operation* operation = undoHistoryExpand(entry);
+
+    _releaseEntry(history, entry);
+    DLL_removeFront(&history->entries, history->entries.head);  // frees entry
+    return operation;
+}
+
+Operation* undoHistoryExpand(const UndoEntry* entry) {
+    Operation* operation = malloc(sizeof(Operation));
+    if (operation == NULL) {
+        logError("Overflow, Memory allocation failed\n");
+        return NULL;
+    }
+    *operation = createOperation((char*)entry->from, (char*)entry->to, (ActionType)entry->type,
+        (entry->flags & UNDO_FLAG_DIR) != 0, NULL);
+    operation->isCopy = (entry->flags & UNDO_FLAG_COPY) != 0;
+
+    operation->itemTemp = malloc(sizeof(Queue));
+    if (operation->itemTemp == NULL) {
+        logError("Overflow, Memory allocation failed\n");
+        return operation;
+    }
+    create_queue(operation->itemTemp);
+
+    for (int i = 0; i < entry->itemCount; i++) {
+        const UndoItem* record = &entry->items[i];
+        ItemType type = (record->flags & UNDO_ITEM_FOLDER) ? ITEM_FOLDER : ITEM_FILE;
+        const char* name = record->name ? record->name : (record->path ? _baseName(record->path) : NULL);
+
+        if (entry->type == ACTION_PASTE) {
+            PasteItem* pasteItem = malloc(sizeof(PasteItem));
+            if (pasteItem == NULL) {
+                break;
+            }
+            pasteItem->item = createItem((char*)name, (char*)record->path, record->size, type, record->time, record->time, 0);
+            pasteItem->originalPath = _dupOrNull(record->originalPath);
+            enqueue(operation->itemTemp, pasteItem);
+        }
+        else {
+            TrashItem* trashItem = malloc(sizeof(TrashItem));
+            if (trashItem == NULL) {
+                break;
+            }
+            trashItem->item = createItem((char*)name, (char*)record->path, record->size, type, 0, 0, record->time);
+            trashItem->originalPath = _dupOrNull(record->originalPath);
+            trashItem->trashPath = _dupOrNull(record->trashPath);
+            trashItem->uid = _dupOrNull(record->uid);
+            trashItem->deletedTime = record->time;
+            enqueue(operation->itemTemp, trashItem);
+        }
+    }
+    return operation;
+}
+
+bool isUndoHistoryEmpty(const UndoHistory* history) {
+    return history->entries.head == NULL;
+}
+
+void clearUndoHistory(UndoHistory* history) {
+    while (history->entries.head != NULL) {
+        _releaseEntry(history, (UndoEntry*)history->entries.head->data);
+        DLL_removeFront(&history->entries, history->entries.head);
+    }
+}
+
+size_t undoHistoryBytes(const UndoHistory* history) {
+    return history->entryBytes + history->paths.bytes;
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - PATH POOL
+================================================================================
+*/
+
+/**
+ * @brief Returns the pooled copy of text, adding it on first use
+ *
+ * @internal
+ * @since 1.0
+ */
+static const char* _intern(PathPool* pool, const char* text) {
+    if (text == NULL) {
+        return NULL;
+    }
+
+    InternedPath* interned = hashmap_get(&pool->map, text);
+    if (interned != NULL) {
+        interned->refs++;
+        return interned->text;
+    }
+
+    size_t length = strlen(text) + 1;
+    interned = malloc(sizeof(InternedPath) + length);
+    if (interned == NULL) {
+        logError("Overflow, Memory allocation failed\n");
+        return NULL;
+    }
+    interned->refs = 1;
+    memcpy(interned->text, text, length);
+    hashmap_put(&pool->map, interned->text, interned);
+    pool->bytes += sizeof(InternedPath) + length + sizeof(HashEntry);
+    memAccount(MEM_UNDO, (long long)(sizeof(InternedPath) + length + sizeof(HashEntry)), 1);
+    return interned->text;
+}
+
+/**
+ * @brief Drops one reference, freeing the string when it reaches zero
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _release(PathPool* pool, const char* text) {
+    if (text == NULL) {
+        return;
+    }
+
+    InternedPath* interned = hashmap_get(&pool->map, text);
+    if (interned == NULL || --interned->refs > 0) {
+        return;
+    }
+    hashmap_remove_entry(&pool->map, interned->text, interned);
+    size_t bytes = sizeof(InternedPath) + strlen(interned->text) + 1 + sizeof(HashEntry);
+    pool->bytes -= bytes;
+    memAccount(MEM_UNDO, -(long long)bytes, -1);
+    free(interned);
+}
+
+/*
+================================================================================
+    PRIVATE HELPER FUNCTIONS - ENTRIES
+================================================================================
+*/
+
+/**
+ * @brief Releases everything an entry references except the entry struct
+ *
+ * The struct itself is freed by the DLL node removal.
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _releaseEntry(UndoHistory* history, UndoEntry* entry) {
+    for (int i = 0; i < entry->itemCount; i++) {
+        UndoItem* record = &entry->items[i];
+        _release(&history->paths, record->path);
+        _release(&history->paths, record->name);
+        _release(&history->paths, record->originalPath);
+        _release(&history->paths, record->trashPath);
+        _release(&history->paths, record->uid);
+    }
+    _release(&history->paths, entry->from);
+    _release(&history->paths, entry->to);
+    free(entry->items);
+    size_t entryBytes = sizeof(UndoEntry) + sizeof(UndoItem) * (size_t)entry->itemCount;
+    history->entryBytes -= entryBytes;
+    memAccount(MEM_UNDO, -(long long)entryBytes, -1);
+}
+
+/**
+ * @brief Removes the oldest entry
+ *
+ * @internal
+ * @since 1.0
+ */
+static void _evictOldest(UndoHistory* history) {
+    DLLNode* oldest = history->entries.tail;
+    _releaseEntry(history, (UndoEntry*)oldest->data);
+    DLL_removeBack(&history->entries, oldest);
+}
+
+/**
+ * @brief Returns the part of path after the last separator
+ *
+ * @internal
+ * @since 1.0
+ */
+static const char* _baseName(const char* path) {
+    const char* slash = strrchr(path, '/');
+    const char* backslash = strrchr(path, '\\');
+    if (backslash != NULL && (slash == NULL || backslash > slash)) {
+        slash = backslash;
+    }
+    return slash ? slash + 1 : path;
+}
+
+/**
+ * @brief strdup() that passes NULL through
+ *
+ * @internal
+ * @since 1.0
+ */
+static char* _dupOrNull(const char* text) {
+    return text ? strdup(text) : NULL;
+}
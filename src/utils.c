@@ -1,45 +1,17 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <ctype.h>
-#include <dirent.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
-#include "file_manager.h"
+#include "logger.h"
 #include "utils.h"
-#include "body.h"
-#include "ctx.h"
 
-#include "raylib.h"
-
-#include "navbar.h"
-#include "toolbar.h"
-
-#define CONTROL_KEY_PRESSED IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)
-#define SHIFT_KEY_PRESSED IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)
-#define ALT_KEY_PRESSED IsKeyDown(KEY_LEFT_ALT) || IsKeyDown(KEY_RIGHT_ALT)
-
-/*
-================================================================================
-    PRIVATE HELPER PROTOTYPES
-================================================================================
-*/
-
-// Shortcuts
-static void _handleClipboardOperations(Context* ctx);       // Handle CTRL+C, CTRL+V, CTRL+X shortcuts
-static void _handleUndoRedoOperations(Context* ctx);        // Handle CTRL+Z, CTRL+Y shortcuts
-static void _handleDeleteOperation(Context* ctx);           // Handle DELETE key or CTRL+DELETE shortcut
-static void _handleRenameOperation(Context* ctx);           // Handle F2 key for renaming
-static void _handleRefreshOperation(Context* ctx);          // Handle F5 key or CTRL+R for refreshing
-static void _handleBackNavigation(Context* ctx);            // Handle BACKSPACE or ALT+LEFT for navigating back
-static void _handleSelectAllOperation(Context* ctx);        // Handle CTRL+A for selecting all items
-static void _handleNewItemOperations(Context* ctx);         // Handle CTRL+N for new file, CTRL+SHIFT+N for new folder
-static void _handleSearchAndPathOperations(Context* ctx);   // Handle CTRL+F for search and CTRL+L for path edit mode
-static void _handleArrowNavigation(Context* ctx);           // Handle arrow keys for navigating through items
-static void _handleEnterKey(Context* ctx);                  // Handle Enter key for folder/file opening
-
-// Utilities
-static int _getTotalItems(Context* ctx);                    // Count total items in current directory
-static void _selectItemAtIndex(Context* ctx, int index);    // Select item at a specific index
+#define FORMAT_BUFFER_COUNT 4      // Jumlah buffer bergilir formatText
+#define FORMAT_BUFFER_LENGTH 4096  // Cukup untuk path terpanjang di Linux
 
 /*
 ================================================================================
@@ -58,7 +30,7 @@ void inputString(char** s) {
         temp[i] = c;
 
         if (temp == NULL) {
-            printf("[LOG] Memory allocation failed\n");
+            logError("Memory allocation failed\n");
             break;
         }
 
@@ -81,241 +53,70 @@ void toLowerStr(char* str) {
     }
 }
 
-void ShortcutKeys(Context* ctx) {
-    _handleClipboardOperations(ctx);
-    _handleUndoRedoOperations(ctx);
-    _handleDeleteOperation(ctx);
-    _handleRenameOperation(ctx);
-    _handleRefreshOperation(ctx);
-    _handleBackNavigation(ctx);
-    _handleSelectAllOperation(ctx);
-    _handleNewItemOperations(ctx);
-    _handleSearchAndPathOperations(ctx);
-    _handleArrowNavigation(ctx);
-    _handleEnterKey(ctx);
-}
-
 /*
 ================================================================================
-    PRIVATE HELPER FUNCTIONS - SHORTCUTS OPERATIONS
+    FILESYSTEM AND FORMATTING
 ================================================================================
 */
 
-static void _handleClipboardOperations(Context* ctx) {
-    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_C)) {
-        copyFile(ctx->fileManager);
-    }
-
-    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_V)) {
-        pasteFile(ctx->fileManager, true);
-    }
+const char* formatText(const char* format, ...) {
+    static char buffers[FORMAT_BUFFER_COUNT][FORMAT_BUFFER_LENGTH];
+    static int index = 0;
 
-    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_X)) {
-        cutFile(ctx->fileManager);
-    }
-}
+    char* buffer = buffers[index];
+    index = (index + 1) % FORMAT_BUFFER_COUNT;
 
-static void _handleUndoRedoOperations(Context* ctx) {
-    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_Z)) {
-        if (ctx->fileManager != NULL) {
-            undo(ctx->fileManager);
-            printf("[LOG] Undo shortcut activated\n");
-        }
-    }
-
-    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_Y)) {
-        if (ctx->fileManager != NULL) {
-            redo(ctx->fileManager);
-            printf("[LOG] Redo shortcut activated\n");
-        }
-    }
-}
-
-static void _handleDeleteOperation(Context* ctx) {
-    if (IsKeyPressed(KEY_DELETE) || ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_DELETE))) {
-        ctx->toolbar->isButtonDeleteClicked = true;
-        printf("[LOG] Delete shortcut activated\n");
-    }
-}
-
-static void _handleRenameOperation(Context* ctx) {
-    if (IsKeyPressed(KEY_F2)) {
-        if (ctx->fileManager != NULL && ctx->fileManager->selectedItem.head != NULL) {
-            Item* selectedItem = (Item*)ctx->fileManager->selectedItem.head->data;
-            if (selectedItem != NULL) {
-                printf("[LOG] Rename shortcut activated for: %s\n", selectedItem->name);
-                // renameFile(ctx->fileManager, selectedItem->path, "new_name"); // Implement proper rename UI
-            }
-        }
-    }
-}
-
-static void _handleRefreshOperation(Context* ctx) {
-    if (IsKeyPressed(KEY_F5) || ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_R))) {
-        refreshFileManager(ctx->fileManager);
-    }
-}
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer, FORMAT_BUFFER_LENGTH, format, args);
+    va_end(args);
 
-static void _handleBackNavigation(Context* ctx) {
-    if (!ctx->disableGroundClick &&
-        !ctx->navbar->textboxPatheditMode &&
-        !ctx->navbar->textboxSearcheditMode &&
-        (IsKeyPressed(KEY_BACKSPACE) || (IsKeyDown(KEY_LEFT_ALT) && IsKeyPressed(KEY_LEFT)))) {
-        if (ctx->fileManager != NULL &&
-            ctx->fileManager->treeCursor != NULL &&
-            ctx->fileManager->treeCursor->parent != NULL) {
-            goBack(ctx->fileManager);
-        }
+    if (written >= FORMAT_BUFFER_LENGTH) {
+        logWarn("formatText: teks terpotong (%d byte)\n", written);
     }
+    return buffer;
 }
 
-static void _handleSelectAllOperation(Context* ctx) {
-    if ((CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_A)) {
-        if (ctx->fileManager != NULL && ctx->fileManager->treeCursor != NULL) {
-            if (!ctx->body->selectedAll) {
-                selectAll(ctx->fileManager);
-                ctx->body->selectedAll = true;
-            }
-            else {
-                clearSelectedFile(ctx->fileManager);
-                ctx->body->selectedAll = false;
-            }
-            printf("[LOG] Select all shortcut activated\n");
-        }
-    }
+bool fileExists(const char* path) {
+    return path != NULL && access(path, F_OK) == 0;
 }
 
-static void _handleNewItemOperations(Context* ctx) {
-    // NEW FOLDER (Ctrl + Shift + N)
-    if ((CONTROL_KEY_PRESSED) && (SHIFT_KEY_PRESSED) && IsKeyPressed(KEY_N)) {
-        ctx->toolbar->selectedType = ITEM_FOLDER;
-        ctx->disableGroundClick = true;
-        if (!ctx->disableGroundClick) {
-            char* name = ctx->toolbar->inputCreateItemBuffer;
-            char* dirPath = TextFormat(".dir/%s", ctx->fileManager->currentPath);
-            createFile(ctx->fileManager, ITEM_FOLDER, dirPath, name, true);
-        }
-    }
-
-    // NEW FILE (Ctrl + N)
-    if (!ctx->disableGroundClick &&
-        (CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_N) && !(SHIFT_KEY_PRESSED)) {
-        ctx->navbar->textboxPatheditMode = false;
-        ctx->navbar->textboxSearcheditMode = false;
-        if (ctx->fileManager != NULL) {
-            ctx->toolbar->selectedType = ITEM_FILE;
-            ctx->disableGroundClick = true;
-            if (!ctx->disableGroundClick) {
-                char* name = ctx->toolbar->inputCreateItemBuffer;
-                char* dirPath = TextFormat(".dir/%s", ctx->fileManager->currentPath);
-                createFile(ctx->fileManager, ITEM_FILE, dirPath, name, true);
-            }
-        }
-    }
+bool directoryExists(const char* path) {
+    struct stat statbuf;
+    return path != NULL && stat(path, &statbuf) == 0 && S_ISDIR(statbuf.st_mode);
 }
 
-static void _handleSearchAndPathOperations(Context* ctx) {
-    // CTRL+F / FIND
-    if (!ctx->disableGroundClick && (CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_F)) {
-        ctx->navbar->textboxPatheditMode = false;
-        ctx->disableGroundClick = false;
-        if (ctx->navbar->textboxSearcheditMode) {
-            ctx->navbar->textboxSearcheditMode = false;
-            printf("[LOG] Search mode deactivated\n");
-        }
-        else {
-            ctx->navbar->textboxSearcheditMode = true;
-            printf("[LOG] Search mode activated\n");
-        }
+int makeDirectory(const char* path) {
+    if (path == NULL || path[0] == '\0') {
+        return -1;
     }
 
-    // CTRL+L / ADDRESS/PATH
-    if (!ctx->disableGroundClick && (CONTROL_KEY_PRESSED) && IsKeyPressed(KEY_L)) {
-        ctx->navbar->textboxSearcheditMode = false;
-        ctx->disableGroundClick = false;
-        if (ctx->navbar->textboxPatheditMode) {
-            ctx->navbar->textboxPatheditMode = false;
-            printf("[LOG] Path edit mode deactivated\n");
-        }
-        else {
-            ctx->navbar->textboxPatheditMode = true;
-            printf("[LOG] Path edit mode activated\n");
-        }
+    char* temp = strdup(path);
+    if (temp == NULL) {
+        return -1;
     }
-}
 
-static void _handleArrowNavigation(Context* ctx) {
-    if (!ctx->navbar->textboxPatheditMode && !ctx->navbar->textboxSearcheditMode && !ctx->disableGroundClick) {
-        if (IsKeyPressed(KEY_UP)) {
-            if (ctx->body->focusedIndex > 0) {
-                ctx->body->focusedIndex--;
-                _selectItemAtIndex(ctx, ctx->body->focusedIndex);
-                printf("[LOG] Arrow up navigation - index: %d\n", ctx->body->focusedIndex);
+    // Buat setiap komponen path secara berurutan, seperti mkdir -p
+    int result = 0;
+    for (char* p = temp + 1; ; p++) {
+        if (*p == '/' || *p == '\\' || *p == '\0') {
+            char saved = *p;
+            *p = '\0';
+#ifdef _WIN32
+            int status = mkdir(temp);
+#else
+            int status = mkdir(temp, 0755);
+#endif
+            if (status != 0 && errno != EEXIST) {
+                result = -1;
             }
-        }
-
-        if (IsKeyPressed(KEY_DOWN)) {
-            int totalItems = _getTotalItems(ctx);
-            if (ctx->body->focusedIndex < totalItems - 1) {
-                ctx->body->focusedIndex++;
-                _selectItemAtIndex(ctx, ctx->body->focusedIndex);
-                printf("[LOG] Arrow down navigation - index: %d\n", ctx->body->focusedIndex);
-            }
-        }
-    }
-}
-
-static void _handleEnterKey(Context* ctx) {
-    if (!ctx->navbar->textboxPatheditMode && !ctx->navbar->textboxSearcheditMode && !ctx->disableGroundClick) {
-        if (IsKeyPressed(KEY_ENTER)) {
-            if (ctx->body->focusedIndex >= 0) {
-                Tree cursor = ctx->fileManager->treeCursor->first_son;
-                int currentIndex = 0;
-
-                while (cursor != NULL && currentIndex < ctx->body->focusedIndex) {
-                    cursor = cursor->next_brother;
-                    currentIndex++;
-                }
-
-                if (cursor != NULL) {
-                    Item item = cursor->item;
-
-                    if (item.type == ITEM_FOLDER) {
-                        goTo(ctx->fileManager, cursor);
-                        ctx->body->focusedIndex = 0;
-                        printf("[LOG] Keyboard action - enter folder: %s\n", item.name);
-                    }
-                    else if (item.type == ITEM_FILE) {
-                        windowsOpenWith(item.path);
-                        printf("[LOG] Keyboard action - open file: %s\n", item.name);
-                    }
-                }
+            *p = saved;
+            if (saved == '\0') {
+                break;
             }
         }
     }
-}
-
-static void _selectItemAtIndex(Context* ctx, int index) {
-    clearSelectedFile(ctx->fileManager);
-
-    Tree cursor = ctx->fileManager->treeCursor->first_son;
-    int currentIndex = 0;
-    while (cursor != NULL && currentIndex < index) {
-        cursor = cursor->next_brother;
-        currentIndex++;
-    }
-    if (cursor != NULL) {
-        cursor->item.selected = true;
-        selectFile(ctx->fileManager, &cursor->item);
-    }
-}
+    free(temp);
 
-static int _getTotalItems(Context* ctx) {
-    Tree cursor = ctx->fileManager->treeCursor->first_son;
-    int totalItems = 0;
-    while (cursor != NULL) {
-        totalItems++;
-        cursor = cursor->next_brother;
-    }
-    return totalItems;
+    return (result == 0 && directoryExists(path)) ? 0 : -1;
 }
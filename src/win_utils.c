@@ -17,7 +17,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "logger.h"
 #include "win_utils.h"
+#include "delete_engine.h"
 
 #ifndef _WIN32
 static int _commandExists(const char* cmd) {
@@ -81,7 +83,7 @@ int RemoveItemsRecurse(const char* folderPath) {
             // Folder kosong mungkin, tetap lanjut hapus folder
             return RemoveDirectoryA(folderPath) ? 1 : 0;
         }
-        printf("[LOG] Gagal akses folder %s (Error: %lu)\n", folderPath, err);
+        logError("Gagal akses folder %s (Error: %lu)\n", folderPath, err);
         return 0;
     }
 
@@ -94,12 +96,12 @@ int RemoveItemsRecurse(const char* folderPath) {
         if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
             if (!RemoveItemsRecurse(itemPath)) {
                 // Jika gagal hapus isi folder, tetap coba lanjut
-                printf("[LOG] Gagal hapus subfolder %s\n", itemPath);
+                logError("Gagal hapus subfolder %s\n", itemPath);
             }
         }
         else {
             if (!DeleteFileA(itemPath)) {
-                printf("[LOG] Gagal hapus file: %s (Error: %lu)\n", itemPath, GetLastError());
+                logError("Gagal hapus file: %s (Error: %lu)\n", itemPath, GetLastError());
             }
         }
     } while (FindNextFileA(hFind, &findData));
@@ -107,52 +109,21 @@ int RemoveItemsRecurse(const char* folderPath) {
     FindClose(hFind);
 
     if (!RemoveDirectoryA(folderPath)) {
-        printf("[LOG] Gagal hapus folder: %s (Error: %lu)\n", folderPath, GetLastError());
+        logError("Gagal hapus folder: %s (Error: %lu)\n", folderPath, GetLastError());
         return 0;
     }
 
     return 1;
 #else
-    DIR* dir = opendir(folderPath);
-    if (!dir) {
-        if (rmdir(folderPath) == 0) {
-            return 1;
-        }
-        printf("[LOG] Gagal akses folder %s (Error: %d)\n", folderPath, errno);
-        return 0;
-    }
-
-    struct dirent* entry = NULL;
-    char itemPath[PATH_MAX];
-    while ((entry = readdir(dir)) != NULL) {
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
-        }
-
-        snprintf(itemPath, sizeof(itemPath), "%s/%s", folderPath, entry->d_name);
-
-        struct stat st;
-        if (lstat(itemPath, &st) != 0) {
-            printf("[LOG] Gagal akses item %s (Error: %d)\n", itemPath, errno);
-            continue;
-        }
-
-        if (S_ISDIR(st.st_mode)) {
-            if (!RemoveItemsRecurse(itemPath)) {
-                printf("[LOG] Gagal hapus subfolder %s\n", itemPath);
-            }
-        }
-        else {
-            if (unlink(itemPath) != 0) {
-                printf("[LOG] Gagal hapus file: %s (Error: %d)\n", itemPath, errno);
-            }
-        }
-    }
+    DeleteStats stats;
+    bool removed = removeTreeParallel(folderPath, &stats);
 
-    closedir(dir);
+    logInfo("Hapus %s: %lld file, %lld folder dalam %.2f detik (%.0f item/detik, %d thread)\n",
+        folderPath, stats.filesRemoved, stats.dirsRemoved, stats.seconds,
+        deleteItemsPerSecond(&stats), stats.threads);
 
-    if (rmdir(folderPath) != 0) {
-        printf("[LOG] Gagal hapus folder: %s (Error: %d)\n", folderPath, errno);
+    if (!removed) {
+        logError("Gagal hapus folder: %s (%lld error)\n", folderPath, stats.errors);
         return 0;
     }
 
@@ -191,16 +162,16 @@ int OpenWindowsFileDialog(char* filePath, int maxPathLength) {
     if (GetOpenFileNameA(&ofn) == TRUE) {
         strncpy(filePath, szFile, maxPathLength - 1);
         filePath[maxPathLength - 1] = '\0';
-        printf("[LOG] File dialog - Selected: %s\n", filePath);
+        logInfo("File dialog - Selected: %s\n", filePath);
         return 1; // Success
     }
     else {
         DWORD error = CommDlgExtendedError();
         if (error != 0) {
-            printf("[LOG] File dialog error: %lu\n", error);
+            logError("File dialog error: %lu\n", error);
         }
         else {
-            printf("[LOG] File dialog cancelled by user\n");
+            logWarn("File dialog cancelled by user\n");
         }
         return 0; // Cancel or error
     }
@@ -212,13 +183,13 @@ int OpenWindowsFileDialog(char* filePath, int maxPathLength) {
     const char* script = "osascript -e 'POSIX path of (choose file with prompt \"Select File to Import\")'";
     FILE* pipe = popen(script, "r");
     if (!pipe) {
-        printf("[LOG] File dialog gagal dibuka\n");
+        logError("File dialog gagal dibuka\n");
         return 0;
     }
 
     if (!fgets(filePath, maxPathLength, pipe)) {
         pclose(pipe);
-        printf("[LOG] File dialog cancelled by user\n");
+        logWarn("File dialog cancelled by user\n");
         return 0;
     }
     pclose(pipe);
@@ -232,7 +203,7 @@ int OpenWindowsFileDialog(char* filePath, int maxPathLength) {
         return 0;
     }
 
-    printf("[LOG] File dialog - Selected: %s\n", filePath);
+    logInfo("File dialog - Selected: %s\n", filePath);
     return 1;
 #elif defined(__linux__)
     if (filePath == NULL || maxPathLength <= 0) {
@@ -241,28 +212,28 @@ int OpenWindowsFileDialog(char* filePath, int maxPathLength) {
 
     if (_commandExists("zenity")) {
         if (_runDialogCommand("zenity --file-selection --title=\"Select File to Import\"", filePath, maxPathLength)) {
-            printf("[LOG] File dialog - Selected: %s\n", filePath);
+            logInfo("File dialog - Selected: %s\n", filePath);
             return 1;
         }
-        printf("[LOG] File dialog cancelled by user\n");
+        logWarn("File dialog cancelled by user\n");
         return 0;
     }
 
     if (_commandExists("kdialog")) {
         if (_runDialogCommand("kdialog --getopenfilename", filePath, maxPathLength)) {
-            printf("[LOG] File dialog - Selected: %s\n", filePath);
+            logInfo("File dialog - Selected: %s\n", filePath);
             return 1;
         }
-        printf("[LOG] File dialog cancelled by user\n");
+        logWarn("File dialog cancelled by user\n");
         return 0;
     }
 
-    printf("[LOG] File dialog tidak tersedia. Install zenity atau kdialog.\n");
+    logInfo("File dialog tidak tersedia. Install zenity atau kdialog.\n");
     return 0;
 #else
     (void)filePath;
     (void)maxPathLength;
-    printf("[LOG] File dialog tidak didukung pada platform ini\n");
+    logInfo("File dialog tidak didukung pada platform ini\n");
     return 0;
 #endif
 }
@@ -289,7 +260,7 @@ int OpenWindowsFolderDialog(char* folderPath, int maxPathLength) {
                 imalloc->lpVtbl->Release(imalloc);
             }
 
-            printf("[LOG] Folder dialog - Selected: %s\n", folderPath);
+            logInfo("Folder dialog - Selected: %s\n", folderPath);
 
             // Uninitialize COM
             if (SUCCEEDED(hr)) {
@@ -311,7 +282,7 @@ int OpenWindowsFolderDialog(char* folderPath, int maxPathLength) {
         CoUninitialize();
     }
 
-    printf("[LOG] Folder dialog cancelled or failed\n");
+    logWarn("Folder dialog cancelled or failed\n");
     return 0; // Cancel or error
 #elif defined(__APPLE__)
     if (folderPath == NULL || maxPathLength <= 0) {
@@ -321,13 +292,13 @@ int OpenWindowsFolderDialog(char* folderPath, int maxPathLength) {
     const char* script = "osascript -e 'POSIX path of (choose folder with prompt \"Select Folder to Import\")'";
     FILE* pipe = popen(script, "r");
     if (!pipe) {
-        printf("[LOG] Folder dialog gagal dibuka\n");
+        logError("Folder dialog gagal dibuka\n");
         return 0;
     }
 
     if (!fgets(folderPath, maxPathLength, pipe)) {
         pclose(pipe);
-        printf("[LOG] Folder dialog cancelled by user\n");
+        logWarn("Folder dialog cancelled by user\n");
         return 0;
     }
     pclose(pipe);
@@ -341,7 +312,7 @@ int OpenWindowsFolderDialog(char* folderPath, int maxPathLength) {
         return 0;
     }
 
-    printf("[LOG] Folder dialog - Selected: %s\n", folderPath);
+    logInfo("Folder dialog - Selected: %s\n", folderPath);
     return 1;
 #elif defined(__linux__)
     if (folderPath == NULL || maxPathLength <= 0) {
@@ -350,28 +321,28 @@ int OpenWindowsFolderDialog(char* folderPath, int maxPathLength) {
 
     if (_commandExists("zenity")) {
         if (_runDialogCommand("zenity --file-selection --directory --title=\"Select Folder to Import\"", folderPath, maxPathLength)) {
-            printf("[LOG] Folder dialog - Selected: %s\n", folderPath);
+            logInfo("Folder dialog - Selected: %s\n", folderPath);
             return 1;
         }
-        printf("[LOG] Folder dialog cancelled by user\n");
+        logWarn("Folder dialog cancelled by user\n");
         return 0;
     }
 
     if (_commandExists("kdialog")) {
         if (_runDialogCommand("kdialog --getexistingdirectory", folderPath, maxPathLength)) {
-            printf("[LOG] Folder dialog - Selected: %s\n", folderPath);
+            logInfo("Folder dialog - Selected: %s\n", folderPath);
             return 1;
         }
-        printf("[LOG] Folder dialog cancelled by user\n");
+        logWarn("Folder dialog cancelled by user\n");
         return 0;
     }
 
-    printf("[LOG] Folder dialog tidak tersedia. Install zenity atau kdialog.\n");
+    logInfo("Folder dialog tidak tersedia. Install zenity atau kdialog.\n");
     return 0;
 #else
     (void)folderPath;
     (void)maxPathLength;
-    printf("[LOG] Folder dialog tidak didukung pada platform ini\n");
+    logInfo("Folder dialog tidak didukung pada platform ini\n");
     return 0;
 #endif
 }
@@ -388,7 +359,7 @@ int GetWindowsCommonPath(WindowsCommonFolder folder, char* path, int pathSize) {
 #ifdef _WIN32
     char* userProfile = getenv("USERPROFILE");
     if (!userProfile) {
-        printf("[LOG] USERPROFILE environment variable not found\n");
+        logWarn("USERPROFILE environment variable not found\n");
         return 0;
     }
 
@@ -412,17 +383,17 @@ int GetWindowsCommonPath(WindowsCommonFolder folder, char* path, int pathSize) {
         snprintf(path, pathSize, "%s\\Videos", userProfile);
         break;
     default:
-        printf("[LOG] Unknown folder type: %d\n", folder);
+        logWarn("Unknown folder type: %d\n", folder);
         return 0;
     }
 
-    printf("[LOG] Common path generated: %s\n", path);
+    logDebug("Common path generated: %s\n", path);
     return 1;
 #else
     const char* home = getenv("HOME");
     const char* suffix = NULL;
     if (!home) {
-        printf("[LOG] HOME environment variable not found\n");
+        logWarn("HOME environment variable not found\n");
         return 0;
     }
 
@@ -446,7 +417,7 @@ int GetWindowsCommonPath(WindowsCommonFolder folder, char* path, int pathSize) {
         suffix = "Movies";
         break;
     default:
-        printf("[LOG] Unknown folder type: %d\n", folder);
+        logWarn("Unknown folder type: %d\n", folder);
         return 0;
     }
 
@@ -457,7 +428,7 @@ int GetWindowsCommonPath(WindowsCommonFolder folder, char* path, int pathSize) {
         snprintf(path, pathSize, "%s/%s", home, suffix);
     }
 
-    printf("[LOG] Common path generated: %s\n", path);
+    logDebug("Common path generated: %s\n", path);
     return 1;
 #endif
 }
@@ -559,7 +530,7 @@ int ValidateWindowsPath(const char* path) {
     // Check if path exists
     DWORD dwAttrib = GetFileAttributesA(path);
     if (dwAttrib == INVALID_FILE_ATTRIBUTES) {
-        printf("[LOG] Path validation failed - not found: %s\n", path);
+        logError("Path validation failed - not found: %s\n", path);
         return 0; // Path doesn't exist
     }
 
@@ -574,12 +545,12 @@ int ValidateWindowsPath(const char* path) {
         NULL);
 
     if (hFile == INVALID_HANDLE_VALUE) {
-        printf("[LOG] Path validation failed - access denied: %s (Error: %lu)\n", path, GetLastError());
+        logError("Path validation failed - access denied: %s (Error: %lu)\n", path, GetLastError());
         return 0; // Can't access
     }
 
     CloseHandle(hFile);
-    printf("[LOG] Path validation successful: %s\n", path);
+    logDebug("Path validation successful: %s\n", path);
     return 1; // Valid and accessible
 #else
     if (!path || strlen(path) == 0) {
@@ -588,16 +559,16 @@ int ValidateWindowsPath(const char* path) {
 
     struct stat st;
     if (stat(path, &st) != 0) {
-        printf("[LOG] Path validation failed - not found: %s (Error: %d)\n", path, errno);
+        logError("Path validation failed - not found: %s (Error: %d)\n", path, errno);
         return 0;
     }
 
     if (access(path, R_OK) != 0) {
-        printf("[LOG] Path validation failed - access denied: %s (Error: %d)\n", path, errno);
+        logError("Path validation failed - access denied: %s (Error: %d)\n", path, errno);
         return 0;
     }
 
-    printf("[LOG] Path validation successful: %s\n", path);
+    logDebug("Path validation successful: %s\n", path);
     return 1;
 #endif
 }